@@ -132,6 +132,9 @@
 // メモリアライメント対応アロケーター | Aligned allocator
 # include <Siv3D/Allocator.hpp>
 
+// フレームアリーナのアロケーター | Frame arena allocator
+# include <Siv3D/ArenaAllocator.hpp>
+
 //////////////////////////////////////////////////
 //
 //	Optional クラス | Optional
@@ -186,6 +189,9 @@
 // 非同期タスク | Asynchronous task
 # include <Siv3D/AsyncTask.hpp>
 
+// タスクグループ | Task group
+# include <Siv3D/TaskGroup.hpp>
+
 // 子プロセス | Child process
 # include <Siv3D/ChildProcess.hpp>
 
@@ -342,6 +348,12 @@
 // プロファイラー | Profiler
 # include <Siv3D/Profiler.hpp>
 
+// フレームの計測値 | Frame metrics
+# include <Siv3D/FrameMetrics.hpp>
+
+// メモリ確保の計測 | Allocation tracker
+# include <Siv3D/AllocationTracker.hpp>
+
 // 処理にかかった時間の測定 | Clock counter in milliseconds
 # include <Siv3D/MillisecClock.hpp>
 
@@ -354,6 +366,9 @@
 // 時間の測定 | Time profiler
 # include <Siv3D/TimeProfiler.hpp>
 
+// トレースイベントの記録 | Trace event recorder
+# include <Siv3D/TraceRecorder.hpp>
+
 //////////////////////////////////////////////////
 //
 //	ファイル I/O | File I/O
@@ -411,6 +426,9 @@
 // 読み込み専用バイナリファイル | Binary file reader
 # include <Siv3D/BinaryReader.hpp>
 
+// メモリマップされた読み込み専用ファイル | Memory-mapped file reader
+# include <Siv3D/MappedReader.hpp>
+
 // 書き込み専用バイナリファイル | Binary file writer
 # include <Siv3D/BinaryWriter.hpp>
 
@@ -468,12 +486,18 @@
 // CSV データの読み書き | CSV reader/writer
 # include <Siv3D/CSV.hpp>
 
+// CSV ファイルのストリーミング読み込み | Streaming CSV reader
+# include <Siv3D/CSVReader.hpp>
+
 // INI データの読み書き | INI reader/writer
 # include <Siv3D/INI.hpp>
 
 // JSON データの書き出し | JSON reader/writer
 # include <Siv3D/JSON.hpp>
 
+// JSON ファイルのストリーミング読み込み | Streaming JSON reader
+# include <Siv3D/JSONReader.hpp>
+
 // XML ファイルの読み込み | XML parser
 # include <Siv3D/XMLReader.hpp>
 
@@ -888,6 +912,12 @@
 // TCP 通信のエラー | TCP connection errors
 # include <Siv3D/TCPError.hpp>
 
+// TCP の受信データの参照 | TCP receive view
+# include <Siv3D/TCPReceiveView.hpp>
+
+// TCP セッションの統計情報 | TCP session statistics
+# include <Siv3D/TCPSessionStats.hpp>
+
 // TCP サーバ | TCP server
 # include <Siv3D/TCPServer.hpp>
 
@@ -0,0 +1,149 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Uncopyable.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+
+namespace s3d
+{
+	/// @brief メモリ確保の分類
+	enum class AllocationTag : uint8
+	{
+		/// @brief 分類されていないメモリ確保
+		Untagged,
+
+		/// @brief `Allocator` による（アライメントが必要な型の）`Array` のメモリ確保
+		Array,
+
+		/// @brief `Image` の作成やデコードによるメモリ確保
+		Image,
+
+		/// @brief `Wave` の作成やデコードによるメモリ確保
+		Wave,
+
+		/// @brief フォントのグリフキャッシュによるメモリ確保
+		GlyphCache,
+
+		/// @brief アセットハンドルの管理によるメモリ確保
+		AssetHandleManager,
+	};
+
+	/// @brief メモリ確保の統計
+	struct AllocationStat
+	{
+		/// @brief 現在確保されているメモリのサイズ（バイト）
+		size_t currentBytes = 0;
+
+		/// @brief 確保されていたメモリのサイズの最大値（バイト）
+		size_t peakBytes = 0;
+
+		/// @brief 現在確保されているメモリブロックの個数
+		size_t currentCount = 0;
+
+		/// @brief メモリ確保の累計回数
+		uint64 totalCount = 0;
+
+		/// @brief 確保したメモリのサイズの累計（バイト）
+		uint64 totalBytes = 0;
+	};
+
+	/// @brief メモリを確保したコード上の位置の統計
+	struct AllocationSite
+	{
+		/// @brief `operator new` の呼び出し元のアドレス
+		const void* address = nullptr;
+
+		/// @brief 呼び出し元の関数名、またはモジュール名とオフセット（取得できない場合は空）
+		String symbol;
+
+		/// @brief 最後にメモリを確保したときの分類
+		AllocationTag tag = AllocationTag::Untagged;
+
+		/// @brief 現在確保されているメモリのサイズ（バイト）
+		size_t currentBytes = 0;
+
+		/// @brief 現在確保されているメモリブロックの個数
+		size_t currentCount = 0;
+
+		/// @brief メモリ確保の累計回数
+		uint64 totalCount = 0;
+	};
+
+	/// @brief メモリ確保の計測
+	/// @remark エンジンを `SIV3D_ALLOCATION_TRACKING` を定義してビルドした場合に、グローバルな `operator new` / `operator delete` を置き換えて、すべてのメモリ確保を分類ごとに集計します。
+	/// @remark それ以外の場合は、統計はすべて 0 になります。
+	/// @remark メモリは、確保したときにそのスレッドで有効な `ScopedAllocationTag` の分類に集計され、解放したときに同じ分類から差し引かれます。
+	namespace AllocationTracker
+	{
+		/// @brief メモリ確保の分類の個数
+		inline constexpr size_t NumTags = (static_cast<size_t>(AllocationTag::AssetHandleManager) + 1);
+
+		/// @brief メモリ確保の計測が有効なビルドであるかを返します。
+		/// @return メモリ確保の計測が有効なビルドである場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsAvailable() noexcept;
+
+		/// @brief 指定した分類のメモリ確保の統計を返します。
+		/// @param tag メモリ確保の分類
+		/// @return 指定した分類のメモリ確保の統計
+		[[nodiscard]]
+		AllocationStat GetStat(AllocationTag tag) noexcept;
+
+		/// @brief すべての分類を合計したメモリ確保の統計を返します。
+		/// @return すべての分類を合計したメモリ確保の統計
+		[[nodiscard]]
+		AllocationStat GetTotalStat() noexcept;
+
+		/// @brief 確保されていたメモリのサイズの最大値を、現在のサイズにリセットします。
+		void ResetPeak() noexcept;
+
+		/// @brief メモリを確保したコード上の位置の記録の ON / OFF を設定します。
+		/// @param enabled 記録を有効にするか
+		/// @remark 記録中はメモリ確保のたびにロックを取るため、デバッグ用途で使います。Web 版では記録できません。
+		void EnableSiteTracking(bool enabled) noexcept;
+
+		/// @brief メモリを確保したコード上の位置を記録中であるかを返します。
+		/// @return 記録中である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsSiteTrackingEnabled() noexcept;
+
+		/// @brief 現在確保されているメモリのサイズが大きい順に、メモリを確保したコード上の位置を返します。
+		/// @param count 返す位置の最大数
+		/// @return メモリを確保したコード上の位置の統計
+		[[nodiscard]]
+		Array<AllocationSite> GetTopSites(size_t count);
+
+		/// @brief 分類ごとの統計と、現在確保されているメモリのサイズが大きい順のメモリを確保したコード上の位置をログに出力します。
+		/// @param count 出力する位置の最大数
+		void DumpTopSites(size_t count = 16);
+	}
+
+	/// @brief スコープを抜けるまで、現在のスレッドでのメモリ確保を指定した分類に集計するクラス
+	class ScopedAllocationTag : Uncopyable
+	{
+	public:
+
+		/// @brief 現在のスレッドのメモリ確保の分類を変更します。
+		/// @param tag メモリ確保の分類
+		SIV3D_NODISCARD_CXX20
+		explicit ScopedAllocationTag(AllocationTag tag) noexcept;
+
+		/// @brief メモリ確保の分類を元に戻します。
+		~ScopedAllocationTag();
+
+	private:
+
+		AllocationTag m_previousTag;
+	};
+}
@@ -15,6 +15,19 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief `Allocator` によるメモリ確保を記録します。
+		/// @param size 確保したメモリのサイズ（バイト）
+		/// @remark `SIV3D_ALLOCATION_TRACKING` が定義されている場合のみ呼ばれます。
+		void RecordAllocatorAllocation(size_t size) noexcept;
+
+		/// @brief `Allocator` によるメモリ解放を記録します。
+		/// @param size 解放したメモリのサイズ（バイト）
+		/// @remark `SIV3D_ALLOCATION_TRACKING` が定義されている場合のみ呼ばれます。
+		void RecordAllocatorDeallocation(size_t size) noexcept;
+	}
+
 	/// @brief メモリアライメント対応アロケータ
 	/// @tparam Type アロケーションするオブジェクトの型
 	/// @tparam Alignment アライメント（バイト）
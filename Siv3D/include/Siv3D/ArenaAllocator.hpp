@@ -0,0 +1,80 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <new>
+# include <type_traits>
+# include "Common.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief フレームアリーナからメモリを確保します。
+		/// @param size 確保するメモリのサイズ（バイト）
+		/// @param alignment アライメント（バイト）
+		/// @return 確保したメモリへのポインタ
+		[[nodiscard]]
+		void* FrameArenaAllocate(size_t size, size_t alignment);
+
+		/// @brief `FrameArenaAllocate()` で確保したメモリを解放します。
+		/// @param p 解放するメモリへのポインタ
+		/// @param size 確保したメモリのサイズ（バイト）
+		/// @param alignment 確保したときのアライメント（バイト）
+		void FrameArenaDeallocate(void* p, size_t size, size_t alignment) noexcept;
+	}
+
+	/// @brief フレームごとにリセットされるアリーナからメモリを確保するアロケータ
+	/// @tparam Type アロケーションするオブジェクトの型
+	/// @remark 1 フレームの中で使い終わる一時的なデータのためのアロケータです。
+	/// @remark アリーナはメインスレッドでのみ使われ、他のスレッドからの確保やアリーナの容量を超える確保は通常のヒープにフォールバックします。アリーナから確保したメモリは、どのスレッドで解放してもかまいません。
+	/// @remark 確保したメモリを `System::Update()` の後まで保持しないでください。保持されたメモリを含むアリーナの領域は、それが解放されるまで再利用されません。
+	template <class Type>
+	class ArenaAllocator
+	{
+	public:
+
+		static_assert(!std::is_const_v<Type>, "ArenaAllocator<const Type> is ill-formed.");
+
+		using value_type								= Type;
+		using size_type									= std::size_t;
+		using difference_type							= std::ptrdiff_t;
+		using propagate_on_container_move_assignment	= std::true_type;
+		using is_always_equal							= std::true_type;
+
+		SIV3D_NODISCARD_CXX20
+		constexpr ArenaAllocator() noexcept = default;
+
+		SIV3D_NODISCARD_CXX20
+		constexpr ArenaAllocator(const ArenaAllocator&) noexcept = default;
+
+		template <class Other>
+		SIV3D_NODISCARD_CXX20
+		constexpr ArenaAllocator(const ArenaAllocator<Other>&) noexcept {}
+
+		[[nodiscard]]
+		Type* allocate(size_t n);
+
+		void deallocate(Type* p, size_t n) noexcept;
+
+		template <class U>
+		struct rebind
+		{
+			using other = ArenaAllocator<U>;
+		};
+	};
+
+	template <class T1, class T2>
+	[[nodiscard]]
+	inline constexpr bool operator ==(const ArenaAllocator<T1>&, const ArenaAllocator<T2>&) noexcept;
+}
+
+# include "detail/ArenaAllocator.ipp"
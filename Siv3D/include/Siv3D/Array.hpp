@@ -16,10 +16,8 @@
 # endif
 # include <vector>
 # ifndef SIV3D_NO_CONCURRENT_API
+	# include <atomic>
 	# include <future>
-	# if SIV3D_PLATFORM(WINDOWS)
-	#	include <execution>
-	# endif
 # endif
 # include <unordered_set>
 # include "String.hpp"
@@ -43,7 +43,8 @@ namespace s3d
 		/// @tparam ...Args 非同期処理のタスクで実行する関数の引数の型
 		/// @param f 非同期処理のタスクで実行する関数
 		/// @param ...args 非同期処理のタスクで実行する関数の引数
-		/// @remark 作成と同時にタスクが非同期で実行されます
+		/// @remark 作成と同時にタスクが専用のスレッドで非同期に実行されます
+		/// @remark 短い処理を多数実行する場合は、エンジンのタスクスケジューラを使う `TaskGroup` を使ってください
 		template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
 		SIV3D_NODISCARD_CXX20
 		explicit AsyncTask(Fty&& f, Args&&... args);
@@ -104,7 +105,7 @@ namespace s3d
 	/// @tparam ...Args 非同期処理のタスクで実行する関数の引数の型
 	/// @param f 非同期処理のタスクで実行する関数
 	/// @param ...args 非同期処理のタスクで実行する関数の引数
-	/// @remark 作成と同時にタスクが非同期で実行されます
+	/// @remark 作成と同時にタスクが専用のスレッドで非同期に実行されます
 	/// @return 作成された非同期処理のタスク
 	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
 	[[nodiscard]]
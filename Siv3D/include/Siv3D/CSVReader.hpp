@@ -0,0 +1,121 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <string>
+# include <string_view>
+# include <variant>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "MemoryMappedFileView.hpp"
+
+namespace s3d
+{
+	/// @brief CSVReader::readColumns() で読み込む列の型
+	enum class CSVColumnType : uint8
+	{
+		/// @brief 64-bit 整数
+		Int64,
+
+		/// @brief 浮動小数点数
+		Double,
+
+		/// @brief 文字列
+		String,
+	};
+
+	/// @brief CSVReader::readColumns() で読み込む列
+	struct CSVColumn
+	{
+		/// @brief 列のインデックス
+		size_t index = 0;
+
+		/// @brief 列の型
+		CSVColumnType type = CSVColumnType::String;
+	};
+
+	/// @brief CSVReader::readColumns() で読み込んだ列のデータ
+	using CSVColumnData = std::variant<Array<int64>, Array<double>, Array<String>>;
+
+	/// @brief UTF-8 の CSV ファイルをメモリマップして、1 行ずつ、または列ごとに読み込むクラス
+	/// @remark 行と要素の区切り方は CSV::load() と同じです。
+	/// @remark 要素の区切り、クオーテーション、エスケープ記号には ASCII の文字のみを使用できます。
+	class CSVReader
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		CSVReader() = default;
+
+		SIV3D_NODISCARD_CXX20
+		explicit CSVReader(FilePathView path, StringView separators = U",", StringView quotes = U"\"", StringView escapes = U"\\");
+
+		/// @brief CSV ファイルを開きます。
+		/// @param path ファイルパス
+		/// @param separators 要素の区切り記号
+		/// @param quotes クオーテーション記号
+		/// @param escapes エスケープ記号
+		/// @return ファイルを開くのに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path, StringView separators = U",", StringView quotes = U"\"", StringView escapes = U"\\");
+
+		/// @brief ファイルを閉じます。
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 次の行を読み込みます。
+		/// @param cells 行の各要素の格納先
+		/// @return 行を読み込んだ場合 true, ファイルの終端に達していた場合は false
+		/// @remark 各要素は、ファイルをマップしたメモリ、または CSVReader 内部のバッファを指す UTF-8 の文字列です。次に readRow() を呼ぶか、ファイルを閉じるまで有効です。
+		bool readRow(Array<std::string_view>& cells);
+
+		/// @brief 読み込み位置をファイルの先頭に戻します。
+		void rewind() noexcept;
+
+		/// @brief 指定した列を、型付きの配列として読み込みます。
+		/// @param columns 読み込む列
+		/// @param skipRows 先頭から読み飛ばす行数
+		/// @return 読み込んだ列のデータ。columns と同じ順に並びます。
+		/// @remark ファイルをいくつかの区間に分割し、並列に読み込みます。readRow() の読み込み位置には影響しません。
+		/// @remark 列が存在しない要素や、数値として解釈できない要素は、Int64 の場合 0, Double の場合 NaN, String の場合は空の文字列になります。
+		[[nodiscard]]
+		Array<CSVColumnData> readColumns(const Array<CSVColumn>& columns, size_t skipRows = 0) const;
+
+		/// @brief 開いているファイルのパスを返します。
+		/// @return 開いているファイルのパス。ファイルを開いていない場合は空の文字列
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		MemoryMappedFileView m_file;
+
+		// 各バイトの種類（要素の区切り、クオーテーション、エスケープ記号など）
+		std::array<uint8, 256> m_charTypes{};
+
+		// 不正なエスケープシーケンスを含む行で使う、バックスラッシュを通常の文字として扱う m_charTypes
+		std::array<uint8, 256> m_fallbackCharTypes{};
+
+		const char* m_begin = nullptr;
+
+		const char* m_end = nullptr;
+
+		const char* m_current = nullptr;
+
+		std::string m_buffer;
+	};
+}
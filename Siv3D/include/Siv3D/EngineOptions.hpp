@@ -60,6 +60,10 @@ namespace s3d
 			/// @brief WebGPU
 			/// @remark 対応: Web
 			WebGPU = 6,
+
+			/// @brief CPU によるソフトウェアレンダリング (2D 描画のみ)
+			/// @remark 対応: Windows / macOS / Linux / Web
+			Software = 7,
 		};
 
 		/// @brief Direct3D 11 ドライバーの種類 (Windows 版)
@@ -177,6 +177,30 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness() const;
 
+		/// @brief キャッシュテクスチャが使うメモリの上限を設定します。
+		/// @param bytes メモリの上限（バイト）
+		/// @remark デフォルト値は 128 MiB です。
+		/// @remark キャッシュテクスチャはページ単位で確保されます。上限に達すると、現在のフレームで使われていないページのうち、最も長い間使われていないページの文字を破棄して再利用します。
+		/// @return *this
+		const Font& setGlyphCacheMemoryBudget(size_t bytes) const;
+
+		/// @brief キャッシュテクスチャが使うメモリの上限を返します。
+		/// @return キャッシュテクスチャが使うメモリの上限（バイト）
+		[[nodiscard]]
+		size_t getGlyphCacheMemoryBudget() const;
+
+		/// @brief シェーピング結果をキャッシュする文字列の最大数を設定します。
+		/// @param capacity キャッシュする文字列の最大数
+		/// @remark デフォルト値は 4096 です。0 を指定するとキャッシュを使いません。
+		/// @remark 同じ文字列を繰り返し描画する場合、キャッシュされたシェーピング結果が使われます。最大数を超えると、最も長い間使われていない文字列の結果を破棄します。
+		/// @return *this
+		const Font& setShapingCacheCapacity(size_t capacity) const;
+
+		/// @brief シェーピング結果をキャッシュする文字列の最大数を返します。
+		/// @return シェーピング結果をキャッシュする文字列の最大数
+		[[nodiscard]]
+		size_t getShapingCacheCapacity() const;
+
 		/// @brief 指定した文字のグリフを持つかを返します。
 		/// @param ch 文字
 		/// @return グリフを持つ場合 true, それ以外の場合は false
@@ -405,8 +429,22 @@ namespace s3d
 		/// @return 事前生成に成功した場合 true, それ以外の場合は false
 		bool preload(StringView chars) const;
 
+		/// @brief キャッシュされているグリフのテクスチャと配置情報をファイルに保存します。
+		/// @param path ファイルパス
+		/// @remark 保存したファイルを loadGlyphCache() で読み込むと、グリフの生成を省略できます。SDF, MSDF フォントの起動時の preload() の代わりに使えます。
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		bool saveGlyphCache(FilePathView path) const;
+
+		/// @brief saveGlyphCache() で保存したファイルからグリフのキャッシュを読み込みます。
+		/// @param path ファイルパス
+		/// @remark フォントファイル、フェイスインデックス、フォントサイズ、レンダリング方式、スタイル、余白が保存時と一致しない場合は失敗します。
+		/// @remark 読み込みに成功した場合、現在キャッシュされているグリフは置き換えられます。
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		bool loadGlyphCache(FilePathView path) const;
+
 		/// @brief フォントの内部でキャッシュされているテクスチャを返します。
 		/// @return フォントの内部でキャッシュされているテクスチャ
+		/// @remark キャッシュテクスチャが複数のページに分かれている場合は、最初のページを返します。
 		[[nodiscard]]
 		const Texture& getTexture() const;
 
@@ -0,0 +1,143 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include "Common.hpp"
+# include "Duration.hpp"
+
+namespace s3d
+{
+	/// @brief 2D 描画コマンドの種類
+	enum class Renderer2DCommandType : uint8
+	{
+		Null,
+
+		SetBuffers,
+
+		UpdateBuffers,
+
+		Draw,
+
+		DrawNull,
+
+		ColorMul,
+
+		ColorAdd,
+
+		BlendState,
+
+		RasterizerState,
+
+		/// @brief 頂点シェーダ / ピクセルシェーダのサンプラーステートの変更
+		SamplerState,
+
+		ScissorRect,
+
+		Viewport,
+
+		SDFParams,
+
+		InternalPSConstants,
+
+		SetRT,
+
+		SetVS,
+
+		SetPS,
+
+		Transform,
+
+		SetConstantBuffer,
+
+		/// @brief 頂点シェーダ / ピクセルシェーダのテクスチャの変更
+		Texture,
+	};
+
+	/// @brief 1 フレームのエンジンの計測値
+	struct FrameMetrics
+	{
+		/// @brief 2D 描画コマンドの種類の数
+		static constexpr size_t NumRenderer2DCommandTypes = (static_cast<size_t>(Renderer2DCommandType::Texture) + 1);
+
+		/// @brief フレームカウント
+		int32 frameCount = 0;
+
+		/// @brief 更新にかかった時間
+		/// @remark 前のフレームの `System::Update()` が終了してから、描画を開始するまでの時間で、アプリケーションの処理時間を含みます。
+		Duration updateTime{ 0 };
+
+		/// @brief 描画コマンドの実行にかかった時間
+		Duration drawTime{ 0 };
+
+		/// @brief 画面の更新にかかった時間
+		/// @remark 垂直同期の待機時間を含みます。
+		Duration presentTime{ 0 };
+
+		/// @brief 2D 描画のドローコール数
+		uint32 drawCalls = 0;
+
+		/// @brief 2D 描画の三角形の個数
+		uint32 triangleCount = 0;
+
+		/// @brief 2D 描画で頂点バッファに書き込んだデータのサイズ（バイト）
+		uint64 vertexBytes = 0;
+
+		/// @brief 2D 描画でインデックスバッファに書き込んだデータのサイズ（バイト）
+		uint64 indexBytes = 0;
+
+		/// @brief 種類ごとの 2D 描画コマンドの個数
+		std::array<uint32, NumRenderer2DCommandTypes> renderer2DCommands{};
+
+		/// @brief 2D 描画のステート変更の回数
+		uint32 stateChanges = 0;
+
+		/// @brief テクスチャに転送したデータのサイズ（バイト）
+		uint64 textureUploadBytes = 0;
+
+		/// @brief `operator new` と `Allocator` によるメモリ確保の回数
+		/// @remark エンジンを `SIV3D_ALLOCATION_TRACKING` を定義してビルドした場合のみ計測されます。それ以外の場合は常に 0 です。
+		uint32 heapAllocations = 0;
+
+		/// @brief `operator new` と `Allocator` によって確保したメモリのサイズ（バイト）
+		/// @remark エンジンを `SIV3D_ALLOCATION_TRACKING` を定義してビルドした場合のみ計測されます。それ以外の場合は常に 0 です。
+		uint64 heapAllocatedBytes = 0;
+
+		/// @brief `operator delete` と `Allocator` によるメモリ解放の回数
+		/// @remark エンジンを `SIV3D_ALLOCATION_TRACKING` を定義してビルドした場合のみ計測されます。それ以外の場合は常に 0 です。
+		uint32 heapDeallocations = 0;
+
+		/// @brief `operator delete` と `Allocator` によって解放したメモリのサイズ（バイト）
+		/// @remark エンジンを `SIV3D_ALLOCATION_TRACKING` を定義してビルドした場合のみ計測されます。それ以外の場合は常に 0 です。
+		uint64 heapDeallocatedBytes = 0;
+
+		/// @brief `ArenaAllocator` によってフレームアリーナから確保したメモリのサイズ（バイト）
+		uint64 arenaBytes = 0;
+
+		/// @brief フォントのグリフキャッシュに存在せず、新たにレンダリングしたグリフの個数
+		uint32 glyphCacheMisses = 0;
+
+		/// @brief 更新、描画、画面の更新にかかった時間の合計を返します。
+		/// @return 更新、描画、画面の更新にかかった時間の合計
+		[[nodiscard]]
+		Duration frameTime() const noexcept;
+
+		/// @brief 指定した種類の 2D 描画コマンドの個数を返します。
+		/// @param type 2D 描画コマンドの種類
+		/// @return 指定した種類の 2D 描画コマンドの個数
+		[[nodiscard]]
+		uint32 getCommandCount(Renderer2DCommandType type) const noexcept;
+
+		void print() const;
+	};
+}
+
+# include "detail/FrameMetrics.ipp"
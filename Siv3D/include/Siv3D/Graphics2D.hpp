@@ -12,6 +12,9 @@
 # pragma once
 # include "Common.hpp"
 # include "Optional.hpp"
+# include "Array.hpp"
+# include "ColorF.hpp"
+# include "2DShapesFwd.hpp"
 # include "BlendState.hpp"
 # include "RasterizerState.hpp"
 # include "SamplerState.hpp"
@@ -126,6 +129,30 @@ namespace s3d
 		/// @param count 描画する三角形の個数
 		void DrawTriangles(uint32 count);
 
+		/// @brief 複数の長方形をまとめて描画します。
+		/// @param rects 長方形の配列
+		/// @param color 色
+		/// @remark 各長方形の `draw(color)` と同じ結果になりますが、頂点をまとめて作成するため高速です。
+		void DrawRects(const Array<RectF>& rects, const ColorF& color);
+
+		/// @brief 複数の長方形をまとめて描画します。
+		/// @param rects 長方形の配列
+		/// @param colors 各長方形の色。rects と要素数が異なる場合は何も描画しません。
+		/// @remark 各長方形の `draw(colors[i])` と同じ結果になりますが、頂点をまとめて作成するため高速です。
+		void DrawRects(const Array<RectF>& rects, const Array<ColorF>& colors);
+
+		/// @brief 複数の円をまとめて描画します。
+		/// @param circles 円の配列
+		/// @param color 色
+		/// @remark 各円の `draw(color)` と同じ結果になりますが、頂点をまとめて作成するため高速です。
+		void DrawCircles(const Array<Circle>& circles, const ColorF& color);
+
+		/// @brief 複数の円をまとめて描画します。
+		/// @param circles 円の配列
+		/// @param colors 各円の色。circles と要素数が異なる場合は何も描画しません。
+		/// @remark 各円の `draw(colors[i])` と同じ結果になりますが、頂点をまとめて作成するため高速です。
+		void DrawCircles(const Array<Circle>& circles, const Array<ColorF>& colors);
+
 		/// @brief SDF 描画用のパラメータを設定します。
 		/// @param textStyle テキストスタイル
 		void SetSDFParameters(const TextStyle& textStyle);
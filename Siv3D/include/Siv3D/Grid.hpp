@@ -509,6 +509,41 @@ namespace s3d
 		[[nodiscard]]
 		Array<Type> values_at(std::initializer_list<Point> indices) const;
 
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		/// @brief 全ての要素を引数に関数を並列に呼び出します。
+		/// @tparam Fty 呼び出す関数の型
+		/// @param f 呼び出す関数
+		/// @remark 行単位の帯に分割し、エンジンのタスクスケジューラで処理します。
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>* = nullptr>
+		Grid& parallel_each(Fty f);
+
+		/// @brief 全ての要素を引数に関数を並列に呼び出します。
+		/// @tparam Fty 呼び出す関数の型
+		/// @param f 呼び出す関数
+		/// @remark 行単位の帯に分割し、エンジンのタスクスケジューラで処理します。
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		const Grid& parallel_each(Fty f) const;
+
+		/// @brief 全ての要素に関数を並列に適用した結果からなる新しい二次元配列を返します。
+		/// @tparam Fty 適用する関数の型
+		/// @param f 適用する関数
+		/// @return 新しい二次元配列
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		[[nodiscard]]
+		auto parallel_map(Fty f) const;
+
+		/// @brief 全ての要素を、関数を並列に適用した結果で置き換えます。
+		/// @tparam Fty 適用する関数の型
+		/// @param f 適用する関数
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty, Type>>* = nullptr>
+		Grid& parallel_transform(Fty f);
+
+	# endif
+
 		[[nodiscard]]
 		friend bool operator ==(const Grid& lhs, const Grid& rhs)
 		{
@@ -13,6 +13,7 @@
 # include "Common.hpp"
 # include "String.hpp"
 # include "BinaryReader.hpp"
+# include "MappedReader.hpp"
 # include "AudioFormat.hpp"
 # include "Wave.hpp"
 
@@ -18,6 +18,7 @@
 # include "Optional.hpp"
 # include "Grid.hpp"
 # include "BinaryReader.hpp"
+# include "MappedReader.hpp"
 
 namespace s3d
 {
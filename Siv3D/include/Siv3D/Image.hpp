@@ -386,35 +386,38 @@ namespace s3d
 		Blob encodeWebP(Lossless lossless = Lossless::No, double quality = WebPEncoder::DefaultQuality, WebPMethod method = WebPMethod::Default) const;
 
 		/// @brief 画像の色を反転します。
+		/// @param parallel 並列処理を行うか
 		/// @return *this
-		Image& negate();
+		Image& negate(Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image negated() const;
+		Image negated(Parallel parallel = Parallel::No) const;
 
 		/// @brief 画像をグレイスケール画像に変換します。
+		/// @param parallel 並列処理を行うか
 		/// @return *this
-		Image& grayscale();
+		Image& grayscale(Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image grayscaled() const;
+		Image grayscaled(Parallel parallel = Parallel::No) const;
 
 		/// @brief 画像をセピア画像に変換します。
+		/// @param parallel 並列処理を行うか
 		/// @return *this
-		Image& sepia();
+		Image& sepia(Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image sepiaed() const;
+		Image sepiaed(Parallel parallel = Parallel::No) const;
 
-		Image& posterize(int32 level);
+		Image& posterize(int32 level, Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image posterized(int32 level) const;
+		Image posterized(int32 level, Parallel parallel = Parallel::No) const;
 
-		Image& brighten(int32 level);
+		Image& brighten(int32 level, Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image brightened(int32 level) const;
+		Image brightened(int32 level, Parallel parallel = Parallel::No) const;
 
 		/// @brief 画像を左右反転します。
 		/// @return *this
@@ -451,10 +454,10 @@ namespace s3d
 		[[nodiscard]]
 		Image rotated270() const;
 
-		Image& gammaCorrect(double gamma);
+		Image& gammaCorrect(double gamma, Parallel parallel = Parallel::No);
 
 		[[nodiscard]]
-		Image gammaCorrected(double gamma) const;
+		Image gammaCorrected(double gamma, Parallel parallel = Parallel::No) const;
 
 		Image& threshold(uint8 threshold, InvertColor invertColor = InvertColor::No);
 
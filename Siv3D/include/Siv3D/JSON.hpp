@@ -481,6 +481,13 @@ namespace s3d
 		[[nodiscard]]
 		static JSON Parse(StringView str, AllowExceptions allowExceptions = AllowExceptions::No);
 
+		/// @brief UTF-8 の JSON 文字列をパースして JSON オブジェクトを返します。
+		/// @param str UTF-8 文字列
+		/// @param allowExceptions 例外を発生させるか
+		/// @return JSON オブジェクト
+		[[nodiscard]]
+		static JSON ParseUTF8(std::string_view str, AllowExceptions allowExceptions = AllowExceptions::No);
+
 		/// @brief BSON 形式のデータから JSON オブジェクトをデシリアライズします。
 		/// @param bson BSON データ
 		/// @param allowExceptions 例外を発生させるか
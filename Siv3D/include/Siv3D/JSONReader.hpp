@@ -0,0 +1,310 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <string_view>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Optional.hpp"
+# include "Error.hpp"
+# include "Unicode.hpp"
+# include "Parse.hpp"
+# include "JSON.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct JSONIndex;
+	}
+
+	/// @brief JSONReader::read() で、JSON の要素を先頭から順に受け取るイベントハンドラ（SAX）
+	/// @remark 各関数で false を返すと、読み込みを中断します。
+	/// @remark 文字列の引数は、その関数の呼び出し中のみ有効です。
+	class IJSONHandler
+	{
+	public:
+
+		virtual ~IJSONHandler() = default;
+
+		/// @brief null を読み込んだときに呼ばれます。
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onNull() { return true; }
+
+		/// @brief 真偽値を読み込んだときに呼ばれます。
+		/// @param value 値
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onBool([[maybe_unused]] bool value) { return true; }
+
+		/// @brief 負の整数を読み込んだときに呼ばれます。
+		/// @param value 値
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onInt64([[maybe_unused]] int64 value) { return true; }
+
+		/// @brief 0 以上の整数を読み込んだときに呼ばれます。
+		/// @param value 値
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onUint64([[maybe_unused]] uint64 value) { return true; }
+
+		/// @brief 浮動小数点数を読み込んだときに呼ばれます。
+		/// @param value 値
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onDouble([[maybe_unused]] double value) { return true; }
+
+		/// @brief 文字列を読み込んだときに呼ばれます。
+		/// @param value 値
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onString([[maybe_unused]] StringView value) { return true; }
+
+		/// @brief オブジェクトのキーを読み込んだときに呼ばれます。
+		/// @param key キー
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onKey([[maybe_unused]] StringView key) { return true; }
+
+		/// @brief オブジェクトの開始 `{` を読み込んだときに呼ばれます。
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onObjectBegin() { return true; }
+
+		/// @brief オブジェクトの終了 `}` を読み込んだときに呼ばれます。
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onObjectEnd() { return true; }
+
+		/// @brief 配列の開始 `[` を読み込んだときに呼ばれます。
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onArrayBegin() { return true; }
+
+		/// @brief 配列の終了 `]` を読み込んだときに呼ばれます。
+		/// @return 読み込みを続ける場合 true, 中断する場合は false
+		virtual bool onArrayEnd() { return true; }
+
+		/// @brief 構文エラーが見つかったときに呼ばれます。
+		/// @param position エラーが見つかった位置（ファイルの先頭からのバイト数）
+		/// @param message エラーメッセージ
+		virtual void onError([[maybe_unused]] size_t position, [[maybe_unused]] StringView message) {}
+	};
+
+	/// @brief JSONReader が作成した索引を使い、JSON の値を必要になった時点で読み込むビュー
+	/// @remark JSONReader が閉じられるか、破棄されるまで有効です。
+	class JSONValueView
+	{
+	public:
+
+		class Iterator
+		{
+		public:
+
+			SIV3D_NODISCARD_CXX20
+			Iterator() = default;
+
+			[[nodiscard]]
+			JSONValueView operator *() const noexcept;
+
+			Iterator& operator ++() noexcept;
+
+			Iterator operator ++(int) noexcept;
+
+			[[nodiscard]]
+			bool operator ==(const Iterator& other) const noexcept;
+
+			[[nodiscard]]
+			bool operator !=(const Iterator& other) const noexcept;
+
+		private:
+
+			friend class JSONValueView;
+
+			const detail::JSONIndex* m_index = nullptr;
+
+			size_t m_node = 0;
+
+			SIV3D_NODISCARD_CXX20
+			Iterator(const detail::JSONIndex* index, size_t node) noexcept;
+		};
+
+		SIV3D_NODISCARD_CXX20
+		JSONValueView() = default;
+
+		/// @brief 値が存在しない（読み込みに失敗したか、要素が見つからなかった）場合のみ true を返します。
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		[[nodiscard]]
+		bool isNull() const noexcept;
+
+		[[nodiscard]]
+		bool isBool() const noexcept;
+
+		[[nodiscard]]
+		bool isNumber() const noexcept;
+
+		[[nodiscard]]
+		bool isInteger() const noexcept;
+
+		[[nodiscard]]
+		bool isUnsigned() const noexcept;
+
+		[[nodiscard]]
+		bool isFloat() const noexcept;
+
+		[[nodiscard]]
+		bool isString() const noexcept;
+
+		[[nodiscard]]
+		bool isArray() const noexcept;
+
+		[[nodiscard]]
+		bool isObject() const noexcept;
+
+		[[nodiscard]]
+		JSONValueType getType() const noexcept;
+
+		/// @brief 配列またはオブジェクトの要素数を返します。
+		/// @return 要素数。配列またはオブジェクトでない場合は 0
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		/// @brief オブジェクトが指定したキーの要素を持つかを返します。
+		/// @param name キー
+		/// @return 指定したキーの要素を持つ場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool hasElement(StringView name) const;
+
+		/// @brief オブジェクトの要素を返します。
+		/// @param name キー
+		/// @remark 要素を先頭から順に検索します。
+		/// @return 要素。見つからない場合は空のビュー
+		[[nodiscard]]
+		JSONValueView operator [](StringView name) const;
+
+		/// @brief 配列またはオブジェクトの要素を返します。
+		/// @param index インデックス
+		/// @remark 要素を先頭から順にたどるため、すべての要素を読む場合は begin(), end() を使ってください。
+		/// @return 要素。範囲外の場合は空のビュー
+		[[nodiscard]]
+		JSONValueView operator [](size_t index) const;
+
+		/// @brief 配列またはオブジェクトの先頭の要素を指すイテレータを返します。
+		[[nodiscard]]
+		Iterator begin() const noexcept;
+
+		/// @brief 配列またはオブジェクトの終端を指すイテレータを返します。
+		[[nodiscard]]
+		Iterator end() const noexcept;
+
+		/// @brief オブジェクトの要素である場合、そのキーを返します。
+		/// @return キー。オブジェクトの要素でない場合は空の文字列
+		[[nodiscard]]
+		String key() const;
+
+		[[nodiscard]]
+		String getString() const;
+
+		template <class Type>
+		[[nodiscard]]
+		Type get() const;
+
+		template <class Type, class U>
+		[[nodiscard]]
+		Type getOr(U&& defaultValue) const;
+
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt() const;
+
+		/// @brief この値の JSON テキスト（UTF-8）を返します。
+		/// @remark コピーせずに、元のデータを直接参照します。
+		[[nodiscard]]
+		std::string_view raw() const noexcept;
+
+		/// @brief この値以下をパースして JSON オブジェクトを作成します。
+		/// @return JSON オブジェクト
+		[[nodiscard]]
+		JSON toJSON() const;
+
+	private:
+
+		friend class JSONReader;
+
+		const detail::JSONIndex* m_index = nullptr;
+
+		size_t m_node = 0;
+
+		SIV3D_NODISCARD_CXX20
+		JSONValueView(const detail::JSONIndex* index, size_t node) noexcept;
+
+		Optional<String> getOptString() const;
+
+		Optional<int64> getOptInt64() const;
+
+		Optional<double> getOptDouble() const;
+
+		Optional<bool> getOptBool() const;
+	};
+
+	/// @brief 大きな JSON ファイルを、DOM を作らずに読み込むクラス
+	/// @remark read() は、要素を先頭から順にイベントハンドラに渡します（SAX）。
+	/// @remark root() は、最初の呼び出しで構造の索引を作り、値は必要になった時点で読み込みます。
+	/// @remark ファイルはメモリマップして読み込むため、ファイル全体をヒープにコピーしません。
+	/// @remark `JSON::Load()` と同じく、NUL 文字をファイルの終わりとして扱います。
+	class JSONReader
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		JSONReader();
+
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(FilePathView path);
+
+		/// @brief JSON ファイルを開きます。
+		/// @param path ファイルパス
+		/// @return ファイルを開くのに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path);
+
+		/// @brief ファイルを閉じます。
+		/// @remark 作成した JSONValueView は無効になります。
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief JSON を先頭から読み込み、要素をイベントハンドラに渡します。
+		/// @param handler イベントハンドラ
+		/// @return 最後まで読み込めた場合 true, 構文エラーがあるか、ハンドラが読み込みを中断した場合は false
+		bool read(IJSONHandler& handler) const;
+
+		/// @brief ルートの値を返します。
+		/// @remark 最初の呼び出しで、ファイル全体の構文を検証して構造の索引を作成します。
+		/// @return ルートの値。ファイルが開いていないか、構文エラーがある場合は空のビュー
+		[[nodiscard]]
+		JSONValueView root() const;
+
+		/// @brief 開いているファイルのフルパスを返します。
+		/// @return 開いているファイルのフルパス
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		class JSONReaderDetail;
+
+		std::shared_ptr<JSONReaderDetail> pImpl;
+	};
+}
+
+# include "detail/JSONReader.ipp"
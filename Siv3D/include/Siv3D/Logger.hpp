@@ -105,6 +105,17 @@ namespace s3d
 
 			/// @brief ログ出力を有効化します
 			void enable() const;
+
+			/// @brief ログをファイルにも出力します。
+			/// @param path ファイルパス。空の場合はファイルへの出力を終了します。
+			/// @param maxFileSize ファイルの最大サイズ（バイト）。超える場合は、古いファイルを `path.1`, `path.2`, ... に移して新しいファイルに出力します。0 の場合は制限しません。
+			/// @param maxBackupFiles 残す古いファイルの最大数
+			/// @return ファイルを開けた場合 true, それ以外の場合は false
+			bool setOutputFile(FilePathView path, size_t maxFileSize = (4 * 1024 * 1024), size_t maxBackupFiles = 3) const;
+
+			/// @brief それまでに出力したログが書き込まれるまで待ちます。
+			/// @remark ログはバックグラウンドのスレッドでまとめて書き込まれます。
+			void flush() const;
 		};
 	}
 
@@ -0,0 +1,166 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <span>
+# include <type_traits>
+# include "Common.hpp"
+# include "IReader.hpp"
+# include "Byte.hpp"
+# include "StringView.hpp"
+# include "MemoryMappedFileView.hpp"
+# include "BinaryReader.hpp"
+
+namespace s3d
+{
+	/// @brief ファイル全体をメモリマップして読み込む IReader
+	/// @remark 読み込んだデータはファイルのマッピングを直接参照するため、ファイル全体をメモリにコピーしません。
+	/// @remark span() でマップされたデータに直接アクセスできます。
+	class MappedReader : public IReader
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		MappedReader() = default;
+
+		/// @brief ファイルを開きます。
+		/// @param path ファイルパス
+		SIV3D_NODISCARD_CXX20
+		explicit MappedReader(FilePathView path);
+
+		/// @brief ファイルを開いてメモリマップします。
+		/// @param path ファイルパス
+		/// @return ファイルのオープンとメモリマップに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path);
+
+		/// @brief ファイルを閉じます。
+		/// @remark ファイルが開いていない場合は何もしません。
+		void close();
+
+		/// @brief 読み込み位置を変更しないデータ読み込みをサポートしているかを返します。
+		/// @return true
+		[[nodiscard]]
+		bool supportsLookahead() const noexcept override;
+
+		/// @brief ファイルが開いているかを返します。
+		/// @return ファイルが開いている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept override;
+
+		/// @brief ファイルが開いているかを返します。
+		/// @return ファイルが開いている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief ファイルのサイズを返します。
+		/// @return ファイルのサイズ（バイト）
+		[[nodiscard]]
+		int64 size() const override;
+
+		/// @brief 現在の読み込み位置を返します。
+		/// @return 現在の読み込み位置（バイト）
+		[[nodiscard]]
+		int64 getPos() const override;
+
+		/// @brief 読み込み位置を変更します。
+		/// @param pos 新しい読み込み位置（バイト）
+		/// @return 読み込み位置の変更に成功した場合 true, それ以外の場合は false
+		bool setPos(int64 pos) override;
+
+		/// @brief 読み飛ばし、読み込み位置を変更します。
+		/// @param offset 読み飛ばすサイズ（バイト）
+		/// @return 新しい読み込み位置（バイト）
+		int64 skip(int64 offset) override;
+
+		/// @brief ファイルからデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 read(void* dst, int64 size) override;
+
+		/// @brief ファイルからデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param pos 先頭から数えた読み込み開始位置（バイト）
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 read(void* dst, int64 pos, int64 size) override;
+
+		/// @brief ファイルからデータを読み込みます。
+		/// @tparam Type 読み込む値の型
+		/// @param dst 読み込み先
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		bool read(TriviallyCopyable& dst);
+
+		/// @brief 読み込み位置を変更しないでデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 lookahead(void* dst, int64 size) const override;
+
+		/// @brief 読み込み位置を変更しないでデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param pos 先頭から数えた読み込み開始位置（バイト）
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 lookahead(void* dst, int64 pos, int64 size) const override;
+
+		/// @brief 読み込み位置を変更しないでデータを読み込みます。
+		/// @tparam Type 読み込む値の型
+		/// @param dst 読み込み先
+		/// @return 読み込みに成功したら true, それ以外の場合は false
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		bool lookahead(TriviallyCopyable& dst) const;
+
+		/// @brief メモリマップされたファイル全体を返します。
+		/// @remark 返される範囲は、ファイルを閉じるか、この MappedReader が破棄されるまで有効です。
+		/// @return メモリマップされたファイル全体。ファイルが開いていないか、空の場合は空の範囲
+		[[nodiscard]]
+		std::span<const Byte> span() const noexcept;
+
+		/// @brief 現在の読み込み位置からファイルの終端までを返します。
+		/// @remark 読み込み位置は変更しません。
+		/// @return 現在の読み込み位置からファイルの終端までの範囲
+		[[nodiscard]]
+		std::span<const Byte> remaining() const noexcept;
+
+		/// @brief 開いているファイルのフルパスを返します。
+		/// @return 開いているファイルのフルパス
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		MemoryMappedFileView m_file;
+
+		const Byte* m_data = nullptr;
+
+		int64 m_size = 0;
+
+		int64 m_pos = 0;
+
+		bool m_isOpen = false;
+	};
+
+	namespace detail
+	{
+		/// @brief ファイルを開いて、その IReader を f に渡します。
+		/// @param path ファイルパス
+		/// @param f ファイル全体を読み込む関数
+		/// @remark ファイル全体を読み込む用途のため、可能な場合は MappedReader で、それ以外の場合（リソースなど）は BinaryReader で開きます。
+		/// @return f の戻り値。ファイルを開けなかった場合は既定値
+		template <class Fty>
+		[[nodiscard]]
+		std::invoke_result_t<Fty, IReader&> ReadWholeFile(FilePathView path, Fty f);
+	}
+}
+
+# include "detail/MappedReader.ipp"
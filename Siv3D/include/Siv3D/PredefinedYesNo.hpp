@@ -118,4 +118,7 @@ namespace s3d
 
 	/// @brief リガチャ（合字）を使う
 	using Ligature = YesNo<struct Ligature_tag>;
+
+	/// @brief 並列処理を行う
+	using Parallel = YesNo<struct Parallel_tag>;
 }
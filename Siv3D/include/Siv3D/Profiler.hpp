@@ -12,6 +12,8 @@
 # pragma once
 # include "Common.hpp"
 # include "ProfilerStat.hpp"
+# include "FrameMetrics.hpp"
+# include "Array.hpp"
 
 namespace s3d
 {
@@ -29,5 +31,25 @@ namespace s3d
 
 		[[nodiscard]]
 		const ProfilerStat& GetStat();
+
+		/// @brief 直前のフレームの計測値を返します。
+		/// @return 直前のフレームの計測値
+		[[nodiscard]]
+		const FrameMetrics& GetFrameMetrics();
+
+		/// @brief 直近のフレームの計測値の履歴を返します。
+		/// @remark 性能の予算を超えていないかを、テストなどで確認するために使います。
+		/// @return 直近のフレームの計測値の履歴（古い順）
+		[[nodiscard]]
+		Array<FrameMetrics> GetFrameMetricsHistory();
+
+		/// @brief 保持するフレームの計測値の履歴の長さを設定します。
+		/// @param size 保持するフレーム数。デフォルトは 300
+		void SetFrameMetricsHistorySize(size_t size);
+
+		/// @brief 保持するフレームの計測値の履歴の長さを返します。
+		/// @return 保持するフレーム数
+		[[nodiscard]]
+		size_t GetFrameMetricsHistorySize();
 	}
 }
@@ -24,6 +24,12 @@ namespace s3d
 
 		uint32 fontCount = 0;
 
+		uint32 fontTextureUploadSize = 0;
+
+		uint32 fontShapingCacheHits = 0;
+
+		uint32 fontShapingCacheMisses = 0;
+
 		uint32 audioCount = 0;
 
 		uint32 activeVoice = 0;
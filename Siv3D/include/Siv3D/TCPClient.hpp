@@ -13,7 +13,10 @@
 # include <memory>
 # include "Common.hpp"
 # include "Concepts.hpp"
+# include "Array.hpp"
+# include "Blob.hpp"
 # include "TCPError.hpp"
+# include "TCPReceiveView.hpp"
 
 namespace s3d
 {
@@ -50,6 +53,19 @@ namespace s3d
 		[[nodiscard]]
 		size_t available() const;
 
+		/// @brief 受信済みのデータを、コピーせずに参照します。
+		/// @return 受信済みのデータの先頭から、メモリ上で連続している範囲
+		/// @remark 返されるサイズは available() より小さいことがあります。その場合は consume() の後に再び peek() を呼ぶと、続きのデータを参照できます。
+		/// @remark 返されるデータは、consume(), skip(), read() を呼ぶまで有効です。
+		/// @remark 複数のスレッドから受信データを読み込む場合、他のスレッドがデータを取り除くと、返されたデータは無効になります。peek() と consume() は 1 つのスレッドから呼んでください。
+		[[nodiscard]]
+		TCPReceiveView peek();
+
+		/// @brief 受信済みのデータを、先頭から指定したサイズだけ取り除きます。
+		/// @param size 取り除くサイズ（バイト）
+		/// @return 取り除いた場合 true, 受信済みのデータが不足している場合は false
+		bool consume(size_t size);
+
 		bool skip(size_t size);
 
 		bool lookahead(void* dst, size_t size) const;
@@ -67,6 +83,26 @@ namespace s3d
 		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
 		bool send(const TriviallyCopyable& from);
 
+		/// @brief メッセージを送信します。
+		/// @param message メッセージ
+		/// @return 送信を開始した場合 true, それ以外の場合は false
+		/// @remark メッセージの先頭に、サイズを表す 4 バイトのヘッダ（uint32, リトルエンディアン）が付加されます。受信側では receiveMessages() で受け取ります。
+		/// @remark 1 つのメッセージのサイズは最大で (32 MiB - 4) バイトです。
+		bool sendMessage(const Blob& message);
+
+		/// @brief 複数のメッセージをまとめて送信します。
+		/// @param messages メッセージの配列
+		/// @return 送信を開始した場合 true, それ以外の場合は false
+		/// @remark sendMessage() を繰り返し呼ぶ場合と同じデータが送信されますが、送信バッファへの追加が 1 回で済みます。
+		bool sendBatch(const Array<Blob>& messages);
+
+		/// @brief sendMessage() または sendBatch() で送信されたメッセージのうち、受信が完了しているものをすべて取り出します。
+		/// @param messages 取り出したメッセージの追加先。取り出したメッセージは末尾に追加されます。
+		/// @return 取り出したメッセージの個数
+		/// @remark 最大サイズを超えるメッセージのヘッダを受信した場合は接続を切断します。
+		/// @remark read() などによるバイト単位の受信と混在させないでください。
+		size_t receiveMessages(Array<Blob>& messages);
+
 	private:
 
 		class TCPClientDetail;
@@ -0,0 +1,44 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Byte.hpp"
+
+namespace s3d
+{
+	/// @brief TCP の受信バッファ内のデータへの参照
+	/// @remark 受信バッファからデータを取り除くまで有効です。
+	struct TCPReceiveView
+	{
+		/// @brief データの先頭へのポインタ
+		const Byte* data = nullptr;
+
+		/// @brief データのサイズ（バイト）
+		size_t size = 0;
+
+		/// @brief データが空であるかを返します。
+		/// @return データが空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool isEmpty() const noexcept
+		{
+			return (size == 0);
+		}
+
+		/// @brief データが空でないかを返します。
+		/// @return データが空でない場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit constexpr operator bool() const noexcept
+		{
+			return (size != 0);
+		}
+	};
+}
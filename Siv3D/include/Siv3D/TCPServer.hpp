@@ -13,8 +13,11 @@
 # include <memory>
 # include "Common.hpp"
 # include "Array.hpp"
+# include "Blob.hpp"
 # include "Optional.hpp"
 # include "Unspecified.hpp"
+# include "TCPReceiveView.hpp"
+# include "TCPSessionStats.hpp"
 
 namespace s3d
 {
@@ -32,7 +35,12 @@ namespace s3d
 
 		void startAccept(uint16 port);
 
-		void startAcceptMulti(uint16 port);
+		/// @brief 複数のセッションの接続の受け付けを開始します。
+		/// @param port ポート番号
+		/// @param numThreads 通信を処理するスレッドの数
+		/// @remark スレッドは必要に応じて追加され、disconnect() を呼ぶまで減りません。
+		/// @remark 各セッションの通信は、スレッドの数によらず順番に処理されます。
+		void startAcceptMulti(uint16 port, size_t numThreads = 1);
 
 		void cancelAccept();
 
@@ -59,6 +67,21 @@ namespace s3d
 		[[nodiscard]]
 		size_t available(const Optional<TCPSessionID>& id = unspecified);
 
+		/// @brief 受信済みのデータを、コピーせずに参照します。
+		/// @param id セッション ID
+		/// @return 受信済みのデータの先頭から、メモリ上で連続している範囲
+		/// @remark 返されるサイズは available() より小さいことがあります。その場合は consume() の後に再び peek() を呼ぶと、続きのデータを参照できます。
+		/// @remark 返されるデータは、同じセッションで consume(), skip(), read() を呼ぶまで有効です。
+		/// @remark 同じセッションの受信データを複数のスレッドから読み込む場合、他のスレッドがデータを取り除くと、返されたデータは無効になります。peek() と consume() は 1 つのスレッドから呼んでください。
+		[[nodiscard]]
+		TCPReceiveView peek(const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief 受信済みのデータを、先頭から指定したサイズだけ取り除きます。
+		/// @param size 取り除くサイズ（バイト）
+		/// @param id セッション ID
+		/// @return 取り除いた場合 true, 受信済みのデータが不足している場合は false
+		bool consume(size_t size, const Optional<TCPSessionID>& id = unspecified);
+
 		bool skip(size_t size, const Optional<TCPSessionID>& id = unspecified);
 
 		bool lookahead(void* dst, size_t size, const Optional<TCPSessionID>& id = unspecified) const;
@@ -76,6 +99,41 @@ namespace s3d
 		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
 		bool send(const TriviallyCopyable& to, const Optional<TCPSessionID>& id = unspecified);
 
+		/// @brief メッセージを送信します。
+		/// @param message メッセージ
+		/// @param id セッション ID
+		/// @return 送信を開始した場合 true, それ以外の場合は false
+		/// @remark メッセージの先頭に、サイズを表す 4 バイトのヘッダ（uint32, リトルエンディアン）が付加されます。受信側では receiveMessages() で受け取ります。
+		/// @remark 1 つのメッセージのサイズは最大で (32 MiB - 4) バイトです。
+		bool sendMessage(const Blob& message, const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief 複数のメッセージをまとめて送信します。
+		/// @param messages メッセージの配列
+		/// @param id セッション ID
+		/// @return 送信を開始した場合 true, それ以外の場合は false
+		/// @remark sendMessage() を繰り返し呼ぶ場合と同じデータが送信されますが、送信バッファへの追加が 1 回で済みます。
+		bool sendBatch(const Array<Blob>& messages, const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief sendMessage() または sendBatch() で送信されたメッセージのうち、受信が完了しているものをすべて取り出します。
+		/// @param messages 取り出したメッセージの追加先。取り出したメッセージは末尾に追加されます。
+		/// @param id セッション ID
+		/// @return 取り出したメッセージの個数
+		/// @remark 最大サイズを超えるメッセージのヘッダを受信した場合は接続を切断します。
+		/// @remark read() などによるバイト単位の受信と混在させないでください。
+		size_t receiveMessages(Array<Blob>& messages, const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief セッションの統計情報を返します。
+		/// @param id セッション ID
+		/// @return セッションの統計情報。セッションが存在しない場合はすべて 0
+		[[nodiscard]]
+		TCPSessionStats getSessionStats(const Optional<TCPSessionID>& id = unspecified) const;
+
+		/// @brief サーバがこれまでに扱ったすべてのセッションの統計情報の合計を返します。
+		/// @remark 切断されたセッションの送受信量も含みます。receiveQueueSize と sendQueueSize は、現在のセッションのみの合計です。
+		/// @return 統計情報の合計
+		[[nodiscard]]
+		TCPSessionStats getStats() const;
+
 	private:
 
 		class TCPServerDetail;
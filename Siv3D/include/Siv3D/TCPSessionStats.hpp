@@ -0,0 +1,49 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief TCP セッションの統計情報
+	struct TCPSessionStats
+	{
+		/// @brief 受信したデータのサイズの合計（バイト）
+		uint64 bytesReceived = 0;
+
+		/// @brief 送信したデータのサイズの合計（バイト）
+		uint64 bytesSent = 0;
+
+		/// @brief receiveMessages() で取り出したメッセージの個数
+		uint64 messagesReceived = 0;
+
+		/// @brief sendMessage() または sendBatch() で送信したメッセージの個数
+		uint64 messagesSent = 0;
+
+		/// @brief 受信バッファに残っているデータのサイズ（バイト）
+		size_t receiveQueueSize = 0;
+
+		/// @brief 送信中および送信待ちのデータのサイズ（バイト）
+		size_t sendQueueSize = 0;
+
+		constexpr TCPSessionStats& operator +=(const TCPSessionStats& other) noexcept
+		{
+			bytesReceived += other.bytesReceived;
+			bytesSent += other.bytesSent;
+			messagesReceived += other.messagesReceived;
+			messagesSent += other.messagesSent;
+			receiveQueueSize += other.receiveQueueSize;
+			sendQueueSize += other.sendQueueSize;
+			return *this;
+		}
+	};
+}
@@ -0,0 +1,79 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# ifndef SIV3D_NO_CONCURRENT_API
+
+# include <memory>
+# include <functional>
+# include <type_traits>
+# include "Common.hpp"
+# include "Threading.hpp"
+
+namespace s3d
+{
+	/// @brief エンジンのタスクスケジューラで実行されるタスクのグループ | A group of tasks executed by the engine task scheduler
+	class TaskGroup
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		TaskGroup();
+
+		/// @brief デストラクタ
+		/// @remark グループ内のすべてのタスクの完了を待ちます。
+		~TaskGroup();
+
+		TaskGroup(const TaskGroup&) = delete;
+
+		TaskGroup& operator =(const TaskGroup&) = delete;
+
+		/// @brief タスクをグループに追加し、スケジューラに投入します。
+		/// @tparam Fty タスクで実行する関数の型
+		/// @tparam ...Args タスクで実行する関数の引数の型
+		/// @param f タスクで実行する関数
+		/// @param ...args タスクで実行する関数の引数
+		template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
+		void submit(Fty&& f, Args&&... args);
+
+		/// @brief グループ内のすべてのタスクが完了しているかを返します。
+		/// @return すべてのタスクが完了している場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isDone() const;
+
+		/// @brief 完了していないタスクの数を返します。
+		/// @return 完了していないタスクの数
+		[[nodiscard]]
+		size_t num_pending() const;
+
+		/// @brief グループ内のすべてのタスクの完了を待ちます。
+		/// @remark 待機中、現在のスレッドは実行待ちのタスクの処理を手伝います。
+		/// @remark タスクが例外を送出した場合、最初の例外をここで再送出します。
+		void wait();
+
+		/// @brief グループ内のすべてのタスクが完了した後に実行される継続タスクを登録します。
+		/// @param continuation 継続タスク
+		/// @remark すでにすべてのタスクが完了している場合は、直ちにスケジューラに投入されます。
+		void then(std::function<void()> continuation);
+
+	private:
+
+		class TaskGroupDetail;
+
+		std::shared_ptr<TaskGroupDetail> pImpl;
+
+		void submitTask(std::function<void()> task);
+	};
+}
+
+# include "detail/TaskGroup.ipp"
+
+# endif // SIV3D_NO_CONCURRENT_API
@@ -10,6 +10,8 @@
 //-----------------------------------------------
 
 # pragma once
+# include <cstddef>
+# include <functional>
 
 namespace s3d
 {
@@ -19,5 +21,31 @@ namespace s3d
 		/// @return サポートされるスレッド数 | Number of concurrent threads supported
 		[[nodiscard]]
 		size_t GetConcurrency() noexcept;
+
+		/// @brief エンジンのタスクスケジューラが持つワーカースレッドの数を返します。 | Returns the number of worker threads owned by the engine task scheduler.
+		/// @return ワーカースレッドの数。スケジューラが起動していない場合は 0 | Number of worker threads, or 0 if the scheduler is not running
+		[[nodiscard]]
+		size_t GetWorkerCount() noexcept;
+
+		/// @brief 現在のスレッドがタスクスケジューラのワーカースレッドであるかを返します。 | Returns whether the current thread is a worker thread of the task scheduler.
+		/// @return ワーカースレッドである場合 true, それ以外の場合は false | True if the current thread is a worker thread, false otherwise
+		[[nodiscard]]
+		bool IsWorkerThread() noexcept;
+
+		/// @brief タスクをスケジューラに投入します。 | Submits a task to the scheduler.
+		/// @param task タスク | Task
+		/// @remark スケジューラが起動していない場合は新しいスレッドで実行されます。 | If the scheduler is not running, the task runs on a new thread.
+		void Submit(std::function<void()> task);
+
+		/// @brief 実行待ちのタスクを 1 つ取り出して現在のスレッドで実行します。 | Takes one pending task and runs it on the current thread.
+		/// @return タスクを実行した場合 true, 実行待ちのタスクが無かった場合は false | True if a task was run, false if there was no pending task
+		bool RunPendingTask();
+
+		/// @brief [0, count) の範囲を分割し、ワーカースレッドと現在のスレッドで並列に処理します。 | Splits [0, count) into chunks and processes them in parallel on the worker threads and the current thread.
+		/// @param count 要素数 | Number of elements
+		/// @param f 各チャンクの範囲 [first, last) を受け取る関数 | Function that receives the range [first, last) of each chunk
+		/// @param minChunkSize 1 つのチャンクの最小要素数 | Minimum number of elements per chunk
+		/// @remark すべてのチャンクの処理が完了するまで戻りません。 | Does not return until all chunks have been processed.
+		void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& f, size_t minChunkSize = 1);
 	}
 }
@@ -0,0 +1,100 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "StringView.hpp"
+# include "RDTSCClock.hpp"
+
+namespace s3d
+{
+	/// @brief トレースイベントの記録
+	/// @remark スコープ単位の処理区間（ゾーン）をスレッドごとのバッファにロックなしで記録し、Chrome / Perfetto で読み込める JSON 形式で保存します。
+	/// @remark ゾーンやイベントの名前には、記録の保存まで有効な文字列（文字列リテラルなど）を渡す必要があります。
+	namespace TraceRecorder
+	{
+		/// @brief トレースイベントの記録を開始します。
+		/// @remark 以前に記録したイベントは破棄されます。
+		void Start();
+
+		/// @brief トレースイベントの記録を終了します。
+		void Stop();
+
+		/// @brief トレースイベントを記録中であるかを返します。
+		/// @return トレースイベントを記録中である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsRecording() noexcept;
+
+		/// @brief 現在のスレッドに名前を付けます。
+		/// @param name スレッドの名前
+		void SetThreadName(StringView name);
+
+		/// @brief 複数のスレッドにまたがる非同期の処理区間の開始を記録します。
+		/// @param name 処理区間の名前
+		/// @param id 処理区間の ID. 対応する `EndAsync()` と同じ値を渡します。
+		void BeginAsync(StringView name, uint64 id);
+
+		/// @brief 複数のスレッドにまたがる非同期の処理区間の終了を記録します。
+		/// @param name 処理区間の名前
+		/// @param id 処理区間の ID. 対応する `BeginAsync()` と同じ値を渡します。
+		void EndAsync(StringView name, uint64 id);
+
+		/// @brief 記録したトレースイベントの個数を返します。
+		/// @return 記録したトレースイベントの個数
+		[[nodiscard]]
+		size_t GetEventCount();
+
+		/// @brief 記録したトレースイベントを Chrome Trace Event 形式の JSON ファイルに保存します。
+		/// @param path 保存するファイルのパス
+		/// @remark 保存中は、記録を開始・終了しないでください。
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		bool Save(FilePathView path);
+	}
+
+	namespace detail
+	{
+		[[nodiscard]]
+		bool IsTraceRecording() noexcept;
+
+		void RecordTraceZone(StringView name, uint64 begin, uint64 end);
+	}
+
+	/// @brief スコープを抜けるまでの処理区間をトレースイベントとして記録するクラス
+	class ScopedTraceZone
+	{
+	public:
+
+		/// @brief 処理区間の記録を開始します。
+		/// @param name 処理区間の名前
+		explicit ScopedTraceZone(StringView name) noexcept;
+
+		/// @brief 処理区間の記録を終了します。
+		~ScopedTraceZone();
+
+		ScopedTraceZone(const ScopedTraceZone&) = delete;
+
+		ScopedTraceZone& operator =(const ScopedTraceZone&) = delete;
+
+	private:
+
+		StringView m_name;
+
+		uint64 m_begin = 0;
+	};
+}
+
+/// @brief スコープを抜けるまでの処理区間をトレースイベントとして記録します。
+/// @param name 処理区間の名前
+# define SIV3D_TRACE_ZONE(name) const s3d::ScopedTraceZone SIV3D_TRACE_ZONE_COMBINE(siv3d_trace_zone_, __LINE__){ name }
+# define SIV3D_TRACE_ZONE_COMBINE_(X,Y) X##Y
+# define SIV3D_TRACE_ZONE_COMBINE(X,Y) SIV3D_TRACE_ZONE_COMBINE_(X,Y)
+
+# include "detail/TraceRecorder.ipp"
@@ -16,12 +16,24 @@ namespace s3d
 	template <class Type, size_t Alignment>
 	Type* Allocator<Type, Alignment>::allocate(const size_t n)
 	{
+	# if defined(SIV3D_ALLOCATION_TRACKING)
+
+		detail::RecordAllocatorAllocation(sizeof(Type) * n);
+
+	# endif
+
 		return AlignedMalloc<Type, Alignment>(n);
 	}
 
 	template <class Type, size_t Alignment>
-	void Allocator<Type, Alignment>::deallocate(Type* const p, const size_t)
+	void Allocator<Type, Alignment>::deallocate(Type* const p, [[maybe_unused]] const size_t n)
 	{
+	# if defined(SIV3D_ALLOCATION_TRACKING)
+
+		detail::RecordAllocatorDeallocation(sizeof(Type) * n);
+
+	# endif
+
 		AlignedFree(p);
 	}
 
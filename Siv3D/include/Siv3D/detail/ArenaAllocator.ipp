@@ -0,0 +1,38 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Type>
+	Type* ArenaAllocator<Type>::allocate(const size_t n)
+	{
+		if ((std::numeric_limits<size_t>::max() / sizeof(Type)) < n)
+		{
+			throw std::bad_array_new_length{};
+		}
+
+		return static_cast<Type*>(detail::FrameArenaAllocate((sizeof(Type) * n), alignof(Type)));
+	}
+
+	template <class Type>
+	void ArenaAllocator<Type>::deallocate(Type* const p, const size_t n) noexcept
+	{
+		detail::FrameArenaDeallocate(p, (sizeof(Type) * n), alignof(Type));
+	}
+
+	template <class T1, class T2>
+	inline constexpr bool operator ==(const ArenaAllocator<T1>&, const ArenaAllocator<T2>&) noexcept
+	{
+		return true;
+	}
+}
@@ -0,0 +1,25 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline Duration FrameMetrics::frameTime() const noexcept
+	{
+		return (updateTime + drawTime + presentTime);
+	}
+
+	inline uint32 FrameMetrics::getCommandCount(const Renderer2DCommandType type) const noexcept
+	{
+		return renderer2DCommands[static_cast<size_t>(type)];
+	}
+}
@@ -1449,6 +1449,76 @@ namespace s3d
 		return new_array;
 	}
 
+# ifndef SIV3D_NO_CONCURRENT_API
+
+	namespace detail
+	{
+		/// @brief 並列処理で 1 つの帯に含める最小の行数を返します。
+		[[nodiscard]]
+		inline constexpr size_t GridParallelMinRows(const size_t width) noexcept
+		{
+			// 1 つの帯あたり少なくとも 4096 要素程度になるようにする
+			return ((width == 0) ? 1 : Max<size_t>(1, (4096 / width)));
+		}
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>*>
+	inline Grid<Type, Allocator>& Grid<Type, Allocator>::parallel_each(Fty f)
+	{
+		Threading::ParallelFor(m_height, [&](const size_t firstRow, const size_t lastRow)
+		{
+			std::for_each((m_data.begin() + (firstRow * m_width)), (m_data.begin() + (lastRow * m_width)), f);
+		}, detail::GridParallelMinRows(m_width));
+
+		return *this;
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
+	inline const Grid<Type, Allocator>& Grid<Type, Allocator>::parallel_each(Fty f) const
+	{
+		Threading::ParallelFor(m_height, [&](const size_t firstRow, const size_t lastRow)
+		{
+			std::for_each((m_data.begin() + (firstRow * m_width)), (m_data.begin() + (lastRow * m_width)), f);
+		}, detail::GridParallelMinRows(m_width));
+
+		return *this;
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
+	inline auto Grid<Type, Allocator>::parallel_map(Fty f) const
+	{
+		using ResultType = std::remove_cvref_t<decltype(f(m_data[0]))>;
+
+		Array<ResultType> new_grid(m_data.size());
+
+		Threading::ParallelFor(m_height, [&](const size_t firstRow, const size_t lastRow)
+		{
+			std::transform((m_data.begin() + (firstRow * m_width)), (m_data.begin() + (lastRow * m_width)),
+				(new_grid.begin() + (firstRow * m_width)), f);
+		}, detail::GridParallelMinRows(m_width));
+
+		return Grid<ResultType>(m_width, m_height, std::move(new_grid));
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty, Type>>*>
+	inline Grid<Type, Allocator>& Grid<Type, Allocator>::parallel_transform(Fty f)
+	{
+		Threading::ParallelFor(m_height, [&](const size_t firstRow, const size_t lastRow)
+		{
+			const auto first = (m_data.begin() + (firstRow * m_width));
+			const auto last = (m_data.begin() + (lastRow * m_width));
+			std::transform(first, last, first, f);
+		}, detail::GridParallelMinRows(m_width));
+
+		return *this;
+	}
+
+# endif
+
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty>>*>
 	inline Grid<Type, Allocator> Grid<Type, Allocator>::Generate(const size_type w, const size_type h, Fty generator)
@@ -15,13 +15,6 @@ namespace s3d
 {
 	inline Wave IAudioDecoder::decode(const FilePathView path) const
 	{
-		BinaryReader reader{ path };
-
-		if (not reader)
-		{
-			return{};
-		}
-
-		return decode(reader, path);
+		return detail::ReadWholeFile(path, [&](IReader& reader) { return decode(reader, path); });
 	}
 }
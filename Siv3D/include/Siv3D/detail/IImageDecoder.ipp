@@ -27,26 +27,12 @@ namespace s3d
 
 	inline Image IImageDecoder::decode(const FilePathView path) const
 	{
-		BinaryReader reader{ path };
-
-		if (not reader)
-		{
-			return{};
-		}
-
-		return decode(reader, path);
+		return detail::ReadWholeFile(path, [&](IReader& reader) { return decode(reader, path); });
 	}
 
 	inline Grid<uint16> IImageDecoder::decodeGray16(const FilePathView path) const
 	{
-		BinaryReader reader{ path };
-
-		if (not reader)
-		{
-			return{};
-		}
-
-		return decodeGray16(reader, path);
+		return detail::ReadWholeFile(path, [&](IReader& reader) { return decodeGray16(reader, path); });
 	}
 
 	inline Grid<uint16> IImageDecoder::decodeGray16(IReader&, FilePathView) const
@@ -0,0 +1,74 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Type>
+	inline Type JSONValueView::get() const
+	{
+		if (const auto opt = getOpt<Type>())
+		{
+			return opt.value();
+		}
+		else
+		{
+			throw Error{ U"JSONValueView::get(): Invalid JSON type. value: " + Unicode::FromUTF8(raw()) };
+		}
+	}
+
+	template <class Type, class U>
+	inline Type JSONValueView::getOr(U&& defaultValue) const
+	{
+		return getOpt<Type>().value_or(std::forward<U>(defaultValue));
+	}
+
+	template <class Type>
+	inline Optional<Type> JSONValueView::getOpt() const
+	{
+		if constexpr (std::is_same_v<Type, String>)
+		{
+			return getOptString();
+		}
+		else if constexpr (std::is_same_v<Type, bool>)
+		{
+			return getOptBool();
+		}
+		else if constexpr (std::is_integral_v<Type>)
+		{
+			if (const auto opt = getOptInt64())
+			{
+				return static_cast<Type>(*opt);
+			}
+
+			return none;
+		}
+		else if constexpr (std::is_floating_point_v<Type>)
+		{
+			if (const auto opt = getOptDouble())
+			{
+				return static_cast<Type>(*opt);
+			}
+
+			return none;
+		}
+		else
+		{
+			if (const auto opt = getOptString())
+			{
+				return ParseOpt<Type>(*opt);
+			}
+
+			return none;
+		}
+	}
+}
@@ -0,0 +1,48 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	SIV3D_CONCEPT_TRIVIALLY_COPYABLE_
+	inline bool MappedReader::read(TriviallyCopyable& dst)
+	{
+		return read(std::addressof(dst), sizeof(TriviallyCopyable)) == sizeof(TriviallyCopyable);
+	}
+
+	SIV3D_CONCEPT_TRIVIALLY_COPYABLE_
+	inline bool MappedReader::lookahead(TriviallyCopyable& dst) const
+	{
+		return lookahead(std::addressof(dst), sizeof(TriviallyCopyable)) == sizeof(TriviallyCopyable);
+	}
+
+	namespace detail
+	{
+		template <class Fty>
+		inline std::invoke_result_t<Fty, IReader&> ReadWholeFile(const FilePathView path, Fty f)
+		{
+			if (MappedReader mapped{ path })
+			{
+				return f(mapped);
+			}
+
+			BinaryReader reader{ path };
+
+			if (not reader)
+			{
+				return{};
+			}
+
+			return f(reader);
+		}
+	}
+}
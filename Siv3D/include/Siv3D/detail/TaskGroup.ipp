@@ -0,0 +1,34 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>*>
+	inline void TaskGroup::submit(Fty&& f, Args&&... args)
+	{
+		auto task = [f = std::forward<Fty>(f), ...args = std::forward<Args>(args)]() mutable
+		{
+			std::invoke(std::move(f), std::move(args)...);
+		};
+
+		if constexpr (std::is_copy_constructible_v<decltype(task)>)
+		{
+			submitTask(std::move(task));
+		}
+		else
+		{
+			// std::function はコピー可能な関数オブジェクトしか保持できないため
+			submitTask([pTask = std::make_shared<decltype(task)>(std::move(task))]() { (*pTask)(); });
+		}
+	}
+}
@@ -0,0 +1,27 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline ScopedTraceZone::ScopedTraceZone(const StringView name) noexcept
+		: m_name{ name }
+		, m_begin{ detail::IsTraceRecording() ? Platform::Rdtsc() : 0 } {}
+
+	inline ScopedTraceZone::~ScopedTraceZone()
+	{
+		if (m_begin)
+		{
+			detail::RecordTraceZone(m_name, m_begin, Platform::Rdtsc());
+		}
+	}
+}
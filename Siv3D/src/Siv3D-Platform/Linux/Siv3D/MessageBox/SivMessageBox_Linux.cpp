@@ -530,7 +530,7 @@ namespace s3d
 				throw Error{ U"Currentry, System::MessageBox~ cannot be called outside of a main loop in this platform (Linux)" };
 			}
 
-			auto result = Async([=]() {
+			auto result = std::async(std::launch::async, [=]() {
 					return ShowMessageBox_impl(title.narrow().c_str(), text.narrow().c_str(), style, buttons);
 					}).get();
 
@@ -18,7 +18,8 @@ namespace s3d
 {
 	ISiv3DRenderer3D* ISiv3DRenderer3D::Create()
 	{
-		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			|| (g_engineOptions.renderer == EngineOption::Renderer::Software))
 		{
 			return new CRenderer3D_Null;
 		}
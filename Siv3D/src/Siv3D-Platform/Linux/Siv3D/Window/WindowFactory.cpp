@@ -17,7 +17,8 @@ namespace s3d
 {
 	ISiv3DWindow* ISiv3DWindow::Create()
 	{
-		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			|| (g_engineOptions.renderer == EngineOption::Renderer::Software))
 		{
 			return new CWindow_Null;
 		}
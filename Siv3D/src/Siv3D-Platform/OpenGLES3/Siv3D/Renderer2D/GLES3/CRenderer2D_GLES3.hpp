@@ -92,7 +92,19 @@ namespace s3d
 
 		Array<GLES3Vertex2DBatch> m_batches;
 		GLES3Renderer2DCommandManager m_commandManager;
-		BufferCreatorFunc m_bufferCreator;
+
+		// Vertex2DBuilder に渡すバッファ作成関数 (インライン展開のため std::function を使わない)
+		struct BufferCreator
+		{
+			CRenderer2D_GLES3* pRenderer2D = nullptr;
+
+			Vertex2DBufferPointer operator ()(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) const
+			{
+				return pRenderer2D->m_batches[pRenderer2D->m_drawCount % 2].requestBuffer(vertexSize, indexSize, pRenderer2D->m_commandManager);
+			}
+		};
+
+		BufferCreator m_bufferCreator;
 
 		Optional<VertexShader> m_currentCustomVS;
 		Optional<PixelShader> m_currentCustomPS;
@@ -137,10 +149,14 @@ namespace s3d
 
 		void addRect(const FloatRect& rect, const Float4(&colors)[4]) override;
 
+		void addRects(const RectF* rects, const ColorF* colors, size_t count, bool singleColor) override;
+
 		void addRectFrame(const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor) override;
 
 		void addCircle(const Float2& center, float r, const Float4& innerColor, const Float4& outerColor) override;
 
+		void addCircles(const Circle* circles, const ColorF* colors, size_t count, bool singleColor) override;
+
 		void addCircleFrame(const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor) override;
 
 		void addCirclePie(const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor) override;
@@ -18,7 +18,8 @@ namespace s3d
 {
 	ISiv3DMesh* ISiv3DMesh::Create()
 	{
-		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			|| (g_engineOptions.renderer == EngineOption::Renderer::Software))
 		{
 			return new CMesh_Null;
 		}
@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer/Null/CRenderer_Null.hpp>
+# include <Siv3D/Renderer/Software/CRenderer_Software.hpp>
 # include <Siv3D/Renderer/GLES3/CRenderer_GLES3.hpp>
 # include <Siv3D/Renderer/WebGPU/CRenderer_WebGPU.hpp>
 
@@ -22,6 +23,10 @@ namespace s3d
 		{
 			return new CRenderer_Null;
 		}
+		else if (g_engineOptions.renderer == EngineOption::Renderer::Software)
+		{
+			return new CRenderer_Software;
+		}
 		else if (g_engineOptions.renderer == EngineOption::Renderer::WebGPU)
 		{
 			return new CRenderer_WebGPU;
@@ -18,7 +18,8 @@ namespace s3d
 {
 	ISiv3DShader* ISiv3DShader::Create()
 	{
-		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			|| (g_engineOptions.renderer == EngineOption::Renderer::Software))
 		{
 			return new CShader_Null;
 		}
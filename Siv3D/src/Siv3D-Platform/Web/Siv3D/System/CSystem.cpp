@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/Threading/IThreading.hpp>
 # include <Siv3D/Resource/IResource.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
@@ -93,6 +94,7 @@ namespace s3d
 		
 		// SystemLog::Initial();
 		SystemMisc::Init();
+		SIV3D_ENGINE(Threading)->init();
 		
 		SIV3D_ENGINE(Resource)->init();
 		SIV3D_ENGINE(Profiler)->init();
@@ -144,6 +146,7 @@ namespace s3d
 			return false;
 		}
 		
+		SIV3D_ENGINE(Profiler)->beginDraw();
 		SIV3D_ENGINE(Addon)->draw();
 		SIV3D_ENGINE(Print)->draw();
 		SIV3D_ENGINE(Renderer)->flush();
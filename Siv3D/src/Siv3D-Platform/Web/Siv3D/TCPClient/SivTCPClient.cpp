@@ -59,6 +59,16 @@ namespace s3d
 		return pImpl->available();
 	}
 
+	TCPReceiveView TCPClient::peek()
+	{
+		return pImpl->peek();
+	}
+
+	bool TCPClient::consume(const size_t size)
+	{
+		return pImpl->skip(size);
+	}
+
 	bool TCPClient::skip(const size_t size)
 	{
 		return pImpl->skip(size);
@@ -78,4 +88,19 @@ namespace s3d
 	{
 		return pImpl->send(data, size);
 	}
+
+	bool TCPClient::sendMessage(const Blob& message)
+	{
+		return pImpl->sendMessages(&message, 1);
+	}
+
+	bool TCPClient::sendBatch(const Array<Blob>& messages)
+	{
+		return pImpl->sendMessages(messages.data(), messages.size());
+	}
+
+	size_t TCPClient::receiveMessages(Array<Blob>& messages)
+	{
+		return pImpl->receiveMessages(messages);
+	}
 }
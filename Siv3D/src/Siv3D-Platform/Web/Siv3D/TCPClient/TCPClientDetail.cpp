@@ -189,6 +189,16 @@ namespace s3d
 		return m_session->available();
 	}
 
+	TCPReceiveView TCPClient::TCPClientDetail::peek()
+	{
+		if (!m_session)
+		{
+			return{};
+		}
+
+		return m_session->peek();
+	}
+
 	bool TCPClient::TCPClientDetail::skip(const size_t size)
 	{
 		if (!m_session)
@@ -228,4 +238,24 @@ namespace s3d
 
 		return m_session->send(data, size);
 	}
+
+	size_t TCPClient::TCPClientDetail::receiveMessages(Array<Blob>& messages)
+	{
+		if (!m_session)
+		{
+			return 0;
+		}
+
+		return m_session->receiveMessages(messages);
+	}
+
+	bool TCPClient::TCPClientDetail::sendMessages(const Blob* messages, const size_t count)
+	{
+		if (!m_session)
+		{
+			return false;
+		}
+
+		return m_session->sendMessages(messages, count);
+	}
 }
@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Texture/Null/CTexture_Null.hpp>
+# include <Siv3D/Texture/Software/CTexture_Software.hpp>
 # include <Siv3D/Texture/GLES3/CTexture_GLES3.hpp>
 # include <Siv3D/Texture/WebGPU/CTexture_WebGPU.hpp>
 
@@ -22,6 +23,10 @@ namespace s3d
 		{
 			return new CTexture_Null;
 		}
+		else if (g_engineOptions.renderer == EngineOption::Renderer::Software)
+		{
+			return new CTexture_Software;
+		}
 		else if (g_engineOptions.renderer == EngineOption::Renderer::WebGPU)
 		{
 			return new CTexture_WebGPU;
@@ -13,6 +13,7 @@
 # include <Siv3D/Error.hpp>
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
@@ -95,10 +96,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches[m_drawCount % 2].requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreator{ this };
 
 		// シャドウ画像を作成
 		{
@@ -238,6 +236,24 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_WebGPU::addRects(const RectF* rects, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		Vertex2DBuilder::BuildRects(m_bufferCreator, rects, colors, count, singleColor, [&](const Vertex2D::IndexType indexCount)
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		});
+	}
+
 	void CRenderer2D_WebGPU::addRectFrame(const FloatRect& rect, const float thickness, const Float4& innerColor, const Float4& outerColor)
 	{
 		if (const auto indexCount = Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, innerColor, outerColor))
@@ -274,6 +290,26 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_WebGPU::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		const float scale = getMaxScaling();
+
+		Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, colors, count, singleColor, scale, [&](const Vertex2D::IndexType indexCount)
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		});
+	}
+
 	void CRenderer2D_WebGPU::addCircleFrame(const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
 	{
 		if (const auto indexCount = Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
@@ -438,7 +474,7 @@ namespace s3d
 
 	void CRenderer2D_WebGPU::addLineString(const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling()))
+		Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -451,12 +487,12 @@ namespace s3d
 			}
 
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_WebGPU::addLineString(const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling()))
+		Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -469,7 +505,7 @@ namespace s3d
 			}
 
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_WebGPU::addPolygon(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Optional<Float2>& offset, const Float4& color)
@@ -528,7 +564,7 @@ namespace s3d
 
 	void CRenderer2D_WebGPU::addPolygonFrame(const Float2* points, const size_t size, const float thickness, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling()))
+		Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -541,7 +577,7 @@ namespace s3d
 			}
 
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_WebGPU::addNullVertices(const uint32 count)
@@ -930,6 +966,8 @@ namespace s3d
 
 	void CRenderer2D_WebGPU::flush()
 	{
+		SIV3D_TRACE_ZONE(U"Renderer2D::flush");
+
 		auto encoder = *pRenderer->getCommandEncoder();
 		flush(encoder);
 	}
@@ -968,6 +1006,8 @@ namespace s3d
 
 		for (const auto& command : m_commandManager.getCommands())
 		{
+			++m_stat.commandCounts[FromEnum(ToRenderer2DCommandType(command.type))];
+
 			switch (command.type)
 			{
 			case WebGPURenderer2DCommandType::Null:
@@ -984,6 +1024,8 @@ namespace s3d
 			case WebGPURenderer2DCommandType::UpdateBuffers:
 				{
 					batchInfo = batch.updateBuffers(*m_device, command.index);
+					m_stat.vertexBytes += (sizeof(Vertex2D) * batchInfo.vertexCount);
+					m_stat.indexBytes += (sizeof(Vertex2D::IndexType) * batchInfo.indexCount);
 
 					LOG_COMMAND(U"UpdateBuffers[{}] BatchInfo(indexCount = {}, startIndexLocation = {}, baseVertexLocation = {})"_fmt(
 						command.index, batchInfo.indexCount, batchInfo.startIndexLocation, batchInfo.baseVertexLocation));
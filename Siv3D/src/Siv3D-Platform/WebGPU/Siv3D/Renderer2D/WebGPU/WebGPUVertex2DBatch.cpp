@@ -184,6 +184,7 @@ namespace s3d
 			// m_vertexBuffer.Unmap();
 
 			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.vertexCount = vertexSize;
 			m_vertexBufferWritePos += vertexSize;
 		}
 
@@ -11,8 +11,8 @@
 
 # pragma once
 # include <atomic>
-# include <mutex>
 # include <Siv3D/Logger/ILogger.hpp>
+# include <Siv3D/Logger/AsyncLogWriter.hpp>
 
 namespace s3d
 {
@@ -20,10 +20,10 @@ namespace s3d
 	{
 	private:
 
-		std::mutex m_mutex;
-
 		std::atomic<bool> m_enabled{ true };
 
+		AsyncLogWriter m_writer;
+
 	public:
 
 		CLogger();
@@ -33,5 +33,9 @@ namespace s3d
 		void write(LogType type, StringView s) override;
 
 		void setEnabled(bool enabled) override;
+
+		bool setOutputFile(FilePathView path, size_t maxFileSize, size_t maxBackupFiles) override;
+
+		void flush() override;
 	};
 }
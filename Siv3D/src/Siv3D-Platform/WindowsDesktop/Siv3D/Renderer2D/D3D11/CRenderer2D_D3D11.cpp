@@ -13,6 +13,7 @@
 # include <Siv3D/Error.hpp>
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
@@ -104,10 +105,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreator{ this };
 
 		// シャドウ画像を作成
 		{
@@ -242,6 +240,24 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_D3D11::addRects(const RectF* rects, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		Vertex2DBuilder::BuildRects(m_bufferCreator, rects, colors, count, singleColor, [&](const Vertex2D::IndexType indexCount)
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		});
+	}
+
 	void CRenderer2D_D3D11::addRectFrame(const FloatRect& rect, const float thickness, const Float4& innerColor, const Float4& outerColor)
 	{
 		if (const auto indexCount = Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, innerColor, outerColor))
@@ -278,6 +294,26 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_D3D11::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		const float scale = getMaxScaling();
+
+		Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, colors, count, singleColor, scale, [&](const Vertex2D::IndexType indexCount)
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		});
+	}
+
 	void CRenderer2D_D3D11::addCircleFrame(const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
 	{
 		if (const auto indexCount = Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
@@ -442,7 +478,7 @@ namespace s3d
 
 	void CRenderer2D_D3D11::addLineString(const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling()))
+		Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -455,12 +491,12 @@ namespace s3d
 			}
 
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_D3D11::addLineString(const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling()))
+		Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -473,7 +509,7 @@ namespace s3d
 			}
 
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_D3D11::addPolygon(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Optional<Float2>& offset, const Float4& color)
@@ -532,7 +568,7 @@ namespace s3d
 
 	void CRenderer2D_D3D11::addPolygonFrame(const Float2* points, const size_t size, const float thickness, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling()))
+		Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -545,7 +581,7 @@ namespace s3d
 			}
 
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_D3D11::addNullVertices(const uint32 count)
@@ -935,6 +971,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::flush()
 	{
+		SIV3D_TRACE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_batches.reset();
@@ -970,6 +1008,8 @@ namespace s3d
 
 		for (const auto& command : m_commandManager.getCommands())
 		{
+			++m_stat.commandCounts[FromEnum(ToRenderer2DCommandType(command.type))];
+
 			switch (command.type)
 			{
 			case D3D11Renderer2DCommandType::Null:
@@ -987,6 +1027,8 @@ namespace s3d
 			case D3D11Renderer2DCommandType::UpdateBuffers:
 				{
 					batchInfo = m_batches.updateBuffers(command.index);
+					m_stat.vertexBytes += (sizeof(Vertex2D) * batchInfo.vertexCount);
+					m_stat.indexBytes += (sizeof(Vertex2D::IndexType) * batchInfo.indexCount);
 					
 					LOG_COMMAND(U"UpdateBuffers[{}] BatchInfo(indexCount = {}, startIndexLocation = {}, baseVertexLocation = {})"_fmt(
 						command.index, batchInfo.indexCount, batchInfo.startIndexLocation, batchInfo.baseVertexLocation));
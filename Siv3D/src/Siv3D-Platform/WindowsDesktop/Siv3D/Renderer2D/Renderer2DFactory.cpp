@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer2D/Null/CRenderer2D_Null.hpp>
+# include <Siv3D/Renderer2D/Software/CRenderer2D_Software.hpp>
 # include <Siv3D/Renderer2D/GL4/CRenderer2D_GL4.hpp>
 # include <Siv3D/Renderer2D/D3D11/CRenderer2D_D3D11.hpp>
 
@@ -22,6 +23,10 @@ namespace s3d
 		{
 			return new CRenderer2D_Null;
 		}
+		else if (g_engineOptions.renderer == EngineOption::Renderer::Software)
+		{
+			return new CRenderer2D_Software;
+		}
 		else if ((g_engineOptions.renderer == EngineOption::Renderer::PlatformDefault)
 			|| (g_engineOptions.renderer == EngineOption::Renderer::Direct3D11))
 		{
@@ -90,14 +90,7 @@ namespace s3d
 		{
 			std::wstring result(detail::UTF16_Length(s), L'0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			wchar_t* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF16_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF16_Encode(static_cast<char16*>(static_cast<void*>(&result[0])), s);
 
 			return result;
 		}
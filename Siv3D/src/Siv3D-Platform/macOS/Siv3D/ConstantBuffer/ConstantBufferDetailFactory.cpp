@@ -18,7 +18,8 @@ namespace s3d
 {
 	IConstantBufferDetail* IConstantBufferDetail::Create(const size_t size)
 	{
-		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			|| (g_engineOptions.renderer == EngineOption::Renderer::Software))
 		{
 			return new ConstantBufferDetail_Null(size);
 		}
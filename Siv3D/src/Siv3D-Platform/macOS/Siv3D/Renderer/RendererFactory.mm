@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer/Null/CRenderer_Null.hpp>
+# include <Siv3D/Renderer/Software/CRenderer_Software.hpp>
 # include <Siv3D/Renderer/GL4/CRenderer_GL4.hpp>
 # include <Siv3D/Renderer/Metal/CRenderer_Metal.hpp>
 
@@ -18,7 +19,11 @@ namespace s3d
 {
 	ISiv3DRenderer* ISiv3DRenderer::Create()
 	{
-		if ((g_engineOptions.renderer == EngineOption::Renderer::OpenGL)
+		if (g_engineOptions.renderer == EngineOption::Renderer::Software)
+		{
+			return new CRenderer_Software;
+		}
+		else if ((g_engineOptions.renderer == EngineOption::Renderer::OpenGL)
 			|| (g_engineOptions.renderer == EngineOption::Renderer::PlatformDefault))
 		{
 			return new CRenderer_GL4;
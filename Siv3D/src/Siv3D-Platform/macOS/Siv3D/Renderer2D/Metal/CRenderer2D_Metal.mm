@@ -110,10 +110,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreator{ this };
 
 		// シャドウ画像を作成
 		{
@@ -248,6 +245,24 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_Metal::addRects(const RectF* rects, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		Vertex2DBuilder::BuildRects(m_bufferCreator, rects, colors, count, singleColor, [&](const Vertex2D::IndexType indexCount)
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		});
+	}
+
 	void CRenderer2D_Metal::addRectFrame(const FloatRect& rect, const float thickness, const Float4& innerColor, const Float4& outerColor)
 	{
 		if (const auto indexCount = Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, innerColor, outerColor))
@@ -284,6 +299,26 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_Metal::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		const float scale = getMaxScaling();
+
+		Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, colors, count, singleColor, scale, [&](const Vertex2D::IndexType indexCount)
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		});
+	}
+
 	void CRenderer2D_Metal::addCircleFrame(const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
 	{
 		if (const auto indexCount = Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
@@ -448,7 +483,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addLineString(const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling()))
+		Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -461,12 +496,12 @@ namespace s3d
 			}
 			
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_Metal::addLineString(const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling()))
+		Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -479,7 +514,7 @@ namespace s3d
 			}
 			
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_Metal::addPolygon(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Optional<Float2>& offset, const Float4& color)
@@ -538,7 +573,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addPolygonFrame(const Float2* points, const size_t size, const float thickness, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling()))
+		Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling(), [&](const Vertex2D::IndexType indexCount)
 		{
 			if (not m_currentCustomVS)
 			{
@@ -551,7 +586,7 @@ namespace s3d
 			}
 			
 			m_commandManager.pushDraw(indexCount);
-		}
+		});
 	}
 
 	void CRenderer2D_Metal::addNullVertices(const uint32 count)
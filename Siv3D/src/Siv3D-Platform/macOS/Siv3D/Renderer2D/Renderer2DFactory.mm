@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer2D/Null/CRenderer2D_Null.hpp>
+# include <Siv3D/Renderer2D/Software/CRenderer2D_Software.hpp>
 # include <Siv3D/Renderer2D/GL4/CRenderer2D_GL4.hpp>
 # include <Siv3D/Renderer2D/Metal/CRenderer2D_Metal.hpp>
 
@@ -18,7 +19,11 @@ namespace s3d
 {
 	ISiv3DRenderer2D* ISiv3DRenderer2D::Create()
 	{
-		if ((g_engineOptions.renderer == EngineOption::Renderer::OpenGL)
+		if (g_engineOptions.renderer == EngineOption::Renderer::Software)
+		{
+			return new CRenderer2D_Software;
+		}
+		else if ((g_engineOptions.renderer == EngineOption::Renderer::OpenGL)
 			|| (g_engineOptions.renderer == EngineOption::Renderer::PlatformDefault))
 		{
 			return new CRenderer2D_GL4;
@@ -113,16 +113,20 @@ namespace s3d
 
 	void BinaryWriter::BinaryWriterDetail::flush()
 	{
-		if (m_buffer.currentWritePos == 0)
+		if (not m_info.isOpen) SIV3D_UNLIKELY
 		{
 			return;
 		}
 
-		std::fwrite(m_buffer.data.get(), 1, m_buffer.currentWritePos, m_file.file);
+		if (m_buffer.currentWritePos != 0)
+		{
+			std::fwrite(m_buffer.data.get(), 1, m_buffer.currentWritePos, m_file.file);
 
-		std::fflush(m_file.file);
+			m_buffer.currentWritePos = 0;
+		}
 
-		m_buffer.currentWritePos = 0;
+		// バッファを経由せずに fwrite() したデータも書き出す
+		std::fflush(m_file.file);
 	}
 
 	void BinaryWriter::BinaryWriterDetail::clear()
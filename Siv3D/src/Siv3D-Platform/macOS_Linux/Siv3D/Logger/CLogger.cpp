@@ -9,29 +9,21 @@
 //
 //-----------------------------------------------
 
-# include <array>
+# include <iostream>
 # include <Siv3D/String.hpp>
-# include <Siv3D/FormatLiteral.hpp>
-# include <Siv3D/Time.hpp>
 # include "CLogger.hpp"
 
 namespace s3d
 {
-	namespace detail
-	{
-		constexpr std::array<StringView, 7> LogTypeNames =
-		{
-			U"[error]   "_sv,
-			U"[fail]    "_sv,
-			U"[warning] "_sv,
-			U""_sv,
-			U"[info]    "_sv,
-			U"[trace]   "_sv,
-			U"[verbose] "_sv,
-		};
-	}
-
 	CLogger::CLogger()
+		: m_writer{ [](const String&, const std::string& utf8)
+			{
+			# if SIV3D_PLATFORM(WEB)
+				std::cout << utf8 << std::flush;
+			# else
+				std::clog << utf8 << std::flush;
+			# endif
+			} }
 	{
 
 	}
@@ -48,23 +40,21 @@ namespace s3d
 			return;
 		}
 
-		const int64 timeStamp = Time::GetMillisec();
-		const StringView logTypeName = detail::LogTypeNames[FromEnum(type)];
-		const String text = U"{}: {}"_fmt(timeStamp, logTypeName) + s;
-		const std::string output = text.narrow();
-
-		std::lock_guard lock{ m_mutex };
-		{
-		# if SIV3D_PLATFORM(WEB)
-			std::cout << output << std::endl;
-		# else
-			std::clog << output << std::endl;
-		# endif
-		}
+		m_writer.push(type, s);
 	}
 
 	void CLogger::setEnabled(const bool enabled)
 	{
 		m_enabled = enabled;
-	}	
+	}
+
+	bool CLogger::setOutputFile(const FilePathView path, const size_t maxFileSize, const size_t maxBackupFiles)
+	{
+		return m_writer.setOutputFile(path, maxFileSize, maxBackupFiles);
+	}
+
+	void CLogger::flush()
+	{
+		m_writer.flush();
+	}
 }
@@ -0,0 +1,32 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/AllocationTracker.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 指定した分類のメモリ確保を統計に加算します。
+		/// @param tag メモリ確保の分類
+		/// @param size 確保したメモリのサイズ（バイト）
+		/// @remark メモリ確保の計測が無効なビルドでは何もしません。
+		void TrackAllocation(AllocationTag tag, size_t size) noexcept;
+
+		/// @brief 指定した分類のメモリ解放を統計に反映します。
+		/// @param tag メモリ確保の分類
+		/// @param size 解放したメモリのサイズ（バイト）
+		/// @remark メモリ確保の計測が無効なビルドでは何もしません。
+		void TrackDeallocation(AllocationTag tag, size_t size) noexcept;
+	}
+}
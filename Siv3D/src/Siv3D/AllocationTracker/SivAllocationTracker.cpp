@@ -0,0 +1,597 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <atomic>
+# include <mutex>
+# include <new>
+# include <cstdlib>
+# include <unordered_map>
+# include <Siv3D/AllocationTracker.hpp>
+# include <Siv3D/Byte.hpp>
+# include <Siv3D/Logger.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/FormatInt.hpp>
+# include <Siv3D/Demangle.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Allocator/AllocatorStat.hpp>
+# include "AllocationTrackerDetail.hpp"
+
+# if SIV3D_PLATFORM(WINDOWS)
+#	include <intrin.h>
+#	define SIV3D_ALLOCATION_CALLER() _ReturnAddress()
+# elif SIV3D_PLATFORM(WEB)
+#	define SIV3D_ALLOCATION_CALLER() nullptr
+# else
+#	include <dlfcn.h>
+#	define SIV3D_ALLOCATION_CALLER() __builtin_return_address(0)
+# endif
+
+namespace s3d
+{
+	namespace detail
+	{
+		// エンジンの初期化前や終了後の `operator new` からも使われるため、すべて定数初期化できる型にする
+		struct AllocationCounter
+		{
+			std::atomic<size_t> currentBytes{ 0 };
+
+			std::atomic<size_t> peakBytes{ 0 };
+
+			std::atomic<size_t> currentCount{ 0 };
+
+			std::atomic<uint64> totalCount{ 0 };
+
+			std::atomic<uint64> totalBytes{ 0 };
+		};
+
+		// 最後の要素はすべての分類の合計
+		static AllocationCounter g_allocationCounters[AllocationTracker::NumTags + 1];
+
+		static thread_local AllocationTag t_currentTag = AllocationTag::Untagged;
+
+		static constexpr StringView AllocationTagNames[AllocationTracker::NumTags] =
+		{
+			U"Untagged",
+			U"Array",
+			U"Image",
+			U"Wave",
+			U"GlyphCache",
+			U"AssetHandleManager",
+		};
+
+		[[nodiscard]]
+		static AllocationCounter& GetAllocationCounter(const AllocationTag tag) noexcept
+		{
+			return g_allocationCounters[Min<size_t>(FromEnum(tag), (AllocationTracker::NumTags - 1))];
+		}
+
+		[[nodiscard]]
+		static AllocationCounter& GetTotalAllocationCounter() noexcept
+		{
+			return g_allocationCounters[AllocationTracker::NumTags];
+		}
+
+		[[nodiscard]]
+		static AllocationStat ToAllocationStat(const AllocationCounter& counter) noexcept
+		{
+			AllocationStat stat;
+			stat.currentBytes	= counter.currentBytes.load(std::memory_order_relaxed);
+			stat.peakBytes		= counter.peakBytes.load(std::memory_order_relaxed);
+			stat.currentCount	= counter.currentCount.load(std::memory_order_relaxed);
+			stat.totalCount		= counter.totalCount.load(std::memory_order_relaxed);
+			stat.totalBytes		= counter.totalBytes.load(std::memory_order_relaxed);
+			return stat;
+		}
+
+	# if defined(SIV3D_ALLOCATION_TRACKING)
+
+		static void AddAllocation(AllocationCounter& counter, const size_t size) noexcept
+		{
+			const size_t currentBytes = (counter.currentBytes.fetch_add(size, std::memory_order_relaxed) + size);
+			counter.currentCount.fetch_add(1, std::memory_order_relaxed);
+			counter.totalCount.fetch_add(1, std::memory_order_relaxed);
+			counter.totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+			size_t peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+
+			while ((peakBytes < currentBytes)
+				&& (not counter.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))) {}
+		}
+
+		static void SubtractAllocation(AllocationCounter& counter, const size_t size) noexcept
+		{
+			counter.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+			counter.currentCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void TrackAllocation(const AllocationTag tag, const size_t size) noexcept
+		{
+			AddAllocation(GetAllocationCounter(tag), size);
+			AddAllocation(GetTotalAllocationCounter(), size);
+		}
+
+		void TrackDeallocation(const AllocationTag tag, const size_t size) noexcept
+		{
+			SubtractAllocation(GetAllocationCounter(tag), size);
+			SubtractAllocation(GetTotalAllocationCounter(), size);
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	メモリを確保したコード上の位置の記録
+		//
+		////////////////////////////////////////////////////////////////
+
+		// 記録用のテーブル自身のメモリ確保は、`operator new` を通さない
+		template <class Type>
+		struct MallocAllocator
+		{
+			using value_type = Type;
+
+			MallocAllocator() = default;
+
+			template <class Other>
+			constexpr MallocAllocator(const MallocAllocator<Other>&) noexcept {}
+
+			[[nodiscard]]
+			Type* allocate(const size_t n)
+			{
+				if (void* p = std::malloc(sizeof(Type) * n))
+				{
+					return static_cast<Type*>(p);
+				}
+
+				throw std::bad_alloc{};
+			}
+
+			void deallocate(Type* p, size_t) noexcept
+			{
+				std::free(p);
+			}
+
+			template <class Other>
+			[[nodiscard]]
+			constexpr bool operator ==(const MallocAllocator<Other>&) const noexcept
+			{
+				return true;
+			}
+		};
+
+		struct SiteCounter
+		{
+			AllocationTag tag = AllocationTag::Untagged;
+
+			size_t currentBytes = 0;
+
+			size_t currentCount = 0;
+
+			uint64 totalCount = 0;
+		};
+
+		using SiteTable = std::unordered_map<const void*, SiteCounter, std::hash<const void*>, std::equal_to<const void*>,
+			MallocAllocator<std::pair<const void* const, SiteCounter>>>;
+
+		static std::atomic<bool> g_siteTrackingEnabled = false;
+
+		static std::mutex g_siteMutex;
+
+		// 記録中のスレッドで確保したメモリは記録しない（再入によるデッドロックを防ぐ）
+		static thread_local bool t_inSiteTable = false;
+
+		class SiteTableLock : Uncopyable
+		{
+		public:
+
+			SiteTableLock()
+				: m_lock{ g_siteMutex }
+			{
+				t_inSiteTable = true;
+			}
+
+			~SiteTableLock()
+			{
+				t_inSiteTable = false;
+			}
+
+		private:
+
+			std::lock_guard<std::mutex> m_lock;
+		};
+
+		// プログラムの終了後にも `operator delete` から使われるため、破棄しない
+		[[nodiscard]]
+		static SiteTable& GetSiteTable()
+		{
+			static SiteTable* table = new (std::malloc(sizeof(SiteTable))) SiteTable{};
+			return *table;
+		}
+
+		[[nodiscard]]
+		static const void* AddSite(const void* site, const AllocationTag tag, const size_t size) noexcept
+		{
+			if ((site == nullptr)
+				|| t_inSiteTable
+				|| (not g_siteTrackingEnabled.load(std::memory_order_relaxed)))
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				const SiteTableLock lock;
+
+				SiteCounter& counter = GetSiteTable()[site];
+				counter.tag = tag;
+				counter.currentBytes += size;
+				++counter.currentCount;
+				++counter.totalCount;
+			}
+			catch (...)
+			{
+				return nullptr;
+			}
+
+			return site;
+		}
+
+		static void RemoveSite(const void* site, const size_t size) noexcept
+		{
+			if ((site == nullptr) || t_inSiteTable)
+			{
+				return;
+			}
+
+			const SiteTableLock lock;
+
+			SiteTable& table = GetSiteTable();
+
+			if (auto it = table.find(site); it != table.end())
+			{
+				it->second.currentBytes -= size;
+				--it->second.currentCount;
+			}
+		}
+
+		[[nodiscard]]
+		static String GetSiteSymbol([[maybe_unused]] const void* site)
+		{
+		# if SIV3D_PLATFORM(MACOS) || SIV3D_PLATFORM(LINUX)
+
+			::Dl_info info;
+
+			if (::dladdr(site, &info))
+			{
+				if (info.dli_sname && info.dli_saddr)
+				{
+					// C の関数名など、デマングルできない名前はそのまま使う
+					String name = Demangle(info.dli_sname);
+
+					if (not name)
+					{
+						name = Unicode::Widen(info.dli_sname);
+					}
+
+					return U"{}+0x{}"_fmt(name, ToHex(static_cast<size_t>(static_cast<const Byte*>(site) - static_cast<const Byte*>(info.dli_saddr))));
+				}
+				else if (info.dli_fname && info.dli_fbase)
+				{
+					return U"{}+0x{}"_fmt(Unicode::Widen(info.dli_fname), ToHex(static_cast<size_t>(static_cast<const Byte*>(site) - static_cast<const Byte*>(info.dli_fbase))));
+				}
+			}
+
+		# endif
+
+			return{};
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	operator new / operator delete
+		//
+		////////////////////////////////////////////////////////////////
+
+		// 確保したメモリの前に置き、解放時にサイズと分類を復元する
+		struct AllocationHeader
+		{
+			// 下位 56 ビットがサイズ、上位 8 ビットが分類
+			uint64 sizeAndTag;
+
+			const void* site;
+		};
+
+		static constexpr size_t DefaultNewAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+		static constexpr size_t AllocationHeaderSize = (((sizeof(AllocationHeader) + (DefaultNewAlignment - 1)) / DefaultNewAlignment) * DefaultNewAlignment);
+
+		[[nodiscard]]
+		static void* TrackedMalloc(const size_t size, const void* site) noexcept
+		{
+			if ((SIZE_MAX - AllocationHeaderSize) < size)
+			{
+				return nullptr;
+			}
+
+			void* block = std::malloc(AllocationHeaderSize + size);
+
+			if (block == nullptr)
+			{
+				return nullptr;
+			}
+
+			const AllocationTag tag = t_currentTag;
+
+			::new (block) AllocationHeader{ (static_cast<uint64>(size) | (static_cast<uint64>(FromEnum(tag)) << 56)), AddSite(site, tag, size) };
+
+			CountAllocation(size);
+			TrackAllocation(tag, size);
+
+			return (static_cast<Byte*>(block) + AllocationHeaderSize);
+		}
+
+		[[nodiscard]]
+		static void* TrackedNew(const size_t size, const void* site)
+		{
+			for (;;)
+			{
+				if (void* p = TrackedMalloc(size, site))
+				{
+					return p;
+				}
+
+				if (const std::new_handler handler = std::get_new_handler())
+				{
+					handler();
+				}
+				else
+				{
+					throw std::bad_alloc{};
+				}
+			}
+		}
+
+		static void TrackedFree(void* const p) noexcept
+		{
+			if (p == nullptr)
+			{
+				return;
+			}
+
+			void* block = (static_cast<Byte*>(p) - AllocationHeaderSize);
+			const AllocationHeader header = *static_cast<const AllocationHeader*>(block);
+			const size_t size = static_cast<size_t>(header.sizeAndTag & 0x00FF'FFFF'FFFF'FFFFull);
+			const AllocationTag tag = ToEnum<AllocationTag>(static_cast<uint8>(header.sizeAndTag >> 56));
+
+			RemoveSite(header.site, size);
+			CountDeallocation(size);
+			TrackDeallocation(tag, size);
+
+			std::free(block);
+		}
+
+	# else
+
+		void TrackAllocation(AllocationTag, size_t) noexcept {}
+
+		void TrackDeallocation(AllocationTag, size_t) noexcept {}
+
+	# endif
+	}
+
+	namespace AllocationTracker
+	{
+		bool IsAvailable() noexcept
+		{
+		# if defined(SIV3D_ALLOCATION_TRACKING)
+
+			return true;
+
+		# else
+
+			return false;
+
+		# endif
+		}
+
+		AllocationStat GetStat(const AllocationTag tag) noexcept
+		{
+			return detail::ToAllocationStat(detail::GetAllocationCounter(tag));
+		}
+
+		AllocationStat GetTotalStat() noexcept
+		{
+			return detail::ToAllocationStat(detail::GetTotalAllocationCounter());
+		}
+
+		void ResetPeak() noexcept
+		{
+			for (auto& counter : detail::g_allocationCounters)
+			{
+				counter.peakBytes.store(counter.currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		void EnableSiteTracking([[maybe_unused]] const bool enabled) noexcept
+		{
+		# if defined(SIV3D_ALLOCATION_TRACKING) && !SIV3D_PLATFORM(WEB)
+
+			detail::g_siteTrackingEnabled.store(enabled, std::memory_order_relaxed);
+
+		# endif
+		}
+
+		bool IsSiteTrackingEnabled() noexcept
+		{
+		# if defined(SIV3D_ALLOCATION_TRACKING)
+
+			return detail::g_siteTrackingEnabled.load(std::memory_order_relaxed);
+
+		# else
+
+			return false;
+
+		# endif
+		}
+
+		Array<AllocationSite> GetTopSites([[maybe_unused]] const size_t count)
+		{
+		# if defined(SIV3D_ALLOCATION_TRACKING)
+
+			Array<AllocationSite> sites;
+			{
+				const detail::SiteTableLock lock;
+
+				for (const auto& [address, counter] : detail::GetSiteTable())
+				{
+					if (counter.currentCount == 0)
+					{
+						continue;
+					}
+
+					AllocationSite site;
+					site.address		= address;
+					site.tag			= counter.tag;
+					site.currentBytes	= counter.currentBytes;
+					site.currentCount	= counter.currentCount;
+					site.totalCount		= counter.totalCount;
+					sites << site;
+				}
+			}
+
+			const size_t n = Min(count, sites.size());
+
+			std::partial_sort(sites.begin(), (sites.begin() + n), sites.end(),
+				[](const AllocationSite& a, const AllocationSite& b) { return (a.currentBytes > b.currentBytes); });
+
+			sites.resize(n);
+
+			for (auto& site : sites)
+			{
+				site.symbol = detail::GetSiteSymbol(site.address);
+			}
+
+			return sites;
+
+		# else
+
+			return{};
+
+		# endif
+		}
+
+		void DumpTopSites(const size_t count)
+		{
+			if (not IsAvailable())
+			{
+				Logger << U"[AllocationTracker] Not available. Build the engine with SIV3D_ALLOCATION_TRACKING defined";
+				return;
+			}
+
+			for (size_t i = 0; i < NumTags; ++i)
+			{
+				const AllocationStat stat = GetStat(ToEnum<AllocationTag>(static_cast<uint8>(i)));
+
+				Logger << U"[AllocationTracker] {}: {} bytes in {} blocks (peak {} bytes, {} allocations in total)"_fmt(
+					detail::AllocationTagNames[i], stat.currentBytes, stat.currentCount, stat.peakBytes, stat.totalCount);
+			}
+
+			if (not IsSiteTrackingEnabled())
+			{
+				Logger << U"[AllocationTracker] Call AllocationTracker::EnableSiteTracking(true) to record allocation sites";
+				return;
+			}
+
+			const Array<AllocationSite> sites = GetTopSites(count);
+
+			for (size_t i = 0; i < sites.size(); ++i)
+			{
+				const auto& site = sites[i];
+
+				Logger << U"[AllocationTracker] #{} {} bytes in {} blocks ({} allocations in total) [{}] 0x{} {}"_fmt(
+					(i + 1), site.currentBytes, site.currentCount, site.totalCount,
+					detail::AllocationTagNames[FromEnum(site.tag)], ToHex(reinterpret_cast<uintptr_t>(site.address)), site.symbol);
+			}
+		}
+	}
+
+	ScopedAllocationTag::ScopedAllocationTag(const AllocationTag tag) noexcept
+		: m_previousTag{ detail::t_currentTag }
+	{
+		detail::t_currentTag = tag;
+	}
+
+	ScopedAllocationTag::~ScopedAllocationTag()
+	{
+		detail::t_currentTag = m_previousTag;
+	}
+}
+
+# if defined(SIV3D_ALLOCATION_TRACKING)
+
+////////////////////////////////////////////////////////////////
+//
+//	グローバルな operator new / operator delete の置き換え
+//	（アライメントを指定する版は置き換えない）
+//
+////////////////////////////////////////////////////////////////
+
+void* operator new(const std::size_t size)
+{
+	return s3d::detail::TrackedNew(size, SIV3D_ALLOCATION_CALLER());
+}
+
+void* operator new[](const std::size_t size)
+{
+	return s3d::detail::TrackedNew(size, SIV3D_ALLOCATION_CALLER());
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+	return s3d::detail::TrackedMalloc(size, SIV3D_ALLOCATION_CALLER());
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+	return s3d::detail::TrackedMalloc(size, SIV3D_ALLOCATION_CALLER());
+}
+
+void operator delete(void* const p) noexcept
+{
+	s3d::detail::TrackedFree(p);
+}
+
+void operator delete[](void* const p) noexcept
+{
+	s3d::detail::TrackedFree(p);
+}
+
+void operator delete(void* const p, std::size_t) noexcept
+{
+	s3d::detail::TrackedFree(p);
+}
+
+void operator delete[](void* const p, std::size_t) noexcept
+{
+	s3d::detail::TrackedFree(p);
+}
+
+void operator delete(void* const p, const std::nothrow_t&) noexcept
+{
+	s3d::detail::TrackedFree(p);
+}
+
+void operator delete[](void* const p, const std::nothrow_t&) noexcept
+{
+	s3d::detail::TrackedFree(p);
+}
+
+# endif
+
+# undef SIV3D_ALLOCATION_CALLER
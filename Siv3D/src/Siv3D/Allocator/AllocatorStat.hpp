@@ -0,0 +1,42 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct AllocatorFrameStat
+		{
+			size_t allocations = 0;
+
+			size_t allocatedBytes = 0;
+
+			size_t deallocations = 0;
+
+			size_t deallocatedBytes = 0;
+		};
+
+		/// @brief メモリ確保を、フレームごとの回数とサイズに加算します。
+		/// @param size 確保したメモリのサイズ（バイト）
+		void CountAllocation(size_t size) noexcept;
+
+		/// @brief メモリ解放を、フレームごとの回数とサイズに加算します。
+		/// @param size 解放したメモリのサイズ（バイト）
+		void CountDeallocation(size_t size) noexcept;
+
+		/// @brief 前回の呼び出し以降のメモリ確保と解放の回数とサイズ（バイト）を返し、カウンタを 0 に戻します。
+		[[nodiscard]]
+		AllocatorFrameStat TakeAllocatorStat() noexcept;
+	}
+}
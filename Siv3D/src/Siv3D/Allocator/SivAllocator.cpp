@@ -0,0 +1,64 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <atomic>
+# include <Siv3D/Allocator.hpp>
+# include <Siv3D/AllocationTracker/AllocationTrackerDetail.hpp>
+# include "AllocatorStat.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// エンジンの初期化前や終了後にも呼ばれるため、エンジンのコンポーネントには置かない
+		static std::atomic<size_t> g_allocationCount = 0;
+
+		static std::atomic<size_t> g_allocatedBytes = 0;
+
+		static std::atomic<size_t> g_deallocationCount = 0;
+
+		static std::atomic<size_t> g_deallocatedBytes = 0;
+
+		void CountAllocation(const size_t size) noexcept
+		{
+			g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+			g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+
+		void CountDeallocation(const size_t size) noexcept
+		{
+			g_deallocationCount.fetch_add(1, std::memory_order_relaxed);
+			g_deallocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+
+		void RecordAllocatorAllocation(const size_t size) noexcept
+		{
+			CountAllocation(size);
+			TrackAllocation(AllocationTag::Array, size);
+		}
+
+		void RecordAllocatorDeallocation(const size_t size) noexcept
+		{
+			CountDeallocation(size);
+			TrackDeallocation(AllocationTag::Array, size);
+		}
+
+		AllocatorFrameStat TakeAllocatorStat() noexcept
+		{
+			AllocatorFrameStat stat;
+			stat.allocations		= g_allocationCount.exchange(0, std::memory_order_relaxed);
+			stat.allocatedBytes		= g_allocatedBytes.exchange(0, std::memory_order_relaxed);
+			stat.deallocations		= g_deallocationCount.exchange(0, std::memory_order_relaxed);
+			stat.deallocatedBytes	= g_deallocatedBytes.exchange(0, std::memory_order_relaxed);
+			return stat;
+		}
+	}
+}
@@ -0,0 +1,27 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief フレームアリーナを次のフレームのために空にします。
+		/// @remark `System::Update()` からメインスレッドで呼ばれます。
+		void ResetFrameArena();
+
+		/// @brief 前回のリセット以降にフレームアリーナから確保したメモリのサイズ（バイト）を返します。
+		[[nodiscard]]
+		size_t GetFrameArenaUsedBytes() noexcept;
+	}
+}
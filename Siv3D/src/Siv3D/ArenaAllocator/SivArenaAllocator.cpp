@@ -0,0 +1,346 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <atomic>
+# include <memory>
+# include <mutex>
+# include <new>
+# include <thread>
+# include <vector>
+# include <Siv3D/ArenaAllocator.hpp>
+# include <Siv3D/Byte.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "FrameArena.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		namespace
+		{
+			// 静的初期化はメインスレッドで行われる
+			const std::thread::id g_mainThreadID = std::this_thread::get_id();
+
+			[[nodiscard]]
+			inline bool IsMainThread() noexcept
+			{
+				return (std::this_thread::get_id() == g_mainThreadID);
+			}
+
+			[[nodiscard]]
+			inline void* HeapAllocate(const size_t size, const size_t alignment)
+			{
+				if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				{
+					return ::operator new(size);
+				}
+				else
+				{
+					return ::operator new(size, std::align_val_t{ alignment });
+				}
+			}
+
+			inline void HeapDeallocate(void* const p, const size_t alignment) noexcept
+			{
+				if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				{
+					::operator delete(p);
+				}
+				else
+				{
+					::operator delete(p, std::align_val_t{ alignment });
+				}
+			}
+
+			class FrameArena
+			{
+			public:
+
+				// 最初に確保するチャンクのサイズ
+				static constexpr size_t InitialChunkSize = (64 * 1024);
+
+				// アリーナ全体の最大容量（解放待ちの世代を含む）。これを超える確保はヒープから行う
+				static constexpr size_t MaxCapacity = (32 * 1024 * 1024);
+
+				// メインスレッドからのみ呼ばれる
+				[[nodiscard]]
+				void* allocate(const size_t size, const size_t alignment)
+				{
+					if (void* p = allocateFromCurrentChunk(size, alignment))
+					{
+						return p;
+					}
+
+					const size_t lastChunkSize = (m_current->chunks.empty() ? (InitialChunkSize / 2) : m_current->chunks.back().size);
+					const size_t chunkSize = Max((lastChunkSize * 2), (size + alignment));
+					const size_t totalCapacity = (m_current->capacity + m_retiredBytes);
+
+					if ((MaxCapacity < totalCapacity)
+						|| ((MaxCapacity - totalCapacity) < chunkSize))
+					{
+						return nullptr;
+					}
+
+					addChunk(chunkSize);
+
+					return allocateFromCurrentChunk(size, alignment);
+				}
+
+				// 任意のスレッドから呼ばれる
+				[[nodiscard]]
+				bool deallocate(void* const p) noexcept
+				{
+					// チャンクの追加や削除はメインスレッドでのみ、ロックした状態で行われる
+					if (IsMainThread())
+					{
+						return release(p);
+					}
+
+					std::lock_guard lock{ m_mutex };
+
+					return release(p);
+				}
+
+				// メインスレッドからのみ呼ばれる
+				void reset()
+				{
+					m_usedBytes = 0;
+
+					releaseRetiredGenerations();
+
+					if (const size_t liveCount = m_current->liveCount.load())
+					{
+						// フレームをまたいで保持されているメモリがあるため、この世代はそれらが解放されるまで残し、新しい世代に切り替える
+						{
+							std::lock_guard lock{ m_mutex };
+							m_retiredBytes += m_current->capacity;
+							m_retired.push_back(std::move(m_current));
+							m_current = std::make_unique<Generation>();
+						}
+
+						m_offset = 0;
+
+						LOG_WARNING(U"FrameArena: {} allocation(s) outlived the frame. {} KiB of arena memory is kept until they are released ({} KiB in total)"_fmt(
+							liveCount, (m_retired.back()->capacity / 1024), (m_retiredBytes / 1024)));
+
+						return;
+					}
+
+					// 複数のチャンクを使ったフレームの後は、1 つの大きなチャンクにまとめる
+					if (1 < m_current->chunks.size())
+					{
+						const size_t capacity = m_current->capacity;
+						{
+							std::lock_guard lock{ m_mutex };
+							m_current->chunks.clear();
+							m_current->capacity = 0;
+						}
+						addChunk(capacity);
+					}
+
+					m_offset = 0;
+				}
+
+				[[nodiscard]]
+				size_t usedBytes() const noexcept
+				{
+					return m_usedBytes;
+				}
+
+			private:
+
+				struct Chunk
+				{
+					std::unique_ptr<Byte[]> data;
+
+					size_t size = 0;
+				};
+
+				// リセットの時点で解放されていないメモリがあると、世代ごと解放待ちになる
+				struct Generation
+				{
+					std::vector<Chunk> chunks;
+
+					size_t capacity = 0;
+
+					// 他のスレッドからも解放される
+					std::atomic<size_t> liveCount{ 0 };
+
+					[[nodiscard]]
+					bool owns(const void* const p) const noexcept
+					{
+						const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+
+						for (const auto& chunk : chunks)
+						{
+							const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+
+							if ((base <= address) && (address < (base + chunk.size)))
+							{
+								return true;
+							}
+						}
+
+						return false;
+					}
+				};
+
+				std::unique_ptr<Generation> m_current = std::make_unique<Generation>();
+
+				std::vector<std::unique_ptr<Generation>> m_retired;
+
+				// 他のスレッドからの解放と、チャンクや世代の追加・削除を排他する
+				std::mutex m_mutex;
+
+				// 最後のチャンクの使用済みのサイズ
+				size_t m_offset = 0;
+
+				size_t m_retiredBytes = 0;
+
+				size_t m_usedBytes = 0;
+
+				void addChunk(const size_t size)
+				{
+					Chunk chunk{ std::make_unique<Byte[]>(size), size };
+					{
+						std::lock_guard lock{ m_mutex };
+						m_current->chunks.push_back(std::move(chunk));
+					}
+					m_current->capacity += size;
+					m_offset = 0;
+				}
+
+				[[nodiscard]]
+				void* allocateFromCurrentChunk(const size_t size, const size_t alignment) noexcept
+				{
+					if (m_current->chunks.empty())
+					{
+						return nullptr;
+					}
+
+					const Chunk& chunk = m_current->chunks.back();
+					const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+					const uintptr_t aligned = (((base + m_offset) + (alignment - 1)) & ~(static_cast<uintptr_t>(alignment) - 1));
+					const size_t offset = static_cast<size_t>(aligned - base);
+
+					if ((chunk.size < offset) || ((chunk.size - offset) < size))
+					{
+						return nullptr;
+					}
+
+					m_offset = (offset + size);
+					m_current->liveCount.fetch_add(1, std::memory_order_relaxed);
+					m_usedBytes += size;
+
+					return reinterpret_cast<void*>(aligned);
+				}
+
+				[[nodiscard]]
+				bool release(const void* const p) noexcept
+				{
+					if (m_current->owns(p))
+					{
+						m_current->liveCount.fetch_sub(1);
+						return true;
+					}
+
+					for (const auto& generation : m_retired)
+					{
+						if (generation->owns(p))
+						{
+							generation->liveCount.fetch_sub(1);
+							return true;
+						}
+					}
+
+					return false;
+				}
+
+				void releaseRetiredGenerations()
+				{
+					if (m_retired.empty())
+					{
+						return;
+					}
+
+					const size_t retiredBytes = m_retiredBytes;
+					{
+						std::lock_guard lock{ m_mutex };
+
+						std::erase_if(m_retired, [this](const std::unique_ptr<Generation>& generation)
+						{
+							if (generation->liveCount.load() != 0)
+							{
+								return false;
+							}
+
+							m_retiredBytes -= generation->capacity;
+							return true;
+						});
+					}
+
+					if (m_retiredBytes < retiredBytes)
+					{
+						LOG_INFO(U"FrameArena: {} KiB of arena memory kept from earlier frames was released"_fmt((retiredBytes - m_retiredBytes) / 1024));
+					}
+				}
+			};
+
+			// 確保とリセットはメインスレッドからのみ、解放は任意のスレッドから行われる
+			FrameArena& GetFrameArena()
+			{
+				static FrameArena arena;
+				return arena;
+			}
+		}
+
+		void* FrameArenaAllocate(const size_t size, const size_t alignment)
+		{
+			if ((size != 0) && IsMainThread())
+			{
+				if (void* p = GetFrameArena().allocate(size, alignment))
+				{
+					return p;
+				}
+			}
+
+			return HeapAllocate(size, alignment);
+		}
+
+		void FrameArenaDeallocate(void* const p, const size_t, const size_t alignment) noexcept
+		{
+			if (p == nullptr)
+			{
+				return;
+			}
+
+			// アリーナのメモリは個別には解放せず、フレームの終わりにまとめて再利用する
+			// 他のスレッドで解放された場合も、ヒープに渡してはならない
+			if (GetFrameArena().deallocate(p))
+			{
+				return;
+			}
+
+			HeapDeallocate(p, alignment);
+		}
+
+		void ResetFrameArena()
+		{
+			GetFrameArena().reset();
+		}
+
+		size_t GetFrameArenaUsedBytes() noexcept
+		{
+			return GetFrameArena().usedBytes();
+		}
+	}
+}
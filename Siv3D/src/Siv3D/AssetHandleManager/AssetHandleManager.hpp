@@ -16,6 +16,7 @@
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AllocationTracker.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -48,6 +49,8 @@ namespace s3d
 
 		void setNullData(std::unique_ptr<Data>&& data)
 		{
+			const ScopedAllocationTag allocationTag{ AllocationTag::AssetHandleManager };
+
 			m_data.emplace(IDType::NullAsset(), std::move(data));
 
 			LOG_TRACE(U"💠 Created {0}[0(null)]"_fmt(m_assetTypeName));
@@ -66,6 +69,8 @@ namespace s3d
 		{
 			std::lock_guard lock{ m_mutex };
 
+			const ScopedAllocationTag allocationTag{ AllocationTag::AssetHandleManager };
+
 			if (++m_idCount == IDType::InvalidID)
 			{
 				m_idFilled = true;
@@ -63,7 +63,7 @@ namespace s3d
 	{
 		m_writer.open(path);
 
-		m_task = Async(&AsyncHTTPTaskDetail::run, this);
+		m_task = std::async(std::launch::async, &AsyncHTTPTaskDetail::run, this);
 	}
 
 	AsyncHTTPTaskDetail::~AsyncHTTPTaskDetail()
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/Wave.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 # include "DynamicAudioSource.hpp"
 
 namespace s3d
@@ -31,6 +32,8 @@ namespace s3d
 
 		unsigned int getAudio(float* aBuffer, unsigned int aSamplesToRead, unsigned int) override
 		{
+			SIV3D_TRACE_ZONE(U"AudioStream::getAudio");
+
 			mParent->m_pAudioStream->getAudio(aBuffer, aBuffer + aSamplesToRead, aSamplesToRead);
 
 			return aSamplesToRead;
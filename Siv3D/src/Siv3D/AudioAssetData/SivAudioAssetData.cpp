@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/AudioAssetData.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 
 namespace s3d
 {
@@ -42,6 +43,8 @@ namespace s3d
 
 	bool AudioAssetData::load(const String& hint)
 	{
+		SIV3D_TRACE_ZONE(U"AudioAsset::load");
+
 		if (isUninitialized())
 		{
 			if (onLoad(*this, hint))
@@ -72,6 +75,8 @@ namespace s3d
 
 			m_task = Async([this, hint = hint]()
 				{
+					SIV3D_TRACE_ZONE(U"AudioAsset::loadAsync");
+
 					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
 				});
 		}
@@ -12,6 +12,7 @@
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/IReader.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AllocationTracker.hpp>
 # include "CAudioDecoder.hpp"
 # include <Siv3D/AudioFormat/WAVEDecoder.hpp>
 # include <Siv3D/AudioFormat/OggVorbisDecoder.hpp>
@@ -93,6 +94,8 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CAudioDecoder::decode()");
 
+		const ScopedAllocationTag allocationTag{ AllocationTag::Wave };
+
 		auto it = findDecoder(imageFormat);
 
 		if (it == m_decoders.end())
@@ -114,6 +117,8 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CAudioDecoder::decode({})"_fmt(decoderName));
 
+		const ScopedAllocationTag allocationTag{ AllocationTag::Wave };
+
 		const auto it = findDecoder(decoderName);
 
 		if (it == m_decoders.end())
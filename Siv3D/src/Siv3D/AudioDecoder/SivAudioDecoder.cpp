@@ -11,6 +11,7 @@
 
 # include <Siv3D/AudioDecoder.hpp>
 # include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/MappedReader.hpp>
 # include "IAudioDecoder.hpp"
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -37,26 +38,12 @@ namespace s3d
 
 		Wave Decode(const FilePathView path, const AudioFormat audioFormat)
 		{
-			BinaryReader reader{ path };
-
-			if (not reader)
-			{
-				return{};
-			}
-
-			return SIV3D_ENGINE(AudioDecoder)->decode(reader, path, audioFormat);
+			return detail::ReadWholeFile(path, [&](IReader& reader) { return SIV3D_ENGINE(AudioDecoder)->decode(reader, path, audioFormat); });
 		}
 
 		Wave Decode(const FilePathView path, const StringView decoderName)
 		{
-			BinaryReader reader{ path };
-
-			if (not reader)
-			{
-				return{};
-			}
-
-			return SIV3D_ENGINE(AudioDecoder)->decode(reader, decoderName);
+			return detail::ReadWholeFile(path, [&](IReader& reader) { return SIV3D_ENGINE(AudioDecoder)->decode(reader, decoderName); });
 		}
 
 		Wave Decode(IReader& reader, const AudioFormat audioFormat)
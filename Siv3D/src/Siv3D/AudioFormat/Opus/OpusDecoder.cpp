@@ -11,6 +11,7 @@
 
 # include <Siv3D/AudioFormat/OpusDecoder.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/MappedReader/MappedReaderUtility.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/ogg/ogg.h>
@@ -75,11 +76,13 @@ namespace s3d
 			return{};
 		}
 
-		Array<uint8> data(reader.size());
-		reader.read(data.data(), data.size());
+		Array<Byte> fileData;
+		const std::span<const Byte> input = detail::ReadRemaining(reader, fileData);
+		const uint8* data = reinterpret_cast<const uint8*>(input.data());
+		const size_t dataSize = input.size();
 
 		int err;
-		OggOpusFile* of = ::op_open_memory(data.data(), data.size(), &err);
+		OggOpusFile* of = ::op_open_memory(data, dataSize, &err);
 
 		if (not of)
 		{
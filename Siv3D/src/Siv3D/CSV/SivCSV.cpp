@@ -11,6 +11,7 @@
 
 # include <Siv3D/CSV.hpp>
 # include <Siv3D/TextWriter.hpp>
+# include <Siv3D/MappedReader.hpp>
 # include <boost/tokenizer.hpp>
 
 namespace s3d
@@ -36,6 +37,13 @@ namespace s3d
 
 	bool CSV::load(const FilePathView path, const StringView separators, const StringView quotes, const StringView escapes)
 	{
+		// ファイル全体を読み込むため、可能な場合はメモリマップしたファイルから直接デコードする
+		if (auto mapped = std::make_unique<MappedReader>(path);
+			mapped->isOpen())
+		{
+			return load(std::move(mapped), separators, quotes, escapes);
+		}
+
 		TextReader textReader{ path };
 
 		if (not loadFromTextReader(textReader, separators, quotes, escapes))
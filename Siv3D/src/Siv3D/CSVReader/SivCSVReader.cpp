@@ -0,0 +1,560 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <algorithm>
+# include <charconv>
+# include <cstring>
+# include <Siv3D/CSVReader.hpp>
+# include <Siv3D/Char.hpp>
+# include <Siv3D/MathConstants.hpp>
+# include <Siv3D/Utility.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Threading.hpp>
+# include <ThirdParty/double-conversion/double-conversion.h>
+
+namespace s3d
+{
+	namespace
+	{
+		enum CharType : uint8
+		{
+			Normal,
+
+			Separator,
+
+			Quote,
+
+			Escape,
+
+			CarriageReturn,
+		};
+
+		// 並列に読み込む際の、1 つの区間の最小サイズ（バイト）
+		constexpr size_t MinChunkSize = (1024 * 1024);
+
+		[[nodiscard]]
+		constexpr bool IsLineBreak(const char ch) noexcept
+		{
+			return ((ch == '\n') || (ch == '\0'));
+		}
+
+		[[nodiscard]]
+		const char* FindLineBreak(const char* p, const char* const end) noexcept
+		{
+			while ((p != end) && (not IsLineBreak(*p)))
+			{
+				++p;
+			}
+
+			return p;
+		}
+
+		/// @brief 1 行を要素に分割します。
+		/// @param strict 不正なエスケープシーケンスを見つけたときに false を返すか
+		/// @return 不正なエスケープシーケンスが含まれていた場合 false
+		/// @remark boost::escaped_list_separator と同じ規則で分割します。
+		[[nodiscard]]
+		bool SplitLine(const char* p, const char* const lineEnd, const std::array<uint8, 256>& charTypes, const bool strict, Array<std::string_view>& cells, std::string& buffer)
+		{
+			cells.clear();
+
+			if (p == lineEnd)
+			{
+				return true;
+			}
+
+			// 要素の長さは、行の長さを超えない
+			if (buffer.size() < static_cast<size_t>(lineEnd - p))
+			{
+				buffer.resize(lineEnd - p);
+			}
+
+			char* const pBuffer = buffer.data();
+			size_t writePos = 0;
+
+			for (;;)
+			{
+				const char* const cellBegin = p;
+
+				while ((p != lineEnd) && (charTypes[static_cast<uint8>(*p)] == Normal))
+				{
+					++p;
+				}
+
+				// 特別な文字を含まない要素は、元のメモリを指す
+				if ((p == lineEnd) || (charTypes[static_cast<uint8>(*p)] == Separator))
+				{
+					cells.emplace_back(cellBegin, (p - cellBegin));
+
+					if (p == lineEnd)
+					{
+						return true;
+					}
+
+					++p;
+					continue;
+				}
+
+				// クオーテーションやエスケープ記号を含む要素は、バッファに展開する
+				const size_t cellBeginPos = writePos;
+				std::memcpy((pBuffer + writePos), cellBegin, (p - cellBegin));
+				writePos += (p - cellBegin);
+
+				bool inQuote = false;
+				bool endOfCell = false;
+
+				for (; p != lineEnd; ++p)
+				{
+					const char ch = *p;
+
+					switch (charTypes[static_cast<uint8>(ch)])
+					{
+					case Normal:
+						pBuffer[writePos++] = ch;
+						break;
+					case Separator:
+						if (not inQuote)
+						{
+							endOfCell = true;
+							break;
+						}
+
+						pBuffer[writePos++] = ch;
+						break;
+					case Quote:
+						inQuote = (not inQuote);
+						break;
+					case Escape:
+						{
+							// U'\r' は読み飛ばされるため、エスケープ記号の次の文字を探すときも無視する
+							const char* pNext = (p + 1);
+
+							while ((pNext != lineEnd) && (*pNext == '\r'))
+							{
+								++pNext;
+							}
+
+							if (pNext != lineEnd)
+							{
+								const char next = *pNext;
+
+								if (next == 'n')
+								{
+									pBuffer[writePos++] = '\n';
+									p = pNext;
+									break;
+								}
+								else if (const uint8 nextType = charTypes[static_cast<uint8>(next)];
+									(nextType == Separator) || (nextType == Quote) || (nextType == Escape))
+								{
+									pBuffer[writePos++] = next;
+									p = pNext;
+									break;
+								}
+							}
+						}
+
+						if (strict)
+						{
+							return false;
+						}
+
+						pBuffer[writePos++] = ch;
+						break;
+					case CarriageReturn:
+						break;
+					}
+
+					if (endOfCell)
+					{
+						break;
+					}
+				}
+
+				cells.emplace_back((pBuffer + cellBeginPos), (writePos - cellBeginPos));
+
+				if (p == lineEnd)
+				{
+					return true;
+				}
+
+				++p;
+			}
+		}
+
+		/// @brief 次の行を読み込みます。
+		/// @return 行を読み込んだ場合 true, 終端に達していた場合は false
+		[[nodiscard]]
+		bool ReadRow(const char*& current, const char* const end, const std::array<uint8, 256>& charTypes, const std::array<uint8, 256>& fallbackCharTypes, Array<std::string_view>& cells, std::string& buffer)
+		{
+			if (current == end)
+			{
+				cells.clear();
+				return false;
+			}
+
+			const char* const lineBegin = current;
+			const char* lineEnd = FindLineBreak(lineBegin, end);
+			const bool hasLineBreak = (lineEnd != end);
+			current = (hasLineBreak ? (lineEnd + 1) : end);
+
+			// U'\r' は読み飛ばす（TextReader::readLine() と同じ）
+			while ((lineBegin != lineEnd) && (lineEnd[-1] == '\r'))
+			{
+				--lineEnd;
+			}
+
+			// 改行で終わらない最後の行が空の場合は、行として扱わない
+			if ((not hasLineBreak) && (std::find_if(lineBegin, lineEnd, [](const char ch) { return (ch != '\r'); }) == lineEnd))
+			{
+				cells.clear();
+				return false;
+			}
+
+			if (not SplitLine(lineBegin, lineEnd, charTypes, true, cells, buffer))
+			{
+				// 不正なエスケープシーケンスを含む行は、バックスラッシュを通常の文字として扱う（CSV::load() と同じ）
+				[[maybe_unused]] const bool result = SplitLine(lineBegin, lineEnd, fallbackCharTypes, false, cells, buffer);
+			}
+
+			return true;
+		}
+
+		[[nodiscard]]
+		std::string_view TrimSpaces(std::string_view s) noexcept
+		{
+			while ((not s.empty()) && ((s.front() == ' ') || (s.front() == '\t')))
+			{
+				s.remove_prefix(1);
+			}
+
+			while ((not s.empty()) && ((s.back() == ' ') || (s.back() == '\t')))
+			{
+				s.remove_suffix(1);
+			}
+
+			return s;
+		}
+
+		[[nodiscard]]
+		int64 ParseInt64(std::string_view s) noexcept
+		{
+			s = TrimSpaces(s);
+
+			if ((2 <= s.size()) && (s.front() == '+') && (s[1] != '-'))
+			{
+				s.remove_prefix(1);
+			}
+
+			int64 result = 0;
+			const auto [ptr, ec] = std::from_chars(s.data(), (s.data() + s.size()), result);
+
+			if ((ec != std::errc{}) || (ptr != (s.data() + s.size())))
+			{
+				return 0;
+			}
+
+			return result;
+		}
+
+		[[nodiscard]]
+		double ParseDouble(const std::string_view s) noexcept
+		{
+			using namespace double_conversion;
+
+			const int flags =
+				StringToDoubleConverter::ALLOW_LEADING_SPACES
+				| StringToDoubleConverter::ALLOW_TRAILING_SPACES
+				| StringToDoubleConverter::ALLOW_SPACES_AFTER_SIGN
+				| StringToDoubleConverter::ALLOW_CASE_INSENSIBILITY;
+			const StringToDoubleConverter conv(flags, Math::QNaN, Math::QNaN, "inf", "nan");
+
+			int unused;
+			return conv.StringToDouble(s.data(), static_cast<int>(s.size()), &unused);
+		}
+
+		void AppendCell(CSVColumnData& data, const CSVColumnType type, const std::string_view cell)
+		{
+			switch (type)
+			{
+			case CSVColumnType::Int64:
+				std::get<Array<int64>>(data).push_back(ParseInt64(cell));
+				break;
+			case CSVColumnType::Double:
+				std::get<Array<double>>(data).push_back(ParseDouble(cell));
+				break;
+			case CSVColumnType::String:
+				std::get<Array<String>>(data).push_back(Unicode::FromUTF8(cell));
+				break;
+			}
+		}
+
+		void AppendMissingCell(CSVColumnData& data, const CSVColumnType type)
+		{
+			switch (type)
+			{
+			case CSVColumnType::Int64:
+				std::get<Array<int64>>(data).push_back(0);
+				break;
+			case CSVColumnType::Double:
+				std::get<Array<double>>(data).push_back(Math::QNaN);
+				break;
+			case CSVColumnType::String:
+				std::get<Array<String>>(data).emplace_back();
+				break;
+			}
+		}
+
+		[[nodiscard]]
+		CSVColumnData MakeColumnData(const CSVColumnType type)
+		{
+			switch (type)
+			{
+			case CSVColumnType::Int64:
+				return Array<int64>{};
+			case CSVColumnType::Double:
+				return Array<double>{};
+			default:
+				return Array<String>{};
+			}
+		}
+
+		void AppendColumnData(CSVColumnData& dst, CSVColumnData&& src)
+		{
+			std::visit([&](auto& dstArray)
+				{
+					using ArrayType = std::decay_t<decltype(dstArray)>;
+					auto& srcArray = std::get<ArrayType>(src);
+
+					if (dstArray.isEmpty())
+					{
+						dstArray = std::move(srcArray);
+					}
+					else
+					{
+						dstArray.insert(dstArray.end(), std::make_move_iterator(srcArray.begin()), std::make_move_iterator(srcArray.end()));
+					}
+				}, dst);
+		}
+
+		[[nodiscard]]
+		std::array<uint8, 256> MakeCharTypes(const StringView separators, const StringView quotes, const StringView escapes)
+		{
+			std::array<uint8, 256> charTypes{};
+			charTypes[static_cast<uint8>('\r')] = CarriageReturn;
+
+			// boost::escaped_list_separator と同じく、エスケープ記号、要素の区切り、クオーテーションの順に優先する
+			for (const char32 ch : quotes)
+			{
+				if (IsASCII(ch))
+				{
+					charTypes[ch] = Quote;
+				}
+			}
+
+			for (const char32 ch : separators)
+			{
+				if (IsASCII(ch))
+				{
+					charTypes[ch] = Separator;
+				}
+			}
+
+			for (const char32 ch : escapes)
+			{
+				if (IsASCII(ch))
+				{
+					charTypes[ch] = Escape;
+				}
+			}
+
+			// 行の区切りは要素の区切りなどに使えない
+			charTypes[static_cast<uint8>('\n')] = Normal;
+			charTypes[static_cast<uint8>('\0')] = Normal;
+
+			return charTypes;
+		}
+
+		[[nodiscard]]
+		std::array<uint8, 256> MakeFallbackCharTypes(std::array<uint8, 256> charTypes) noexcept
+		{
+			if (charTypes[static_cast<uint8>('\\')] == Escape)
+			{
+				charTypes[static_cast<uint8>('\\')] = Normal;
+			}
+
+			return charTypes;
+		}
+	}
+
+	CSVReader::CSVReader(const FilePathView path, const StringView separators, const StringView quotes, const StringView escapes)
+	{
+		open(path, separators, quotes, escapes);
+	}
+
+	bool CSVReader::open(const FilePathView path, const StringView separators, const StringView quotes, const StringView escapes)
+	{
+		close();
+
+		if (not m_file.open(path, MapAll::Yes))
+		{
+			return false;
+		}
+
+		const size_t fileSize = static_cast<size_t>(m_file.fileSize());
+
+		if ((fileSize != 0) && (m_file.mappedSize() != fileSize))
+		{
+			m_file.close();
+			return false;
+		}
+
+		m_begin = static_cast<const char*>(static_cast<const void*>(m_file.data()));
+		m_end = (m_begin + fileSize);
+
+		// BOM を読み飛ばす
+		if ((3 <= fileSize)
+			&& (static_cast<uint8>(m_begin[0]) == 0xEF)
+			&& (static_cast<uint8>(m_begin[1]) == 0xBB)
+			&& (static_cast<uint8>(m_begin[2]) == 0xBF))
+		{
+			m_begin += 3;
+		}
+
+		m_current = m_begin;
+		m_charTypes = MakeCharTypes(separators, quotes, escapes);
+		m_fallbackCharTypes = MakeFallbackCharTypes(m_charTypes);
+
+		return true;
+	}
+
+	void CSVReader::close()
+	{
+		m_file.close();
+		m_begin = nullptr;
+		m_end = nullptr;
+		m_current = nullptr;
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+	}
+
+	bool CSVReader::isOpen() const noexcept
+	{
+		return m_file.isOpen();
+	}
+
+	CSVReader::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	bool CSVReader::readRow(Array<std::string_view>& cells)
+	{
+		return ReadRow(m_current, m_end, m_charTypes, m_fallbackCharTypes, cells, m_buffer);
+	}
+
+	void CSVReader::rewind() noexcept
+	{
+		m_current = m_begin;
+	}
+
+	Array<CSVColumnData> CSVReader::readColumns(const Array<CSVColumn>& columns, const size_t skipRows) const
+	{
+		Array<CSVColumnData> results = columns.map([](const CSVColumn& column) { return MakeColumnData(column.type); });
+
+		if (not isOpen())
+		{
+			return results;
+		}
+
+		// 読み飛ばす行は、区間に分割する前に処理する
+		const char* begin = m_begin;
+		{
+			Array<std::string_view> cells;
+			std::string buffer;
+
+			for (size_t i = 0; i < skipRows; ++i)
+			{
+				if (not ReadRow(begin, m_end, m_charTypes, m_fallbackCharTypes, cells, buffer))
+				{
+					return results;
+				}
+			}
+		}
+
+		// 行の途中から始まらないように、区間の先頭を次の行の先頭に合わせる
+		const size_t size = (m_end - begin);
+		const size_t numChunks = Max<size_t>(1, Min<size_t>((size / MinChunkSize), (Threading::GetConcurrency() * 4)));
+		Array<const char*> chunkBegins(numChunks + 1);
+		chunkBegins.front() = begin;
+		chunkBegins.back() = m_end;
+
+		for (size_t i = 1; i < numChunks; ++i)
+		{
+			const char* p = FindLineBreak(Max(chunkBegins[i - 1], (begin + (size * i / numChunks))), m_end);
+			chunkBegins[i] = ((p == m_end) ? m_end : (p + 1));
+		}
+
+		Array<Array<CSVColumnData>> chunkResults(numChunks);
+
+		Threading::ParallelFor(numChunks, [&](const size_t first, const size_t last)
+			{
+				Array<std::string_view> cells;
+				std::string buffer;
+
+				for (size_t chunkIndex = first; chunkIndex < last; ++chunkIndex)
+				{
+					Array<CSVColumnData>& chunkResult = chunkResults[chunkIndex];
+					chunkResult = columns.map([](const CSVColumn& column) { return MakeColumnData(column.type); });
+
+					const char* current = chunkBegins[chunkIndex];
+					const char* const chunkEnd = chunkBegins[chunkIndex + 1];
+
+					while (current < chunkEnd)
+					{
+						if (not ReadRow(current, chunkEnd, m_charTypes, m_fallbackCharTypes, cells, buffer))
+						{
+							break;
+						}
+
+						for (size_t i = 0; i < columns.size(); ++i)
+						{
+							const CSVColumn& column = columns[i];
+
+							if (column.index < cells.size())
+							{
+								AppendCell(chunkResult[i], column.type, cells[column.index]);
+							}
+							else
+							{
+								AppendMissingCell(chunkResult[i], column.type);
+							}
+						}
+					}
+				}
+			});
+
+		for (auto& chunkResult : chunkResults)
+		{
+			for (size_t i = 0; i < columns.size(); ++i)
+			{
+				AppendColumnData(results[i], std::move(chunkResult[i]));
+			}
+		}
+
+		return results;
+	}
+
+	const FilePath& CSVReader::path() const noexcept
+	{
+		return m_file.path();
+	}
+}
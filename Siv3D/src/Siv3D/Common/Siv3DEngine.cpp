@@ -57,6 +57,7 @@
 # include <Siv3D/Effect/IEffect.hpp>
 # include <Siv3D/Script/IScript.hpp>
 # include <Siv3D/Addon/IAddon.hpp>
+# include <Siv3D/Threading/IThreading.hpp>
 
 namespace s3d
 {
@@ -62,6 +62,7 @@ namespace s3d
 	class ISiv3DEffect;
 	class ISiv3DScript;
 	class ISiv3DAddon;
+	class ISiv3DThreading;
 
 	class Siv3DEngine
 	{
@@ -116,7 +117,9 @@ namespace s3d
 			Siv3DComponent<ISiv3DAsset>,
 			Siv3DComponent<ISiv3DEffect>,
 			Siv3DComponent<ISiv3DScript>,
-			Siv3DComponent<ISiv3DAddon>> m_components;
+			Siv3DComponent<ISiv3DAddon>,
+			// 実行待ちのタスクが他のコンポーネントを使う可能性があるため、最初に解放する
+			Siv3DComponent<ISiv3DThreading>> m_components;
 
 	public:
 
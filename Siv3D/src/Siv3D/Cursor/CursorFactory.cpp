@@ -17,7 +17,8 @@ namespace s3d
 {
 	ISiv3DCursor* ISiv3DCursor::Create()
 	{
-		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			|| (g_engineOptions.renderer == EngineOption::Renderer::Software))
 		{
 			return new CCursor_Null;
 		}
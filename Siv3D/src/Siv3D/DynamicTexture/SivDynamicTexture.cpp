@@ -10,11 +10,33 @@
 //-----------------------------------------------
 
 # include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/2DShapes.hpp>
 # include <Siv3D/Texture/ITexture.hpp>
+# include <Siv3D/Profiler/IProfiler.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		[[nodiscard]]
+		static bool RecordTextureUpload(const bool uploaded, const size_t size)
+		{
+			if (uploaded)
+			{
+				SIV3D_ENGINE(Profiler)->addTextureUploadSize(size);
+			}
+
+			return uploaded;
+		}
+
+		[[nodiscard]]
+		static size_t RegionSize(const Texture& texture, const Rect& rect)
+		{
+			return (static_cast<size_t>(Rect{ texture.size() }.getOverlap(rect).area()) * texture.getFormat().pixelSize());
+		}
+	}
+
 	DynamicTexture::DynamicTexture(const uint32 width, const uint32 height, const TextureFormat& format, const TextureDesc desc)
 		: Texture{ Texture::Dynamic{}, Size{ width, height }, nullptr, 0, format, desc } {}
 
@@ -40,7 +62,7 @@ namespace s3d
 			return false;
 		}
 
-		return SIV3D_ENGINE(Texture)->fill(m_handle->id(), color, true);
+		return detail::RecordTextureUpload(SIV3D_ENGINE(Texture)->fill(m_handle->id(), color, true), detail::RegionSize(*this, Rect{ size() }));
 	}
 
 	bool DynamicTexture::fillRegion(const ColorF& color, const Rect& rect)
@@ -50,7 +72,7 @@ namespace s3d
 			return false;
 		}
 
-		return SIV3D_ENGINE(Texture)->fillRegion(m_handle->id(), color, rect);
+		return detail::RecordTextureUpload(SIV3D_ENGINE(Texture)->fillRegion(m_handle->id(), color, rect), detail::RegionSize(*this, rect));
 	}
 
 	bool DynamicTexture::fill(const Image& image)
@@ -65,7 +87,7 @@ namespace s3d
 			return false;
 		}
 
-		return SIV3D_ENGINE(Texture)->fill(m_handle->id(), image.data(), image.stride(), true);
+		return detail::RecordTextureUpload(SIV3D_ENGINE(Texture)->fill(m_handle->id(), image.data(), image.stride(), true), image.size_bytes());
 	}
 
 	bool DynamicTexture::fillRegion(const Image& image, const Rect& rect)
@@ -79,7 +101,7 @@ namespace s3d
 			return false;
 		}
 
-		return SIV3D_ENGINE(Texture)->fillRegion(m_handle->id(), image.data(), image.stride(), rect, true);
+		return detail::RecordTextureUpload(SIV3D_ENGINE(Texture)->fillRegion(m_handle->id(), image.data(), image.stride(), rect, true), detail::RegionSize(*this, rect));
 	}
 
 	bool DynamicTexture::fillIfNotBusy(const Image& image)
@@ -94,7 +116,7 @@ namespace s3d
 			return false;
 		}
 
-		return SIV3D_ENGINE(Texture)->fill(m_handle->id(), image.data(), image.stride(), false);
+		return detail::RecordTextureUpload(SIV3D_ENGINE(Texture)->fill(m_handle->id(), image.data(), image.stride(), false), image.size_bytes());
 	}
 
 	bool DynamicTexture::fillRegionIfNotBusy(const Image& image, const Rect& rect)
@@ -108,7 +130,7 @@ namespace s3d
 			return false;
 		}
 
-		return SIV3D_ENGINE(Texture)->fillRegion(m_handle->id(), image.data(), image.stride(), rect, false);
+		return detail::RecordTextureUpload(SIV3D_ENGINE(Texture)->fillRegion(m_handle->id(), image.data(), image.stride(), rect, false), detail::RegionSize(*this, rect));
 	}
 
 	void DynamicTexture::swap(DynamicTexture& other) noexcept
@@ -188,6 +188,43 @@ namespace s3d
 		return m_fonts.size();
 	}
 
+	void CFont::addTextureUploadSize(const size_t size)
+	{
+		m_textureUploadSize += size;
+	}
+
+	size_t CFont::resetTextureUploadSize()
+	{
+		return m_textureUploadSize.exchange(0);
+	}
+
+	void CFont::addShapingCacheResult(const bool hit)
+	{
+		if (hit)
+		{
+			++m_shapingCacheHits;
+		}
+		else
+		{
+			++m_shapingCacheMisses;
+		}
+	}
+
+	std::pair<size_t, size_t> CFont::resetShapingCacheStats()
+	{
+		return{ m_shapingCacheHits.exchange(0), m_shapingCacheMisses.exchange(0) };
+	}
+
+	void CFont::addGlyphCacheMisses(const size_t count)
+	{
+		m_glyphCacheMisses += count;
+	}
+
+	size_t CFont::resetGlyphCacheMisses()
+	{
+		return m_glyphCacheMisses.exchange(0);
+	}
+
 	Font::IDType CFont::create(const FilePathView path, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
 	{
 		// Font を作成
@@ -248,6 +285,26 @@ namespace s3d
 		return m_fonts[handleID]->getGlyphCache().getBufferWidth();
 	}
 
+	void CFont::setGlyphCacheMemoryBudget(const Font::IDType handleID, const size_t bytes)
+	{
+		m_fonts[handleID]->getGlyphCache().setMemoryBudget(bytes);
+	}
+
+	size_t CFont::getGlyphCacheMemoryBudget(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getMemoryBudget();
+	}
+
+	void CFont::setShapingCacheCapacity(const Font::IDType handleID, const size_t capacity)
+	{
+		m_fonts[handleID]->setShapingCacheCapacity(capacity);
+	}
+
+	size_t CFont::getShapingCacheCapacity(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getShapingCacheCapacity();
+	}
+
 	bool CFont::hasGlyph(const Font::IDType handleID, StringView ch)
 	{
 		return m_fonts[handleID]->hasGlyph(ch);
@@ -352,6 +409,16 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
+	bool CFont::saveGlyphCache(const Font::IDType handleID, const FilePathView path)
+	{
+		return m_fonts[handleID]->saveGlyphCache(path);
+	}
+
+	bool CFont::loadGlyphCache(const Font::IDType handleID, const FilePathView path)
+	{
+		return m_fonts[handleID]->loadGlyphCache(path);
+	}
+
 	const Texture& CFont::getTexture(const Font::IDType handleID)
 	{
 		return m_fonts[handleID]->getGlyphCache().getTexture();
@@ -53,6 +53,18 @@ namespace s3d
 
 		size_t getFontCount() const override;
 
+		void addTextureUploadSize(size_t size) override;
+
+		size_t resetTextureUploadSize() override;
+
+		void addShapingCacheResult(bool hit) override;
+
+		std::pair<size_t, size_t> resetShapingCacheStats() override;
+
+		void addGlyphCacheMisses(size_t count) override;
+
+		size_t resetGlyphCacheMisses() override;
+
 		Font::IDType create(FilePathView path, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style) override;
 
 		Font::IDType create(Typeface typeface, FontMethod fontMethod, int32 fontSize, FontStyle style) override;
@@ -71,6 +83,14 @@ namespace s3d
 
 		int32 getBufferThickness(Font::IDType handleID) override;
 
+		void setGlyphCacheMemoryBudget(Font::IDType handleID, size_t bytes) override;
+
+		size_t getGlyphCacheMemoryBudget(Font::IDType handleID) override;
+
+		void setShapingCacheCapacity(Font::IDType handleID, size_t capacity) override;
+
+		size_t getShapingCacheCapacity(Font::IDType handleID) override;
+
 		bool hasGlyph(Font::IDType handleID, StringView ch) override;
 
 		GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) override;
@@ -107,6 +127,10 @@ namespace s3d
 	
 		bool preload(Font::IDType handleID, StringView chars) override;
 
+		bool saveGlyphCache(Font::IDType handleID, FilePathView path) override;
+
+		bool loadGlyphCache(Font::IDType handleID, FilePathView path) override;
+
 		const Texture& getTexture(Font::IDType handleID) override;
 
 		Glyph getGlyph(Font::IDType handleID, StringView ch) override;
@@ -169,5 +193,14 @@ namespace s3d
 		std::unique_ptr<EmojiData> m_defaultEmoji;
 
 		Array<std::unique_ptr<IconData>> m_defaultIcons;
+
+		// グリフのテクスチャへの転送量（バイト）。グリフキャッシュは別のスレッドから更新されることがある
+		std::atomic<size_t> m_textureUploadSize = 0;
+
+		std::atomic<size_t> m_shapingCacheHits = 0;
+
+		std::atomic<size_t> m_shapingCacheMisses = 0;
+
+		std::atomic<size_t> m_glyphCacheMisses = 0;
 	};
 }
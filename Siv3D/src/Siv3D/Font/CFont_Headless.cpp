@@ -104,6 +104,43 @@ namespace s3d
 		return m_fonts.size();
 	}
 
+	void CFont_Headless::addTextureUploadSize(const size_t size)
+	{
+		m_textureUploadSize += size;
+	}
+
+	size_t CFont_Headless::resetTextureUploadSize()
+	{
+		return m_textureUploadSize.exchange(0);
+	}
+
+	void CFont_Headless::addShapingCacheResult(const bool hit)
+	{
+		if (hit)
+		{
+			++m_shapingCacheHits;
+		}
+		else
+		{
+			++m_shapingCacheMisses;
+		}
+	}
+
+	std::pair<size_t, size_t> CFont_Headless::resetShapingCacheStats()
+	{
+		return{ m_shapingCacheHits.exchange(0), m_shapingCacheMisses.exchange(0) };
+	}
+
+	void CFont_Headless::addGlyphCacheMisses(const size_t count)
+	{
+		m_glyphCacheMisses += count;
+	}
+
+	size_t CFont_Headless::resetGlyphCacheMisses()
+	{
+		return m_glyphCacheMisses.exchange(0);
+	}
+
 	Font::IDType CFont_Headless::create(const FilePathView path, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
 	{
 		// Font を作成
@@ -164,6 +201,26 @@ namespace s3d
 		return m_fonts[handleID]->getGlyphCache().getBufferWidth();
 	}
 
+	void CFont_Headless::setGlyphCacheMemoryBudget(const Font::IDType handleID, const size_t bytes)
+	{
+		m_fonts[handleID]->getGlyphCache().setMemoryBudget(bytes);
+	}
+
+	size_t CFont_Headless::getGlyphCacheMemoryBudget(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getMemoryBudget();
+	}
+
+	void CFont_Headless::setShapingCacheCapacity(const Font::IDType handleID, const size_t capacity)
+	{
+		m_fonts[handleID]->setShapingCacheCapacity(capacity);
+	}
+
+	size_t CFont_Headless::getShapingCacheCapacity(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getShapingCacheCapacity();
+	}
+
 	bool CFont_Headless::hasGlyph(const Font::IDType handleID, StringView ch)
 	{
 		return m_fonts[handleID]->hasGlyph(ch);
@@ -268,6 +325,16 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
+	bool CFont_Headless::saveGlyphCache(const Font::IDType handleID, const FilePathView path)
+	{
+		return m_fonts[handleID]->saveGlyphCache(path);
+	}
+
+	bool CFont_Headless::loadGlyphCache(const Font::IDType handleID, const FilePathView path)
+	{
+		return m_fonts[handleID]->loadGlyphCache(path);
+	}
+
 	const Texture& CFont_Headless::getTexture(const Font::IDType handleID)
 	{
 		return m_fonts[handleID]->getGlyphCache().getTexture();
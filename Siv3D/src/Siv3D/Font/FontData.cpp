@@ -14,6 +14,8 @@
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/Blob.hpp>
 # include "FontData.hpp"
 # include "GlyphRenderer/GlyphRenderer.hpp"
 # include "GlyphRenderer/BitmapGlyphRenderer.hpp"
@@ -83,6 +85,12 @@ namespace s3d
 			break;
 		}
 
+		m_path = path;
+
+		m_faceIndex = faceIndex;
+
+		m_style = style;
+
 		m_method = fontMethod;
 
 		m_initialized = true;
@@ -142,6 +150,36 @@ namespace s3d
 	}
 
 	Array<GlyphCluster> FontData::getGlyphClusters(const StringView s, const bool recursive, const Ligature ligature) const
+	{
+		const size_t fallbackCount = (recursive ? m_fallbackFonts.count_if([](const auto& font) { return (not font.expired()); }) : 0);
+
+		if (const Array<GlyphCluster>* clusters = m_shapingCache.find(s, recursive, ligature, fallbackCount))
+		{
+			SIV3D_ENGINE(Font)->addShapingCacheResult(true);
+
+			return *clusters;
+		}
+
+		SIV3D_ENGINE(Font)->addShapingCacheResult(false);
+
+		Array<GlyphCluster> clusters = shapeGlyphClusters(s, recursive, ligature);
+
+		m_shapingCache.insert(s, recursive, ligature, fallbackCount, clusters);
+
+		return clusters;
+	}
+
+	void FontData::setShapingCacheCapacity(const size_t capacity)
+	{
+		m_shapingCache.setCapacity(capacity);
+	}
+
+	size_t FontData::getShapingCacheCapacity() const noexcept
+	{
+		return m_shapingCache.getCapacity();
+	}
+
+	Array<GlyphCluster> FontData::shapeGlyphClusters(const StringView s, const bool recursive, const Ligature ligature) const
 	{
 		const HBGlyphInfo glyphInfo = m_fontFace.getHBGlyphInfo(s, ligature);
 
@@ -321,6 +359,16 @@ namespace s3d
 		return RenderMSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
 	}
 
+	Array<SDFGlyph> FontData::renderSDFsByGlyphIndices(const Array<GlyphIndex>& glyphIndices, const int32 buffer) const
+	{
+		return RenderSDFGlyphs(m_fontFace.getFT_Face(), glyphIndices, buffer, m_fontFace.getProperty());
+	}
+
+	Array<MSDFGlyph> FontData::renderMSDFsByGlyphIndices(const Array<GlyphIndex>& glyphIndices, const int32 buffer) const
+	{
+		return RenderMSDFGlyphs(m_fontFace.getFT_Face(), glyphIndices, buffer, m_fontFace.getProperty());
+	}
+
 	IGlyphCache& FontData::getGlyphCache() const
 	{
 		return *m_glyphCache;
@@ -330,6 +378,8 @@ namespace s3d
 	{
 		m_fallbackFonts.push_back(font);
 
+		m_shapingCache.clear();
+
 		return true;
 	}
 
@@ -337,4 +387,136 @@ namespace s3d
 	{
 		return m_fallbackFonts[index];
 	}
+
+	namespace detail
+	{
+		// グリフキャッシュのファイルの先頭に書き込む識別子とバージョン
+		constexpr uint64 GlyphCacheFileSignature = 0x4843594C47443353; // "S3DGLYCH"
+
+		constexpr uint32 GlyphCacheFileVersion = 2;
+
+		struct GlyphCacheFileHeader
+		{
+			uint64 signature = GlyphCacheFileSignature;
+
+			uint32 version = GlyphCacheFileVersion;
+
+			uint32 reserved = 0;
+
+			uint64 fontFileHash = 0;
+
+			uint64 faceIndex = 0;
+
+			int32 fontPixelSize = 0;
+
+			int32 bufferWidth = 0;
+
+			uint8 method = 0;
+
+			uint8 style = 0;
+
+			uint8 unused[6] = {};
+
+			[[nodiscard]]
+			friend bool operator ==(const GlyphCacheFileHeader& lhs, const GlyphCacheFileHeader& rhs) noexcept
+			{
+				return (std::memcmp(&lhs, &rhs, sizeof(GlyphCacheFileHeader)) == 0);
+			}
+		};
+	}
+
+	bool FontData::saveGlyphCache(const FilePathView path) const
+	{
+		if ((not m_initialized) || (not m_glyphCache))
+		{
+			return false;
+		}
+
+		detail::GlyphCacheFileHeader header;
+		header.fontFileHash		= getFontFileHash();
+		header.faceIndex		= m_faceIndex;
+		header.fontPixelSize	= m_fontFace.getProperty().fontPixelSize;
+		header.bufferWidth		= m_glyphCache->getBufferWidth();
+		header.method			= static_cast<uint8>(m_method);
+		header.style			= static_cast<uint8>(m_style);
+
+		BinaryWriter writer{ path };
+
+		if (not writer)
+		{
+			LOG_FAIL(U"Font::saveGlyphCache(): Failed to open `{}`"_fmt(path));
+			return false;
+		}
+
+		return (writer.write(header)
+			&& m_glyphCache->save(writer));
+	}
+
+	bool FontData::loadGlyphCache(const FilePathView path)
+	{
+		if ((not m_initialized) || (not m_glyphCache))
+		{
+			return false;
+		}
+
+		BinaryReader reader{ path };
+
+		if (not reader)
+		{
+			LOG_FAIL(U"Font::loadGlyphCache(): Failed to open `{}`"_fmt(path));
+			return false;
+		}
+
+		detail::GlyphCacheFileHeader header;
+
+		if (not reader.read(header))
+		{
+			return false;
+		}
+
+		detail::GlyphCacheFileHeader expected;
+		expected.fontFileHash	= getFontFileHash();
+		expected.faceIndex		= m_faceIndex;
+		expected.fontPixelSize	= m_fontFace.getProperty().fontPixelSize;
+		expected.bufferWidth	= m_glyphCache->getBufferWidth();
+		expected.method			= static_cast<uint8>(m_method);
+		expected.style			= static_cast<uint8>(m_style);
+
+		if (header != expected)
+		{
+			LOG_FAIL(U"Font::loadGlyphCache(): `{}` was created for a different font, font size, method or version"_fmt(path));
+			return false;
+		}
+
+		if (not m_glyphCache->load(reader))
+		{
+			LOG_FAIL(U"Font::loadGlyphCache(): `{}` is broken"_fmt(path));
+			return false;
+		}
+
+		return true;
+	}
+
+	uint64 FontData::getFontFileHash() const
+	{
+		if (not m_fontFileHash)
+		{
+		# if SIV3D_PLATFORM(WINDOWS)
+
+			if (FileSystem::IsResource(m_path))
+			{
+				m_fontFileHash = Hash::XXHash3(m_resource.data(), m_resource.size());
+
+				return *m_fontFileHash;
+			}
+
+		# endif
+
+			const Blob blob{ m_path };
+
+			m_fontFileHash = Hash::XXHash3(blob.data(), blob.size());
+		}
+
+		return *m_fontFileHash;
+	}
 }
@@ -15,6 +15,7 @@
 # include <Siv3D/Font.hpp>
 # include "FontResourceHolder.hpp"
 # include "FontFace.hpp"
+# include "ShapingCache.hpp"
 
 namespace s3d
 {
@@ -54,6 +55,11 @@ namespace s3d
 		[[nodiscard]]
 		Array<GlyphCluster> getGlyphClusters(StringView s, bool recursive, Ligature ligature) const;
 
+		void setShapingCacheCapacity(size_t capacity);
+
+		[[nodiscard]]
+		size_t getShapingCacheCapacity() const noexcept;
+
 		[[nodiscard]]
 		GlyphInfo getGlyphInfoByGlyphIndex(GlyphIndex glyphIndex) const;
 
@@ -78,6 +84,12 @@ namespace s3d
 		[[nodiscard]]
 		MSDFGlyph renderMSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
 
+		[[nodiscard]]
+		Array<SDFGlyph> renderSDFsByGlyphIndices(const Array<GlyphIndex>& glyphIndices, int32 buffer) const;
+
+		[[nodiscard]]
+		Array<MSDFGlyph> renderMSDFsByGlyphIndices(const Array<GlyphIndex>& glyphIndices, int32 buffer) const;
+
 		[[nodiscard]]
 		IGlyphCache& getGlyphCache() const;
 
@@ -87,6 +99,10 @@ namespace s3d
 		[[nodiscard]]
 		const std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>& getFallbackFont(size_t index) const;
 
+		bool saveGlyphCache(FilePathView path) const;
+
+		bool loadGlyphCache(FilePathView path);
+
 	private:
 
 	# if SIV3D_PLATFORM(WINDOWS)
@@ -97,12 +113,30 @@ namespace s3d
 
 		FontFace m_fontFace;
 
+		FilePath m_path;
+
+		size_t m_faceIndex = 0;
+
+		FontStyle m_style = FontStyle::Default;
+
+		// グリフキャッシュのファイルがこのフォントのものであるかを確認するための、フォントファイルのハッシュ値
+		mutable Optional<uint64> m_fontFileHash;
+
 		Array<std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>> m_fallbackFonts;
 
 		FontMethod m_method = FontMethod::Bitmap;
 
 		std::unique_ptr<IGlyphCache> m_glyphCache;
 
+		// 同じ文字列を毎フレーム描画する場合に、シェーピングを省略する
+		mutable ShapingCache m_shapingCache;
+
 		bool m_initialized = false;
+
+		[[nodiscard]]
+		Array<GlyphCluster> shapeGlyphClusters(StringView s, bool recursive, Ligature ligature) const;
+
+		[[nodiscard]]
+		uint64 getFontFileHash() const;
 	};
 }
@@ -13,6 +13,9 @@
 # include <Siv3D/BitmapGlyph.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/System.hpp>
+# include <Siv3D/TraceRecorder.hpp>
+# include <Siv3D/AllocationTracker.hpp>
+# include <Siv3D/ArenaAllocator.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "BitmapGlyphCache.hpp"
@@ -25,7 +28,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -66,7 +69,7 @@ namespace s3d
 
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -104,7 +107,7 @@ namespace s3d
 		{
 			// do tnohing
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const double dotXAdvance = m_glyphTable.find(dotGlyphCluster[0].glyphIndex)->second.info.xAdvance;
 		const Vec2 areaBottomRight = area.br();
@@ -121,10 +124,11 @@ namespace s3d
 		const int32 maxLines = Max(static_cast<int32>(area.h / (lineHeight ? lineHeight : 1)), 1);
 		const Vec2 basePos{ area.pos };
 
-		Array<Vec2> penPositions;
+		// 描画中にだけ使う一時的な配列は、フレームアリーナから確保する
+		Array<Vec2, ArenaAllocator<Vec2>> penPositions;
 		size_t clusterIndex = 0;
 		{
-			Array<double> xAdvances(Arg::reserve = clusters.size());
+			Array<double, ArenaAllocator<double>> xAdvances(Arg::reserve = clusters.size());
 			Vec2 penPos{ basePos };
 			int32 lineIndex = 0;
 			double currentLineWidth = 0.0;
@@ -203,13 +207,13 @@ namespace s3d
 		}
 
 		String newText;
-		Array<GlyphCluster> newClusters;
-		Array<Vec2> newPenPositions;
+		Array<GlyphCluster, ArenaAllocator<GlyphCluster>> newClusters;
+		Array<Vec2, ArenaAllocator<Vec2>> newPenPositions;
 
 		if (clusterIndex == clusters.size())
 		{
 			newText = s;
-			newClusters = clusters;
+			newClusters.assign(clusters.begin(), clusters.end());
 			newPenPositions = std::move(penPositions);
 		}
 		else
@@ -219,7 +223,7 @@ namespace s3d
 			newText.append(v);
 			newText.append(U"...");
 
-			newClusters = clusters.take(clusterIndex);
+			newClusters.assign(clusters.begin(), (clusters.begin() + clusterIndex));
 
 			newClusters.push_back(dotGlyphCluster.front());
 			newClusters.back().pos = (newText.size() - 3);
@@ -256,7 +260,7 @@ namespace s3d
 			{
 				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -284,7 +288,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -297,7 +301,7 @@ namespace s3d
 		{
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -485,9 +489,9 @@ namespace s3d
 
 	const Texture& BitmapGlyphCache::getTexture() noexcept
 	{
-		updateTexture();
+		m_atlas.updateTexture();
 
-		return m_texture;
+		return m_atlas.getTexture();
 	}
 
 	TextureRegion BitmapGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
@@ -496,10 +500,10 @@ namespace s3d
 		{
 			return{};
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		return m_atlas.getTextureRegion(cache);
 	}
 
 	int32 BitmapGlyphCache::getBufferThickness(const GlyphIndex)
@@ -507,72 +511,63 @@ namespace s3d
 		return 0;
 	}
 
+	void BitmapGlyphCache::setMemoryBudget(const size_t bytes)
+	{
+		m_atlas.setMemoryBudget(bytes);
+	}
+
+	size_t BitmapGlyphCache::getMemoryBudget() const noexcept
+	{
+		return m_atlas.getMemoryBudget();
+	}
+
+	bool BitmapGlyphCache::save(BinaryWriter& writer) const
+	{
+		return m_atlas.save(writer, m_glyphTable);
+	}
+
+	bool BitmapGlyphCache::load(BinaryReader& reader)
+	{
+		return m_atlas.load(reader, m_glyphTable);
+	}
+
 	bool BitmapGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
 	{
-		if (m_glyphTable.empty())
+		SIV3D_TRACE_ZONE(U"GlyphCache::prerender");
+
+		const ScopedAllocationTag allocationTag{ AllocationTag::GlyphCache };
+
+		if (not m_glyphTable.contains(0))
 		{
 			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(0);
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
-		for (const auto& cluster : clusters)
+		for (const auto& glyphIndex : m_atlas.getUncachedGlyphIndices(clusters, m_glyphTable, isMainFont))
 		{
-			if (isMainFont && (cluster.fontIndex != 0))
-			{
-				continue;
-			}
-
-			if (m_glyphTable.contains(cluster.glyphIndex))
-			{
-				continue;
-			}
-
-			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(cluster.glyphIndex);
+			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(glyphIndex);
 
 			if (m_glyphTable.contains(glyph.glyphIndex))
 			{
 				continue;
 			}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
 		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
 		{
-			updateTexture();
+			m_atlas.updateTexture();
 		}
 
 		return true;
 	}
-
-	void BitmapGlyphCache::updateTexture()
-	{
-		if (not m_hasDirty)
-		{
-			return;
-		}
-
-		if (m_texture.size() == m_buffer.image.size())
-		{
-			m_texture.fill(m_buffer.image);
-		}
-		else
-		{
-			m_texture = DynamicTexture{ m_buffer.image };
-		}
-
-		m_hasDirty = false;
-	}
 }
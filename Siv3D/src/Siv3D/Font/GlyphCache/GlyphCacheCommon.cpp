@@ -9,10 +9,77 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/HashSet.hpp>
+# include <Siv3D/ArenaAllocator.hpp>
+# include <Siv3D/Scene.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AllocationTracker.hpp>
+# include <Siv3D/Font/IFont.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "GlyphCacheCommon.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 構造体のレイアウトに依存しないよう、グリフキャッシュをフィールドごとに書き込む
+		[[nodiscard]]
+		static bool WriteGlyphCache(BinaryWriter& writer, const GlyphCache& cache)
+		{
+			const GlyphInfo& info = cache.info;
+
+			return (writer.write(info.glyphIndex)
+				&& writer.write(info.buffer)
+				&& writer.write(info.left)
+				&& writer.write(info.top)
+				&& writer.write(info.width)
+				&& writer.write(info.height)
+				&& writer.write(info.ascender)
+				&& writer.write(info.descender)
+				&& writer.write(info.xAdvance)
+				&& writer.write(info.yAdvance)
+				&& writer.write(cache.textureRegionLeft)
+				&& writer.write(cache.textureRegionTop)
+				&& writer.write(cache.textureRegionWidth)
+				&& writer.write(cache.textureRegionHeight)
+				&& writer.write(cache.page));
+		}
+
+		[[nodiscard]]
+		static bool ReadGlyphCache(BinaryReader& reader, GlyphCache& cache)
+		{
+			GlyphInfo& info = cache.info;
+
+			return (reader.read(info.glyphIndex)
+				&& reader.read(info.buffer)
+				&& reader.read(info.left)
+				&& reader.read(info.top)
+				&& reader.read(info.width)
+				&& reader.read(info.height)
+				&& reader.read(info.ascender)
+				&& reader.read(info.descender)
+				&& reader.read(info.xAdvance)
+				&& reader.read(info.yAdvance)
+				&& reader.read(cache.textureRegionLeft)
+				&& reader.read(cache.textureRegionTop)
+				&& reader.read(cache.textureRegionWidth)
+				&& reader.read(cache.textureRegionHeight)
+				&& reader.read(cache.page));
+		}
+
+		// 読み込んだグリフのテクスチャ領域がページの画像の内側にあるかを返す
+		[[nodiscard]]
+		static bool IsInsidePage(const GlyphCache& cache, const Image& image) noexcept
+		{
+			return ((0 <= cache.textureRegionLeft)
+				&& (0 <= cache.textureRegionTop)
+				&& (0 <= cache.textureRegionWidth)
+				&& (0 <= cache.textureRegionHeight)
+				&& ((cache.textureRegionLeft + cache.textureRegionWidth) <= image.width())
+				&& ((cache.textureRegionTop + cache.textureRegionHeight) <= image.height()));
+		}
+	}
+
 	double GetTabAdvance(const double spaceWidth, const double scale, const double baseX, const double currentX, const int32 indentSize)
 	{
 		const double maxTabWidth = (spaceWidth * scale * indentSize);
@@ -47,7 +114,7 @@ namespace s3d
 	}
 
 	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
-		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+		BufferImage& buffer, const uint16 page, HashTable<GlyphIndex, GlyphCache>& glyphTable)
 	{
 		if (not buffer.image)
 		{
@@ -88,12 +155,29 @@ namespace s3d
 
 		image.overwrite(buffer.image, buffer.penPos);
 
+		if (bitmapWidth && bitmapHeight)
+		{
+			const Rect glyphRect{ buffer.penPos, bitmapWidth, bitmapHeight };
+
+			if (buffer.dirtyRect.isEmpty())
+			{
+				buffer.dirtyRect = glyphRect;
+			}
+			else
+			{
+				const Point tl{ Min(buffer.dirtyRect.x, glyphRect.x), Min(buffer.dirtyRect.y, glyphRect.y) };
+				const Point br{ Max(buffer.dirtyRect.rightX(), glyphRect.rightX()), Max(buffer.dirtyRect.bottomY(), glyphRect.bottomY()) };
+				buffer.dirtyRect = Rect{ tl, (br - tl) };
+			}
+		}
+
 		GlyphCache cache;
 		cache.info					= glyphInfo;
 		cache.textureRegionLeft		= static_cast<int16>(buffer.penPos.x);
 		cache.textureRegionTop		= static_cast<int16>(buffer.penPos.y);
 		cache.textureRegionWidth	= static_cast<int16>(bitmapWidth);
 		cache.textureRegionHeight	= static_cast<int16>(bitmapHeight);
+		cache.page					= page;
 		glyphTable.emplace(glyphInfo.glyphIndex, cache);
 
 		buffer.currentMaxHeight = Max(buffer.currentMaxHeight, bitmapHeight);
@@ -101,4 +185,356 @@ namespace s3d
 
 		return true;
 	}
+
+	void UpdateGlyphTexture(DynamicTexture& texture, BufferImage& buffer)
+	{
+		size_t uploadSize = 0;
+
+		if (texture.size() == buffer.image.size())
+		{
+			if (not buffer.dirtyRect.isEmpty())
+			{
+				texture.fillRegion(buffer.image, buffer.dirtyRect);
+				uploadSize = (buffer.dirtyRect.area() * sizeof(Color));
+			}
+		}
+		else
+		{
+			texture = DynamicTexture{ buffer.image };
+			uploadSize = buffer.image.size_bytes();
+		}
+
+		buffer.dirtyRect = Rect::Empty();
+
+		SIV3D_ENGINE(Font)->addTextureUploadSize(uploadSize);
+	}
+
+	GlyphAtlas::GlyphAtlas(const Color& backgroundColor)
+		: m_backgroundColor{ backgroundColor } {}
+
+	void GlyphAtlas::setBufferWidth(const int32 width)
+	{
+		m_bufferWidth = Max(width, 0);
+	}
+
+	int32 GlyphAtlas::getBufferWidth() const noexcept
+	{
+		return m_bufferWidth;
+	}
+
+	void GlyphAtlas::setMemoryBudget(const size_t bytes)
+	{
+		m_memoryBudget = bytes;
+	}
+
+	size_t GlyphAtlas::getMemoryBudget() const noexcept
+	{
+		return m_memoryBudget;
+	}
+
+	Array<GlyphIndex> GlyphAtlas::getUncachedGlyphIndices(const Array<GlyphCluster>& clusters, const HashTable<GlyphIndex, GlyphCache>& glyphTable, const bool isMainFont)
+	{
+		const int32 currentFrame = Scene::FrameCount();
+		Array<GlyphIndex> glyphIndices;
+		HashSet<GlyphIndex, phmap::priv::hash_default_hash<GlyphIndex>, phmap::priv::hash_default_eq<GlyphIndex>, ArenaAllocator<GlyphIndex>> added;
+
+		for (const auto& cluster : clusters)
+		{
+			if (isMainFont && (cluster.fontIndex != 0))
+			{
+				continue;
+			}
+
+			if (auto it = glyphTable.find(cluster.glyphIndex);
+				it != glyphTable.end())
+			{
+				m_pages[it->second.page].lastUsedFrame = currentFrame;
+				continue;
+			}
+
+			if (added.insert(cluster.glyphIndex).second)
+			{
+				glyphIndices << cluster.glyphIndex;
+			}
+		}
+
+		if (glyphIndices)
+		{
+			SIV3D_ENGINE(Font)->addGlyphCacheMisses(glyphIndices.size());
+		}
+
+		return glyphIndices;
+	}
+
+	bool GlyphAtlas::cacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		const int32 currentFrame = Scene::FrameCount();
+
+		if (not m_pages)
+		{
+			addPage();
+		}
+
+		for (;;)
+		{
+			Page& page = m_pages[m_currentPage];
+
+			if (CacheGlyph(font, image, glyphInfo, page.buffer, static_cast<uint16>(m_currentPage), glyphTable))
+			{
+				page.lastUsedFrame = currentFrame;
+				return true;
+			}
+
+			// 空のページにも配置できないグリフ
+			if (page.buffer.penPos.y <= (page.buffer.padding * 3))
+			{
+				return false;
+			}
+
+			if (canAddPage())
+			{
+				addPage();
+				continue;
+			}
+
+			if (const auto pageIndex = findLeastRecentlyUsedPage(currentFrame))
+			{
+				clearPage(*pageIndex, glyphTable);
+				m_currentPage = *pageIndex;
+				continue;
+			}
+
+			return false;
+		}
+	}
+
+	void GlyphAtlas::updateTexture()
+	{
+		for (auto& page : m_pages)
+		{
+			if (page.texture.size() != page.buffer.image.size()
+				|| (not page.buffer.dirtyRect.isEmpty()))
+			{
+				UpdateGlyphTexture(page.texture, page.buffer);
+			}
+		}
+	}
+
+	const Texture& GlyphAtlas::getTexture() const noexcept
+	{
+		if (not m_pages)
+		{
+			return m_emptyTexture;
+		}
+
+		return m_pages.front().texture;
+	}
+
+	TextureRegion GlyphAtlas::getTextureRegion(const GlyphCache& cache) const
+	{
+		return m_pages[cache.page].texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+	}
+
+	size_t GlyphAtlas::num_pages() const noexcept
+	{
+		return m_pages.size();
+	}
+
+	bool GlyphAtlas::canAddPage() const noexcept
+	{
+		if (m_pages.size() >= Largest<uint16>)
+		{
+			return false;
+		}
+
+		const size_t pageWidth = static_cast<size_t>(m_pages.front().buffer.image.width());
+		const size_t pageSize = (pageWidth * BufferImage::MaxImageHeight * sizeof(Color));
+
+		return (((m_pages.size() + 1) * pageSize) <= m_memoryBudget);
+	}
+
+	void GlyphAtlas::addPage()
+	{
+		Page page;
+		page.buffer.backgroundColor = m_backgroundColor;
+		page.buffer.bufferWidth = m_bufferWidth;
+		m_pages << std::move(page);
+		m_currentPage = (m_pages.size() - 1);
+	}
+
+	Optional<size_t> GlyphAtlas::findLeastRecentlyUsedPage(const int32 currentFrame) const
+	{
+		Optional<size_t> result;
+
+		for (size_t i = 0; i < m_pages.size(); ++i)
+		{
+			const int32 lastUsedFrame = m_pages[i].lastUsedFrame;
+
+			if (lastUsedFrame == currentFrame)
+			{
+				continue;
+			}
+
+			if ((not result) || (lastUsedFrame < m_pages[*result].lastUsedFrame))
+			{
+				result = i;
+			}
+		}
+
+		return result;
+	}
+
+	void GlyphAtlas::clearPage(const size_t pageIndex, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		Array<GlyphIndex> evicted;
+
+		for (const auto& [glyphIndex, cache] : glyphTable)
+		{
+			if (cache.page == pageIndex)
+			{
+				evicted << glyphIndex;
+			}
+		}
+
+		for (const auto& glyphIndex : evicted)
+		{
+			glyphTable.erase(glyphIndex);
+		}
+
+		BufferImage& buffer = m_pages[pageIndex].buffer;
+		buffer.image.fill(buffer.backgroundColor);
+		buffer.penPos = { 0, buffer.padding };
+		buffer.currentMaxHeight = 0;
+		buffer.dirtyRect = Rect{ buffer.image.size() };
+
+		LOG_TRACE(U"GlyphAtlas: page {} evicted ({} glyphs)"_fmt(pageIndex, evicted.size()));
+	}
+
+	bool GlyphAtlas::save(BinaryWriter& writer, const HashTable<GlyphIndex, GlyphCache>& glyphTable) const
+	{
+		bool result = writer.write(static_cast<uint32>(m_pages.size()))
+			&& writer.write(static_cast<uint32>(m_currentPage));
+
+		for (const auto& page : m_pages)
+		{
+			const BufferImage& buffer = page.buffer;
+
+			result = result
+				&& writer.write(static_cast<int32>(buffer.image.width()))
+				&& writer.write(static_cast<int32>(buffer.image.height()))
+				&& writer.write(static_cast<int32>(buffer.penPos.x))
+				&& writer.write(static_cast<int32>(buffer.penPos.y))
+				&& writer.write(buffer.currentMaxHeight);
+
+			if (result && buffer.image)
+			{
+				const int64 size = static_cast<int64>(buffer.image.size_bytes());
+				result = (writer.write(buffer.image.data(), size) == size);
+			}
+		}
+
+		result = result && writer.write(static_cast<uint32>(glyphTable.size()));
+
+		for (const auto& [glyphIndex, cache] : glyphTable)
+		{
+			result = result
+				&& writer.write(glyphIndex)
+				&& detail::WriteGlyphCache(writer, cache);
+		}
+
+		return result;
+	}
+
+	bool GlyphAtlas::load(BinaryReader& reader, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		const ScopedAllocationTag allocationTag{ AllocationTag::GlyphCache };
+
+		uint32 pageCount = 0, currentPage = 0;
+
+		if ((not reader.read(pageCount))
+			|| (not reader.read(currentPage))
+			|| (Largest<uint16> < pageCount)
+			|| ((pageCount != 0) && (pageCount <= currentPage)))
+		{
+			return false;
+		}
+
+		Array<Page> pages(pageCount);
+
+		for (auto& page : pages)
+		{
+			BufferImage& buffer = page.buffer;
+			int32 width = 0, height = 0, penX = 0, penY = 0;
+
+			if ((not reader.read(width))
+				|| (not reader.read(height))
+				|| (not reader.read(penX))
+				|| (not reader.read(penY))
+				|| (not reader.read(buffer.currentMaxHeight))
+				|| (not InRange(width, 0, Image::MaxWidth))
+				|| (not InRange(height, 0, BufferImage::MaxImageHeight)))
+			{
+				return false;
+			}
+
+			// ペンの位置はページの内側にある。ただし、ページが最大の高さに達して行を折り返せなかった場合は、下端を行間の分だけ越えていることがある
+			if ((not InRange(penX, 0, Max(width, buffer.padding)))
+				|| (not InRange(penY, 0, (BufferImage::MaxImageHeight + buffer.padding * 2)))
+				|| (not InRange(buffer.currentMaxHeight, 0, height)))
+			{
+				return false;
+			}
+
+			buffer.penPos.set(penX, penY);
+
+			buffer.backgroundColor = m_backgroundColor;
+			buffer.bufferWidth = m_bufferWidth;
+
+			if (width && height)
+			{
+				buffer.image.resize(width, height);
+
+				const int64 size = static_cast<int64>(buffer.image.size_bytes());
+
+				if (reader.read(buffer.image.data(), size) != size)
+				{
+					return false;
+				}
+
+				buffer.dirtyRect = Rect{ buffer.image.size() };
+			}
+		}
+
+		uint32 glyphCount = 0;
+
+		if (not reader.read(glyphCount))
+		{
+			return false;
+		}
+
+		HashTable<GlyphIndex, GlyphCache> table;
+		table.reserve(glyphCount);
+
+		for (uint32 i = 0; i < glyphCount; ++i)
+		{
+			GlyphIndex glyphIndex = 0;
+			GlyphCache cache;
+
+			if ((not reader.read(glyphIndex))
+				|| (not detail::ReadGlyphCache(reader, cache))
+				|| (pageCount <= cache.page)
+				|| (not detail::IsInsidePage(cache, pages[cache.page].buffer.image)))
+			{
+				return false;
+			}
+
+			table.emplace(glyphIndex, cache);
+		}
+
+		m_pages = std::move(pages);
+		m_currentPage = currentPage;
+		glyphTable = std::move(table);
+
+		return true;
+	}
 }
@@ -13,7 +13,11 @@
 # include <Siv3D/Common.hpp>
 # include <Siv3D/GlyphInfo.hpp>
 # include <Siv3D/Image.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/DynamicTexture.hpp>
 # include <Siv3D/HashTable.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/BinaryWriter.hpp>
 # include <Siv3D/Char.hpp>
 # include "../FontData.hpp"
 
@@ -30,6 +34,9 @@ namespace s3d
 		int16 textureRegionWidth = 0;
 
 		int16 textureRegionHeight = 0;
+
+		// グリフが配置されているアトラスのページ
+		uint16 page = 0;
 	};
 
 	struct BufferImage
@@ -47,6 +54,9 @@ namespace s3d
 		Point penPos = { 0, padding };
 
 		int32 currentMaxHeight = 0;
+
+		// 前回テクスチャに転送してから変更された範囲
+		Rect dirtyRect = Rect::Empty();
 	};
 
 	[[nodiscard]]
@@ -57,5 +67,94 @@ namespace s3d
 
 	[[nodiscard]]
 	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
-		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+		BufferImage& buffer, uint16 page, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	/// @brief バッファの変更された範囲をテクスチャに転送します。
+	/// @remark バッファのサイズが変わった場合は、テクスチャを作り直します。
+	void UpdateGlyphTexture(DynamicTexture& texture, BufferImage& buffer);
+
+	/// @brief 複数のページからなるグリフのアトラス
+	/// @remark ページが埋まると新しいページを追加します。メモリの予算内でページを追加できない場合は、最も長い間使われていないページを空にして再利用します。
+	/// @remark 現在のフレームで使われたページは空にしません。
+	class GlyphAtlas
+	{
+	public:
+
+		/// @brief デフォルトのメモリの予算（バイト）
+		static constexpr size_t DefaultMemoryBudget = (128 * 1024 * 1024);
+
+		explicit GlyphAtlas(const Color& backgroundColor);
+
+		void setBufferWidth(int32 width);
+
+		[[nodiscard]]
+		int32 getBufferWidth() const noexcept;
+
+		void setMemoryBudget(size_t bytes);
+
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept;
+
+		/// @brief クラスタのうち、まだキャッシュされていないグリフのインデックスを、重複を除いて出現順に返します。
+		/// @remark キャッシュ済みのグリフがあるページは、現在のフレームで使われたものとして記録されます。
+		[[nodiscard]]
+		Array<GlyphIndex> getUncachedGlyphIndices(const Array<GlyphCluster>& clusters, const HashTable<GlyphIndex, GlyphCache>& glyphTable, bool isMainFont);
+
+		/// @brief グリフの画像をアトラスに追加します。
+		/// @remark ページを空にした場合は、そのページにあったグリフを glyphTable から削除します。
+		[[nodiscard]]
+		bool cacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+		void updateTexture();
+
+		/// @brief 最初のページのテクスチャを返します。
+		[[nodiscard]]
+		const Texture& getTexture() const noexcept;
+
+		[[nodiscard]]
+		TextureRegion getTextureRegion(const GlyphCache& cache) const;
+
+		[[nodiscard]]
+		size_t num_pages() const noexcept;
+
+		/// @brief アトラスの画像とグリフの配置をファイルに書き込みます。
+		bool save(BinaryWriter& writer, const HashTable<GlyphIndex, GlyphCache>& glyphTable) const;
+
+		/// @brief save() で書き込んだアトラスの画像とグリフの配置を読み込みます。
+		/// @remark 読み込みに成功した場合、現在のアトラスと glyphTable の内容は置き換えられます。
+		bool load(BinaryReader& reader, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	private:
+
+		struct Page
+		{
+			BufferImage buffer;
+
+			DynamicTexture texture;
+
+			// ページのグリフが最後に使われたフレーム
+			int32 lastUsedFrame = 0;
+		};
+
+		Array<Page> m_pages;
+
+		DynamicTexture m_emptyTexture;
+
+		Color m_backgroundColor;
+
+		int32 m_bufferWidth = 2;
+
+		size_t m_memoryBudget = DefaultMemoryBudget;
+
+		size_t m_currentPage = 0;
+
+		bool canAddPage() const noexcept;
+
+		void addPage();
+
+		[[nodiscard]]
+		Optional<size_t> findLeastRecentlyUsedPage(int32 currentFrame) const;
+
+		void clearPage(size_t pageIndex, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+	};
 }
@@ -14,6 +14,8 @@
 # include <Siv3D/2DShapes.hpp>
 # include <Siv3D/Texture.hpp>
 # include <Siv3D/Font.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/BinaryWriter.hpp>
 # include "../FontData.hpp"
 
 namespace s3d
@@ -56,5 +58,14 @@ namespace s3d
 
 		[[nodiscard]]
 		virtual int32 getBufferThickness(GlyphIndex glyphIndex) = 0;
+
+		virtual void setMemoryBudget(size_t bytes) = 0;
+
+		[[nodiscard]]
+		virtual size_t getMemoryBudget() const noexcept = 0;
+
+		virtual bool save(BinaryWriter& writer) const = 0;
+
+		virtual bool load(BinaryReader& reader) = 0;
 	};
 }
@@ -12,6 +12,9 @@
 # include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/MSDFGlyph.hpp>
 # include <Siv3D/System.hpp>
+# include <Siv3D/TraceRecorder.hpp>
+# include <Siv3D/AllocationTracker.hpp>
+# include <Siv3D/ArenaAllocator.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "MSDFGlyphCache.hpp"
@@ -24,7 +27,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -65,7 +68,7 @@ namespace s3d
 
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -103,7 +106,7 @@ namespace s3d
 		{
 			// do tnohing
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const double dotXAdvance = m_glyphTable.find(dotGlyphCluster[0].glyphIndex)->second.info.xAdvance;
 		const Vec2 areaBottomRight = area.br();
@@ -120,10 +123,11 @@ namespace s3d
 		const int32 maxLines = Max(static_cast<int32>(area.h / (lineHeight ? lineHeight : 1)), 1);
 		const Vec2 basePos{ area.pos };
 
-		Array<Vec2> penPositions;
+		// 描画中にだけ使う一時的な配列は、フレームアリーナから確保する
+		Array<Vec2, ArenaAllocator<Vec2>> penPositions;
 		size_t clusterIndex = 0;
 		{
-			Array<double> xAdvances(Arg::reserve = clusters.size());
+			Array<double, ArenaAllocator<double>> xAdvances(Arg::reserve = clusters.size());
 			Vec2 penPos{ basePos };
 			int32 lineIndex = 0;
 			double currentLineWidth = 0.0;
@@ -202,13 +206,13 @@ namespace s3d
 		}
 
 		String newText;
-		Array<GlyphCluster> newClusters;
-		Array<Vec2> newPenPositions;
+		Array<GlyphCluster, ArenaAllocator<GlyphCluster>> newClusters;
+		Array<Vec2, ArenaAllocator<Vec2>> newPenPositions;
 
 		if (clusterIndex == clusters.size())
 		{
 			newText = s;
-			newClusters = clusters;
+			newClusters.assign(clusters.begin(), clusters.end());
 			newPenPositions = std::move(penPositions);
 		}
 		else
@@ -218,7 +222,7 @@ namespace s3d
 			newText.append(v);
 			newText.append(U"...");
 
-			newClusters = clusters.take(clusterIndex);
+			newClusters.assign(clusters.begin(), (clusters.begin() + clusterIndex));
 
 			newClusters.push_back(dotGlyphCluster.front());
 			newClusters.back().pos = (newText.size() - 3);
@@ -255,7 +259,7 @@ namespace s3d
 			{
 				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -283,7 +287,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -296,7 +300,7 @@ namespace s3d
 		{
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 				RectF rect;
@@ -470,12 +474,12 @@ namespace s3d
 
 	void MSDFGlyphCache::setBufferWidth(const int32 width)
 	{
-		m_buffer.bufferWidth = Max(width, 0);
+		m_atlas.setBufferWidth(width);
 	}
 
 	int32 MSDFGlyphCache::getBufferWidth() const noexcept
 	{
-		return m_buffer.bufferWidth;
+		return m_atlas.getBufferWidth();
 	}
 
 	bool MSDFGlyphCache::preload(const FontData& font, const StringView s)
@@ -485,9 +489,9 @@ namespace s3d
 
 	const Texture& MSDFGlyphCache::getTexture() noexcept
 	{
-		updateTexture();
+		m_atlas.updateTexture();
 
-		return m_texture;
+		return m_atlas.getTexture();
 	}
 
 	TextureRegion MSDFGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
@@ -496,10 +500,10 @@ namespace s3d
 		{
 			return{};
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		return m_atlas.getTextureRegion(cache);
 	}
 
 	int32 MSDFGlyphCache::getBufferThickness(const GlyphIndex glyphIndex)
@@ -513,72 +517,64 @@ namespace s3d
 		return 0;
 	}
 
-	bool MSDFGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
+	void MSDFGlyphCache::setMemoryBudget(const size_t bytes)
 	{
-		if (m_glyphTable.empty())
-		{
-			const MSDFGlyph glyph = font.renderMSDFByGlyphIndex(0, m_buffer.bufferWidth);
+		m_atlas.setMemoryBudget(bytes);
+	}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
-			{
-				return false;
-			}
+	size_t MSDFGlyphCache::getMemoryBudget() const noexcept
+	{
+		return m_atlas.getMemoryBudget();
+	}
 
-			m_hasDirty = true;
-		}
+	bool MSDFGlyphCache::save(BinaryWriter& writer) const
+	{
+		return m_atlas.save(writer, m_glyphTable);
+	}
 
-		for (const auto& cluster : clusters)
+	bool MSDFGlyphCache::load(BinaryReader& reader)
+	{
+		return m_atlas.load(reader, m_glyphTable);
+	}
+
+	bool MSDFGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
+	{
+		SIV3D_TRACE_ZONE(U"GlyphCache::prerender");
+
+		const ScopedAllocationTag allocationTag{ AllocationTag::GlyphCache };
+
+		if (not m_glyphTable.contains(0))
 		{
-			if (isMainFont && (cluster.fontIndex != 0))
-			{
-				continue;
-			}
+			const MSDFGlyph glyph = font.renderMSDFByGlyphIndex(0, m_atlas.getBufferWidth());
 
-			if (m_glyphTable.contains(cluster.glyphIndex))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
-				continue;
+				return false;
 			}
+		}
 
-			const MSDFGlyph glyph = font.renderMSDFByGlyphIndex(cluster.glyphIndex, m_buffer.bufferWidth);
+		const Array<GlyphIndex> glyphIndices = m_atlas.getUncachedGlyphIndices(clusters, m_glyphTable, isMainFont);
 
+		// 距離場の生成はワーカースレッドで並列に行い、アトラスへの配置は順番に行う
+		for (const auto& glyph : font.renderMSDFsByGlyphIndices(glyphIndices, m_atlas.getBufferWidth()))
+		{
 			if (m_glyphTable.contains(glyph.glyphIndex))
 			{
 				continue;
 			}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
 		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
 		{
-			updateTexture();
+			m_atlas.updateTexture();
 		}
 
 		return true;
 	}
-
-	void MSDFGlyphCache::updateTexture()
-	{
-		if (not m_hasDirty)
-		{
-			return;
-		}
-
-		if (m_texture.size() == m_buffer.image.size())
-		{
-			m_texture.fill(m_buffer.image);
-		}
-		else
-		{
-			m_texture = DynamicTexture{ m_buffer.image };
-		}
-
-		m_hasDirty = false;
-	}
 }
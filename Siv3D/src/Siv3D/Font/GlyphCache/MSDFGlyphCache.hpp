@@ -59,21 +59,24 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
+		void setMemoryBudget(size_t bytes) override;
+
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept override;
+
+		bool save(BinaryWriter& writer) const override;
+
+		bool load(BinaryReader& reader) override;
+
 	private:
 
 		static constexpr int32 DefaultBuffer = 2;
 
 		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
 
-		DynamicTexture m_texture;
-
-		bool m_hasDirty = false;
-
-		BufferImage m_buffer = { .image = {}, .backgroundColor = Color{ 0, 0 } };
+		GlyphAtlas m_atlas{ Color{ 0, 0 } };
 
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
-
-		void updateTexture();
 	};
 }
@@ -59,19 +59,22 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
-	private:
+		void setMemoryBudget(size_t bytes) override;
 
-		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept override;
+
+		bool save(BinaryWriter& writer) const override;
 
-		DynamicTexture m_texture;
+		bool load(BinaryReader& reader) override;
 
-		bool m_hasDirty = false;
+	private:
+
+		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
 
-		BufferImage m_buffer = {};
+		GlyphAtlas m_atlas{ Color{ 0, 0 } };
 	
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
-
-		void updateTexture();
 	};
 }
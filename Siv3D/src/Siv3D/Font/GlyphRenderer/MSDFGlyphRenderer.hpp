@@ -11,6 +11,7 @@
 
 # pragma once
 # include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
 # include <Siv3D/MSDFGlyph.hpp>
 
 struct FT_FaceRec_;
@@ -22,4 +23,9 @@ namespace s3d
 
 	[[nodiscard]]
 	MSDFGlyph RenderMSDFGlyph(FT_Face face, GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop);
+
+	/// @brief 複数のグリフのMSDFをまとめて生成します。
+	/// @remark アウトラインの取得は呼び出し元のスレッドで、距離場の生成はワーカースレッドで並列に行います。
+	[[nodiscard]]
+	Array<MSDFGlyph> RenderMSDFGlyphs(FT_Face face, const Array<GlyphIndex>& glyphIndices, int32 buffer, const FontFaceProperty& prop);
 }
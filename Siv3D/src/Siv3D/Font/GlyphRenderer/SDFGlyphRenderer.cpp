@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/Threading.hpp>
 # include "GlyphRenderer.hpp"
 # include "SDFGlyphRenderer.hpp"
 # include "../FreeType.hpp"
@@ -135,43 +136,97 @@ namespace s3d
 
 			return image;
 		}
+
+		struct SDFShape
+		{
+			msdfgen::Shape shape;
+
+			Vec2 offset{ 0, 0 };
+		};
+
+		// FT_Face を使うため、スレッドセーフではない
+		[[nodiscard]]
+		static bool LoadSDFShape(FT_Face face, const GlyphIndex glyphIndex, const int32 buffer, const FontFaceProperty& prop, SDFGlyph& result, SDFShape& shape)
+		{
+			if (not LoadOutlineGlyph(face, glyphIndex, prop.style))
+			{
+				return false;
+			}
+
+			if (not GetShape(face, shape.shape))
+			{
+				return false;
+			}
+
+			const GlyphBBox bbox = GetBound(shape.shape);
+			shape.offset.set((-bbox.xMin + buffer), (-bbox.yMin + buffer));
+
+			result.glyphIndex	= glyphIndex;
+			result.buffer		= buffer;
+			result.left			= static_cast<int16>(bbox.xMin);
+			result.top			= static_cast<int16>(bbox.yMax);
+			result.width		= static_cast<int16>(bbox.xMax - bbox.xMin);
+			result.height		= static_cast<int16>(bbox.yMax - bbox.yMin);
+			result.xAdvance		= (face->glyph->metrics.horiAdvance / 64.0);
+			result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
+			result.ascender		= prop.ascender;
+			result.descender	= prop.descender;
+			return true;
+		}
+
+		// 距離場の生成。異なる Shape であれば複数のスレッドで同時に実行できる
+		static void GenerateSDFImage(const SDFShape& shape, SDFGlyph& result)
+		{
+			const int32 buffer = result.buffer;
+
+			msdfgen::Bitmap<float, 1> bitmap{ (result.width + (2 * buffer)), (result.height + (2 * buffer)) };
+			msdfgen::generateSDF(bitmap, shape.shape, 8.0, 1.0, msdfgen::Vector2(shape.offset.x, shape.offset.y));
+
+			result.image = RenderMSDF(bitmap);
+		}
 	}
 
 	SDFGlyph RenderSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
 	{
-		if (not LoadOutlineGlyph(face, glyphIndex, prop.style))
+		buffer = Max(buffer, 0);
+
+		SDFGlyph result;
+		detail::SDFShape shape;
+
+		if (not detail::LoadSDFShape(face, glyphIndex, buffer, prop, result, shape))
 		{
 			return{};
 		}
 
+		detail::GenerateSDFImage(shape, result);
+		return result;
+	}
+
+	Array<SDFGlyph> RenderSDFGlyphs(FT_Face face, const Array<GlyphIndex>& glyphIndices, int32 buffer, const FontFaceProperty& prop)
+	{
 		buffer = Max(buffer, 0);
 
-		msdfgen::Shape shape;	
-		if (not detail::GetShape(face, shape))
+		Array<SDFGlyph> results(glyphIndices.size());
+		Array<detail::SDFShape> shapes(glyphIndices.size());
+		Array<size_t> loaded(Arg::reserve = glyphIndices.size());
+
+		// アウトラインの取得は FT_Face を共有するため、呼び出し元のスレッドで順に行う
+		for (size_t i = 0; i < glyphIndices.size(); ++i)
 		{
-			return{};
+			if (detail::LoadSDFShape(face, glyphIndices[i], buffer, prop, results[i], shapes[i]))
+			{
+				loaded << i;
+			}
 		}
 
-		const GlyphBBox bbox	= detail::GetBound(shape);
-		const int32 width		= static_cast<int32>(bbox.xMax - bbox.xMin);
-		const int32 height		= static_cast<int32>(bbox.yMax - bbox.yMin);
-		const Vec2 offset{ (-bbox.xMin+ buffer), (-bbox.yMin + buffer) };
-
-		msdfgen::Bitmap<float, 1> bitmap{ (width + (2 * buffer)), (height + (2 * buffer)) };
-		msdfgen::generateSDF(bitmap, shape, 8.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
+		Threading::ParallelFor(loaded.size(), [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					detail::GenerateSDFImage(shapes[loaded[i]], results[loaded[i]]);
+				}
+			});
 
-		SDFGlyph result;
-		result.glyphIndex	= glyphIndex;
-		result.buffer		= buffer;
-		result.left			= static_cast<int16>(bbox.xMin);
-		result.top			= static_cast<int16>(bbox.yMax);
-		result.width		= static_cast<int16>(width);
-		result.height		= static_cast<int16>(height);
-		result.xAdvance		= (face->glyph->metrics.horiAdvance / 64.0);
-		result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
-		result.ascender		= prop.ascender;
-		result.descender	= prop.descender;
-		result.image		= detail::RenderMSDF(bitmap);
-		return result;
+		return results;
 	}
 }
@@ -30,6 +30,21 @@ namespace s3d
 
 		virtual size_t getFontCount() const = 0;
 
+		virtual void addTextureUploadSize(size_t size) = 0;
+
+		/// @brief 前回の呼び出し以降にグリフのテクスチャへ転送したデータのサイズを返し、カウンタを 0 に戻します。
+		virtual size_t resetTextureUploadSize() = 0;
+
+		virtual void addShapingCacheResult(bool hit) = 0;
+
+		/// @brief 前回の呼び出し以降のシェーピングキャッシュのヒット数とミス数を返し、カウンタを 0 に戻します。
+		virtual std::pair<size_t, size_t> resetShapingCacheStats() = 0;
+
+		virtual void addGlyphCacheMisses(size_t count) = 0;
+
+		/// @brief 前回の呼び出し以降に新たにレンダリングしたグリフの個数を返し、カウンタを 0 に戻します。
+		virtual size_t resetGlyphCacheMisses() = 0;
+
 		virtual Font::IDType create(FilePathView path, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style) = 0;
 
 		virtual Font::IDType create(Typeface typeface, FontMethod fontMethod, int32 fontSize, FontStyle style) = 0;
@@ -48,6 +63,14 @@ namespace s3d
 
 		virtual int32 getBufferThickness(Font::IDType handleID) = 0;
 
+		virtual void setGlyphCacheMemoryBudget(Font::IDType handleID, size_t bytes) = 0;
+
+		virtual size_t getGlyphCacheMemoryBudget(Font::IDType handleID) = 0;
+
+		virtual void setShapingCacheCapacity(Font::IDType handleID, size_t capacity) = 0;
+
+		virtual size_t getShapingCacheCapacity(Font::IDType handleID) = 0;
+
 		virtual bool hasGlyph(Font::IDType handleID, StringView ch) = 0;
 
 		virtual GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) = 0;
@@ -84,6 +107,10 @@ namespace s3d
 
 		virtual bool preload(Font::IDType handleID, StringView chars) = 0;
 
+		virtual bool saveGlyphCache(Font::IDType handleID, FilePathView path) = 0;
+
+		virtual bool loadGlyphCache(Font::IDType handleID, FilePathView path) = 0;
+
 		virtual const Texture& getTexture(Font::IDType handleID) = 0;
 
 		virtual Glyph getGlyph(Font::IDType handleID, StringView ch) = 0;
@@ -0,0 +1,111 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Hash.hpp>
+# include "ShapingCache.hpp"
+
+namespace s3d
+{
+	const Array<GlyphCluster>* ShapingCache::find(const StringView s, const bool recursive, const Ligature ligature, const size_t fallbackCount)
+	{
+		if (m_capacity == 0)
+		{
+			return nullptr;
+		}
+
+		const size_t hash = MakeHash(s, recursive, ligature, fallbackCount);
+
+		auto it = m_table.find(hash);
+
+		if (it == m_table.end())
+		{
+			return nullptr;
+		}
+
+		const Entry& entry = *(it->second);
+
+		// ハッシュ値の衝突
+		if ((entry.recursive != recursive)
+			|| (entry.ligature != ligature.getBool())
+			|| (entry.fallbackCount != fallbackCount)
+			|| (entry.text != s))
+		{
+			return nullptr;
+		}
+
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+		return &m_entries.front().clusters;
+	}
+
+	void ShapingCache::insert(const StringView s, const bool recursive, const Ligature ligature, const size_t fallbackCount, const Array<GlyphCluster>& clusters)
+	{
+		if (m_capacity == 0)
+		{
+			return;
+		}
+
+		const size_t hash = MakeHash(s, recursive, ligature, fallbackCount);
+
+		if (auto it = m_table.find(hash);
+			it != m_table.end())
+		{
+			m_entries.erase(it->second);
+			m_table.erase(it);
+		}
+
+		m_entries.push_front(Entry{ hash, String{ s }, recursive, ligature.getBool(), fallbackCount, clusters });
+		m_table.emplace(hash, m_entries.begin());
+
+		shrinkToCapacity();
+	}
+
+	void ShapingCache::clear()
+	{
+		m_entries.clear();
+		m_table.clear();
+	}
+
+	void ShapingCache::setCapacity(const size_t capacity)
+	{
+		m_capacity = capacity;
+
+		shrinkToCapacity();
+	}
+
+	size_t ShapingCache::getCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	size_t ShapingCache::size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+	size_t ShapingCache::MakeHash(const StringView s, const bool recursive, const Ligature ligature, const size_t fallbackCount) noexcept
+	{
+		size_t hash = static_cast<size_t>(Hash::XXHash3(s.data(), s.size_bytes()));
+		Hash::Combine(hash, recursive);
+		Hash::Combine(hash, ligature.getBool());
+		Hash::Combine(hash, fallbackCount);
+		return hash;
+	}
+
+	void ShapingCache::shrinkToCapacity()
+	{
+		while (m_capacity < m_entries.size())
+		{
+			m_table.erase(m_entries.back().hash);
+			m_entries.pop_back();
+		}
+	}
+}
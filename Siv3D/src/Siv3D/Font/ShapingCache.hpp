@@ -0,0 +1,82 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <list>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/GlyphCluster.hpp>
+# include <Siv3D/PredefinedYesNo.hpp>
+
+namespace s3d
+{
+	/// @brief 文字列のシェーピング結果を保存する LRU キャッシュ
+	class ShapingCache
+	{
+	public:
+
+		/// @brief デフォルトの最大エントリ数
+		static constexpr size_t DefaultCapacity = 4096;
+
+		/// @brief キャッシュされたシェーピング結果を探します。
+		/// @param s 文字列
+		/// @param recursive フォールバックフォントを使うか
+		/// @param ligature リガチャを使うか
+		/// @param fallbackCount 有効なフォールバックフォントの個数
+		/// @return シェーピング結果。見つからなかった場合は nullptr
+		[[nodiscard]]
+		const Array<GlyphCluster>* find(StringView s, bool recursive, Ligature ligature, size_t fallbackCount);
+
+		/// @brief シェーピング結果を追加します。
+		/// @remark 最大エントリ数を超える場合は、最も長い間使われていないエントリを削除します。
+		void insert(StringView s, bool recursive, Ligature ligature, size_t fallbackCount, const Array<GlyphCluster>& clusters);
+
+		void clear();
+
+		void setCapacity(size_t capacity);
+
+		[[nodiscard]]
+		size_t getCapacity() const noexcept;
+
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+	private:
+
+		struct Entry
+		{
+			size_t hash = 0;
+
+			String text;
+
+			bool recursive = false;
+
+			bool ligature = true;
+
+			size_t fallbackCount = 0;
+
+			Array<GlyphCluster> clusters;
+		};
+
+		// 先頭ほど最近使われたエントリ
+		std::list<Entry> m_entries;
+
+		HashTable<size_t, std::list<Entry>::iterator> m_table;
+
+		size_t m_capacity = DefaultCapacity;
+
+		[[nodiscard]]
+		static size_t MakeHash(StringView s, bool recursive, Ligature ligature, size_t fallbackCount) noexcept;
+
+		void shrinkToCapacity();
+	};
+}
@@ -230,6 +230,30 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->getBufferThickness(m_handle->id());
 	}
 
+	const Font& Font::setGlyphCacheMemoryBudget(const size_t bytes) const
+	{
+		SIV3D_ENGINE(Font)->setGlyphCacheMemoryBudget(m_handle->id(), bytes);
+
+		return *this;
+	}
+
+	size_t Font::getGlyphCacheMemoryBudget() const
+	{
+		return SIV3D_ENGINE(Font)->getGlyphCacheMemoryBudget(m_handle->id());
+	}
+
+	const Font& Font::setShapingCacheCapacity(const size_t capacity) const
+	{
+		SIV3D_ENGINE(Font)->setShapingCacheCapacity(m_handle->id(), capacity);
+
+		return *this;
+	}
+
+	size_t Font::getShapingCacheCapacity() const
+	{
+		return SIV3D_ENGINE(Font)->getShapingCacheCapacity(m_handle->id());
+	}
+
 	bool Font::hasGlyph(const char32 ch) const
 	{
 		return SIV3D_ENGINE(Font)->hasGlyph(m_handle->id(), StringView(&ch, 1));
@@ -393,6 +417,16 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->preload(m_handle->id(), chars);
 	}
 
+	bool Font::saveGlyphCache(const FilePathView path) const
+	{
+		return SIV3D_ENGINE(Font)->saveGlyphCache(m_handle->id(), path);
+	}
+
+	bool Font::loadGlyphCache(const FilePathView path) const
+	{
+		return SIV3D_ENGINE(Font)->loadGlyphCache(m_handle->id(), path);
+	}
+
 	const Texture& Font::getTexture() const
 	{
 		return SIV3D_ENGINE(Font)->getTexture(m_handle->id());
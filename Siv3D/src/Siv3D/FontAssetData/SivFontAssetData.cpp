@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/FontAssetData.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 
 namespace s3d
 {
@@ -32,6 +33,8 @@ namespace s3d
 
 	bool FontAssetData::load(const String& hint)
 	{
+		SIV3D_TRACE_ZONE(U"FontAsset::load");
+
 		if (isUninitialized())
 		{
 			if (onLoad(*this, hint))
@@ -62,6 +65,8 @@ namespace s3d
 
 			m_task = Async([this, hint = hint]()
 				{
+					SIV3D_TRACE_ZONE(U"FontAsset::loadAsync");
+
 					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
 				});
 		}
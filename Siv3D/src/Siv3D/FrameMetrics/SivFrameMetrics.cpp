@@ -0,0 +1,37 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/FrameMetrics.hpp>
+# include <Siv3D/Print.hpp>
+# include <Siv3D/AllocationTracker.hpp>
+
+namespace s3d
+{
+	void FrameMetrics::print() const
+	{
+		Print << U"Frame\t\t\t" << frameCount;
+		Print << U"Update / Draw / Present\t{:.2f} / {:.2f} / {:.2f} ms"_fmt((updateTime.count() * 1000.0), (drawTime.count() * 1000.0), (presentTime.count() * 1000.0));
+		Print << U"Draw calls\t\t\t" << drawCalls;
+		Print << U"Triangle count\t\t" << triangleCount;
+		Print << U"Vertex / Index bytes\t" << vertexBytes << U" / " << indexBytes;
+		Print << U"State changes\t\t" << stateChanges;
+		Print << U"Texture upload\t\t" << textureUploadBytes << U" bytes";
+
+		if (AllocationTracker::IsAvailable())
+		{
+			Print << U"Heap allocations\t\t" << heapAllocations << U" (" << heapAllocatedBytes << U" bytes)";
+			Print << U"Heap deallocations\t\t" << heapDeallocations << U" (" << heapDeallocatedBytes << U" bytes)";
+		}
+
+		Print << U"Frame arena\t\t" << arenaBytes << U" bytes";
+		Print << U"Glyph cache misses\t" << glyphCacheMisses;
+	}
+}
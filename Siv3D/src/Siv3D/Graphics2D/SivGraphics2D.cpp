@@ -136,6 +136,36 @@ namespace s3d
 			SIV3D_ENGINE(Renderer2D)->addNullVertices(count * 3);
 		}
 
+		void DrawRects(const Array<RectF>& rects, const ColorF& color)
+		{
+			SIV3D_ENGINE(Renderer2D)->addRects(rects.data(), &color, rects.size(), true);
+		}
+
+		void DrawRects(const Array<RectF>& rects, const Array<ColorF>& colors)
+		{
+			if (rects.size() != colors.size())
+			{
+				return;
+			}
+
+			SIV3D_ENGINE(Renderer2D)->addRects(rects.data(), colors.data(), rects.size(), false);
+		}
+
+		void DrawCircles(const Array<Circle>& circles, const ColorF& color)
+		{
+			SIV3D_ENGINE(Renderer2D)->addCircles(circles.data(), &color, circles.size(), true);
+		}
+
+		void DrawCircles(const Array<Circle>& circles, const Array<ColorF>& colors)
+		{
+			if (circles.size() != colors.size())
+			{
+				return;
+			}
+
+			SIV3D_ENGINE(Renderer2D)->addCircles(circles.data(), colors.data(), circles.size(), false);
+		}
+
 		void SetSDFParameters(const TextStyle& textStyle)
 		{
 			Float4 param = textStyle.param;
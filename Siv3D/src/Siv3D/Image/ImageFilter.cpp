@@ -0,0 +1,936 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/CPUInfo.hpp>
+# include <Siv3D/SIMD.hpp>
+# include "ImageFilter.hpp"
+
+# if SIV3D_IMAGE_FILTER_AVX2
+
+	# include <immintrin.h>
+
+	# if defined(_MSC_VER) && !defined(__clang__)
+		# define SIV3D_TARGET_AVX2
+	# else
+		# define SIV3D_TARGET_AVX2 __attribute__((target("avx2")))
+	# endif
+
+# endif
+
+namespace s3d
+{
+	namespace ImageFilter
+	{
+		////////////////////////////////////////////////////////////////
+		//
+		//	Reference
+		//
+		////////////////////////////////////////////////////////////////
+
+		void Negate_Reference(Color* p, const size_t count)
+		{
+			const Color* const pEnd = (p + count);
+
+			while (p != pEnd)
+			{
+				*p = ~*p;
+				++p;
+			}
+		}
+
+		void Grayscale_Reference(Color* p, const size_t count)
+		{
+			const Color* const pEnd = (p + count);
+
+			while (p != pEnd)
+			{
+				const uint8 gray = p->grayscale0_255();
+				p->r = gray;
+				p->g = gray;
+				p->b = gray;
+				++p;
+			}
+		}
+
+		void Sepia_Reference(Color* p, const size_t count)
+		{
+			const Color* const pEnd = (p + count);
+
+			while (p != pEnd)
+			{
+				const double tr = Min(((0.393 * p->r) + (0.769 * p->g) + (0.189 * p->b)), 255.0);
+				const double tg = Min(((0.349 * p->r) + (0.686 * p->g) + (0.168 * p->b)), 255.0);
+				const double tb = Min(((0.272 * p->r) + (0.534 * p->g) + (0.131 * p->b)), 255.0);
+
+				p->r = static_cast<uint8>(tr);
+				p->g = static_cast<uint8>(tg);
+				p->b = static_cast<uint8>(tb);
+				++p;
+			}
+		}
+
+		void Brighten_Reference(Color* p, const size_t count, const int32 level)
+		{
+			const Color* const pEnd = (p + count);
+
+			if (level < 0)
+			{
+				while (p != pEnd)
+				{
+					p->r = static_cast<uint8>(Max(static_cast<int32>(p->r) + level, 0));
+					p->g = static_cast<uint8>(Max(static_cast<int32>(p->g) + level, 0));
+					p->b = static_cast<uint8>(Max(static_cast<int32>(p->b) + level, 0));
+					++p;
+				}
+			}
+			else
+			{
+				while (p != pEnd)
+				{
+					p->r = static_cast<uint8>(Min(static_cast<int32>(p->r) + level, 255));
+					p->g = static_cast<uint8>(Min(static_cast<int32>(p->g) + level, 255));
+					p->b = static_cast<uint8>(Min(static_cast<int32>(p->b) + level, 255));
+					++p;
+				}
+			}
+		}
+
+		void Threshold_Reference(Color* p, const size_t count, const uint8 threshold, const bool invertColor)
+		{
+			const Color* const pEnd = (p + count);
+			const double thresholdF = (threshold / 255.0);
+			const uint8 above = (invertColor ? 0 : 255);
+			const uint8 below = (invertColor ? 255 : 0);
+
+			while (p != pEnd)
+			{
+				if (thresholdF < p->grayscale())
+				{
+					p->setRGB(above);
+				}
+				else
+				{
+					p->setRGB(below);
+				}
+
+				++p;
+			}
+		}
+
+		void SwapRB_Reference(Color* p, const size_t count)
+		{
+			const Color* const pEnd = (p + count);
+
+			while (p != pEnd)
+			{
+				const uint8 t = p->r;
+				p->r = p->b;
+				p->b = t;
+				++p;
+			}
+		}
+
+		void Reverse_Reference(Color* p, const size_t count)
+		{
+			std::reverse(p, (p + count));
+		}
+
+		void ReverseCopy_Reference(const Color* pSrc, Color* pDst, const size_t count)
+		{
+			std::reverse_copy(pSrc, (pSrc + count), pDst);
+		}
+
+		// [xBegin, xEnd) × [yBegin, yEnd) の範囲を時計回りに 90° 回転してコピーする
+		static void Rotate90_Reference(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight,
+			const size_t xBegin, const size_t xEnd, const size_t yBegin, const size_t yEnd)
+		{
+			for (size_t y = yBegin; y < yEnd; ++y)
+			{
+				const Color* pSrcLine = (pSrc + y * srcWidth);
+				Color* pDstColumn = (pDst + (srcHeight - y - 1));
+
+				for (size_t x = xBegin; x < xEnd; ++x)
+				{
+					pDstColumn[x * srcHeight] = pSrcLine[x];
+				}
+			}
+		}
+
+		// [xBegin, xEnd) × [yBegin, yEnd) の範囲を時計回りに 270° 回転してコピーする
+		static void Rotate270_Reference(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight,
+			const size_t xBegin, const size_t xEnd, const size_t yBegin, const size_t yEnd)
+		{
+			for (size_t y = yBegin; y < yEnd; ++y)
+			{
+				const Color* pSrcLine = (pSrc + y * srcWidth);
+				Color* pDstColumn = (pDst + y);
+
+				for (size_t x = xBegin; x < xEnd; ++x)
+				{
+					pDstColumn[(srcWidth - x - 1) * srcHeight] = pSrcLine[x];
+				}
+			}
+		}
+
+		void Rotate90_Reference(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+			Rotate90_Reference(pSrc, pDst, srcWidth, srcHeight, 0, srcWidth, 0, srcHeight);
+		}
+
+		void Rotate270_Reference(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+			Rotate270_Reference(pSrc, pDst, srcWidth, srcHeight, 0, srcWidth, 0, srcHeight);
+		}
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	SSE4.1
+		//
+		////////////////////////////////////////////////////////////////
+
+		namespace simd
+		{
+			// Reference と同じ結果を得るため、重み付き和は double で計算する
+			struct WeightedSum4
+			{
+				__m128d lo;
+
+				__m128d hi;
+			};
+
+			[[nodiscard]]
+			inline __m128d WeightedSum2(const __m128i r, const __m128i g, const __m128i b, const __m128d wr, const __m128d wg, const __m128d wb)
+			{
+				const __m128d tr = ::_mm_mul_pd(wr, ::_mm_cvtepi32_pd(r));
+				const __m128d tg = ::_mm_mul_pd(wg, ::_mm_cvtepi32_pd(g));
+				const __m128d tb = ::_mm_mul_pd(wb, ::_mm_cvtepi32_pd(b));
+				return ::_mm_add_pd(::_mm_add_pd(tr, tg), tb);
+			}
+
+			[[nodiscard]]
+			inline WeightedSum4 WeightedSum(const __m128i r, const __m128i g, const __m128i b, const double wr, const double wg, const double wb)
+			{
+				const __m128d vwr = ::_mm_set1_pd(wr);
+				const __m128d vwg = ::_mm_set1_pd(wg);
+				const __m128d vwb = ::_mm_set1_pd(wb);
+
+				return{ WeightedSum2(r, g, b, vwr, vwg, vwb),
+					WeightedSum2(::_mm_unpackhi_epi64(r, r), ::_mm_unpackhi_epi64(g, g), ::_mm_unpackhi_epi64(b, b), vwr, vwg, vwb) };
+			}
+
+			[[nodiscard]]
+			inline WeightedSum4 Min(const WeightedSum4& v, const __m128d max)
+			{
+				return{ ::_mm_min_pd(v.lo, max), ::_mm_min_pd(v.hi, max) };
+			}
+
+			[[nodiscard]]
+			inline __m128i Truncate(const WeightedSum4& v)
+			{
+				return ::_mm_unpacklo_epi64(::_mm_cvttpd_epi32(v.lo), ::_mm_cvttpd_epi32(v.hi));
+			}
+
+			[[nodiscard]]
+			inline __m128i Channel(const __m128i v, const int32 index)
+			{
+				return ::_mm_and_si128(::_mm_srl_epi32(v, ::_mm_cvtsi32_si128(index * 8)), ::_mm_set1_epi32(0xFF));
+			}
+
+			[[nodiscard]]
+			inline __m128i Reverse4(const __m128i v)
+			{
+				return ::_mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+			}
+
+			[[nodiscard]]
+			inline __m128i Load(const Color* p)
+			{
+				return ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			}
+
+			inline void Store(Color* p, const __m128i v)
+			{
+				::_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+			}
+		}
+
+		void Negate_SSE4_1(Color* p, const size_t count)
+		{
+			const __m128i rgbMask = ::_mm_set1_epi32(0x00FFFFFF);
+			const Color* const pEnd = (p + (count & ~size_t(3)));
+
+			for (; p != pEnd; p += 4)
+			{
+				simd::Store(p, ::_mm_xor_si128(simd::Load(p), rgbMask));
+			}
+
+			Negate_Reference(p, (count & 3));
+		}
+
+		void Grayscale_SSE4_1(Color* p, const size_t count)
+		{
+			const __m128i alphaMask = ::_mm_set1_epi32(static_cast<int32>(0xFF000000));
+			const Color* const pEnd = (p + (count & ~size_t(3)));
+
+			for (; p != pEnd; p += 4)
+			{
+				const __m128i v = simd::Load(p);
+				const __m128i gray = simd::Truncate(simd::WeightedSum(simd::Channel(v, 0), simd::Channel(v, 1), simd::Channel(v, 2), 0.299, 0.587, 0.114));
+				const __m128i rgb = ::_mm_or_si128(::_mm_or_si128(gray, ::_mm_slli_epi32(gray, 8)), ::_mm_slli_epi32(gray, 16));
+				simd::Store(p, ::_mm_or_si128(::_mm_and_si128(v, alphaMask), rgb));
+			}
+
+			Grayscale_Reference(p, (count & 3));
+		}
+
+		void Sepia_SSE4_1(Color* p, const size_t count)
+		{
+			const __m128i alphaMask = ::_mm_set1_epi32(static_cast<int32>(0xFF000000));
+			const __m128d max = ::_mm_set1_pd(255.0);
+			const Color* const pEnd = (p + (count & ~size_t(3)));
+
+			for (; p != pEnd; p += 4)
+			{
+				const __m128i v = simd::Load(p);
+				const __m128i r = simd::Channel(v, 0);
+				const __m128i g = simd::Channel(v, 1);
+				const __m128i b = simd::Channel(v, 2);
+
+				const simd::WeightedSum4 tr = simd::WeightedSum(r, g, b, 0.393, 0.769, 0.189);
+				const simd::WeightedSum4 tg = simd::WeightedSum(r, g, b, 0.349, 0.686, 0.168);
+				const simd::WeightedSum4 tb = simd::WeightedSum(r, g, b, 0.272, 0.534, 0.131);
+
+				const __m128i rgb = ::_mm_or_si128(::_mm_or_si128(simd::Truncate(simd::Min(tr, max)), ::_mm_slli_epi32(simd::Truncate(simd::Min(tg, max)), 8)), ::_mm_slli_epi32(simd::Truncate(simd::Min(tb, max)), 16));
+				simd::Store(p, ::_mm_or_si128(::_mm_and_si128(v, alphaMask), rgb));
+			}
+
+			Sepia_Reference(p, (count & 3));
+		}
+
+		void Brighten_SSE4_1(Color* p, const size_t count, const int32 level)
+		{
+			const int32 amount = static_cast<int32>(Min(((level < 0) ? -static_cast<int64>(level) : level), int64(255)));
+			const __m128i addend = ::_mm_set1_epi32(amount | (amount << 8) | (amount << 16));
+			const Color* const pEnd = (p + (count & ~size_t(3)));
+
+			if (level < 0)
+			{
+				for (; p != pEnd; p += 4)
+				{
+					simd::Store(p, ::_mm_subs_epu8(simd::Load(p), addend));
+				}
+			}
+			else
+			{
+				for (; p != pEnd; p += 4)
+				{
+					simd::Store(p, ::_mm_adds_epu8(simd::Load(p), addend));
+				}
+			}
+
+			Brighten_Reference(p, (count & 3), level);
+		}
+
+		void Threshold_SSE4_1(Color* p, const size_t count, const uint8 threshold, const bool invertColor)
+		{
+			const __m128i alphaMask = ::_mm_set1_epi32(static_cast<int32>(0xFF000000));
+			const __m128i invertMask = ::_mm_set1_epi32(invertColor ? 0x00FFFFFF : 0);
+			const __m128d thresholdF = ::_mm_set1_pd(threshold / 255.0);
+			const Color* const pEnd = (p + (count & ~size_t(3)));
+
+			for (; p != pEnd; p += 4)
+			{
+				const __m128i v = simd::Load(p);
+				const simd::WeightedSum4 gray = simd::WeightedSum(simd::Channel(v, 0), simd::Channel(v, 1), simd::Channel(v, 2), (0.299 / 255.0), (0.587 / 255.0), (0.114 / 255.0));
+				const __m128 lo = ::_mm_castpd_ps(::_mm_cmplt_pd(thresholdF, gray.lo));
+				const __m128 hi = ::_mm_castpd_ps(::_mm_cmplt_pd(thresholdF, gray.hi));
+				const __m128i above = ::_mm_castps_si128(::_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+				const __m128i rgb = ::_mm_xor_si128(::_mm_andnot_si128(alphaMask, above), invertMask);
+				simd::Store(p, ::_mm_or_si128(::_mm_and_si128(v, alphaMask), rgb));
+			}
+
+			Threshold_Reference(p, (count & 3), threshold, invertColor);
+		}
+
+		void SwapRB_SSE4_1(Color* p, const size_t count)
+		{
+			const __m128i shuffle = ::_mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+			const Color* const pEnd = (p + (count & ~size_t(3)));
+
+			for (; p != pEnd; p += 4)
+			{
+				simd::Store(p, ::_mm_shuffle_epi8(simd::Load(p), shuffle));
+			}
+
+			SwapRB_Reference(p, (count & 3));
+		}
+
+		void Reverse_SSE4_1(Color* p, const size_t count)
+		{
+			Color* pFirst = p;
+			Color* pLast = (p + count);
+
+			while (8 <= (pLast - pFirst))
+			{
+				pLast -= 4;
+				const __m128i first = simd::Load(pFirst);
+				const __m128i last = simd::Load(pLast);
+				simd::Store(pFirst, simd::Reverse4(last));
+				simd::Store(pLast, simd::Reverse4(first));
+				pFirst += 4;
+			}
+
+			std::reverse(pFirst, pLast);
+		}
+
+		void ReverseCopy_SSE4_1(const Color* pSrc, Color* pDst, const size_t count)
+		{
+			const Color* pSrcLast = (pSrc + count);
+			const Color* const pDstEnd = (pDst + (count & ~size_t(3)));
+
+			for (; pDst != pDstEnd; pDst += 4)
+			{
+				pSrcLast -= 4;
+				simd::Store(pDst, simd::Reverse4(simd::Load(pSrcLast)));
+			}
+
+			std::reverse_copy(pSrc, pSrcLast, pDst);
+		}
+
+		void Rotate90_SSE4_1(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+			const size_t width4 = (srcWidth & ~size_t(3));
+			const size_t height4 = (srcHeight & ~size_t(3));
+
+			for (size_t y = 0; y < height4; y += 4)
+			{
+				// 下の行から順に読むことで、転置した列がそのまま出力の行の並びになる
+				const Color* pSrc0 = (pSrc + (y + 3) * srcWidth);
+				const Color* pSrc1 = (pSrc + (y + 2) * srcWidth);
+				const Color* pSrc2 = (pSrc + (y + 1) * srcWidth);
+				const Color* pSrc3 = (pSrc + (y + 0) * srcWidth);
+				Color* pDstBlock = (pDst + (srcHeight - y - 4));
+
+				for (size_t x = 0; x < width4; x += 4)
+				{
+					const __m128i t0 = ::_mm_unpacklo_epi32(simd::Load(pSrc0 + x), simd::Load(pSrc1 + x));
+					const __m128i t1 = ::_mm_unpacklo_epi32(simd::Load(pSrc2 + x), simd::Load(pSrc3 + x));
+					const __m128i t2 = ::_mm_unpackhi_epi32(simd::Load(pSrc0 + x), simd::Load(pSrc1 + x));
+					const __m128i t3 = ::_mm_unpackhi_epi32(simd::Load(pSrc2 + x), simd::Load(pSrc3 + x));
+
+					simd::Store((pDstBlock + (x + 0) * srcHeight), ::_mm_unpacklo_epi64(t0, t1));
+					simd::Store((pDstBlock + (x + 1) * srcHeight), ::_mm_unpackhi_epi64(t0, t1));
+					simd::Store((pDstBlock + (x + 2) * srcHeight), ::_mm_unpacklo_epi64(t2, t3));
+					simd::Store((pDstBlock + (x + 3) * srcHeight), ::_mm_unpackhi_epi64(t2, t3));
+				}
+			}
+
+			Rotate90_Reference(pSrc, pDst, srcWidth, srcHeight, width4, srcWidth, 0, height4);
+			Rotate90_Reference(pSrc, pDst, srcWidth, srcHeight, 0, srcWidth, height4, srcHeight);
+		}
+
+		void Rotate270_SSE4_1(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+			const size_t width4 = (srcWidth & ~size_t(3));
+			const size_t height4 = (srcHeight & ~size_t(3));
+
+			for (size_t y = 0; y < height4; y += 4)
+			{
+				const Color* pSrc0 = (pSrc + (y + 0) * srcWidth);
+				const Color* pSrc1 = (pSrc + (y + 1) * srcWidth);
+				const Color* pSrc2 = (pSrc + (y + 2) * srcWidth);
+				const Color* pSrc3 = (pSrc + (y + 3) * srcWidth);
+				Color* pDstBlock = (pDst + y);
+
+				for (size_t x = 0; x < width4; x += 4)
+				{
+					const __m128i t0 = ::_mm_unpacklo_epi32(simd::Load(pSrc0 + x), simd::Load(pSrc1 + x));
+					const __m128i t1 = ::_mm_unpacklo_epi32(simd::Load(pSrc2 + x), simd::Load(pSrc3 + x));
+					const __m128i t2 = ::_mm_unpackhi_epi32(simd::Load(pSrc0 + x), simd::Load(pSrc1 + x));
+					const __m128i t3 = ::_mm_unpackhi_epi32(simd::Load(pSrc2 + x), simd::Load(pSrc3 + x));
+
+					simd::Store((pDstBlock + (srcWidth - x - 1) * srcHeight), ::_mm_unpacklo_epi64(t0, t1));
+					simd::Store((pDstBlock + (srcWidth - x - 2) * srcHeight), ::_mm_unpackhi_epi64(t0, t1));
+					simd::Store((pDstBlock + (srcWidth - x - 3) * srcHeight), ::_mm_unpacklo_epi64(t2, t3));
+					simd::Store((pDstBlock + (srcWidth - x - 4) * srcHeight), ::_mm_unpackhi_epi64(t2, t3));
+				}
+			}
+
+			Rotate270_Reference(pSrc, pDst, srcWidth, srcHeight, width4, srcWidth, 0, height4);
+			Rotate270_Reference(pSrc, pDst, srcWidth, srcHeight, 0, srcWidth, height4, srcHeight);
+		}
+
+	# endif
+
+	# if SIV3D_IMAGE_FILTER_AVX2
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	AVX2
+		//
+		////////////////////////////////////////////////////////////////
+
+		namespace simd
+		{
+			struct WeightedSum8
+			{
+				__m256d lo;
+
+				__m256d hi;
+			};
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline __m256d WeightedSum4_AVX2(const __m128i r, const __m128i g, const __m128i b, const __m256d wr, const __m256d wg, const __m256d wb)
+			{
+				const __m256d tr = ::_mm256_mul_pd(wr, ::_mm256_cvtepi32_pd(r));
+				const __m256d tg = ::_mm256_mul_pd(wg, ::_mm256_cvtepi32_pd(g));
+				const __m256d tb = ::_mm256_mul_pd(wb, ::_mm256_cvtepi32_pd(b));
+				return ::_mm256_add_pd(::_mm256_add_pd(tr, tg), tb);
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline WeightedSum8 WeightedSum_AVX2(const __m256i r, const __m256i g, const __m256i b, const double wr, const double wg, const double wb)
+			{
+				const __m256d vwr = ::_mm256_set1_pd(wr);
+				const __m256d vwg = ::_mm256_set1_pd(wg);
+				const __m256d vwb = ::_mm256_set1_pd(wb);
+
+				return{ WeightedSum4_AVX2(::_mm256_castsi256_si128(r), ::_mm256_castsi256_si128(g), ::_mm256_castsi256_si128(b), vwr, vwg, vwb),
+					WeightedSum4_AVX2(::_mm256_extracti128_si256(r, 1), ::_mm256_extracti128_si256(g, 1), ::_mm256_extracti128_si256(b, 1), vwr, vwg, vwb) };
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline __m256i Combine_AVX2(const __m128i lo, const __m128i hi)
+			{
+				return ::_mm256_inserti128_si256(::_mm256_castsi128_si256(lo), hi, 1);
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline WeightedSum8 Min_AVX2(const WeightedSum8& v, const __m256d max)
+			{
+				return{ ::_mm256_min_pd(v.lo, max), ::_mm256_min_pd(v.hi, max) };
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline __m256i Truncate_AVX2(const WeightedSum8& v)
+			{
+				return Combine_AVX2(::_mm256_cvttpd_epi32(v.lo), ::_mm256_cvttpd_epi32(v.hi));
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline __m256i Channel_AVX2(const __m256i v, const int32 index)
+			{
+				return ::_mm256_and_si256(::_mm256_srl_epi32(v, ::_mm_cvtsi32_si128(index * 8)), ::_mm256_set1_epi32(0xFF));
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline __m256i Reverse8_AVX2(const __m256i v)
+			{
+				return ::_mm256_permutevar8x32_epi32(v, ::_mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+			}
+
+			[[nodiscard]]
+			SIV3D_TARGET_AVX2
+			inline __m256i Load_AVX2(const Color* p)
+			{
+				return ::_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			}
+
+			SIV3D_TARGET_AVX2
+			inline void Store_AVX2(Color* p, const __m256i v)
+			{
+				::_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+			}
+		}
+
+		SIV3D_TARGET_AVX2
+		void Negate_AVX2(Color* p, const size_t count)
+		{
+			const __m256i rgbMask = ::_mm256_set1_epi32(0x00FFFFFF);
+			const Color* const pEnd = (p + (count & ~size_t(7)));
+
+			for (; p != pEnd; p += 8)
+			{
+				simd::Store_AVX2(p, ::_mm256_xor_si256(simd::Load_AVX2(p), rgbMask));
+			}
+
+			Negate_Reference(p, (count & 7));
+		}
+
+		SIV3D_TARGET_AVX2
+		void Grayscale_AVX2(Color* p, const size_t count)
+		{
+			const __m256i alphaMask = ::_mm256_set1_epi32(static_cast<int32>(0xFF000000));
+			const Color* const pEnd = (p + (count & ~size_t(7)));
+
+			for (; p != pEnd; p += 8)
+			{
+				const __m256i v = simd::Load_AVX2(p);
+				const __m256i gray = simd::Truncate_AVX2(simd::WeightedSum_AVX2(simd::Channel_AVX2(v, 0), simd::Channel_AVX2(v, 1), simd::Channel_AVX2(v, 2), 0.299, 0.587, 0.114));
+				const __m256i rgb = ::_mm256_or_si256(::_mm256_or_si256(gray, ::_mm256_slli_epi32(gray, 8)), ::_mm256_slli_epi32(gray, 16));
+				simd::Store_AVX2(p, ::_mm256_or_si256(::_mm256_and_si256(v, alphaMask), rgb));
+			}
+
+			Grayscale_Reference(p, (count & 7));
+		}
+
+		SIV3D_TARGET_AVX2
+		void Sepia_AVX2(Color* p, const size_t count)
+		{
+			const __m256i alphaMask = ::_mm256_set1_epi32(static_cast<int32>(0xFF000000));
+			const __m256d max = ::_mm256_set1_pd(255.0);
+			const Color* const pEnd = (p + (count & ~size_t(7)));
+
+			for (; p != pEnd; p += 8)
+			{
+				const __m256i v = simd::Load_AVX2(p);
+				const __m256i r = simd::Channel_AVX2(v, 0);
+				const __m256i g = simd::Channel_AVX2(v, 1);
+				const __m256i b = simd::Channel_AVX2(v, 2);
+
+				const simd::WeightedSum8 tr = simd::WeightedSum_AVX2(r, g, b, 0.393, 0.769, 0.189);
+				const simd::WeightedSum8 tg = simd::WeightedSum_AVX2(r, g, b, 0.349, 0.686, 0.168);
+				const simd::WeightedSum8 tb = simd::WeightedSum_AVX2(r, g, b, 0.272, 0.534, 0.131);
+
+				const __m256i rgb = ::_mm256_or_si256(::_mm256_or_si256(simd::Truncate_AVX2(simd::Min_AVX2(tr, max)), ::_mm256_slli_epi32(simd::Truncate_AVX2(simd::Min_AVX2(tg, max)), 8)), ::_mm256_slli_epi32(simd::Truncate_AVX2(simd::Min_AVX2(tb, max)), 16));
+				simd::Store_AVX2(p, ::_mm256_or_si256(::_mm256_and_si256(v, alphaMask), rgb));
+			}
+
+			Sepia_Reference(p, (count & 7));
+		}
+
+		SIV3D_TARGET_AVX2
+		void Brighten_AVX2(Color* p, const size_t count, const int32 level)
+		{
+			const int32 amount = static_cast<int32>(Min(((level < 0) ? -static_cast<int64>(level) : level), int64(255)));
+			const __m256i addend = ::_mm256_set1_epi32(amount | (amount << 8) | (amount << 16));
+			const Color* const pEnd = (p + (count & ~size_t(7)));
+
+			if (level < 0)
+			{
+				for (; p != pEnd; p += 8)
+				{
+					simd::Store_AVX2(p, ::_mm256_subs_epu8(simd::Load_AVX2(p), addend));
+				}
+			}
+			else
+			{
+				for (; p != pEnd; p += 8)
+				{
+					simd::Store_AVX2(p, ::_mm256_adds_epu8(simd::Load_AVX2(p), addend));
+				}
+			}
+
+			Brighten_Reference(p, (count & 7), level);
+		}
+
+		SIV3D_TARGET_AVX2
+		void Threshold_AVX2(Color* p, const size_t count, const uint8 threshold, const bool invertColor)
+		{
+			const __m256i alphaMask = ::_mm256_set1_epi32(static_cast<int32>(0xFF000000));
+			const __m256i invertMask = ::_mm256_set1_epi32(invertColor ? 0x00FFFFFF : 0);
+			const __m256i evenLanes = ::_mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+			const __m256d thresholdF = ::_mm256_set1_pd(threshold / 255.0);
+			const Color* const pEnd = (p + (count & ~size_t(7)));
+
+			for (; p != pEnd; p += 8)
+			{
+				const __m256i v = simd::Load_AVX2(p);
+				const simd::WeightedSum8 gray = simd::WeightedSum_AVX2(simd::Channel_AVX2(v, 0), simd::Channel_AVX2(v, 1), simd::Channel_AVX2(v, 2), (0.299 / 255.0), (0.587 / 255.0), (0.114 / 255.0));
+				const __m256i lo = ::_mm256_permutevar8x32_epi32(::_mm256_castpd_si256(::_mm256_cmp_pd(thresholdF, gray.lo, _CMP_LT_OQ)), evenLanes);
+				const __m256i hi = ::_mm256_permutevar8x32_epi32(::_mm256_castpd_si256(::_mm256_cmp_pd(thresholdF, gray.hi, _CMP_LT_OQ)), evenLanes);
+				const __m256i above = simd::Combine_AVX2(::_mm256_castsi256_si128(lo), ::_mm256_castsi256_si128(hi));
+				const __m256i rgb = ::_mm256_xor_si256(::_mm256_andnot_si256(alphaMask, above), invertMask);
+				simd::Store_AVX2(p, ::_mm256_or_si256(::_mm256_and_si256(v, alphaMask), rgb));
+			}
+
+			Threshold_Reference(p, (count & 7), threshold, invertColor);
+		}
+
+		SIV3D_TARGET_AVX2
+		void SwapRB_AVX2(Color* p, const size_t count)
+		{
+			const __m256i shuffle = ::_mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+			const Color* const pEnd = (p + (count & ~size_t(7)));
+
+			for (; p != pEnd; p += 8)
+			{
+				simd::Store_AVX2(p, ::_mm256_shuffle_epi8(simd::Load_AVX2(p), shuffle));
+			}
+
+			SwapRB_Reference(p, (count & 7));
+		}
+
+		SIV3D_TARGET_AVX2
+		void Reverse_AVX2(Color* p, const size_t count)
+		{
+			Color* pFirst = p;
+			Color* pLast = (p + count);
+
+			while (16 <= (pLast - pFirst))
+			{
+				pLast -= 8;
+				const __m256i first = simd::Load_AVX2(pFirst);
+				const __m256i last = simd::Load_AVX2(pLast);
+				simd::Store_AVX2(pFirst, simd::Reverse8_AVX2(last));
+				simd::Store_AVX2(pLast, simd::Reverse8_AVX2(first));
+				pFirst += 8;
+			}
+
+			std::reverse(pFirst, pLast);
+		}
+
+		SIV3D_TARGET_AVX2
+		void ReverseCopy_AVX2(const Color* pSrc, Color* pDst, const size_t count)
+		{
+			const Color* pSrcLast = (pSrc + count);
+			const Color* const pDstEnd = (pDst + (count & ~size_t(7)));
+
+			for (; pDst != pDstEnd; pDst += 8)
+			{
+				pSrcLast -= 8;
+				simd::Store_AVX2(pDst, simd::Reverse8_AVX2(simd::Load_AVX2(pSrcLast)));
+			}
+
+			std::reverse_copy(pSrc, pSrcLast, pDst);
+		}
+
+	# endif
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	Dispatch
+		//
+		////////////////////////////////////////////////////////////////
+
+		void Negate(Color* p, const size_t count)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return Negate_AVX2(p, count);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Negate_SSE4_1(p, count);
+			}
+
+		# endif
+
+			Negate_Reference(p, count);
+		}
+
+		void Grayscale(Color* p, const size_t count)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return Grayscale_AVX2(p, count);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Grayscale_SSE4_1(p, count);
+			}
+
+		# endif
+
+			Grayscale_Reference(p, count);
+		}
+
+		void Sepia(Color* p, const size_t count)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return Sepia_AVX2(p, count);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Sepia_SSE4_1(p, count);
+			}
+
+		# endif
+
+			Sepia_Reference(p, count);
+		}
+
+		void Brighten(Color* p, const size_t count, const int32 level)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return Brighten_AVX2(p, count, level);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Brighten_SSE4_1(p, count, level);
+			}
+
+		# endif
+
+			Brighten_Reference(p, count, level);
+		}
+
+		void Threshold(Color* p, const size_t count, const uint8 threshold, const bool invertColor)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return Threshold_AVX2(p, count, threshold, invertColor);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Threshold_SSE4_1(p, count, threshold, invertColor);
+			}
+
+		# endif
+
+			Threshold_Reference(p, count, threshold, invertColor);
+		}
+
+		void SwapRB(Color* p, const size_t count)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return SwapRB_AVX2(p, count);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return SwapRB_SSE4_1(p, count);
+			}
+
+		# endif
+
+			SwapRB_Reference(p, count);
+		}
+
+		void Reverse(Color* p, const size_t count)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return Reverse_AVX2(p, count);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Reverse_SSE4_1(p, count);
+			}
+
+		# endif
+
+			Reverse_Reference(p, count);
+		}
+
+		void ReverseCopy(const Color* pSrc, Color* pDst, const size_t count)
+		{
+		# if SIV3D_IMAGE_FILTER_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return ReverseCopy_AVX2(pSrc, pDst, count);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return ReverseCopy_SSE4_1(pSrc, pDst, count);
+			}
+
+		# endif
+
+			ReverseCopy_Reference(pSrc, pDst, count);
+		}
+
+		void Rotate90(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Rotate90_SSE4_1(pSrc, pDst, srcWidth, srcHeight);
+			}
+
+		# endif
+
+			Rotate90_Reference(pSrc, pDst, srcWidth, srcHeight);
+		}
+
+		void Rotate270(const Color* pSrc, Color* pDst, const size_t srcWidth, const size_t srcHeight)
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return Rotate270_SSE4_1(pSrc, pDst, srcWidth, srcHeight);
+			}
+
+		# endif
+
+			Rotate270_Reference(pSrc, pDst, srcWidth, srcHeight);
+		}
+	}
+}
@@ -0,0 +1,115 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Image.hpp>
+
+# if SIV3D_INTRINSIC(SSE) && (defined(_M_X64) || defined(__x86_64__)) && !SIV3D_PLATFORM(WEB)
+
+	# define SIV3D_IMAGE_FILTER_AVX2 1
+
+# else
+
+	# define SIV3D_IMAGE_FILTER_AVX2 0
+
+# endif
+
+namespace s3d
+{
+	namespace ImageFilter
+	{
+		void Negate(Color* p, size_t count);
+
+		void Grayscale(Color* p, size_t count);
+
+		void Sepia(Color* p, size_t count);
+
+		void Brighten(Color* p, size_t count, int32 level);
+
+		void Threshold(Color* p, size_t count, uint8 threshold, bool invertColor);
+
+		void SwapRB(Color* p, size_t count);
+
+		void Reverse(Color* p, size_t count);
+
+		void ReverseCopy(const Color* pSrc, Color* pDst, size_t count);
+
+		void Rotate90(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+		void Rotate270(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+		// 以下は CPU の判定を行わない実装（テスト用）
+
+		void Negate_Reference(Color* p, size_t count);
+
+		void Grayscale_Reference(Color* p, size_t count);
+
+		void Sepia_Reference(Color* p, size_t count);
+
+		void Brighten_Reference(Color* p, size_t count, int32 level);
+
+		void Threshold_Reference(Color* p, size_t count, uint8 threshold, bool invertColor);
+
+		void SwapRB_Reference(Color* p, size_t count);
+
+		void Reverse_Reference(Color* p, size_t count);
+
+		void ReverseCopy_Reference(const Color* pSrc, Color* pDst, size_t count);
+
+		void Rotate90_Reference(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+		void Rotate270_Reference(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		void Negate_SSE4_1(Color* p, size_t count);
+
+		void Grayscale_SSE4_1(Color* p, size_t count);
+
+		void Sepia_SSE4_1(Color* p, size_t count);
+
+		void Brighten_SSE4_1(Color* p, size_t count, int32 level);
+
+		void Threshold_SSE4_1(Color* p, size_t count, uint8 threshold, bool invertColor);
+
+		void SwapRB_SSE4_1(Color* p, size_t count);
+
+		void Reverse_SSE4_1(Color* p, size_t count);
+
+		void ReverseCopy_SSE4_1(const Color* pSrc, Color* pDst, size_t count);
+
+		void Rotate90_SSE4_1(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+		void Rotate270_SSE4_1(const Color* pSrc, Color* pDst, size_t srcWidth, size_t srcHeight);
+
+	# endif
+
+	# if SIV3D_IMAGE_FILTER_AVX2
+
+		void Negate_AVX2(Color* p, size_t count);
+
+		void Grayscale_AVX2(Color* p, size_t count);
+
+		void Sepia_AVX2(Color* p, size_t count);
+
+		void Brighten_AVX2(Color* p, size_t count, int32 level);
+
+		void Threshold_AVX2(Color* p, size_t count, uint8 threshold, bool invertColor);
+
+		void SwapRB_AVX2(Color* p, size_t count);
+
+		void Reverse_AVX2(Color* p, size_t count);
+
+		void ReverseCopy_AVX2(const Color* pSrc, Color* pDst, size_t count);
+
+	# endif
+	}
+}
@@ -22,12 +22,14 @@
 # include <Siv3D/ImageEncoder.hpp>
 # include <Siv3D/Dialog.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Threading.hpp>
 # include <Siv3D/ImageFormat/PNGEncoder.hpp>
 # include <Siv3D/ImageFormat/JPEGEncoder.hpp>
 # include <Siv3D/ImageFormat/PPMEncoder.hpp>
 # include <Siv3D/ImageFormat/WebPEncoder.hpp>
 # include <Siv3D/OpenCV_Bridge.hpp>
 # include "ImagePainting.hpp"
+# include "ImageFilter.hpp"
 
 namespace s3d
 {
@@ -56,19 +58,6 @@ namespace s3d
 			return (px * py * (c1 - c2 - c3 + c4) + px * (c2 - c1) + py * (c3 - c1) + c1);
 		}
 
-		[[nodiscard]]
-		static Color MakeSepia(Color color) noexcept
-		{
-			const double tr = Min(((0.393 * color.r) + (0.769 * color.g) + (0.189 * color.b)), 255.0);
-			const double tg = Min(((0.349 * color.r) + (0.686 * color.g) + (0.168 * color.b)), 255.0);
-			const double tb = Min(((0.272 * color.r) + (0.534 * color.g) + (0.131 * color.b)), 255.0);
-
-			color.r = static_cast<uint8>(tr);
-			color.g = static_cast<uint8>(tg);
-			color.b = static_cast<uint8>(tb);
-			return color;
-		}
-
 		static void InitPosterizeTable(const int32 level, uint8 table[256]) noexcept
 		{
 			const int32 levN = Clamp(level, 2, 256) - 1;
@@ -89,6 +78,36 @@ namespace s3d
 			}
 		}
 
+		// 画像のピクセル列 (Color*, size_t) に関数を適用する。並列処理の場合は行単位の帯に分割する
+		template <class Fty>
+		static void ForEachSpan(Image& image, const Parallel parallel, Fty f)
+		{
+			if (parallel)
+			{
+				const size_t width = image.width();
+				Color* const pData = image.data();
+
+				Threading::ParallelFor(image.height(), [=, &f](const size_t firstRow, const size_t lastRow)
+				{
+					f((pData + (firstRow * width)), ((lastRow - firstRow) * width));
+				}, Max<size_t>(1, (16384 / width)));
+			}
+			else
+			{
+				f(image.data(), image.num_pixels());
+			}
+		}
+
+		// 画像の全ピクセルに関数を適用する。並列処理の場合は行単位の帯に分割する
+		template <class Fty>
+		static void ForEachPixel(Image& image, const Parallel parallel, Fty f)
+		{
+			ForEachSpan(image, parallel, [&f](Color* p, const size_t count)
+			{
+				std::for_each(p, (p + count), f);
+			});
+		}
+
 		static Color GetAverage(const Image& src, const Rect& rect)
 		{
 			const int32 count = rect.area();
@@ -590,16 +609,7 @@ namespace s3d
 
 	Image& Image::RGBAtoBGRA()
 	{
-		Color* p = m_data.data();
-		const Color* pEnd = (p + num_pixels());
-
-		while (p != pEnd)
-		{
-			const uint8 t = p->r;
-			p->r = p->b;
-			p->b = t;
-			++p;
-		}
+		ImageFilter::SwapRB(m_data.data(), num_pixels());
 
 		return *this;
 	}
@@ -712,7 +722,7 @@ namespace s3d
 		return WebPEncoder{}.encode(*this, lossless, quality, method);
 	}
 
-	Image& Image::negate()
+	Image& Image::negate(const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -724,16 +734,13 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				pixel = ~pixel;
-			}
+			detail::ForEachSpan(*this, parallel, ImageFilter::Negate);
 		}
 
 		return *this;
 	}
 
-	Image Image::negated() const
+	Image Image::negated(const Parallel parallel) const
 	{
 		// 1. パラメータチェック
 		{
@@ -747,16 +754,13 @@ namespace s3d
 		{
 			Image image{ *this };
 
-			for (auto& pixel : image)
-			{
-				pixel = ~pixel;
-			}
+			detail::ForEachSpan(image, parallel, ImageFilter::Negate);
 
 			return image;
 		}
 	}
 
-	Image& Image::grayscale()
+	Image& Image::grayscale(const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -768,19 +772,13 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				const uint8 gray = pixel.grayscale0_255();
-				pixel.r = gray;
-				pixel.g = gray;
-				pixel.b = gray;
-			}
+			detail::ForEachSpan(*this, parallel, ImageFilter::Grayscale);
 		}
 
 		return *this;
 	}
 
-	Image Image::grayscaled() const
+	Image Image::grayscaled(const Parallel parallel) const
 	{
 		// 1. パラメータチェック
 		{
@@ -794,19 +792,13 @@ namespace s3d
 		{
 			Image image{ *this };
 
-			for (auto& pixel : image)
-			{
-				const uint8 gray = pixel.grayscale0_255();
-				pixel.r = gray;
-				pixel.g = gray;
-				pixel.b = gray;
-			}
+			detail::ForEachSpan(image, parallel, ImageFilter::Grayscale);
 
 			return image;
 		}
 	}
 
-	Image& Image::sepia()
+	Image& Image::sepia(const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -818,16 +810,13 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				pixel = detail::MakeSepia(pixel);
-			}
+			detail::ForEachSpan(*this, parallel, ImageFilter::Sepia);
 		}
 
 		return *this;
 	}
 
-	Image Image::sepiaed() const
+	Image Image::sepiaed(const Parallel parallel) const
 	{
 		// 1. パラメータチェック
 		{
@@ -841,16 +830,13 @@ namespace s3d
 		{
 			Image image{ *this };
 
-			for (auto& pixel : image)
-			{
-				pixel = detail::MakeSepia(pixel);
-			}
+			detail::ForEachSpan(image, parallel, ImageFilter::Sepia);
 
 			return image;
 		}
 	}
 
-	Image& Image::posterize(const int32 level)
+	Image& Image::posterize(const int32 level, const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -865,18 +851,18 @@ namespace s3d
 			uint8 colorTable[256];
 			detail::InitPosterizeTable(level, colorTable);
 
-			for (auto& pixel : m_data)
+			detail::ForEachPixel(*this, parallel, [&colorTable](Color& pixel)
 			{
 				pixel.r = colorTable[pixel.r];
 				pixel.g = colorTable[pixel.g];
 				pixel.b = colorTable[pixel.b];
-			}
+			});
 		}
 
 		return *this;
 	}
 
-	Image Image::posterized(const int32 level) const
+	Image Image::posterized(const int32 level, const Parallel parallel) const
 	{
 		// 1. パラメータチェック
 		{
@@ -893,18 +879,18 @@ namespace s3d
 			uint8 colorTable[256];
 			detail::InitPosterizeTable(level, colorTable);
 
-			for (auto& pixel : image)
+			detail::ForEachPixel(image, parallel, [&colorTable](Color& pixel)
 			{
 				pixel.r = colorTable[pixel.r];
 				pixel.g = colorTable[pixel.g];
 				pixel.b = colorTable[pixel.b];
-			}
+			});
 
 			return image;
 		}
 	}
 
-	Image& Image::brighten(const int32 level)
+	Image& Image::brighten(const int32 level, const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -916,30 +902,16 @@ namespace s3d
 
 		// 2. 処理
 		{
-			if (level < 0)
+			if (level != 0)
 			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = static_cast<uint8>(Max(static_cast<int32>(pixel.r) + level, 0));
-					pixel.g = static_cast<uint8>(Max(static_cast<int32>(pixel.g) + level, 0));
-					pixel.b = static_cast<uint8>(Max(static_cast<int32>(pixel.b) + level, 0));
-				}
-			}
-			else if (level > 0)
-			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = static_cast<uint8>(Min(static_cast<int32>(pixel.r) + level, 255));
-					pixel.g = static_cast<uint8>(Min(static_cast<int32>(pixel.g) + level, 255));
-					pixel.b = static_cast<uint8>(Min(static_cast<int32>(pixel.b) + level, 255));
-				}
+				detail::ForEachSpan(*this, parallel, [level](Color* p, const size_t count) { ImageFilter::Brighten(p, count, level); });
 			}
 		}
 
 		return *this;
 	}
 
-	Image Image::brightened(const int32 level) const
+	Image Image::brightened(const int32 level, const Parallel parallel) const
 	{
 		// 1. パラメータチェック
 		{
@@ -953,23 +925,9 @@ namespace s3d
 		{
 			Image image{ *this };
 
-			if (level < 0)
+			if (level != 0)
 			{
-				for (auto& pixel : image)
-				{
-					pixel.r = static_cast<uint8>(Max(static_cast<int32>(pixel.r) + level, 0));
-					pixel.g = static_cast<uint8>(Max(static_cast<int32>(pixel.g) + level, 0));
-					pixel.b = static_cast<uint8>(Max(static_cast<int32>(pixel.b) + level, 0));
-				}
-			}
-			else if (level > 0)
-			{
-				for (auto& pixel : image)
-				{
-					pixel.r = static_cast<uint8>(Min(static_cast<int32>(pixel.r) + level, 255));
-					pixel.g = static_cast<uint8>(Min(static_cast<int32>(pixel.g) + level, 255));
-					pixel.b = static_cast<uint8>(Min(static_cast<int32>(pixel.b) + level, 255));
-				}
+				detail::ForEachSpan(image, parallel, [level](Color* p, const size_t count) { ImageFilter::Brighten(p, count, level); });
 			}
 
 			return image;
@@ -993,7 +951,7 @@ namespace s3d
 
 			for (uint32 y = 0; y < m_height; ++y)
 			{
-				std::reverse(p, p + imageWidth);
+				ImageFilter::Reverse(p, imageWidth);
 				p += imageWidth;
 			}
 		}
@@ -1021,13 +979,7 @@ namespace s3d
 
 			for (size_t y = 0; y < m_height; ++y)
 			{
-				const Color* pSrcLine = (pSrc + width * y + width - 1);
-				Color* pDstLine = (pDst + width * y);
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					*(pDstLine + x) = *(pSrcLine - x);
-				}
+				ImageFilter::ReverseCopy((pSrc + width * y), (pDst + width * y), width);
 			}
 
 			return image;
@@ -1102,19 +1054,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			// [Siv3D ToDo] 最適化
 			Image tmp{ m_height, m_width };
 
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = data() + y * m_width;
-				const size_t dstX = m_height - y - 1;
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					tmp[x][dstX] = pSrc[x];
-				}
-			}
+			ImageFilter::Rotate90(data(), tmp.data(), m_width, m_height);
 
 			swap(tmp);
 		}
@@ -1136,17 +1078,7 @@ namespace s3d
 		{
 			Image image{ m_height, m_width };
 
-			// [Siv3D ToDo] 最適化
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = data() + y * m_width;
-				const size_t dstX = m_height - y - 1;
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					image[x][dstX] = pSrc[x];
-				}
-			}
+			ImageFilter::Rotate90(data(), image.data(), m_width, m_height);
 
 			return image;
 		}
@@ -1154,7 +1086,7 @@ namespace s3d
 
 	Image& Image::rotate180()
 	{
-		std::reverse(begin(), end());
+		ImageFilter::Reverse(data(), num_pixels());
 
 		return *this;
 	}
@@ -1173,14 +1105,7 @@ namespace s3d
 		{
 			Image image{ m_width, m_height };
 
-			const Color* pSrc = data() + num_pixels() - 1;
-			Color* pDst = image.data();
-			const Color* const pDstEnd = pDst + image.num_pixels();
-
-			while (pDst != pDstEnd)
-			{
-				*pDst++ = *pSrc--;
-			}
+			ImageFilter::ReverseCopy(data(), image.data(), num_pixels());
 
 			return image;
 		}
@@ -1198,18 +1123,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			// [Siv3D ToDo] 最適化
 			Image tmp{ m_height, m_width };
 
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = (data() + y * m_width);
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					tmp[m_width - x - 1][y] = pSrc[x];
-				}
-			}
+			ImageFilter::Rotate270(data(), tmp.data(), m_width, m_height);
 
 			swap(tmp);
 		}
@@ -1231,21 +1147,13 @@ namespace s3d
 		{
 			Image image{ m_height, m_width };
 
-			for (size_t y = 0; y < m_height; ++y)
-			{
-				const Color* pSrc = (data() + y * m_width);
-
-				for (size_t x = 0; x < m_width; ++x)
-				{
-					image[m_width - x - 1][y] = pSrc[x];
-				}
-			}
+			ImageFilter::Rotate270(data(), image.data(), m_width, m_height);
 
 			return image;
 		}
 	}
 
-	Image& Image::gammaCorrect(const double gamma)
+	Image& Image::gammaCorrect(const double gamma, const Parallel parallel)
 	{
 		// 1. パラメータチェック
 		{
@@ -1260,18 +1168,18 @@ namespace s3d
 			uint8 colorTable[256];
 			detail::InitGammmaTable(gamma, colorTable);
 
-			for (auto& pixel : m_data)
+			detail::ForEachPixel(*this, parallel, [&colorTable](Color& pixel)
 			{
 				pixel.r = colorTable[pixel.r];
 				pixel.g = colorTable[pixel.g];
 				pixel.b = colorTable[pixel.b];
-			}
+			});
 		}
 
 		return *this;
 	}
 
-	Image Image::gammaCorrected(const double gamma) const
+	Image Image::gammaCorrected(const double gamma, const Parallel parallel) const
 	{
 		// 1. パラメータチェック
 		{
@@ -1288,12 +1196,12 @@ namespace s3d
 			uint8 colorTable[256];
 			detail::InitGammmaTable(gamma, colorTable);
 
-			for (auto& pixel : image)
+			detail::ForEachPixel(image, parallel, [&colorTable](Color& pixel)
 			{
 				pixel.r = colorTable[pixel.r];
 				pixel.g = colorTable[pixel.g];
 				pixel.b = colorTable[pixel.b];
-			}
+			});
 
 			return image;
 		}
@@ -1311,42 +1219,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			Color* pDst = data();
-			const Color* pDstEnd = pDst + num_pixels();
-			const double thresholdF = (threshold / 255.0);
-
-			if (invertColor)
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(0);
-					}
-					else
-					{
-						pDst->setRGB(255);
-					}
-
-					++pDst;
-				}
-			}
-			else
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(255);
-					}
-					else
-					{
-						pDst->setRGB(0);
-					}
-
-					++pDst;
-				}
-			}
+			ImageFilter::Threshold(data(), num_pixels(), threshold, invertColor.getBool());
 		}
 
 		return *this;
@@ -1366,42 +1239,7 @@ namespace s3d
 		{
 			Image image{ *this };
 
-			Color* pDst = image.data();
-			const Color* pDstEnd = pDst + num_pixels();
-			const double thresholdF = (threshold / 255.0);
-
-			if (invertColor)
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(0);
-					}
-					else
-					{
-						pDst->setRGB(255);
-					}
-
-					++pDst;
-				}
-			}
-			else
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(255);
-					}
-					else
-					{
-						pDst->setRGB(0);
-					}
-
-					++pDst;
-				}
-			}
+			ImageFilter::Threshold(image.data(), image.num_pixels(), threshold, invertColor.getBool());
 
 			return image;
 		}
@@ -2743,14 +2581,7 @@ namespace s3d
 
 		for (int32 y = 0; y < region.h; ++y)
 		{
-			Color* p = pLine;
-
-			for (int32 x = 0; x < region.w; ++x)
-			{
-				*p = detail::MakeSepia(*p);
-				++p;
-			}
-
+			ImageFilter::Sepia(pLine, region.w);
 			pLine += imageWidth;
 		}
 
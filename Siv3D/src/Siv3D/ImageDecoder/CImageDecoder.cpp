@@ -12,6 +12,7 @@
 # include <Siv3D/FileSystem.hpp>
 # include "CImageDecoder.hpp"
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AllocationTracker.hpp>
 # include <Siv3D/ImageFormat/BMPDecoder.hpp>
 # include <Siv3D/ImageFormat/PNGDecoder.hpp>
 # include <Siv3D/ImageFormat/JPEGDecoder.hpp>
@@ -72,6 +73,8 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CImageDecoder::decode()");
 
+		const ScopedAllocationTag allocationTag{ AllocationTag::Image };
+
 		auto it = findDecoder(imageFormat);
 
 		if (it == m_decoders.end())
@@ -93,6 +96,8 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CImageDecoder::decodeGray16()");
 
+		const ScopedAllocationTag allocationTag{ AllocationTag::Image };
+
 		auto it = findDecoder(imageFormat);
 
 		if (it == m_decoders.end())
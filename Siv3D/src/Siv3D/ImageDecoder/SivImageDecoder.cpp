@@ -11,6 +11,7 @@
 
 # include <Siv3D/ImageDecoder.hpp>
 # include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/MappedReader.hpp>
 # include "IImageDecoder.hpp"
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -37,14 +38,7 @@ namespace s3d
 
 		Image Decode(const FilePathView path, const ImageFormat imageFormat)
 		{
-			BinaryReader reader(path);
-
-			if (not reader)
-			{
-				return{};
-			}
-
-			return SIV3D_ENGINE(ImageDecoder)->decode(reader, path, imageFormat);
+			return detail::ReadWholeFile(path, [&](IReader& reader) { return SIV3D_ENGINE(ImageDecoder)->decode(reader, path, imageFormat); });
 		}
 
 		Image Decode(IReader& reader, const ImageFormat imageFormat)
@@ -54,14 +48,7 @@ namespace s3d
 
 		Grid<uint16> DecodeGray16(FilePathView path, const ImageFormat imageFormat)
 		{
-			BinaryReader reader(path);
-
-			if (not reader)
-			{
-				return{};
-			}
-
-			return SIV3D_ENGINE(ImageDecoder)->decodeGray16(reader, path, imageFormat);
+			return detail::ReadWholeFile(path, [&](IReader& reader) { return SIV3D_ENGINE(ImageDecoder)->decodeGray16(reader, path, imageFormat); });
 		}
 
 		Grid<uint16> DecodeGray16(IReader& reader, const ImageFormat imageFormat)
@@ -11,6 +11,7 @@
 
 # include <Siv3D/ImageFormat/JPEGDecoder.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/MappedReader/MappedReaderUtility.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/libjpeg-turbo/turbojpeg.h>
@@ -123,23 +124,22 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"JPEGDecoder::decode()");
 
-		const int64 size = reader.size();
-
-		uint8* buffer = static_cast<uint8*>(std::malloc(static_cast<size_t>(size)));
-
-		reader.read(buffer, size);
+		Array<Byte> allocated;
+		const std::span<const Byte> data = detail::ReadRemaining(reader, allocated);
+		const uint8* buffer = reinterpret_cast<const uint8*>(data.data());
+		const int64 size = static_cast<int64>(data.size());
 
 		int width, height;
 
 		tjhandle tj = ::tjInitDecompress();
 
-		::tjDecompressHeader(tj, buffer, static_cast<unsigned long>(size), &width, &height);
+		::tjDecompressHeader(tj, const_cast<uint8*>(buffer), static_cast<unsigned long>(size), &width, &height);
 
 		Image image(width, height);
 
 		::tjDecompress(
 			tj,
-			buffer,
+			const_cast<uint8*>(buffer),
 			static_cast<unsigned long>(size),
 			image.dataAsUint8(),
 			image.width(),
@@ -150,8 +150,6 @@ namespace s3d
 
 		::tjDestroy(tj);
 
-		std::free(buffer);
-
 		LOG_VERBOSE(U"Image ({}x{}) decoded"_fmt(
 			width, height));
 
@@ -11,6 +11,7 @@
 
 # include <Siv3D/ImageFormat/WebPDecoder.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/MappedReader/MappedReaderUtility.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/libwebp/decode.h>
@@ -101,20 +102,17 @@ namespace s3d
 		config.options.use_threads = true;
 		config.output.colorspace = MODE_RGBA;
 
-		const int64 dataSize = reader.size();
-		Array<uint8> buffer(dataSize);
+		Array<Byte> buffer;
+		const std::span<const Byte> input = detail::ReadRemaining(reader, buffer);
+		const uint8* data = reinterpret_cast<const uint8*>(input.data());
+		const size_t dataSize = input.size();
 
-		if (dataSize != reader.read(buffer.data(), dataSize))
+		if (::WebPGetFeatures(data, dataSize, bitstream) != VP8_STATUS_OK)
 		{
 			return{};
 		}
 
-		if (::WebPGetFeatures(static_cast<const uint8*>(buffer.data()), dataSize, bitstream) != VP8_STATUS_OK)
-		{
-			return{};
-		}
-
-		if (::WebPDecode(static_cast<const uint8*>(buffer.data()), dataSize, &config) != VP8_STATUS_OK)
+		if (::WebPDecode(data, dataSize, &config) != VP8_STATUS_OK)
 		{
 			return{};
 		}
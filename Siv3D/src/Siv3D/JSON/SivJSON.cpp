@@ -12,9 +12,12 @@
 # include <variant>
 # include <Siv3D/JSON.hpp>
 # include <Siv3D/TextReader.hpp>
+# include <Siv3D/TextEncoding.hpp>
+# include <Siv3D/MappedReader.hpp>
 # include <Siv3D/TextWriter.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <ThirdParty/nlohmann/json.hpp>
+# include <Siv3D/MappedReader/MappedReaderUtility.hpp>
 
 namespace s3d
 {
@@ -88,6 +91,41 @@ namespace s3d
 					std::get<ValueType>(m_json) : std::get<RefType>(m_json).get();
 			}
 		};
+
+		/// @brief MappedReader の UTF-8 テキストを、String への変換を経ずにマップされたデータから直接パースします。
+		/// @param reader IReader
+		/// @remark TextReader を経由した場合と結果が異なりうる入力（NUL 文字、文字列中の \r, 不正な UTF-8）や、パースに失敗した場合は無効な JSON を返します。
+		/// @return JSON オブジェクト
+		[[nodiscard]]
+		static JSON ParseMappedUTF8(const IReader& reader)
+		{
+			const std::span<const Byte> mapped = GetMappedSpan(reader);
+
+			if (mapped.empty())
+			{
+				return JSON::Invalid();
+			}
+
+			const TextEncoding encoding = Unicode::GetTextEncoding(reader);
+
+			if ((encoding != TextEncoding::UTF8_NO_BOM)
+				&& (encoding != TextEncoding::UTF8_WITH_BOM))
+			{
+				return JSON::Invalid();
+			}
+
+			const std::string_view text = std::string_view{ reinterpret_cast<const char*>(mapped.data()), mapped.size() }
+				.substr(Unicode::GetBOMSize(encoding));
+
+			// TextReader は NUL 文字で読み込みを終了する
+			if (text.find('\0') != std::string_view::npos)
+			{
+				return JSON::Invalid();
+			}
+
+			// 文字列中の \r や不正な UTF-8 はパースエラーになるため、その場合は呼び出し側で TextReader を経由して読み込み直す
+			return JSON::ParseUTF8(text);
+		}
 	}
 
 	//////////////////////////////////////////////////
@@ -945,6 +983,14 @@ namespace s3d
 
 	JSON JSON::Load(const FilePathView path, const AllowExceptions allowExceptions)
 	{
+		if (MappedReader mapped{ path })
+		{
+			if (JSON json = detail::ParseMappedUTF8(mapped))
+			{
+				return json;
+			}
+		}
+
 		TextReader reader{ path };
 
 		if (not reader)
@@ -962,6 +1008,14 @@ namespace s3d
 
 	JSON JSON::Load(std::unique_ptr<IReader>&& reader, const AllowExceptions allowExceptions)
 	{
+		if (reader)
+		{
+			if (JSON json = detail::ParseMappedUTF8(*reader))
+			{
+				return json;
+			}
+		}
+
 		TextReader textReader{ std::move(reader) };
 
 		if (not textReader)
@@ -999,6 +1053,28 @@ namespace s3d
 		return value;
 	}
 
+	JSON JSON::ParseUTF8(const std::string_view str, const AllowExceptions allowExceptions)
+	{
+		JSON value{ Invalid_{} };
+
+		try
+		{
+			value.m_detail = std::make_shared<detail::JSONDetail>(detail::JSONDetail::Value(), nlohmann::json::parse(str));
+			value.m_isValid = true;
+		}
+		catch (const std::exception& e)
+		{
+			if (not allowExceptions)
+			{
+				return JSON::Invalid();
+			}
+
+			throw Error{ U"JSON::ParseUTF8(): " + Unicode::Widen(e.what()) };
+		}
+
+		return value;
+	}
+
 	JSON JSON::FromBSON(const Blob& bson, const AllowExceptions allowExceptions)
 	{
 		JSON value{ Invalid_{} };
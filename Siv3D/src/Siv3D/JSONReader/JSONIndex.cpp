@@ -0,0 +1,673 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <charconv>
+# include <cmath>
+# include <limits>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/Unicode/UnicodeSIMD.hpp>
+# include <Siv3D/Unicode/UnicodeUtility.hpp>
+# include <ThirdParty/double-conversion/double-conversion.h>
+# include "JSONIndex.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static constexpr bool IsWhitespace(const char ch) noexcept
+		{
+			return ((ch == ' ') || (ch == '\n') || (ch == '\r') || (ch == '\t'));
+		}
+
+		[[nodiscard]]
+		static constexpr bool IsDigit(const char ch) noexcept
+		{
+			return (('0' <= ch) && (ch <= '9'));
+		}
+
+		[[nodiscard]]
+		static const char* SkipWhitespace(const char* p, const char* const last) noexcept
+		{
+			while ((p != last) && IsWhitespace(*p))
+			{
+				++p;
+			}
+
+			return p;
+		}
+
+		// [first, last) から最初の '"', '\\', 制御文字を探す
+		[[nodiscard]]
+		static const char* FindStringSpecial(const char* first, const char* const last) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			const __m128i quote = _mm_set1_epi8('"');
+			const __m128i backslash = _mm_set1_epi8('\\');
+			const __m128i control = _mm_set1_epi8(0x1F);
+
+			while ((last - first) >= 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				const __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(v, control), v);
+				const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)), isControl);
+
+				if (const int32 mask = _mm_movemask_epi8(m))
+				{
+					return (first + std::countr_zero(static_cast<uint32>(mask)));
+				}
+
+				first += 16;
+			}
+
+		# endif
+
+			for (; first != last; ++first)
+			{
+				const uint8 ch = static_cast<uint8>(*first);
+
+				if ((ch == '"') || (ch == '\\') || (ch <= 0x1F))
+				{
+					break;
+				}
+			}
+
+			return first;
+		}
+
+		[[nodiscard]]
+		static int32 HexValue(const char ch) noexcept
+		{
+			if (IsDigit(ch))
+			{
+				return (ch - '0');
+			}
+			else if (('a' <= ch) && (ch <= 'f'))
+			{
+				return (ch - 'a' + 10);
+			}
+			else if (('A' <= ch) && (ch <= 'F'))
+			{
+				return (ch - 'A' + 10);
+			}
+
+			return -1;
+		}
+
+		// p が \\u の直後を指すとき、4 桁の 16 進数を読む。不正な場合は -1
+		[[nodiscard]]
+		static int32 ReadHex4(const char* p, const char* const last) noexcept
+		{
+			if ((last - p) < 4)
+			{
+				return -1;
+			}
+
+			int32 result = 0;
+
+			for (int32 i = 0; i < 4; ++i)
+			{
+				const int32 h = HexValue(p[i]);
+
+				if (h < 0)
+				{
+					return -1;
+				}
+
+				result = ((result << 4) | h);
+			}
+
+			return result;
+		}
+
+		// p が '"' の次を指すとき、文字列の終端の '"' を探す。構文エラーの場合は nullptr を返す
+		[[nodiscard]]
+		static const char* ScanString(const char* p, const char* const last, bool& escaped) noexcept
+		{
+			escaped = false;
+
+			for (;;)
+			{
+				p = FindStringSpecial(p, last);
+
+				if (p == last)
+				{
+					return nullptr;
+				}
+
+				if (*p == '"')
+				{
+					return p;
+				}
+				else if (*p != '\\')
+				{
+					// エスケープされていない制御文字
+					return nullptr;
+				}
+
+				escaped = true;
+
+				if (++p == last)
+				{
+					return nullptr;
+				}
+
+				switch (*p)
+				{
+				case '"':
+				case '\\':
+				case '/':
+				case 'b':
+				case 'f':
+				case 'n':
+				case 'r':
+				case 't':
+					++p;
+					break;
+				case 'u':
+					{
+						const int32 codeUnit = ReadHex4(p + 1, last);
+						p += 5;
+
+						if (InRange(codeUnit, 0xDC00, 0xDFFF))
+						{
+							return nullptr;
+						}
+						else if (InRange(codeUnit, 0xD800, 0xDBFF))
+						{
+							// 上位サロゲートの後には、下位サロゲートの \\u が続く必要がある
+							if (((last - p) < 2) || (p[0] != '\\') || (p[1] != 'u'))
+							{
+								return nullptr;
+							}
+
+							if (not InRange(ReadHex4(p + 2, last), 0xDC00, 0xDFFF))
+							{
+								return nullptr;
+							}
+
+							p += 6;
+						}
+						else if (codeUnit < 0)
+						{
+							return nullptr;
+						}
+
+						break;
+					}
+				default:
+					return nullptr;
+				}
+			}
+		}
+
+		// 数値を読み、終端を返す。構文エラーの場合は nullptr を返す
+		[[nodiscard]]
+		static const char* ScanNumber(const char* p, const char* const last, JSONNodeType& type) noexcept
+		{
+			const char* const first = p;
+			bool isFloat = false;
+			bool hasExponent = false;
+
+			if (*p == '-')
+			{
+				++p;
+			}
+
+			if (p == last)
+			{
+				return nullptr;
+			}
+
+			if (*p == '0')
+			{
+				++p;
+			}
+			else if (IsDigit(*p))
+			{
+				while ((p != last) && IsDigit(*p))
+				{
+					++p;
+				}
+			}
+			else
+			{
+				return nullptr;
+			}
+
+			if ((p != last) && (*p == '.'))
+			{
+				isFloat = true;
+
+				if ((++p == last) || (not IsDigit(*p)))
+				{
+					return nullptr;
+				}
+
+				while ((p != last) && IsDigit(*p))
+				{
+					++p;
+				}
+			}
+
+			if ((p != last) && ((*p == 'e') || (*p == 'E')))
+			{
+				isFloat = true;
+				hasExponent = true;
+
+				if ((++p != last) && ((*p == '+') || (*p == '-')))
+				{
+					++p;
+				}
+
+				if ((p == last) || (not IsDigit(*p)))
+				{
+					return nullptr;
+				}
+
+				while ((p != last) && IsDigit(*p))
+				{
+					++p;
+				}
+			}
+
+			if (isFloat)
+			{
+				type = JSONNodeType::Float;
+			}
+			else if (*first == '-')
+			{
+				// int64 に収まらない整数は浮動小数点数として扱う
+				int64 value;
+				type = (std::from_chars(first, p, value).ec == std::errc{}) ? JSONNodeType::Integer : JSONNodeType::Float;
+			}
+			else
+			{
+				// uint64 に収まらない整数は浮動小数点数として扱う
+				uint64 value;
+				type = (std::from_chars(first, p, value).ec == std::errc{}) ? JSONNodeType::Unsigned : JSONNodeType::Float;
+			}
+
+			// double の範囲を超える数値は、JSON::Parse() と同じく構文エラーとする
+			if ((type == JSONNodeType::Float)
+				&& (hasExponent || (308 < (p - first)))
+				&& (not std::isfinite(*ParseJSONDouble(std::string_view{ first, static_cast<size_t>(p - first) }, type))))
+			{
+				return nullptr;
+			}
+
+			return p;
+		}
+
+		[[nodiscard]]
+		static const char* ScanLiteral(const char* p, const char* const last, const std::string_view literal) noexcept
+		{
+			if ((static_cast<size_t>(last - p) < literal.size())
+				|| (std::string_view{ p, literal.size() } != literal))
+			{
+				return nullptr;
+			}
+
+			return (p + literal.size());
+		}
+
+		bool JSONIndex::build(const char* const first, const char* const last)
+		{
+			source = first;
+			nodes.clear();
+
+			{
+				// 文字列以外の部分に ASCII 以外の文字は現れないため、
+				// 全体が正しい UTF-8 であれば、すべての文字列は正しい UTF-8 である
+				size_t utf32Length, utf16Length;
+
+				if (not ValidateUTF8(first, (last - first), utf32Length, utf16Length))
+				{
+					return false;
+				}
+			}
+
+			// 開いている配列とオブジェクトのノード
+			Array<uint32> stack;
+
+			const char* p = first;
+
+			// UTF-8 BOM
+			if (((last - p) >= 3)
+				&& (static_cast<uint8>(p[0]) == 0xEF) && (static_cast<uint8>(p[1]) == 0xBB) && (static_cast<uint8>(p[2]) == 0xBF))
+			{
+				p += 3;
+			}
+
+			// 次の値のキー
+			bool hasKey = false;
+			uint64 keyBegin = 0;
+			uint32 keyLength = 0;
+			bool keyEscaped = false;
+
+			// p がキーの '"' を指すとき、キーと ':' を読む
+			auto scanKey = [&]() -> bool
+			{
+				p = SkipWhitespace(p, last);
+
+				if ((p == last) || (*p != '"'))
+				{
+					return false;
+				}
+
+				const char* const keyFirst = (p + 1);
+				const char* const keyLast = ScanString(keyFirst, last, keyEscaped);
+
+				if (not keyLast)
+				{
+					return false;
+				}
+
+				hasKey = true;
+				keyBegin = static_cast<uint64>(keyFirst - first);
+				keyLength = static_cast<uint32>(keyLast - keyFirst);
+
+				p = SkipWhitespace(keyLast + 1, last);
+
+				if ((p == last) || (*p != ':'))
+				{
+					return false;
+				}
+
+				++p;
+
+				return true;
+			};
+
+			for (;;)
+			{
+				// 値を読む
+				p = SkipWhitespace(p, last);
+
+				if ((p == last)
+					|| (std::numeric_limits<uint32>::max() <= nodes.size()))
+				{
+					return false;
+				}
+
+				const uint32 nodeIndex = static_cast<uint32>(nodes.size());
+
+				if (not stack.isEmpty())
+				{
+					++nodes[stack.back()].count;
+				}
+
+				JSONIndexNode node;
+				node.begin = static_cast<uint64>(p - first);
+				node.hasKey = hasKey;
+				node.keyBegin = keyBegin;
+				node.keyLength = keyLength;
+				node.keyEscaped = keyEscaped;
+				hasKey = false;
+
+				bool isContainer = false;
+				const char* valueLast = nullptr;
+
+				switch (*p)
+				{
+				case '{':
+				case '[':
+					node.type = ((*p == '{') ? JSONNodeType::Object : JSONNodeType::Array);
+					isContainer = true;
+					break;
+				case '"':
+					node.type = JSONNodeType::String;
+
+					if (const char* const stringLast = ScanString(p + 1, last, node.valueEscaped))
+					{
+						valueLast = (stringLast + 1);
+					}
+					break;
+				case 't':
+					node.type = JSONNodeType::True;
+					valueLast = ScanLiteral(p, last, "true");
+					break;
+				case 'f':
+					node.type = JSONNodeType::False;
+					valueLast = ScanLiteral(p, last, "false");
+					break;
+				case 'n':
+					node.type = JSONNodeType::Null;
+					valueLast = ScanLiteral(p, last, "null");
+					break;
+				default:
+					valueLast = ScanNumber(p, last, node.type);
+					break;
+				}
+
+				if (isContainer)
+				{
+					const char closing = ((node.type == JSONNodeType::Object) ? '}' : ']');
+					nodes.push_back(node);
+					p = SkipWhitespace(p + 1, last);
+
+					if ((p != last) && (*p == closing))
+					{
+						// 空の配列またはオブジェクト
+						nodes.back().end = static_cast<uint64>(p + 1 - first);
+						nodes.back().next = (nodeIndex + 1);
+						++p;
+					}
+					else
+					{
+						stack.push_back(nodeIndex);
+
+						if ((node.type == JSONNodeType::Object) && (not scanKey()))
+						{
+							return false;
+						}
+
+						continue;
+					}
+				}
+				else
+				{
+					if (not valueLast)
+					{
+						return false;
+					}
+
+					node.end = static_cast<uint64>(valueLast - first);
+					node.next = (nodeIndex + 1);
+					nodes.push_back(node);
+					p = valueLast;
+				}
+
+				// 値の後の ',' または閉じ括弧を読む
+				for (;;)
+				{
+					p = SkipWhitespace(p, last);
+
+					if (stack.isEmpty())
+					{
+						// ルートの後には空白のみが許される
+						return (p == last);
+					}
+
+					if (p == last)
+					{
+						return false;
+					}
+
+					JSONIndexNode& parent = nodes[stack.back()];
+
+					if (*p == ',')
+					{
+						++p;
+
+						if ((parent.type == JSONNodeType::Object) && (not scanKey()))
+						{
+							return false;
+						}
+
+						break;
+					}
+					else if (*p == ((parent.type == JSONNodeType::Object) ? '}' : ']'))
+					{
+						++p;
+						parent.end = static_cast<uint64>(p - first);
+						parent.next = static_cast<uint32>(nodes.size());
+						stack.pop_back();
+					}
+					else
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		std::string_view JSONIndex::raw(const size_t node) const noexcept
+		{
+			const JSONIndexNode& n = nodes[node];
+			return{ (source + n.begin), static_cast<size_t>(n.end - n.begin) };
+		}
+
+		std::string_view JSONIndex::rawString(const size_t node) const noexcept
+		{
+			const JSONIndexNode& n = nodes[node];
+			return{ (source + n.begin + 1), static_cast<size_t>(n.end - n.begin - 2) };
+		}
+
+		std::string_view JSONIndex::rawKey(const size_t node) const noexcept
+		{
+			const JSONIndexNode& n = nodes[node];
+			return{ (source + n.keyBegin), n.keyLength };
+		}
+
+		void UnescapeJSONString(const std::string_view s, std::string& dst)
+		{
+			dst.clear();
+			dst.reserve(s.size());
+
+			const char* p = s.data();
+			const char* const last = (p + s.size());
+
+			while (p != last)
+			{
+				if (*p != '\\')
+				{
+					dst.push_back(*p++);
+					continue;
+				}
+
+				++p;
+
+				switch (*p++)
+				{
+				case 'b':
+					dst.push_back('\b');
+					break;
+				case 'f':
+					dst.push_back('\f');
+					break;
+				case 'n':
+					dst.push_back('\n');
+					break;
+				case 'r':
+					dst.push_back('\r');
+					break;
+				case 't':
+					dst.push_back('\t');
+					break;
+				case 'u':
+					{
+						char32 codePoint = static_cast<char32>(ReadHex4(p, last));
+						p += 4;
+
+						if (InRange<char32>(codePoint, 0xD800, 0xDBFF))
+						{
+							const char32 low = static_cast<char32>(ReadHex4(p + 2, last));
+							p += 6;
+							codePoint = (0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00));
+						}
+
+						char8 buffer[4];
+						char8* pDst = buffer;
+						UTF8_Encode(&pDst, codePoint);
+						dst.append(buffer, pDst);
+						break;
+					}
+				default:
+					// '"', '\\', '/'
+					dst.push_back(p[-1]);
+					break;
+				}
+			}
+		}
+
+		String DecodeJSONString(const std::string_view s, const bool escaped)
+		{
+			if (not escaped)
+			{
+				return Unicode::FromUTF8(s);
+			}
+
+			std::string unescaped;
+			UnescapeJSONString(s, unescaped);
+			return Unicode::FromUTF8(unescaped);
+		}
+
+		Optional<int64> ParseJSONInt64(const std::string_view s, const JSONNodeType type) noexcept
+		{
+			if (type == JSONNodeType::Integer)
+			{
+				int64 value = 0;
+				std::from_chars(s.data(), (s.data() + s.size()), value);
+				return value;
+			}
+			else if (type == JSONNodeType::Unsigned)
+			{
+				uint64 value = 0;
+				std::from_chars(s.data(), (s.data() + s.size()), value);
+				return static_cast<int64>(value);
+			}
+			else if (type == JSONNodeType::Float)
+			{
+				return static_cast<int64>(*ParseJSONDouble(s, type));
+			}
+
+			return none;
+		}
+
+		Optional<double> ParseJSONDouble(const std::string_view s, const JSONNodeType type) noexcept
+		{
+			if (type == JSONNodeType::Integer)
+			{
+				return static_cast<double>(*ParseJSONInt64(s, type));
+			}
+			else if (type == JSONNodeType::Unsigned)
+			{
+				uint64 value = 0;
+				std::from_chars(s.data(), (s.data() + s.size()), value);
+				return static_cast<double>(value);
+			}
+			else if (type == JSONNodeType::Float)
+			{
+				using namespace double_conversion;
+				const StringToDoubleConverter conv(StringToDoubleConverter::NO_FLAGS, 0.0, 0.0, nullptr, nullptr);
+
+				int unused;
+				return conv.StringToDouble(s.data(), static_cast<int>(s.size()), &unused);
+			}
+
+			return none;
+		}
+	}
+}
@@ -0,0 +1,112 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <string>
+# include <string_view>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Optional.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		enum class JSONNodeType : uint8
+		{
+			Null,
+
+			False,
+
+			True,
+
+			// 負の整数
+			Integer,
+
+			// 0 以上の整数
+			Unsigned,
+
+			Float,
+
+			String,
+
+			Array,
+
+			Object,
+		};
+
+		// 値 1 つ分の索引。ノードは値の出現順（前順）に並ぶ
+		struct JSONIndexNode
+		{
+			// 値の先頭と終端（ソースの先頭からのバイト数）
+			uint64 begin = 0;
+
+			uint64 end = 0;
+
+			// オブジェクトの要素である場合、キーの先頭（" の次）のバイト位置と長さ
+			uint64 keyBegin = 0;
+
+			uint32 keyLength = 0;
+
+			// この値以下の部分木の次のノード
+			uint32 next = 0;
+
+			// 配列またはオブジェクトの要素数
+			uint32 count = 0;
+
+			JSONNodeType type = JSONNodeType::Null;
+
+			bool hasKey = false;
+
+			// 文字列の値またはキーがエスケープシーケンスを含むか
+			bool valueEscaped = false;
+
+			bool keyEscaped = false;
+		};
+
+		struct JSONIndex
+		{
+			const char* source = nullptr;
+
+			Array<JSONIndexNode> nodes;
+
+			// [first, last) の UTF-8 の JSON の構文を検証して索引を作成する。構文エラーがある場合は false を返す
+			[[nodiscard]]
+			bool build(const char* first, const char* last);
+
+			[[nodiscard]]
+			std::string_view raw(size_t node) const noexcept;
+
+			// 文字列の値の中身（エスケープシーケンスを含む）
+			[[nodiscard]]
+			std::string_view rawString(size_t node) const noexcept;
+
+			// キーの中身（エスケープシーケンスを含む）
+			[[nodiscard]]
+			std::string_view rawKey(size_t node) const noexcept;
+		};
+
+		// build() で検証済みの JSON 文字列の中身のエスケープシーケンスを UTF-8 に戻して dst に格納する
+		void UnescapeJSONString(std::string_view s, std::string& dst);
+
+		// build() で検証済みの JSON 文字列の中身を String に変換する
+		[[nodiscard]]
+		String DecodeJSONString(std::string_view s, bool escaped);
+
+		// build() で検証済みの JSON の数値をパースする
+		[[nodiscard]]
+		Optional<int64> ParseJSONInt64(std::string_view s, JSONNodeType type) noexcept;
+
+		[[nodiscard]]
+		Optional<double> ParseJSONDouble(std::string_view s, JSONNodeType type) noexcept;
+	}
+}
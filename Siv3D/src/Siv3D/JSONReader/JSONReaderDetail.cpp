@@ -0,0 +1,220 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Unicode/UnicodeUtility.hpp>
+# include <ThirdParty/nlohmann/json.hpp>
+# include "JSONReaderDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// nlohmann::json の SAX イベントを IJSONHandler に渡す
+		class JSONSAXAdapter
+		{
+		public:
+
+			explicit JSONSAXAdapter(IJSONHandler& handler)
+				: m_handler{ handler } {}
+
+			bool null()
+			{
+				return m_handler.onNull();
+			}
+
+			bool boolean(const bool value)
+			{
+				return m_handler.onBool(value);
+			}
+
+			bool number_integer(const nlohmann::json::number_integer_t value)
+			{
+				return m_handler.onInt64(value);
+			}
+
+			bool number_unsigned(const nlohmann::json::number_unsigned_t value)
+			{
+				return m_handler.onUint64(value);
+			}
+
+			bool number_float(const nlohmann::json::number_float_t value, const nlohmann::json::string_t&)
+			{
+				return m_handler.onDouble(value);
+			}
+
+			bool string(nlohmann::json::string_t& value)
+			{
+				return m_handler.onString(decode(value));
+			}
+
+			bool binary(nlohmann::json::binary_t&)
+			{
+				return true;
+			}
+
+			bool start_object(std::size_t)
+			{
+				return m_handler.onObjectBegin();
+			}
+
+			bool key(nlohmann::json::string_t& value)
+			{
+				return m_handler.onKey(decode(value));
+			}
+
+			bool end_object()
+			{
+				return m_handler.onObjectEnd();
+			}
+
+			bool start_array(std::size_t)
+			{
+				return m_handler.onArrayBegin();
+			}
+
+			bool end_array()
+			{
+				return m_handler.onArrayEnd();
+			}
+
+			bool parse_error(const std::size_t position, const std::string&, const nlohmann::detail::exception& e)
+			{
+				m_handler.onError(position, Unicode::Widen(e.what()));
+				return false;
+			}
+
+		private:
+
+			IJSONHandler& m_handler;
+
+			// 文字列ごとのメモリ確保を避けるため、変換先のバッファを使いまわす
+			String m_buffer;
+
+			// nlohmann::json は、正しい UTF-8 の文字列のみを渡す
+			[[nodiscard]]
+			StringView decode(const std::string_view s)
+			{
+				m_buffer.resize(UTF32_Length(s));
+				UTF8_DecodeValid(m_buffer.data(), s);
+				return m_buffer;
+			}
+		};
+	}
+
+	JSONReader::JSONReaderDetail::JSONReaderDetail() {}
+
+	JSONReader::JSONReaderDetail::~JSONReaderDetail()
+	{
+		close();
+	}
+
+	bool JSONReader::JSONReaderDetail::open(const FilePathView path)
+	{
+		close();
+
+		if (m_mapped.open(path))
+		{
+			const std::span<const Byte> data = m_mapped.span();
+			m_first = reinterpret_cast<const char*>(data.data());
+			m_last = (m_first + data.size());
+			m_fullPath = m_mapped.path();
+		}
+		else
+		{
+			BinaryReader reader{ path };
+
+			if (not reader)
+			{
+				return false;
+			}
+
+			m_blob = Blob{ reader };
+			m_first = reinterpret_cast<const char*>(m_blob.data());
+			m_last = (m_first + m_blob.size());
+			m_fullPath = reader.path();
+		}
+
+		// nlohmann::json と同じく、NUL 文字を入力の終わりとして扱う（read() と root() の結果をそろえる）
+		if (const void* nul = ((m_first != m_last) ? std::memchr(m_first, '\0', static_cast<size_t>(m_last - m_first)) : nullptr))
+		{
+			m_last = static_cast<const char*>(nul);
+		}
+
+		m_isOpen = true;
+
+		return true;
+	}
+
+	void JSONReader::JSONReaderDetail::close()
+	{
+		if (not m_isOpen)
+		{
+			return;
+		}
+
+		m_index = {};
+		m_indexed = false;
+		m_indexValid = false;
+
+		m_mapped.close();
+		m_blob.release();
+		m_fullPath.clear();
+		m_first = m_last = nullptr;
+		m_isOpen = false;
+	}
+
+	bool JSONReader::JSONReaderDetail::isOpen() const noexcept
+	{
+		return m_isOpen;
+	}
+
+	bool JSONReader::JSONReaderDetail::read(IJSONHandler& handler) const
+	{
+		if (not m_isOpen)
+		{
+			return false;
+		}
+
+		detail::JSONSAXAdapter adapter{ handler };
+
+		return nlohmann::json::sax_parse(m_first, m_last, &adapter);
+	}
+
+	const detail::JSONIndex* JSONReader::JSONReaderDetail::getIndex()
+	{
+		if (not m_isOpen)
+		{
+			return nullptr;
+		}
+
+		if (not m_indexed)
+		{
+			m_indexValid = m_index.build(m_first, m_last);
+			m_indexed = true;
+
+			if (not m_indexValid)
+			{
+				m_index = {};
+			}
+		}
+
+		return (m_indexValid ? &m_index : nullptr);
+	}
+
+	const FilePath& JSONReader::JSONReaderDetail::path() const noexcept
+	{
+		return m_fullPath;
+	}
+}
@@ -0,0 +1,66 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/JSONReader.hpp>
+# include <Siv3D/MappedReader.hpp>
+# include <Siv3D/Blob.hpp>
+# include "JSONIndex.hpp"
+
+namespace s3d
+{
+	class JSONReader::JSONReaderDetail
+	{
+	public:
+
+		JSONReaderDetail();
+
+		~JSONReaderDetail();
+
+		[[nodiscard]]
+		bool open(FilePathView path);
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		bool read(IJSONHandler& handler) const;
+
+		// 最初の呼び出しで索引を作成する。構文エラーがある場合は nullptr を返す
+		[[nodiscard]]
+		const detail::JSONIndex* getIndex();
+
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		MappedReader m_mapped;
+
+		// メモリマップできないファイル（リソースなど）の場合は、ファイル全体を読み込む
+		Blob m_blob;
+
+		FilePath m_fullPath;
+
+		const char* m_first = nullptr;
+
+		const char* m_last = nullptr;
+
+		bool m_isOpen = false;
+
+		bool m_indexed = false;
+
+		bool m_indexValid = false;
+
+		detail::JSONIndex m_index;
+	};
+}
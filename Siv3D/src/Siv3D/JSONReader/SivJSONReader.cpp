@@ -0,0 +1,65 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/JSONReader.hpp>
+# include "JSONReaderDetail.hpp"
+
+namespace s3d
+{
+	JSONReader::JSONReader()
+		: pImpl{ std::make_shared<JSONReaderDetail>() } {}
+
+	JSONReader::JSONReader(const FilePathView path)
+		: JSONReader{}
+	{
+		open(path);
+	}
+
+	bool JSONReader::open(const FilePathView path)
+	{
+		return pImpl->open(path);
+	}
+
+	void JSONReader::close()
+	{
+		pImpl->close();
+	}
+
+	bool JSONReader::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	JSONReader::operator bool() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	bool JSONReader::read(IJSONHandler& handler) const
+	{
+		return pImpl->read(handler);
+	}
+
+	JSONValueView JSONReader::root() const
+	{
+		if (const detail::JSONIndex* index = pImpl->getIndex())
+		{
+			return JSONValueView{ index, 0 };
+		}
+
+		return{};
+	}
+
+	const FilePath& JSONReader::path() const noexcept
+	{
+		return pImpl->path();
+	}
+}
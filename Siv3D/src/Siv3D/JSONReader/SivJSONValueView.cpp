@@ -0,0 +1,332 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/JSONReader.hpp>
+# include "JSONIndex.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static constexpr bool IsContainer(const JSONNodeType type) noexcept
+		{
+			return ((type == JSONNodeType::Array) || (type == JSONNodeType::Object));
+		}
+	}
+
+	////////////////////////////////////////////////
+	//
+	//	JSONValueView::Iterator
+	//
+	////////////////////////////////////////////////
+
+	JSONValueView::Iterator::Iterator(const detail::JSONIndex* index, const size_t node) noexcept
+		: m_index{ index }
+		, m_node{ node } {}
+
+	JSONValueView JSONValueView::Iterator::operator *() const noexcept
+	{
+		return JSONValueView{ m_index, m_node };
+	}
+
+	JSONValueView::Iterator& JSONValueView::Iterator::operator ++() noexcept
+	{
+		m_node = m_index->nodes[m_node].next;
+
+		return *this;
+	}
+
+	JSONValueView::Iterator JSONValueView::Iterator::operator ++(int) noexcept
+	{
+		const Iterator it = *this;
+
+		++(*this);
+
+		return it;
+	}
+
+	bool JSONValueView::Iterator::operator ==(const Iterator& other) const noexcept
+	{
+		return ((m_index == other.m_index) && (m_node == other.m_node));
+	}
+
+	bool JSONValueView::Iterator::operator !=(const Iterator& other) const noexcept
+	{
+		return (not (*this == other));
+	}
+
+	////////////////////////////////////////////////
+	//
+	//	JSONValueView
+	//
+	////////////////////////////////////////////////
+
+	JSONValueView::JSONValueView(const detail::JSONIndex* index, const size_t node) noexcept
+		: m_index{ index }
+		, m_node{ node } {}
+
+	bool JSONValueView::isEmpty() const noexcept
+	{
+		return (m_index == nullptr);
+	}
+
+	JSONValueView::operator bool() const noexcept
+	{
+		return (m_index != nullptr);
+	}
+
+	bool JSONValueView::isNull() const noexcept
+	{
+		return (getType() == JSONValueType::Null);
+	}
+
+	bool JSONValueView::isBool() const noexcept
+	{
+		return (getType() == JSONValueType::Bool);
+	}
+
+	bool JSONValueView::isNumber() const noexcept
+	{
+		return (getType() == JSONValueType::Number);
+	}
+
+	bool JSONValueView::isInteger() const noexcept
+	{
+		if (not m_index)
+		{
+			return false;
+		}
+
+		const detail::JSONNodeType type = m_index->nodes[m_node].type;
+
+		return ((type == detail::JSONNodeType::Integer) || (type == detail::JSONNodeType::Unsigned));
+	}
+
+	bool JSONValueView::isUnsigned() const noexcept
+	{
+		return (m_index && (m_index->nodes[m_node].type == detail::JSONNodeType::Unsigned));
+	}
+
+	bool JSONValueView::isFloat() const noexcept
+	{
+		return (m_index && (m_index->nodes[m_node].type == detail::JSONNodeType::Float));
+	}
+
+	bool JSONValueView::isString() const noexcept
+	{
+		return (getType() == JSONValueType::String);
+	}
+
+	bool JSONValueView::isArray() const noexcept
+	{
+		return (getType() == JSONValueType::Array);
+	}
+
+	bool JSONValueView::isObject() const noexcept
+	{
+		return (getType() == JSONValueType::Object);
+	}
+
+	JSONValueType JSONValueView::getType() const noexcept
+	{
+		if (not m_index)
+		{
+			return JSONValueType::Empty;
+		}
+
+		switch (m_index->nodes[m_node].type)
+		{
+		case detail::JSONNodeType::Null:
+			return JSONValueType::Null;
+		case detail::JSONNodeType::False:
+		case detail::JSONNodeType::True:
+			return JSONValueType::Bool;
+		case detail::JSONNodeType::Integer:
+		case detail::JSONNodeType::Unsigned:
+		case detail::JSONNodeType::Float:
+			return JSONValueType::Number;
+		case detail::JSONNodeType::String:
+			return JSONValueType::String;
+		case detail::JSONNodeType::Array:
+			return JSONValueType::Array;
+		default:
+			return JSONValueType::Object;
+		}
+	}
+
+	size_t JSONValueView::size() const noexcept
+	{
+		if (not m_index)
+		{
+			return 0;
+		}
+
+		return m_index->nodes[m_node].count;
+	}
+
+	bool JSONValueView::hasElement(const StringView name) const
+	{
+		return (not operator [](name).isEmpty());
+	}
+
+	JSONValueView JSONValueView::operator [](const StringView name) const
+	{
+		if (not isObject())
+		{
+			return{};
+		}
+
+		const std::string key = Unicode::ToUTF8(name);
+		std::string unescaped;
+		JSONValueView result;
+
+		// キーが重複する場合は、JSON::Parse() と同じく後の要素を返す
+		for (auto it = begin(); it != end(); ++it)
+		{
+			const size_t node = it.m_node;
+			std::string_view rawKey = m_index->rawKey(node);
+
+			if (m_index->nodes[node].keyEscaped)
+			{
+				detail::UnescapeJSONString(rawKey, unescaped);
+				rawKey = unescaped;
+			}
+
+			if (rawKey == key)
+			{
+				result = *it;
+			}
+		}
+
+		return result;
+	}
+
+	JSONValueView JSONValueView::operator [](const size_t index) const
+	{
+		if (index >= size())
+		{
+			return{};
+		}
+
+		auto it = begin();
+
+		for (size_t i = 0; i < index; ++i)
+		{
+			++it;
+		}
+
+		return *it;
+	}
+
+	JSONValueView::Iterator JSONValueView::begin() const noexcept
+	{
+		if (not m_index)
+		{
+			return{};
+		}
+
+		const detail::JSONIndexNode& node = m_index->nodes[m_node];
+
+		if (not detail::IsContainer(node.type))
+		{
+			return{ m_index, node.next };
+		}
+
+		return{ m_index, (m_node + 1) };
+	}
+
+	JSONValueView::Iterator JSONValueView::end() const noexcept
+	{
+		if (not m_index)
+		{
+			return{};
+		}
+
+		return{ m_index, m_index->nodes[m_node].next };
+	}
+
+	String JSONValueView::key() const
+	{
+		if ((not m_index)
+			|| (not m_index->nodes[m_node].hasKey))
+		{
+			return{};
+		}
+
+		return detail::DecodeJSONString(m_index->rawKey(m_node), m_index->nodes[m_node].keyEscaped);
+	}
+
+	String JSONValueView::getString() const
+	{
+		return getOptString().value_or(String{});
+	}
+
+	std::string_view JSONValueView::raw() const noexcept
+	{
+		if (not m_index)
+		{
+			return{};
+		}
+
+		return m_index->raw(m_node);
+	}
+
+	JSON JSONValueView::toJSON() const
+	{
+		if (not m_index)
+		{
+			return JSON::Invalid();
+		}
+
+		return JSON::ParseUTF8(raw());
+	}
+
+	Optional<String> JSONValueView::getOptString() const
+	{
+		if (not isString())
+		{
+			return none;
+		}
+
+		return detail::DecodeJSONString(m_index->rawString(m_node), m_index->nodes[m_node].valueEscaped);
+	}
+
+	Optional<int64> JSONValueView::getOptInt64() const
+	{
+		if (not isNumber())
+		{
+			return none;
+		}
+
+		return detail::ParseJSONInt64(raw(), m_index->nodes[m_node].type);
+	}
+
+	Optional<double> JSONValueView::getOptDouble() const
+	{
+		if (not isNumber())
+		{
+			return none;
+		}
+
+		return detail::ParseJSONDouble(raw(), m_index->nodes[m_node].type);
+	}
+
+	Optional<bool> JSONValueView::getOptBool() const
+	{
+		if (not isBool())
+		{
+			return none;
+		}
+
+		return (m_index->nodes[m_node].type == detail::JSONNodeType::True);
+	}
+}
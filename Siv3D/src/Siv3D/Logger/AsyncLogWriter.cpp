@@ -0,0 +1,434 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <array>
+# include <Siv3D/FormatInt.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/Unicode.hpp>
+# include "AsyncLogWriter.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr std::array<StringView, 7> LogTypeNames =
+		{
+			U"[error]   "_sv,
+			U"[fail]    "_sv,
+			U"[warning] "_sv,
+			U""_sv,
+			U"[info]    "_sv,
+			U"[trace]   "_sv,
+			U"[verbose] "_sv,
+		};
+
+		static void AppendLog(String& batch, const int64 timeStamp, const LogType type, const StringView s)
+		{
+			batch.append(ToString(timeStamp));
+			batch.append(U": "_sv);
+			batch.append(LogTypeNames[FromEnum(type)]);
+			batch.append(s);
+			batch.push_back(U'\n');
+		}
+
+		LogQueue::LogQueue(const size_t capacity)
+			: m_cells{ std::make_unique<Cell[]>(capacity) }
+			, m_mask{ (capacity - 1) }
+		{
+			assert((capacity != 0) && ((capacity & (capacity - 1)) == 0));
+
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				m_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		bool LogQueue::push(LogEntry&& entry)
+		{
+			size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				Cell& cell = m_cells[pos & m_mask];
+				const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				const intptr_t diff = (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos));
+
+				if (diff == 0)
+				{
+					if (m_enqueuePos.compare_exchange_weak(pos, (pos + 1), std::memory_order_relaxed))
+					{
+						cell.entry = std::move(entry);
+						cell.sequence.store((pos + 1), std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool LogQueue::pop(LogEntry& entry)
+		{
+			Cell& cell = m_cells[m_dequeuePos & m_mask];
+			const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+			if (sequence != (m_dequeuePos + 1))
+			{
+				return false;
+			}
+
+			entry = std::move(cell.entry);
+			cell.entry.text.clear();
+			cell.sequence.store((m_dequeuePos + m_mask + 1), std::memory_order_release);
+			++m_dequeuePos;
+
+			return true;
+		}
+
+		bool LogQueue::isEmpty() const noexcept
+		{
+			const Cell& cell = m_cells[m_dequeuePos & m_mask];
+
+			return (cell.sequence.load(std::memory_order_acquire) != (m_dequeuePos + 1));
+		}
+	}
+
+	AsyncLogWriter::AsyncLogWriter(OutputFunction output)
+		: m_output{ std::move(output) }
+	{
+	# if not SIV3D_PLATFORM(WEB)
+
+		m_thread = std::thread{ [this]() { run(); } };
+
+	# endif
+	}
+
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		if (m_thread.joinable())
+		{
+			{
+				std::lock_guard lock{ m_mutex };
+				m_quit = true;
+			}
+
+			m_wakeCondition.notify_one();
+
+			m_thread.join();
+		}
+	}
+
+	bool AsyncLogWriter::push(const LogType type, const StringView s)
+	{
+		const int64 timeStamp = Time::GetMillisec();
+
+	# if SIV3D_PLATFORM(WEB)
+
+		// スレッドを使えない環境では、その場で出力する
+		writeNow(timeStamp, type, s);
+		return true;
+
+	# else
+
+		// 書き込みスレッド自身のログ（ファイルのローテーションの失敗など）は、待つこともその場で出力することもできない
+		const bool onWriterThread = (std::this_thread::get_id() == m_thread.get_id());
+
+		// 書き込みスレッドが無い、または終了処理中の場合は、キューに追加しても出力されないため、その場で出力する
+		if ((not onWriterThread) && (not isWriterRunning()))
+		{
+			writeNow(timeStamp, type, s);
+			return true;
+		}
+
+		// エラーは、プロセスがクラッシュしても残るように、破棄せずにファイルに書き込むまで待つ
+		const bool critical = (((type == LogType::Error) || (type == LogType::Fail)) && (not onWriterThread));
+
+		detail::LogEntry entry{ timeStamp, type, String{ s } };
+
+		while (not m_queue.push(std::move(entry)))
+		{
+			if (not critical)
+			{
+				++m_droppedCount;
+				return false;
+			}
+
+			// 書き込みスレッドが終了した場合は、キューが空くのを待たずにその場で出力する
+			if (not isWriterRunning())
+			{
+				writeNow(timeStamp, type, s);
+				return true;
+			}
+
+			// キューが空くまで待つ（push() は失敗した場合 entry を変更しない）
+			wakeWriter();
+			std::this_thread::yield();
+		}
+
+		++m_pushedCount;
+
+		if (critical)
+		{
+			flush();
+		}
+		else
+		{
+			// キューへの追加と m_sleeping の読み取りの順序を保証し、run() の待機と行き違わないようにする
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (m_sleeping.load(std::memory_order_relaxed))
+			{
+				wakeWriter();
+			}
+		}
+
+		return true;
+
+	# endif
+	}
+
+	void AsyncLogWriter::flush()
+	{
+		if (not m_thread.joinable())
+		{
+			return;
+		}
+
+		const uint64 target = m_pushedCount.load();
+
+		std::unique_lock lock{ m_mutex };
+
+		m_wakeCondition.notify_one();
+
+		// 書き込みスレッドが終了した後に追加されたログは出力されないため、終了した場合も戻る
+		m_flushCondition.wait(lock, [&]() { return ((target <= m_writtenCount.load()) || m_stopped.load()); });
+	}
+
+	bool AsyncLogWriter::setOutputFile(const FilePathView path, const size_t maxFileSize, const size_t maxBackupFiles)
+	{
+		flush();
+
+		std::lock_guard lock{ m_fileMutex };
+
+		m_file.close();
+		m_filePath.clear();
+		m_fileSize = 0;
+
+		if (not path)
+		{
+			return true;
+		}
+
+		if (not m_file.open(path, OpenMode::Append))
+		{
+			return false;
+		}
+
+		m_filePath = path;
+		m_maxFileSize = maxFileSize;
+		m_maxBackupFiles = maxBackupFiles;
+		m_fileSize = m_file.size();
+
+		return true;
+	}
+
+	void AsyncLogWriter::run()
+	{
+		String batch;
+		std::string utf8;
+
+		for (;;)
+		{
+			const size_t count = writeQueuedLogs(batch, utf8);
+
+			if (count)
+			{
+				{
+					std::lock_guard lock{ m_mutex };
+					m_writtenCount += count;
+				}
+
+				m_flushCondition.notify_all();
+
+				continue;
+			}
+
+			std::unique_lock lock{ m_mutex };
+
+			if (m_quit)
+			{
+				break;
+			}
+
+			m_sleeping.store(true, std::memory_order_relaxed);
+
+			// push() でのキューへの追加と m_sleeping の読み取りに対応する
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			m_wakeCondition.wait(lock, [&]() { return (m_quit || (not m_queue.isEmpty())); });
+
+			m_sleeping.store(false, std::memory_order_relaxed);
+		}
+
+		// 終了前に追加されたログを出力する
+		const size_t count = writeQueuedLogs(batch, utf8);
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_writtenCount += count;
+			m_stopped = true;
+		}
+
+		m_flushCondition.notify_all();
+	}
+
+	bool AsyncLogWriter::isWriterRunning() const noexcept
+	{
+		return (m_thread.joinable() && (not m_quit.load()) && (not m_stopped.load()));
+	}
+
+	void AsyncLogWriter::writeNow(const int64 timeStamp, const LogType type, const StringView s)
+	{
+		std::lock_guard lock{ m_mutex };
+		String text;
+		detail::AppendLog(text, timeStamp, type, s);
+		const std::string utf8 = Unicode::ToUTF8(text);
+		m_output(text, utf8);
+		writeFile(utf8);
+	}
+
+	void AsyncLogWriter::wakeWriter()
+	{
+		// 書き込みスレッドが条件を確認してから待機するまでの間に通知しないよう、ロックを取ってから通知する
+		{
+			std::lock_guard lock{ m_mutex };
+		}
+
+		m_wakeCondition.notify_one();
+	}
+
+	size_t AsyncLogWriter::writeQueuedLogs(String& batch, std::string& utf8)
+	{
+		batch.clear();
+
+		size_t count = 0;
+		detail::LogEntry entry;
+
+		while (m_queue.pop(entry))
+		{
+			detail::AppendLog(batch, entry.timeStamp, entry.type, entry.text);
+			++count;
+		}
+
+		if (const uint64 dropped = m_droppedCount.exchange(0))
+		{
+			detail::AppendLog(batch, Time::GetMillisec(), LogType::Warning, U"Logger: {} log messages were dropped because the queue was full"_fmt(dropped));
+		}
+
+		if (batch)
+		{
+			utf8 = Unicode::ToUTF8(batch);
+			m_output(batch, utf8);
+			writeFile(utf8);
+		}
+
+		return count;
+	}
+
+	void AsyncLogWriter::writeFile(const std::string& utf8)
+	{
+		std::lock_guard lock{ m_fileMutex };
+
+		if (not m_file)
+		{
+			return;
+		}
+
+		std::string_view rest{ utf8 };
+
+		while (not rest.empty())
+		{
+			size_t size = rest.size();
+
+			// 最大サイズを超える場合は、収まる行までを書き込んでから次のファイルに移る
+			if (m_maxFileSize && (m_maxFileSize < (static_cast<size_t>(m_fileSize) + size)))
+			{
+				const size_t room = ((static_cast<size_t>(m_fileSize) < m_maxFileSize) ? (m_maxFileSize - static_cast<size_t>(m_fileSize)) : 0);
+				const size_t lineEnd = (room ? rest.rfind('\n', (room - 1)) : std::string_view::npos);
+
+				if (lineEnd != std::string_view::npos)
+				{
+					size = (lineEnd + 1);
+				}
+				else if (0 < m_fileSize)
+				{
+					rotateFile();
+
+					if (not m_file)
+					{
+						return;
+					}
+
+					continue;
+				}
+				else
+				{
+					// 1 行が最大サイズを超える
+					size = (Min(rest.find('\n'), (rest.size() - 1)) + 1);
+				}
+			}
+
+			m_file.write(rest.data(), size);
+			m_fileSize += size;
+			rest.remove_prefix(size);
+		}
+
+		m_file.flush();
+	}
+
+	void AsyncLogWriter::rotateFile()
+	{
+		m_file.close();
+
+		// path.(n-1) -> path.n, ..., path -> path.1
+		if (m_maxBackupFiles == 0)
+		{
+			FileSystem::Remove(m_filePath);
+		}
+		else
+		{
+			FileSystem::Remove(U"{}.{}"_fmt(m_filePath, m_maxBackupFiles));
+
+			for (size_t i = m_maxBackupFiles; 1 < i; --i)
+			{
+				const FilePath from = U"{}.{}"_fmt(m_filePath, (i - 1));
+
+				if (FileSystem::Exists(from))
+				{
+					FileSystem::Rename(from, U"{}.{}"_fmt(m_filePath, i));
+				}
+			}
+
+			FileSystem::Rename(m_filePath, (m_filePath + U".1"));
+		}
+
+		m_file.open(m_filePath, OpenMode::Trunc);
+		m_fileSize = 0;
+	}
+}
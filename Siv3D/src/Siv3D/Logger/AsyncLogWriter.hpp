@@ -0,0 +1,183 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
+# include <functional>
+# include <memory>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/LogType.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief ログの 1 行
+		struct LogEntry
+		{
+			int64 timeStamp = 0;
+
+			LogType type = LogType::App;
+
+			String text;
+		};
+
+		/// @brief 固定長のログのキュー
+		/// @remark 追加は複数のスレッドから、取り出しは 1 つのスレッドからロックせずに行えます。
+		class LogQueue
+		{
+		public:
+
+			SIV3D_NODISCARD_CXX20
+			explicit LogQueue(size_t capacity);
+
+			LogQueue(const LogQueue&) = delete;
+
+			LogQueue& operator =(const LogQueue&) = delete;
+
+			/// @brief ログを追加します。（任意のスレッド）
+			/// @param entry ログ
+			/// @return 追加した場合 true, キューが満杯の場合は false（entry は変更されません）
+			[[nodiscard]]
+			bool push(LogEntry&& entry);
+
+			/// @brief 先頭のログを取り出します。（取り出しスレッド）
+			/// @param entry 取り出したログの格納先
+			/// @return 取り出した場合 true, キューが空の場合は false
+			[[nodiscard]]
+			bool pop(LogEntry& entry);
+
+			/// @brief キューが空であるかを返します。
+			[[nodiscard]]
+			bool isEmpty() const noexcept;
+
+		private:
+
+			struct Cell
+			{
+				std::atomic<size_t> sequence = 0;
+
+				LogEntry entry;
+			};
+
+			std::unique_ptr<Cell[]> m_cells;
+
+			const size_t m_mask;
+
+			alignas(64) std::atomic<size_t> m_enqueuePos = 0;
+
+			alignas(64) size_t m_dequeuePos = 0;
+		};
+	}
+
+	/// @brief ログをバックグラウンドのスレッドでまとめて出力するクラス
+	/// @remark ログを書き込んだスレッドは、キューに追加するだけで出力を待ちません。
+	/// @remark キューが満杯の場合、ログは破棄され、破棄した件数が後で出力されます。
+	/// @remark ただし LogType::Error と LogType::Fail のログは破棄せず、出力されるまで待ちます。
+	class AsyncLogWriter
+	{
+	public:
+
+		/// @brief キューに保持できるログの最大数
+		static constexpr size_t QueueCapacity = 8192;
+
+		/// @brief 出力先（コンソールやデバッガ）に複数行のテキストを書き込む関数。UTF-32 と UTF-8 の同じテキストが渡されます。
+		using OutputFunction = std::function<void(const String&, const std::string&)>;
+
+		SIV3D_NODISCARD_CXX20
+		explicit AsyncLogWriter(OutputFunction output);
+
+		~AsyncLogWriter();
+
+		/// @brief ログを追加します。
+		/// @param type ログの種類
+		/// @param s テキスト
+		/// @return 追加した場合 true, キューが満杯で破棄した場合は false
+		/// @remark LogType::Error と LogType::Fail のログは、キューが空くのを待って追加し、ファイルに書き込まれるまで待ちます。
+		bool push(LogType type, StringView s);
+
+		/// @brief それまでに追加したすべてのログが出力されるまで待ちます。
+		void flush();
+
+		/// @brief ログをファイルにも書き込みます。
+		/// @param path ファイルパス。空の場合はファイルへの書き込みを終了します。
+		/// @param maxFileSize ファイルの最大サイズ（バイト）。超える場合は古いファイルの名前を変更して新しいファイルに書き込みます。
+		/// @param maxBackupFiles 名前を変更して残す古いファイルの最大数
+		/// @return ファイルを開けた場合 true, それ以外の場合は false
+		bool setOutputFile(FilePathView path, size_t maxFileSize, size_t maxBackupFiles);
+
+	private:
+
+		OutputFunction m_output;
+
+		detail::LogQueue m_queue{ QueueCapacity };
+
+		std::atomic<uint64> m_pushedCount = 0;
+
+		std::atomic<uint64> m_droppedCount = 0;
+
+		// 書き込みスレッドだけが変更する
+		std::atomic<uint64> m_writtenCount = 0;
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_wakeCondition;
+
+		std::condition_variable m_flushCondition;
+
+		std::atomic<bool> m_sleeping = false;
+
+		// m_mutex をロックして変更する
+		std::atomic<bool> m_quit = false;
+
+		// 書き込みスレッドが終了したか
+		std::atomic<bool> m_stopped = false;
+
+		// ファイル出力
+		std::mutex m_fileMutex;
+
+		BinaryWriter m_file;
+
+		FilePath m_filePath;
+
+		size_t m_maxFileSize = 0;
+
+		size_t m_maxBackupFiles = 0;
+
+		int64 m_fileSize = 0;
+
+		std::thread m_thread;
+
+		void run();
+
+		// 書き込みスレッドがログを受け付けているかを返す
+		[[nodiscard]]
+		bool isWriterRunning() const noexcept;
+
+		// 書き込みスレッドを介さずに、その場で出力する
+		void writeNow(int64 timeStamp, LogType type, StringView s);
+
+		// 書き込みスレッドを起こす
+		void wakeWriter();
+
+		// キューのログをすべて出力し、出力した件数を返す
+		size_t writeQueuedLogs(String& batch, std::string& utf8);
+
+		void writeFile(const std::string& utf8);
+
+		void rotateFile();
+	};
+}
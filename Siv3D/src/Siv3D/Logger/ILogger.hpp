@@ -11,11 +11,11 @@
 
 # pragma once
 # include <Siv3D/Common.hpp>
+# include <Siv3D/StringView.hpp>
 
 namespace s3d
 {
 	enum class LogType : uint8;
-	class StringView;
 
 	class SIV3D_NOVTABLE ISiv3DLogger
 	{
@@ -28,5 +28,9 @@ namespace s3d
 		virtual void write(LogType type, StringView s) = 0;
 
 		virtual void setEnabled(bool enabled) = 0;
+
+		virtual bool setOutputFile(FilePathView path, size_t maxFileSize, size_t maxBackupFiles) = 0;
+
+		virtual void flush() = 0;
 	};
 }
@@ -81,5 +81,15 @@ namespace s3d
 		{
 			SIV3D_ENGINE(Logger)->setEnabled(true);
 		}
+
+		bool Logger_impl::setOutputFile(const FilePathView path, const size_t maxFileSize, const size_t maxBackupFiles) const
+		{
+			return SIV3D_ENGINE(Logger)->setOutputFile(path, maxFileSize, maxBackupFiles);
+		}
+
+		void Logger_impl::flush() const
+		{
+			SIV3D_ENGINE(Logger)->flush();
+		}
 	}
 }
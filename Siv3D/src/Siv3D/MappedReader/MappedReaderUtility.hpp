@@ -0,0 +1,56 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/MappedReader.hpp>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief reader が MappedReader である場合、現在の読み込み位置からファイルの終端までのマップされた範囲を返します。
+		/// @param reader IReader
+		/// @remark MappedReader でない場合や、読み込むデータが無い場合は空の範囲を返します。
+		/// @return マップされた範囲
+		[[nodiscard]]
+		inline std::span<const Byte> GetMappedSpan(const IReader& reader) noexcept
+		{
+			if (const MappedReader* mapped = dynamic_cast<const MappedReader*>(&reader))
+			{
+				return mapped->remaining();
+			}
+
+			return{};
+		}
+
+		/// @brief reader の現在の読み込み位置からファイルの終端までのデータを返します。
+		/// @param reader IReader
+		/// @param buffer MappedReader でない場合に、データを読み込むバッファ
+		/// @remark MappedReader の場合はコピーせずにマップされた範囲を返し、それ以外の場合は buffer に読み込んだ範囲を返します。
+		/// @remark 返した範囲の分だけ読み込み位置を進めます。
+		/// @return データの範囲
+		[[nodiscard]]
+		inline std::span<const Byte> ReadRemaining(IReader& reader, Array<Byte>& buffer)
+		{
+			if (const std::span<const Byte> mapped = GetMappedSpan(reader);
+				not mapped.empty())
+			{
+				reader.skip(static_cast<int64>(mapped.size()));
+				return mapped;
+			}
+
+			buffer.resize(static_cast<size_t>(Max<int64>((reader.size() - reader.getPos()), 0)));
+			const int64 readSize = reader.read(buffer.data(), static_cast<int64>(buffer.size()));
+			return{ buffer.data(), static_cast<size_t>(Max<int64>(readSize, 0)) };
+		}
+	}
+}
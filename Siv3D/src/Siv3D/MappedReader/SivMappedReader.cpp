@@ -0,0 +1,182 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include <Siv3D/MappedReader.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Utility.hpp>
+
+namespace s3d
+{
+	MappedReader::MappedReader(const FilePathView path)
+	{
+		open(path);
+	}
+
+	bool MappedReader::open(const FilePathView path)
+	{
+		close();
+
+		// リソースファイルはメモリマップできない
+		if (FileSystem::IsResourcePath(path))
+		{
+			return false;
+		}
+
+		if (not m_file.open(path, MapAll::Yes))
+		{
+			return false;
+		}
+
+		const int64 fileSize = m_file.fileSize();
+
+		// ディレクトリなど、マップに失敗した場合
+		if ((0 < fileSize)
+			&& ((m_file.data() == nullptr) || (m_file.mappedSize() != static_cast<size_t>(fileSize))))
+		{
+			m_file.close();
+			return false;
+		}
+
+		m_data = m_file.data();
+		m_size = fileSize;
+		m_pos = 0;
+		m_isOpen = true;
+
+		return true;
+	}
+
+	void MappedReader::close()
+	{
+		if (not m_isOpen)
+		{
+			return;
+		}
+
+		m_file.close();
+		m_data = nullptr;
+		m_size = 0;
+		m_pos = 0;
+		m_isOpen = false;
+	}
+
+	bool MappedReader::supportsLookahead() const noexcept
+	{
+		return true;
+	}
+
+	bool MappedReader::isOpen() const noexcept
+	{
+		return m_isOpen;
+	}
+
+	MappedReader::operator bool() const noexcept
+	{
+		return m_isOpen;
+	}
+
+	int64 MappedReader::size() const
+	{
+		return m_size;
+	}
+
+	int64 MappedReader::getPos() const
+	{
+		return m_pos;
+	}
+
+	bool MappedReader::setPos(const int64 pos)
+	{
+		if (not InRange<int64>(pos, 0, m_size))
+		{
+			return false;
+		}
+
+		m_pos = pos;
+
+		return true;
+	}
+
+	int64 MappedReader::skip(const int64 offset)
+	{
+		m_pos = Clamp<int64>((m_pos + offset), 0, m_size);
+
+		return m_pos;
+	}
+
+	int64 MappedReader::read(void* dst, const int64 size)
+	{
+		const int64 readSize = lookahead(dst, size);
+
+		m_pos += readSize;
+
+		return readSize;
+	}
+
+	int64 MappedReader::read(void* dst, const int64 pos, const int64 size)
+	{
+		if ((not dst)
+			|| (size <= 0)
+			|| (not InRange<int64>(pos, 0, m_size)))
+		{
+			return 0;
+		}
+
+		const int64 readSize = lookahead(dst, pos, size);
+
+		m_pos = (pos + readSize);
+
+		return readSize;
+	}
+
+	int64 MappedReader::lookahead(void* dst, const int64 size) const
+	{
+		return lookahead(dst, m_pos, size);
+	}
+
+	int64 MappedReader::lookahead(void* dst, const int64 pos, const int64 size) const
+	{
+		if ((not dst)
+			|| (not InRange<int64>(pos, 0, m_size)))
+		{
+			return 0;
+		}
+
+		const int64 readSize = Clamp<int64>(size, 0, (m_size - pos));
+
+		if (readSize)
+		{
+			std::memcpy(dst, (m_data + pos), static_cast<size_t>(readSize));
+		}
+
+		return readSize;
+	}
+
+	std::span<const Byte> MappedReader::span() const noexcept
+	{
+		if (not m_data)
+		{
+			return{};
+		}
+
+		return{ m_data, static_cast<size_t>(m_size) };
+	}
+
+	std::span<const Byte> MappedReader::remaining() const noexcept
+	{
+		return span().subspan(static_cast<size_t>(m_pos));
+	}
+
+	const FilePath& MappedReader::path() const noexcept
+	{
+		return m_file.path();
+	}
+}
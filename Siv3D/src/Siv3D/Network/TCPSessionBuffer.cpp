@@ -0,0 +1,351 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Network/TCPSessionBuffer.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		TCPReceiveBuffer::TCPReceiveBuffer(const size_t maxSize)
+			: m_maxSize{ maxSize }
+		{
+			m_tail = m_head = new Block;
+		}
+
+		TCPReceiveBuffer::~TCPReceiveBuffer()
+		{
+			Block* block = m_head;
+
+			while (block)
+			{
+				Block* next = block->next.load(std::memory_order_relaxed);
+				delete block;
+				block = next;
+			}
+
+			delete m_spare.load(std::memory_order_relaxed);
+		}
+
+		bool TCPReceiveBuffer::write(const void* data, size_t size)
+		{
+			if (m_maxSize < (m_size.load(std::memory_order_acquire) + size))
+			{
+				return false;
+			}
+
+			const Byte* src = static_cast<const Byte*>(data);
+			const size_t totalSize = size;
+
+			while (size)
+			{
+				if (m_tailPos == BlockSize)
+				{
+					Block* block = allocateBlock();
+					m_tail->next.store(block, std::memory_order_release);
+					m_tail = block;
+					m_tailPos = 0;
+				}
+
+				const size_t n = Min((BlockSize - m_tailPos), size);
+				std::memcpy((m_tail->data + m_tailPos), src, n);
+				m_tailPos += n;
+				src += n;
+				size -= n;
+			}
+
+			m_size.fetch_add(totalSize, std::memory_order_release);
+
+			return true;
+		}
+
+		size_t TCPReceiveBuffer::size() const noexcept
+		{
+			return m_size.load(std::memory_order_acquire);
+		}
+
+		TCPReceiveView TCPReceiveBuffer::peek() noexcept
+		{
+			const size_t available = m_size.load(std::memory_order_acquire);
+
+			if (available == 0)
+			{
+				return{};
+			}
+
+			advanceHead(available);
+
+			return{ (m_head->data + m_headPos), Min((BlockSize - m_headPos), available) };
+		}
+
+		bool TCPReceiveBuffer::skip(const size_t size) noexcept
+		{
+			if (m_size.load(std::memory_order_acquire) < size)
+			{
+				return false;
+			}
+
+			copy(nullptr, size, true);
+
+			m_size.fetch_sub(size, std::memory_order_release);
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::lookahead(void* dst, const size_t size) noexcept
+		{
+			if (m_size.load(std::memory_order_acquire) < size)
+			{
+				return false;
+			}
+
+			copy(dst, size, false);
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::read(void* dst, const size_t size) noexcept
+		{
+			if (m_size.load(std::memory_order_acquire) < size)
+			{
+				return false;
+			}
+
+			copy(dst, size, true);
+
+			m_size.fetch_sub(size, std::memory_order_release);
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::readMessages(Array<Blob>& messages)
+		{
+			size_t available = m_size.load(std::memory_order_acquire);
+			size_t consumed = 0;
+			bool result = true;
+
+			while (TCPMessageHeaderSize <= available)
+			{
+				uint32 messageSize = 0;
+				copy(&messageSize, TCPMessageHeaderSize, false);
+
+				if ((m_maxSize - TCPMessageHeaderSize) < messageSize)
+				{
+					result = false;
+					break;
+				}
+
+				if (available < (TCPMessageHeaderSize + messageSize))
+				{
+					break;
+				}
+
+				copy(nullptr, TCPMessageHeaderSize, true);
+
+				Blob message(messageSize);
+				copy(message.data(), messageSize, true);
+				messages.push_back(std::move(message));
+
+				available -= (TCPMessageHeaderSize + messageSize);
+				consumed += (TCPMessageHeaderSize + messageSize);
+			}
+
+			if (consumed)
+			{
+				m_size.fetch_sub(consumed, std::memory_order_release);
+			}
+
+			return result;
+		}
+
+		TCPReceiveBuffer::Block* TCPReceiveBuffer::allocateBlock()
+		{
+			if (Block* block = m_spare.exchange(nullptr, std::memory_order_acquire))
+			{
+				block->next.store(nullptr, std::memory_order_relaxed);
+				return block;
+			}
+
+			return new Block;
+		}
+
+		void TCPReceiveBuffer::releaseBlock(Block* block) noexcept
+		{
+			delete m_spare.exchange(block, std::memory_order_acq_rel);
+		}
+
+		void TCPReceiveBuffer::advanceHead(const size_t available) noexcept
+		{
+			if ((m_headPos == BlockSize) && available)
+			{
+				Block* next = m_head->next.load(std::memory_order_acquire);
+				releaseBlock(m_head);
+				m_head = next;
+				m_headPos = 0;
+			}
+		}
+
+		void TCPReceiveBuffer::copy(void* dst, size_t size, const bool remove) noexcept
+		{
+			Byte* pDst = static_cast<Byte*>(dst);
+			Block* block = m_head;
+			size_t pos = m_headPos;
+
+			while (size)
+			{
+				if (pos == BlockSize)
+				{
+					Block* next = block->next.load(std::memory_order_acquire);
+
+					if (remove)
+					{
+						releaseBlock(block);
+					}
+
+					block = next;
+					pos = 0;
+				}
+
+				const size_t n = Min((BlockSize - pos), size);
+
+				if (pDst)
+				{
+					std::memcpy(pDst, (block->data + pos), n);
+					pDst += n;
+				}
+
+				pos += n;
+				size -= n;
+			}
+
+			if (remove)
+			{
+				m_head = block;
+				m_headPos = pos;
+			}
+		}
+
+		bool TCPSendBuffer::push(const void* data, const size_t size)
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_pending.insert(m_pending.end(), static_cast<const Byte*>(data), (static_cast<const Byte*>(data) + size));
+
+			if (m_isSending)
+			{
+				return false;
+			}
+
+			m_sending.swap(m_pending);
+			m_pending.clear();
+			m_isSending = true;
+
+			return true;
+		}
+
+		bool TCPSendBuffer::pushMessages(const Blob* messages, const size_t count)
+		{
+			size_t totalSize = 0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				totalSize += (TCPMessageHeaderSize + messages[i].size());
+			}
+
+			std::lock_guard lock{ m_mutex };
+
+			const size_t oldSize = m_pending.size();
+			m_pending.resize(oldSize + totalSize);
+			Byte* pDst = (m_pending.data() + oldSize);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint32 messageSize = static_cast<uint32>(messages[i].size());
+				std::memcpy(pDst, &messageSize, TCPMessageHeaderSize);
+				pDst += TCPMessageHeaderSize;
+
+				if (messageSize)
+				{
+					std::memcpy(pDst, messages[i].data(), messageSize);
+					pDst += messageSize;
+				}
+			}
+
+			if (m_isSending)
+			{
+				return false;
+			}
+
+			m_sending.swap(m_pending);
+			m_pending.clear();
+			m_isSending = true;
+
+			return true;
+		}
+
+		const Array<Byte>& TCPSendBuffer::sending() const noexcept
+		{
+			return m_sending;
+		}
+
+		bool TCPSendBuffer::onSent()
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_sending.clear();
+
+			if (m_pending.isEmpty())
+			{
+				m_isSending = false;
+				return false;
+			}
+
+			m_sending.swap(m_pending);
+
+			return true;
+		}
+
+		void TCPSendBuffer::clear()
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_pending.clear();
+
+			if (not m_isSending)
+			{
+				m_sending.clear();
+			}
+		}
+
+		void TCPSendBuffer::cancel()
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_pending.clear();
+			m_sending.clear();
+			m_isSending = false;
+		}
+
+		bool TCPSendBuffer::isSending() const
+		{
+			std::lock_guard lock{ m_mutex };
+
+			return m_isSending;
+		}
+
+		size_t TCPSendBuffer::size() const
+		{
+			std::lock_guard lock{ m_mutex };
+
+			return (m_pending.size() + m_sending.size());
+		}
+	}
+}
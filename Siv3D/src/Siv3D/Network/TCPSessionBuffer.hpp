@@ -0,0 +1,186 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <mutex>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Byte.hpp>
+# include <Siv3D/Blob.hpp>
+# include <Siv3D/TCPReceiveView.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief メッセージの先頭に付けるヘッダ（メッセージのサイズを表す uint32, リトルエンディアン）のサイズ（バイト）
+		inline constexpr size_t TCPMessageHeaderSize = sizeof(uint32);
+
+		/// @brief TCP の受信バッファ
+		/// @remark 書き込み（通信スレッド）と読み込み（ユーザのスレッド）がそれぞれ 1 つのスレッドから行われる場合に限り、ロックせずに使えます。
+		/// @remark 固定サイズのブロックを連結したリストで、読み込みで先頭のデータを取り除く際にデータの移動が発生しません。
+		class TCPReceiveBuffer
+		{
+		public:
+
+			/// @brief 1 ブロックのサイズ（バイト）
+			static constexpr size_t BlockSize = (64 * 1024);
+
+			SIV3D_NODISCARD_CXX20
+			explicit TCPReceiveBuffer(size_t maxSize);
+
+			~TCPReceiveBuffer();
+
+			TCPReceiveBuffer(const TCPReceiveBuffer&) = delete;
+
+			TCPReceiveBuffer& operator =(const TCPReceiveBuffer&) = delete;
+
+			/// @brief 受信したデータを追加します。（書き込みスレッド）
+			/// @param data データの先頭へのポインタ
+			/// @param size データのサイズ（バイト）
+			/// @return 追加に成功した場合 true, 最大サイズを超える場合は false
+			[[nodiscard]]
+			bool write(const void* data, size_t size);
+
+			/// @brief 読み込み可能なデータのサイズを返します。
+			/// @return 読み込み可能なデータのサイズ（バイト）
+			[[nodiscard]]
+			size_t size() const noexcept;
+
+			/// @brief 先頭から連続して配置されているデータを、コピーせずに参照します。（読み込みスレッド）
+			/// @return 先頭から連続して配置されているデータ
+			[[nodiscard]]
+			TCPReceiveView peek() noexcept;
+
+			/// @brief 先頭から指定したサイズのデータを取り除きます。（読み込みスレッド）
+			/// @param size 取り除くサイズ（バイト）
+			/// @return 取り除いた場合 true, 読み込み可能なデータが不足している場合は false
+			bool skip(size_t size) noexcept;
+
+			/// @brief 先頭から指定したサイズのデータを、取り除かずにコピーします。（読み込みスレッド）
+			/// @param dst コピー先
+			/// @param size コピーするサイズ（バイト）
+			/// @return コピーした場合 true, 読み込み可能なデータが不足している場合は false
+			bool lookahead(void* dst, size_t size) noexcept;
+
+			/// @brief 先頭から指定したサイズのデータをコピーして取り除きます。（読み込みスレッド）
+			/// @param dst コピー先
+			/// @param size コピーするサイズ（バイト）
+			/// @return コピーした場合 true, 読み込み可能なデータが不足している場合は false
+			bool read(void* dst, size_t size) noexcept;
+
+			/// @brief 受信が完了しているすべてのメッセージを取り出して、messages の末尾に追加します。（読み込みスレッド）
+			/// @param messages メッセージの追加先
+			/// @return メッセージのヘッダが正しい場合 true, 最大サイズを超えるメッセージのヘッダを受信した場合は false
+			[[nodiscard]]
+			bool readMessages(Array<Blob>& messages);
+
+		private:
+
+			struct Block
+			{
+				Byte data[BlockSize];
+
+				std::atomic<Block*> next = nullptr;
+			};
+
+			const size_t m_maxSize;
+
+			// 読み込み可能なデータのサイズ
+			std::atomic<size_t> m_size = 0;
+
+			// 読み込みスレッドが使い終えたブロック（1 つだけ再利用する）
+			std::atomic<Block*> m_spare = nullptr;
+
+			// 書き込みスレッドの状態
+			Block* m_tail = nullptr;
+
+			size_t m_tailPos = 0;
+
+			// 読み込みスレッドの状態
+			Block* m_head = nullptr;
+
+			size_t m_headPos = 0;
+
+			[[nodiscard]]
+			Block* allocateBlock();
+
+			void releaseBlock(Block* block) noexcept;
+
+			// m_head の終端まで読み込み済みで、続きのデータがある場合に次のブロックに移動する
+			void advanceHead(size_t available) noexcept;
+
+			// remove が true の場合、コピーした範囲だけ m_head, m_headPos を進める（m_size は呼び出し側で減らす）
+			void copy(void* dst, size_t size, bool remove) noexcept;
+		};
+
+		/// @brief TCP の送信バッファ
+		/// @remark 送信中に追加されたデータは 1 つのバッファにまとめられ、次の送信で一度に送られます。確保したメモリは再利用されます。
+		class TCPSendBuffer
+		{
+		public:
+
+			/// @brief 送信するデータを追加します。
+			/// @param data データの先頭へのポインタ
+			/// @param size データのサイズ（バイト）
+			/// @return 新しく送信を開始する必要がある場合 true, 送信中の場合は false
+			[[nodiscard]]
+			bool push(const void* data, size_t size);
+
+			/// @brief 送信するメッセージを、ヘッダを付けて追加します。
+			/// @param messages メッセージの配列の先頭へのポインタ
+			/// @param count メッセージの個数
+			/// @return 新しく送信を開始する必要がある場合 true, 送信中の場合は false
+			[[nodiscard]]
+			bool pushMessages(const Blob* messages, size_t count);
+
+			/// @brief 送信中のデータを返します。
+			/// @return 送信中のデータ
+			[[nodiscard]]
+			const Array<Byte>& sending() const noexcept;
+
+			/// @brief 送信が完了したときに呼びます。
+			/// @return 続けて送信するデータがある場合 true, それ以外の場合は false
+			[[nodiscard]]
+			bool onSent();
+
+			/// @brief 送信中でないデータを削除します。
+			void clear();
+
+			/// @brief 送信を中止し、すべてのデータを削除します。
+			/// @remark 送信の完了または失敗が通知された後に呼びます。
+			void cancel();
+
+			/// @brief 送信中であるかを返します。
+			/// @return 送信中である場合 true, それ以外の場合は false
+			[[nodiscard]]
+			bool isSending() const;
+
+			/// @brief 送信中および送信待ちのデータのサイズを返します。
+			/// @return 送信中および送信待ちのデータのサイズ（バイト）
+			[[nodiscard]]
+			size_t size() const;
+
+		private:
+
+			mutable std::mutex m_mutex;
+
+			// 次の送信で送るデータ
+			Array<Byte> m_pending;
+
+			// 送信中のデータ
+			Array<Byte> m_sending;
+
+			bool m_isSending = false;
+		};
+	}
+}
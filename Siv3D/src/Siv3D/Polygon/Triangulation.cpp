@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include "Triangulation.hpp"
+# include <Siv3D/ArenaAllocator.hpp>
 # include <ThirdParty/Earcut/earcut.hpp>
 
 // Earcut s3d::Vec2 adapter
@@ -51,32 +52,35 @@ namespace s3d::detail
 
 	void Triangulate(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, Array<Float2>& dstVertices, Array<Vertex2D::IndexType>& dstIndices)
 	{
-		Array<Vec2> vertices;
+		// 頂点は一時配列を経由せず、出力先に直接コピーする
 		{
-			vertices.reserve(outer.size() + GetVertexCount(holes));
+			dstVertices.clear();
 
-			vertices.append(outer);
+			dstVertices.reserve(outer.size() + GetVertexCount(holes));
+
+			dstVertices.insert(dstVertices.end(), outer.begin(), outer.end());
 
 			for (const auto& hole : holes)
 			{
-				vertices.append(hole);
+				dstVertices.insert(dstVertices.end(), hole.begin(), hole.end());
 			}
 		}
 
-		Array<Array<Vec2>> polygon;
+		// earcut に渡す輪郭の一時的なコピーは、フレームアリーナから確保する
+		using ArenaRing = Array<Vec2, ArenaAllocator<Vec2>>;
+
+		Array<ArenaRing, ArenaAllocator<ArenaRing>> polygon;
 		{
 			polygon.reserve(1 + holes.size());
 
-			polygon.push_back(outer);
+			polygon.emplace_back(outer.begin(), outer.end());
 
 			for (const auto& hole : holes)
 			{
-				polygon.push_back(hole);
+				polygon.emplace_back(hole.begin(), hole.end());
 			}
 		}
 
-		dstVertices.assign(vertices.begin(), vertices.end());
-		
 		dstIndices = mapbox::earcut<Vertex2D::IndexType>(polygon);
 	}
 }
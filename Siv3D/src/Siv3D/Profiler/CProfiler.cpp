@@ -22,6 +22,9 @@
 # include <Siv3D/Texture/ITexture.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Audio/IAudio.hpp>
+# include <Siv3D/Scene/IScene.hpp>
+# include <Siv3D/Allocator/AllocatorStat.hpp>
+# include <Siv3D/ArenaAllocator/FrameArena.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "CProfiler.hpp"
 
@@ -36,6 +39,8 @@ namespace s3d
 
 	void CProfiler::beginFrame()
 	{
+		const uint64 timestampNanosec = Time::GetNanosec();
+
 		// FPS
 		{
 			if (const int64 timestampMillisec = Time::GetMillisec();
@@ -61,14 +66,34 @@ namespace s3d
 
 			m_stat.textureCount	= static_cast<uint32>(SIV3D_ENGINE(Texture)->getTextureCount());
 			m_stat.fontCount	= static_cast<uint32>(SIV3D_ENGINE(Font)->getFontCount());
+			m_stat.fontTextureUploadSize = static_cast<uint32>(Min<size_t>(SIV3D_ENGINE(Font)->resetTextureUploadSize(), UINT32_MAX));
+			{
+				const auto [hits, misses] = SIV3D_ENGINE(Font)->resetShapingCacheStats();
+				m_stat.fontShapingCacheHits		= static_cast<uint32>(Min<size_t>(hits, UINT32_MAX));
+				m_stat.fontShapingCacheMisses	= static_cast<uint32>(Min<size_t>(misses, UINT32_MAX));
+			}
 			m_stat.audioCount	= static_cast<uint32>(SIV3D_ENGINE(Audio)->getAudioCount());
 			m_stat.activeVoice	= static_cast<uint32>(GlobalAudio::GetActiveVoiceCount());
 		}
+
+		// FrameMetrics
+		{
+			updateFrameMetrics(timestampNanosec);
+
+			m_frameBeginNanosec = timestampNanosec;
+			m_drawBeginNanosec = 0;
+			m_drawEndNanosec = 0;
+		}
 	}
 
-	void CProfiler::endFrame()
+	void CProfiler::beginDraw()
 	{
+		m_drawBeginNanosec = Time::GetNanosec();
+	}
 
+	void CProfiler::endFrame()
+	{
+		m_drawEndNanosec = Time::GetNanosec();
 	}
 
 	int32 CProfiler::getFPS() const noexcept
@@ -92,4 +117,115 @@ namespace s3d
 	{
 		return m_stat;
 	}
+
+	void CProfiler::addTextureUploadSize(const size_t size)
+	{
+		m_textureUploadSize += size;
+	}
+
+	const FrameMetrics& CProfiler::getFrameMetrics() const
+	{
+		return m_frameMetrics;
+	}
+
+	Array<FrameMetrics> CProfiler::getFrameMetricsHistory() const
+	{
+		// 古い順に並べる
+		Array<FrameMetrics> history(Arg::reserve = m_frameMetricsHistory.size());
+		history.insert(history.end(), (m_frameMetricsHistory.begin() + m_frameMetricsHistoryIndex), m_frameMetricsHistory.end());
+		history.insert(history.end(), m_frameMetricsHistory.begin(), (m_frameMetricsHistory.begin() + m_frameMetricsHistoryIndex));
+		return history;
+	}
+
+	void CProfiler::setFrameMetricsHistorySize(const size_t size)
+	{
+		Array<FrameMetrics> history = getFrameMetricsHistory();
+
+		if (size < history.size())
+		{
+			history.erase(history.begin(), (history.end() - size));
+		}
+
+		m_frameMetricsHistory = std::move(history);
+		m_frameMetricsHistorySize = size;
+		m_frameMetricsHistoryIndex = 0;
+	}
+
+	size_t CProfiler::getFrameMetricsHistorySize() const noexcept
+	{
+		return m_frameMetricsHistorySize;
+	}
+
+	void CProfiler::updateFrameMetrics(const uint64 frameEndNanosec)
+	{
+		const size_t textureUploadSize = m_textureUploadSize.exchange(0);
+		const detail::AllocatorFrameStat allocatorStat = detail::TakeAllocatorStat();
+		const size_t glyphCacheMisses = SIV3D_ENGINE(Font)->resetGlyphCacheMisses();
+
+		// 最初のフレームの前には記録しない
+		if (m_frameBeginNanosec == 0)
+		{
+			return;
+		}
+
+		FrameMetrics metrics;
+		metrics.frameCount = SIV3D_ENGINE(Scene)->getFrameCounter().getUserFrameCount();
+
+		if (m_drawBeginNanosec && m_drawEndNanosec)
+		{
+			metrics.updateTime	= Duration{ (m_drawBeginNanosec - m_frameBeginNanosec) / 1'000'000'000.0 };
+			metrics.drawTime	= Duration{ (m_drawEndNanosec - m_drawBeginNanosec) / 1'000'000'000.0 };
+			metrics.presentTime	= Duration{ (frameEndNanosec - m_drawEndNanosec) / 1'000'000'000.0 };
+		}
+
+		{
+			const auto& stat = SIV3D_ENGINE(Renderer2D)->getStat();
+			metrics.drawCalls			= stat.drawCalls;
+			metrics.triangleCount		= stat.triangleCount;
+			metrics.vertexBytes			= stat.vertexBytes;
+			metrics.indexBytes			= stat.indexBytes;
+			metrics.renderer2DCommands	= stat.commandCounts;
+		}
+
+		for (size_t i = 0; i < metrics.renderer2DCommands.size(); ++i)
+		{
+			switch (ToEnum<Renderer2DCommandType>(static_cast<uint8>(i)))
+			{
+			case Renderer2DCommandType::Null:
+			case Renderer2DCommandType::SetBuffers:
+			case Renderer2DCommandType::UpdateBuffers:
+			case Renderer2DCommandType::Draw:
+			case Renderer2DCommandType::DrawNull:
+				break;
+			default:
+				metrics.stateChanges += metrics.renderer2DCommands[i];
+				break;
+			}
+		}
+
+		metrics.textureUploadBytes		= textureUploadSize;
+		metrics.heapAllocations			= static_cast<uint32>(Min<size_t>(allocatorStat.allocations, UINT32_MAX));
+		metrics.heapAllocatedBytes		= allocatorStat.allocatedBytes;
+		metrics.heapDeallocations		= static_cast<uint32>(Min<size_t>(allocatorStat.deallocations, UINT32_MAX));
+		metrics.heapDeallocatedBytes	= allocatorStat.deallocatedBytes;
+		metrics.arenaBytes				= detail::GetFrameArenaUsedBytes();
+		metrics.glyphCacheMisses		= static_cast<uint32>(Min<size_t>(glyphCacheMisses, UINT32_MAX));
+
+		m_frameMetrics = metrics;
+
+		if (m_frameMetricsHistorySize == 0)
+		{
+			return;
+		}
+
+		if (m_frameMetricsHistory.size() < m_frameMetricsHistorySize)
+		{
+			m_frameMetricsHistory.push_back(metrics);
+		}
+		else
+		{
+			m_frameMetricsHistory[m_frameMetricsHistoryIndex] = metrics;
+			m_frameMetricsHistoryIndex = ((m_frameMetricsHistoryIndex + 1) % m_frameMetricsHistorySize);
+		}
+	}
 }
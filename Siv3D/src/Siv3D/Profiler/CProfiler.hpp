@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <atomic>
 # include "IProfiler.hpp"
 
 namespace s3d
@@ -22,6 +23,8 @@ namespace s3d
 
 		void beginFrame() override;
 
+		void beginDraw() override;
+
 		void endFrame() override;
 
 		int32 getFPS() const noexcept override;
@@ -30,6 +33,16 @@ namespace s3d
 
 		const ProfilerStat& getStat() const override;
 
+		void addTextureUploadSize(size_t size) override;
+
+		const FrameMetrics& getFrameMetrics() const override;
+
+		Array<FrameMetrics> getFrameMetricsHistory() const override;
+
+		void setFrameMetricsHistorySize(size_t size) override;
+
+		size_t getFrameMetricsHistorySize() const noexcept override;
+
 	private:
 
 		//
@@ -45,5 +58,30 @@ namespace s3d
 		//	Stat
 		//
 		ProfilerStat m_stat;
+
+		//
+		//	FrameMetrics
+		//
+		static constexpr size_t DefaultFrameMetricsHistorySize = 300;
+
+		// 各フェーズの開始時刻（0 の場合は未計測）
+		uint64 m_frameBeginNanosec = 0;
+
+		uint64 m_drawBeginNanosec = 0;
+
+		uint64 m_drawEndNanosec = 0;
+
+		std::atomic<size_t> m_textureUploadSize = 0;
+
+		FrameMetrics m_frameMetrics;
+
+		// リングバッファ
+		Array<FrameMetrics> m_frameMetricsHistory;
+
+		size_t m_frameMetricsHistorySize = DefaultFrameMetricsHistorySize;
+
+		size_t m_frameMetricsHistoryIndex = 0;
+
+		void updateFrameMetrics(uint64 frameEndNanosec);
 	};
 }
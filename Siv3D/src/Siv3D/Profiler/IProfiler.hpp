@@ -12,6 +12,8 @@
 # pragma once
 # include <Siv3D/Common.hpp>
 # include <Siv3D/ProfilerStat.hpp>
+# include <Siv3D/FrameMetrics.hpp>
+# include <Siv3D/Array.hpp>
 
 namespace s3d
 {
@@ -29,6 +31,8 @@ namespace s3d
 
 		virtual void beginFrame() = 0;
 
+		virtual void beginDraw() = 0;
+
 		virtual void endFrame() = 0;
 
 		virtual int32 getFPS() const noexcept = 0;
@@ -36,5 +40,17 @@ namespace s3d
 		virtual String getSimpleStatistics() const = 0;
 
 		virtual const ProfilerStat& getStat() const = 0;
+
+		/// @brief テクスチャに転送したデータのサイズを記録します。
+		/// @remark 任意のスレッドから呼ばれます。
+		virtual void addTextureUploadSize(size_t size) = 0;
+
+		virtual const FrameMetrics& getFrameMetrics() const = 0;
+
+		virtual Array<FrameMetrics> getFrameMetricsHistory() const = 0;
+
+		virtual void setFrameMetricsHistorySize(size_t size) = 0;
+
+		virtual size_t getFrameMetricsHistorySize() const noexcept = 0;
 	};
 }
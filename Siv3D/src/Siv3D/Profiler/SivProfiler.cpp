@@ -32,5 +32,25 @@ namespace s3d
 		{
 			return SIV3D_ENGINE(Profiler)->getStat();
 		}
+
+		const FrameMetrics& GetFrameMetrics()
+		{
+			return SIV3D_ENGINE(Profiler)->getFrameMetrics();
+		}
+
+		Array<FrameMetrics> GetFrameMetricsHistory()
+		{
+			return SIV3D_ENGINE(Profiler)->getFrameMetricsHistory();
+		}
+
+		void SetFrameMetricsHistorySize(const size_t size)
+		{
+			SIV3D_ENGINE(Profiler)->setFrameMetricsHistorySize(size);
+		}
+
+		size_t GetFrameMetricsHistorySize()
+		{
+			return SIV3D_ENGINE(Profiler)->getFrameMetricsHistorySize();
+		}
 	}
 }
@@ -20,6 +20,8 @@ namespace s3d
 		Print << U"Triangle count\t\t" << triangleCount;
 		Print << U"Texture count\t\t" << textureCount;
 		Print << U"Font count\t\t\t" << fontCount;
+		Print << U"Font texture upload\t" << fontTextureUploadSize << U" bytes";
+		Print << U"Font shaping cache\t" << fontShapingCacheHits << U" hits / " << fontShapingCacheMisses << U" misses";
 		Print << U"Audio count\t\t" << audioCount;
 		Print << U"Active voice\t\t" << activeVoice;
 	}
@@ -0,0 +1,175 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "CRenderer_Software.hpp"
+# include <Siv3D/Error.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Shader/IShader.hpp>
+# include <Siv3D/Mesh/IMesh.hpp>
+# include <Siv3D/Renderer2D/Software/CRenderer2D_Software.hpp>
+# include <Siv3D/Texture/Software/CTexture_Software.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	CRenderer_Software::CRenderer_Software()
+	{
+		// do nothing
+	}
+
+	CRenderer_Software::~CRenderer_Software()
+	{
+		LOG_SCOPED_TRACE(U"CRenderer_Software::~CRenderer_Software()");
+	}
+
+	EngineOption::Renderer CRenderer_Software::getRendererType() const noexcept
+	{
+		return EngineOption::Renderer::Software;
+	}
+
+	void CRenderer_Software::init()
+	{
+		LOG_SCOPED_TRACE(U"CRenderer_Software::init()");
+
+		pTexture = static_cast<CTexture_Software*>(SIV3D_ENGINE(Texture));
+		pRenderer2D = static_cast<CRenderer2D_Software*>(SIV3D_ENGINE(Renderer2D));
+
+		pTexture->init();
+
+		SIV3D_ENGINE(Shader)->init();
+		SIV3D_ENGINE(Mesh)->init();
+
+		m_backBuffer.resize(Scene::DefaultSceneSize);
+
+		clear();
+	}
+
+	StringView CRenderer_Software::getName() const
+	{
+		static constexpr StringView name(U"Software");
+		return name;
+	}
+
+	void CRenderer_Software::clear()
+	{
+		m_backBuffer.fill(m_backgroundColor.toColor());
+
+		pRenderer2D->update();
+	}
+
+	void CRenderer_Software::flush()
+	{
+		pRenderer2D->flush();
+	}
+
+	bool CRenderer_Software::present()
+	{
+		// 表示先のウィンドウを持たないため、何もしない
+		return true;
+	}
+
+	void CRenderer_Software::setVSyncEnabled(bool)
+	{
+		// do nothing
+	}
+
+	bool CRenderer_Software::isVSyncEnabled() const
+	{
+		return false;
+	}
+
+	void CRenderer_Software::captureScreenshot()
+	{
+		m_screenCapture = m_backBuffer;
+	}
+
+	const Image& CRenderer_Software::getScreenCapture() const
+	{
+		return m_screenCapture;
+	}
+
+	void CRenderer_Software::setSceneResizeMode(const ResizeMode resizeMode)
+	{
+		m_sceneResizeMode = resizeMode;
+	}
+
+	ResizeMode CRenderer_Software::getSceneResizeMode() const noexcept
+	{
+		return m_sceneResizeMode;
+	}
+
+	void CRenderer_Software::setSceneBufferSize(const Size size)
+	{
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return;
+		}
+
+		if (size == m_backBuffer.size())
+		{
+			return;
+		}
+
+		LOG_TRACE(U"CRenderer_Software::setSceneBufferSize({})"_fmt(size));
+
+		m_backBuffer.resize(size, m_backgroundColor.toColor());
+	}
+
+	Size CRenderer_Software::getSceneBufferSize() const noexcept
+	{
+		return m_backBuffer.size();
+	}
+
+	void CRenderer_Software::setSceneTextureFilter(const TextureFilter textureFilter)
+	{
+		m_sceneTextureFilter = textureFilter;
+	}
+
+	TextureFilter CRenderer_Software::getSceneTextureFilter() const noexcept
+	{
+		return m_sceneTextureFilter;
+	}
+
+	void CRenderer_Software::setBackgroundColor(const ColorF& color)
+	{
+		m_backgroundColor = color;
+	}
+
+	const ColorF& CRenderer_Software::getBackgroundColor() const noexcept
+	{
+		return m_backgroundColor;
+	}
+
+	void CRenderer_Software::setLetterboxColor(const ColorF& color)
+	{
+		m_letterboxColor = color;
+	}
+
+	const ColorF& CRenderer_Software::getLetterboxColor() const noexcept
+	{
+		return m_letterboxColor;
+	}
+
+	std::pair<float, RectF> CRenderer_Software::getLetterboxComposition() const noexcept
+	{
+		return{ 1.0f, RectF{ m_backBuffer.size() } };
+	}
+
+	void CRenderer_Software::updateSceneSize()
+	{
+		// do nothing
+	}
+
+	Image& CRenderer_Software::getBackBuffer() noexcept
+	{
+		return m_backBuffer;
+	}
+}
@@ -31,6 +31,7 @@
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/Particle2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
+# include <Siv3D/FrameMetrics.hpp>
 
 namespace s3d
 {
@@ -41,6 +42,9 @@ namespace s3d
 	{
 		uint32 drawCalls = 0;
 		uint32 triangleCount = 0;
+		uint64 vertexBytes = 0;
+		uint64 indexBytes = 0;
+		std::array<uint32, FrameMetrics::NumRenderer2DCommandTypes> commandCounts{};
 	};
 
 	class SIV3D_NOVTABLE ISiv3DRenderer2D
@@ -67,10 +71,14 @@ namespace s3d
 
 		virtual void addRect(const FloatRect& rect, const Float4(&colors)[4]) = 0;
 
+		virtual void addRects(const RectF* rects, const ColorF* colors, size_t count, bool singleColor) = 0;
+
 		virtual void addRectFrame(const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor) = 0;
 
 		virtual void addCircle(const Float2& center, float r, const Float4& innerColor, const Float4& outerColor) = 0;
 
+		virtual void addCircles(const Circle* circles, const ColorF* colors, size_t count, bool singleColor) = 0;
+
 		virtual void addCircleFrame(const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor) = 0;
 
 		virtual void addCirclePie(const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor) = 0;
@@ -0,0 +1,45 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Vertex2D.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/ColorHSV.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/LineStyle.hpp>
+# include <Siv3D/PredefinedYesNo.hpp>
+
+namespace s3d
+{
+	namespace Internal
+	{
+		/// @brief 1 回のバッファ要求で作成された頂点とインデックス
+		struct Vertex2DBatch
+		{
+			/// @brief 頂点
+			Array<Vertex2D> vertices;
+
+			/// @brief インデックス
+			Array<Vertex2D::IndexType> indices;
+
+			/// @brief 描画コマンドに渡されたインデックスの個数
+			size_t drawnIndexCount = 0;
+		};
+
+		/// @brief LineString の描画と同じ方法で線の頂点とインデックスを作成して返します。
+		/// @remark エンジンのテスト用です。公開ヘッダには含まれません。
+		/// @return バッファ要求ごとの頂点とインデックス
+		[[nodiscard]]
+		Array<Vertex2DBatch> BuildLineStringVertices(const LineStyle& style, const Array<Vec2>& points, const Optional<Float2>& offset, double thickness, bool inner, const ColorF& color, CloseRing closeRing);
+	}
+}
@@ -67,6 +67,11 @@ namespace s3d
 		// do nothing
 	}
 
+	void CRenderer2D_Null::addRects(const RectF*, const ColorF*, const size_t, const bool)
+	{
+		// do nothing
+	}
+
 	void CRenderer2D_Null::addRectFrame(const FloatRect&, const float, const Float4&, const Float4&)
 	{
 		// do nothing
@@ -77,6 +82,11 @@ namespace s3d
 		// do nothing
 	}
 
+	void CRenderer2D_Null::addCircles(const Circle*, const ColorF*, const size_t, const bool)
+	{
+		// do nothing
+	}
+
 	void CRenderer2D_Null::addCircleFrame(const Float2&, const float, const float, const Float4&, const Float4&)
 	{
 		// do nothing
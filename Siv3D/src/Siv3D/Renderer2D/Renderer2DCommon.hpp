@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/Common.hpp>
 # include <Siv3D/PointVector.hpp>
+# include <Siv3D/FrameMetrics.hpp>
 
 namespace s3d
 {
@@ -42,5 +43,63 @@ namespace s3d
 		uint32 startIndexLocation = 0;
 
 		uint32 baseVertexLocation = 0;
+
+		uint32 vertexCount = 0;
 	};
+
+	/// @brief 各バックエンドの 2D 描画コマンドの種類を、共通の種類に変換します。
+	template <class CommandType>
+	[[nodiscard]]
+	inline constexpr Renderer2DCommandType ToRenderer2DCommandType(const CommandType type) noexcept
+	{
+		if ((CommandType::VSSamplerState0 <= type) && (type <= CommandType::PSSamplerState7))
+		{
+			return Renderer2DCommandType::SamplerState;
+		}
+
+		if ((CommandType::VSTexture0 <= type) && (type <= CommandType::PSTexture7))
+		{
+			return Renderer2DCommandType::Texture;
+		}
+
+		switch (type)
+		{
+		case CommandType::SetBuffers:
+			return Renderer2DCommandType::SetBuffers;
+		case CommandType::UpdateBuffers:
+			return Renderer2DCommandType::UpdateBuffers;
+		case CommandType::Draw:
+			return Renderer2DCommandType::Draw;
+		case CommandType::DrawNull:
+			return Renderer2DCommandType::DrawNull;
+		case CommandType::ColorMul:
+			return Renderer2DCommandType::ColorMul;
+		case CommandType::ColorAdd:
+			return Renderer2DCommandType::ColorAdd;
+		case CommandType::BlendState:
+			return Renderer2DCommandType::BlendState;
+		case CommandType::RasterizerState:
+			return Renderer2DCommandType::RasterizerState;
+		case CommandType::ScissorRect:
+			return Renderer2DCommandType::ScissorRect;
+		case CommandType::Viewport:
+			return Renderer2DCommandType::Viewport;
+		case CommandType::SDFParams:
+			return Renderer2DCommandType::SDFParams;
+		case CommandType::InternalPSConstants:
+			return Renderer2DCommandType::InternalPSConstants;
+		case CommandType::SetRT:
+			return Renderer2DCommandType::SetRT;
+		case CommandType::SetVS:
+			return Renderer2DCommandType::SetVS;
+		case CommandType::SetPS:
+			return Renderer2DCommandType::SetPS;
+		case CommandType::Transform:
+			return Renderer2DCommandType::Transform;
+		case CommandType::SetConstantBuffer:
+			return Renderer2DCommandType::SetConstantBuffer;
+		default:
+			return Renderer2DCommandType::Null;
+		}
+	}
 }
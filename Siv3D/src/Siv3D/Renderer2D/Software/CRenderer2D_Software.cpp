@@ -0,0 +1,857 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "CRenderer2D_Software.hpp"
+# include <Siv3D/Error.hpp>
+# include <Siv3D/Resource.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/TraceRecorder.hpp>
+# include <Siv3D/ScopeGuard.hpp>
+# include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
+# include <Siv3D/Renderer/Software/CRenderer_Software.hpp>
+# include <Siv3D/Texture/Software/CTexture_Software.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static Rect IntersectRect(const Rect& a, const Rect& b) noexcept
+		{
+			const int32 x0 = Max(a.x, b.x);
+			const int32 y0 = Max(a.y, b.y);
+			const int32 x1 = Min((a.x + a.w), (b.x + b.w));
+			const int32 y1 = Min((a.y + a.h), (b.y + b.h));
+			return Rect{ x0, y0, Max((x1 - x0), 0), Max((y1 - y0), 0) };
+		}
+
+		[[nodiscard]]
+		static bool IsSameRenderTarget(const Optional<RenderTexture>& a, const Optional<RenderTexture>& b) noexcept
+		{
+			if (a.has_value() != b.has_value())
+			{
+				return false;
+			}
+
+			return ((not a) || (a->id() == b->id()));
+		}
+
+		// 描画ステートの変更を、他のバックエンドの描画コマンドの種類ごとに数える
+		static void CountStateChanges(Renderer2DStat& stat, const SoftwareDrawState& from, const SoftwareDrawState& to) noexcept
+		{
+			const auto count = [&](const Renderer2DCommandType type)
+			{
+				++stat.commandCounts[FromEnum(type)];
+			};
+
+			if (from.blendState != to.blendState)
+			{
+				count(Renderer2DCommandType::BlendState);
+			}
+
+			if (from.cullMode != to.cullMode)
+			{
+				count(Renderer2DCommandType::RasterizerState);
+			}
+
+			if (from.samplerState != to.samplerState)
+			{
+				count(Renderer2DCommandType::SamplerState);
+			}
+
+			if (from.pixelShader != to.pixelShader)
+			{
+				count(Renderer2DCommandType::SetPS);
+			}
+
+			if (from.textureID != to.textureID)
+			{
+				count(Renderer2DCommandType::Texture);
+			}
+
+			if (from.colorAdd != to.colorAdd)
+			{
+				count(Renderer2DCommandType::ColorAdd);
+			}
+
+			// ビューポートとシザー矩形は描画範囲にまとめられている
+			if (from.clipRect != to.clipRect)
+			{
+				count(Renderer2DCommandType::ScissorRect);
+			}
+		}
+	}
+
+	CRenderer2D_Software::CRenderer2D_Software()
+	{
+		m_vsTextures.fill(Texture::IDType::InvalidValue());
+		m_psTextures.fill(Texture::IDType::InvalidValue());
+		m_vsSamplerStates.fill(SamplerState::Default2D);
+		m_psSamplerStates.fill(SamplerState::Default2D);
+		m_sdfParams.fill(Float4{ 0.0f, 0.0f, 0.0f, 0.0f });
+	}
+
+	CRenderer2D_Software::~CRenderer2D_Software()
+	{
+		LOG_SCOPED_TRACE(U"CRenderer2D_Software::~CRenderer2D_Software()");
+	}
+
+	void CRenderer2D_Software::init()
+	{
+		LOG_SCOPED_TRACE(U"CRenderer2D_Software::init()");
+
+		pRenderer	= static_cast<CRenderer_Software*>(SIV3D_ENGINE(Renderer));
+		pTexture	= static_cast<CTexture_Software*>(SIV3D_ENGINE(Texture));
+
+		// バッファ作成関数を作成
+		m_bufferCreator = BufferCreator{ this };
+
+		// シャドウ画像を作成
+		{
+			// ソフトウェアレンダラーはミップマップを使わない
+			const Image boxShadowImage{ Resource(U"engine/texture/box-shadow/256.png") };
+
+			m_boxShadowTexture = std::make_unique<Texture>(boxShadowImage);
+
+			if (m_boxShadowTexture->isEmpty())
+			{
+				throw EngineError(U"Failed to create a box-shadow texture");
+			}
+		}
+
+		m_segments = { Segment{ m_currentRT, 0 } };
+	}
+
+	void CRenderer2D_Software::update()
+	{
+		m_stat = {};
+	}
+
+	const Renderer2DStat& CRenderer2D_Software::getStat() const
+	{
+		return m_stat;
+	}
+
+	void CRenderer2D_Software::addLine(const LineStyle& style, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2])
+	{
+		if (Vertex2DBuilder::BuildLine(style, m_bufferCreator, begin, end, thickness, colors, getMaxScaling()))
+		{
+			if (style.hasSquareDot())
+			{
+				commit(SoftwarePixelShader::SquareDot);
+			}
+			else if (style.hasRoundDot())
+			{
+				commit(SoftwarePixelShader::RoundDot);
+			}
+			else
+			{
+				commit(SoftwarePixelShader::Shape);
+			}
+		}
+	}
+
+	void CRenderer2D_Software::addTriangle(const Float2(&points)[3], const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildTriangle(m_bufferCreator, points, color))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addTriangle(const Float2(&points)[3], const Float4(&colors)[3])
+	{
+		if (Vertex2DBuilder::BuildTriangle(m_bufferCreator, points, colors))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addRect(const FloatRect& rect, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildRect(m_bufferCreator, rect, color))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addRect(const FloatRect& rect, const Float4(&colors)[4])
+	{
+		if (Vertex2DBuilder::BuildRect(m_bufferCreator, rect, colors))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addRects(const RectF* rects, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		Vertex2DBuilder::BuildRects(m_bufferCreator, rects, colors, count, singleColor, [&](Vertex2D::IndexType)
+		{
+			commit(SoftwarePixelShader::Shape);
+		});
+	}
+
+	void CRenderer2D_Software::addRectFrame(const FloatRect& rect, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, innerColor, outerColor))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addCircle(const Float2& center, const float r, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildCircle(m_bufferCreator, center, r, innerColor, outerColor, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const bool singleColor)
+	{
+		const float scale = getMaxScaling();
+
+		Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, colors, count, singleColor, scale, [&](Vertex2D::IndexType)
+		{
+			commit(SoftwarePixelShader::Shape);
+		});
+	}
+
+	void CRenderer2D_Software::addCircleFrame(const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addCirclePie(const Float2& center, const float r, const float startAngle, const float angle, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildCirclePie(m_bufferCreator, center, r, startAngle, angle, innerColor, outerColor, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addCircleArc(const LineStyle& style, const Float2& center, const float rInner, const float startAngle, const float angle, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildCircleArc(m_bufferCreator, style, center, rInner, startAngle, angle, thickness, innerColor, outerColor, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addEllipse(const Float2& center, const float a, const float b, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildEllipse(m_bufferCreator, center, a, b, innerColor, outerColor, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addEllipseFrame(const Float2& center, const float aInner, const float bInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (Vertex2DBuilder::BuildEllipseFrame(m_bufferCreator, center, aInner, bInner, thickness, innerColor, outerColor, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addQuad(const FloatQuad& quad, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, color))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addQuad(const FloatQuad& quad, const Float4(&colors)[4])
+	{
+		if (Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, colors))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRect(const FloatRect& rect, const float w, const float h, const float r, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildRoundRect(m_bufferCreator, m_buffer, rect, w, h, r, color, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRectFrame(const RoundRect& outer, const RoundRect& inner, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildRoundRectFrame(m_bufferCreator, m_buffer, outer, inner, color, getMaxScaling()))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addLineString(const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing)
+	{
+		Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling(), [&](Vertex2D::IndexType)
+		{
+			commit(SoftwarePixelShader::Shape);
+		});
+	}
+
+	void CRenderer2D_Software::addLineString(const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing)
+	{
+		Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling(), [&](Vertex2D::IndexType)
+		{
+			commit(SoftwarePixelShader::Shape);
+		});
+	}
+
+	void CRenderer2D_Software::addPolygon(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Optional<Float2>& offset, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildPolygon(m_bufferCreator, vertices, indices, offset, color))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygon(const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
+	{
+		if (Vertex2DBuilder::BuildPolygon(m_bufferCreator, vertices, vertexCount, indices, num_triangles))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygonTransformed(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, float s, float c, const Float2& offset, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildPolygonTransformed(m_bufferCreator, vertices, indices, s, c, offset, color))
+		{
+			commit(SoftwarePixelShader::Shape);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygonFrame(const Float2* points, const size_t size, const float thickness, const Float4& color)
+	{
+		Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling(), [&](Vertex2D::IndexType)
+		{
+			commit(SoftwarePixelShader::Shape);
+		});
+	}
+
+	void CRenderer2D_Software::addNullVertices(const uint32 count)
+	{
+		// 頂点シェーダで頂点を生成する描画は実行できないため、統計のみ更新する
+		++m_stat.commandCounts[FromEnum(Renderer2DCommandType::DrawNull)];
+		++m_stat.drawCalls;
+		m_stat.triangleCount += (count / 3);
+	}
+
+	void CRenderer2D_Software::addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, color))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	void CRenderer2D_Software::addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+	{
+		if (Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, colors))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedCircle(const Texture& texture, const Circle& circle, const FloatRect& uv, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildTexturedCircle(m_bufferCreator, circle, uv, color, getMaxScaling()))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildTexturedQuad(m_bufferCreator, quad, uv, color))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedRoundRect(const Texture& texture, const FloatRect& rect, const float w, const float h, const float r, const FloatRect& uvRect, const Float4& color)
+	{
+		if (Vertex2DBuilder::BuildTexturedRoundRect(m_bufferCreator, m_buffer, rect, w, h, r, uvRect, color, getMaxScaling()))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedVertices(const Texture& texture, const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
+	{
+		if (Vertex2DBuilder::BuildTexturedVertices(m_bufferCreator, vertices, vertexCount, indices, num_triangles))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
+		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
+	{
+		if (Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		{
+			reserveTexture(texture);
+			m_psTextures[0] = texture.id();
+			commit(SoftwarePixelShader::Texture);
+		}
+	}
+
+	Float4 CRenderer2D_Software::getColorMul() const
+	{
+		return m_colorMul;
+	}
+
+	Float4 CRenderer2D_Software::getColorAdd() const
+	{
+		return m_colorAdd;
+	}
+
+	void CRenderer2D_Software::setColorMul(const Float4& color)
+	{
+		m_colorMul = color;
+	}
+
+	void CRenderer2D_Software::setColorAdd(const Float4& color)
+	{
+		m_colorAdd = color;
+	}
+
+	BlendState CRenderer2D_Software::getBlendState() const
+	{
+		return m_blendState;
+	}
+
+	RasterizerState CRenderer2D_Software::getRasterizerState() const
+	{
+		return m_rasterizerState;
+	}
+
+	SamplerState CRenderer2D_Software::getSamplerState(const ShaderStage shaderStage, const uint32 slot) const
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		if (shaderStage == ShaderStage::Vertex)
+		{
+			return m_vsSamplerStates[slot];
+		}
+		else
+		{
+			return m_psSamplerStates[slot];
+		}
+	}
+
+	void CRenderer2D_Software::setBlendState(const BlendState& state)
+	{
+		m_blendState = state;
+	}
+
+	void CRenderer2D_Software::setRasterizerState(const RasterizerState& state)
+	{
+		m_rasterizerState = state;
+	}
+
+	void CRenderer2D_Software::setSamplerState(const ShaderStage shaderStage, const uint32 slot, const SamplerState& state)
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		if (shaderStage == ShaderStage::Vertex)
+		{
+			m_vsSamplerStates[slot] = state;
+		}
+		else
+		{
+			m_psSamplerStates[slot] = state;
+		}
+	}
+
+	void CRenderer2D_Software::setScissorRect(const Rect& rect)
+	{
+		m_scissorRect = rect;
+	}
+
+	Rect CRenderer2D_Software::getScissorRect() const
+	{
+		return m_scissorRect;
+	}
+
+	void CRenderer2D_Software::setViewport(const Optional<Rect>& viewport)
+	{
+		m_viewport = viewport;
+	}
+
+	Optional<Rect> CRenderer2D_Software::getViewport() const
+	{
+		return m_viewport;
+	}
+
+	void CRenderer2D_Software::setSDFParameters(const std::array<Float4, 3>& params)
+	{
+		m_sdfParams = params;
+	}
+
+	void CRenderer2D_Software::setInternalPSConstants(const Float4& value)
+	{
+		m_internalPSConstants = value;
+	}
+
+	Optional<VertexShader> CRenderer2D_Software::getCustomVS() const
+	{
+		return m_currentCustomVS;
+	}
+
+	Optional<PixelShader> CRenderer2D_Software::getCustomPS() const
+	{
+		return m_currentCustomPS;
+	}
+
+	void CRenderer2D_Software::setCustomVS(const Optional<VertexShader>& vs)
+	{
+		// カスタムシェーダは実行できないため、状態の保持のみを行う
+		if (vs && (not vs->isEmpty()))
+		{
+			m_currentCustomVS = *vs;
+		}
+		else
+		{
+			m_currentCustomVS.reset();
+		}
+	}
+
+	void CRenderer2D_Software::setCustomPS(const Optional<PixelShader>& ps)
+	{
+		// カスタムシェーダは実行できないため、状態の保持のみを行う
+		if (ps && (not ps->isEmpty()))
+		{
+			m_currentCustomPS = *ps;
+		}
+		else
+		{
+			m_currentCustomPS.reset();
+		}
+	}
+
+	const Mat3x2& CRenderer2D_Software::getLocalTransform() const
+	{
+		return m_localTransform;
+	}
+
+	const Mat3x2& CRenderer2D_Software::getCameraTransform() const
+	{
+		return m_cameraTransform;
+	}
+
+	void CRenderer2D_Software::setLocalTransform(const Mat3x2& matrix)
+	{
+		m_localTransform = matrix;
+		m_combinedTransform = (m_localTransform * m_cameraTransform);
+		m_maxScaling = detail::CalculateMaxScaling(m_combinedTransform);
+	}
+
+	void CRenderer2D_Software::setCameraTransform(const Mat3x2& matrix)
+	{
+		m_cameraTransform = matrix;
+		m_combinedTransform = (m_localTransform * m_cameraTransform);
+		m_maxScaling = detail::CalculateMaxScaling(m_combinedTransform);
+	}
+
+	float CRenderer2D_Software::getMaxScaling() const noexcept
+	{
+		return m_maxScaling;
+	}
+
+	void CRenderer2D_Software::setVSTexture(const uint32 slot, const Optional<Texture>& texture)
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		if (texture)
+		{
+			reserveTexture(*texture);
+			m_vsTextures[slot] = texture->id();
+		}
+		else
+		{
+			m_vsTextures[slot] = Texture::IDType::InvalidValue();
+		}
+	}
+
+	void CRenderer2D_Software::setPSTexture(const uint32 slot, const Optional<Texture>& texture)
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		if (texture)
+		{
+			reserveTexture(*texture);
+			m_psTextures[slot] = texture->id();
+		}
+		else
+		{
+			m_psTextures[slot] = Texture::IDType::InvalidValue();
+		}
+	}
+
+	void CRenderer2D_Software::setRenderTarget(const Optional<RenderTexture>& rt)
+	{
+		if (rt)
+		{
+			const Texture::IDType textureID = rt->id();
+
+			// バインドされていたら解除
+			for (auto& id : m_psTextures)
+			{
+				if (id == textureID)
+				{
+					id = Texture::IDType::InvalidValue();
+				}
+			}
+
+			for (auto& id : m_vsTextures)
+			{
+				if (id == textureID)
+				{
+					id = Texture::IDType::InvalidValue();
+				}
+			}
+		}
+
+		if (detail::IsSameRenderTarget(rt, m_currentRT))
+		{
+			return;
+		}
+
+		m_currentRT = rt;
+
+		if (m_segments.back().triangleBegin == m_triangles.size())
+		{
+			// 直前の描画先に三角形が無い場合は置き換える
+			m_segments.back().renderTarget = rt;
+		}
+		else
+		{
+			m_segments.push_back(Segment{ rt, m_triangles.size() });
+		}
+	}
+
+	Optional<RenderTexture> CRenderer2D_Software::getRenderTarget() const
+	{
+		return m_currentRT;
+	}
+
+	void CRenderer2D_Software::setConstantBuffer(ShaderStage, uint32, const ConstantBufferBase&, const float*, uint32)
+	{
+		// カスタムシェーダ用の定数バッファは使用されない
+	}
+
+	const Texture& CRenderer2D_Software::getBoxShadowTexture() const noexcept
+	{
+		return *m_boxShadowTexture;
+	}
+
+	void CRenderer2D_Software::flush()
+	{
+		SIV3D_TRACE_ZONE(U"Renderer2D::flush");
+
+		ScopeGuard cleanUp = [this]()
+		{
+			m_vertices.clear();
+			m_indices.clear();
+			m_pendingBuffers.clear();
+			m_triangles.clear();
+			m_states.clear();
+			m_segments = { Segment{ m_currentRT, 0 } };
+			m_reservedTextures.clear();
+			m_vsTextures.fill(Texture::IDType::InvalidValue());
+			m_psTextures.fill(Texture::IDType::InvalidValue());
+			m_currentCustomVS.reset();
+			m_currentCustomPS.reset();
+		};
+
+		if (not m_triangles)
+		{
+			return;
+		}
+
+		// 頂点とインデックスは 1 つのバッファとして扱う
+		++m_stat.commandCounts[FromEnum(Renderer2DCommandType::UpdateBuffers)];
+		m_stat.vertexBytes += (sizeof(Vertex2D) * m_vertices.size());
+		m_stat.indexBytes += (sizeof(Vertex2D::IndexType) * 3 * m_triangles.size());
+
+		// 描画ステートのテクスチャを取得
+		for (auto& state : m_states)
+		{
+			state.pTexture = (state.textureID.isInvalid() ? nullptr : &pTexture->getImage(state.textureID));
+		}
+
+		for (size_t i = 0; i < m_segments.size(); ++i)
+		{
+			const Segment& segment = m_segments[i];
+			const size_t triangleBegin = segment.triangleBegin;
+			const size_t triangleEnd = (((i + 1) < m_segments.size()) ? m_segments[i + 1].triangleBegin : m_triangles.size());
+
+			if (triangleBegin == triangleEnd)
+			{
+				continue;
+			}
+
+			Image* pTarget = (segment.renderTarget ? pTexture->getRenderTargetImage(segment.renderTarget->id()) : &pRenderer->getBackBuffer());
+
+			if (not pTarget)
+			{
+				continue;
+			}
+
+			// 描画先と同じ画像はサンプリングしない
+			Array<std::pair<size_t, const Image*>> unboundTextures;
+			{
+				for (size_t k = 0; k < m_states.size(); ++k)
+				{
+					if (m_states[k].pTexture == pTarget)
+					{
+						unboundTextures.emplace_back(k, m_states[k].pTexture);
+						m_states[k].pTexture = nullptr;
+					}
+				}
+			}
+
+			m_rasterizer.draw(*pTarget, m_vertices, (m_triangles.data() + triangleBegin), (triangleEnd - triangleBegin), m_states);
+
+			for (const auto& [index, pImage] : unboundTextures)
+			{
+				m_states[index].pTexture = pImage;
+			}
+
+			if (i != 0)
+			{
+				++m_stat.commandCounts[FromEnum(Renderer2DCommandType::SetRT)];
+			}
+
+			// 描画ステートが切り替わるごとに 1 回の描画として数える
+			for (size_t k = triangleBegin; k < triangleEnd; ++k)
+			{
+				if ((k == triangleBegin) || (m_triangles[k].stateIndex != m_triangles[k - 1].stateIndex))
+				{
+					if (k != 0)
+					{
+						detail::CountStateChanges(m_stat, m_states[m_triangles[k - 1].stateIndex], m_states[m_triangles[k].stateIndex]);
+					}
+
+					++m_stat.commandCounts[FromEnum(Renderer2DCommandType::Draw)];
+					++m_stat.drawCalls;
+				}
+			}
+
+			m_stat.triangleCount += static_cast<uint32>(triangleEnd - triangleBegin);
+		}
+	}
+
+	void CRenderer2D_Software::commit(const SoftwarePixelShader pixelShader)
+	{
+		if (not m_pendingBuffers)
+		{
+			return;
+		}
+
+		// 頂点をスクリーン座標に変換する
+		{
+			const Float2 offset = (m_viewport ? Float2{ m_viewport->pos } : Float2{ 0.0f, 0.0f });
+			const Mat3x2 transform = m_combinedTransform;
+			const Float4 colorMul = m_colorMul;
+
+			for (size_t i = m_pendingBuffers.front().baseVertex; i < m_vertices.size(); ++i)
+			{
+				Vertex2D& vertex = m_vertices[i];
+				vertex.pos = (offset + transform.transformPoint(vertex.pos));
+				vertex.color *= colorMul;
+			}
+		}
+
+		// 描画ステートを登録する
+		{
+			const SoftwareDrawState state = makeCurrentState(pixelShader);
+
+			if ((not m_states) || (m_states.back() != state))
+			{
+				m_states.push_back(state);
+			}
+		}
+
+		// 三角形を登録する
+		{
+			const uint32 stateIndex = static_cast<uint32>(m_states.size() - 1);
+
+			for (const auto& buffer : m_pendingBuffers)
+			{
+				const Vertex2D::IndexType* pIndex = (m_indices.data() + buffer.indexStart);
+
+				for (uint32 i = 0; (i + 2) < buffer.indexCount; i += 3)
+				{
+					m_triangles.push_back({ { (buffer.baseVertex + pIndex[i]), (buffer.baseVertex + pIndex[i + 1]), (buffer.baseVertex + pIndex[i + 2]) }, stateIndex });
+				}
+			}
+		}
+
+		m_indices.clear();
+		m_pendingBuffers.clear();
+	}
+
+	SoftwareDrawState CRenderer2D_Software::makeCurrentState(const SoftwarePixelShader pixelShader) const
+	{
+		SoftwareDrawState state;
+		state.blendState	= m_blendState;
+		state.cullMode		= m_rasterizerState.cullMode;
+		state.pixelShader	= pixelShader;
+		state.colorAdd		= m_colorAdd;
+
+		// テクスチャを使わない描画ではテクスチャとサンプラーを区別しない
+		if (pixelShader == SoftwarePixelShader::Texture)
+		{
+			state.samplerState	= m_psSamplerStates[0];
+			state.textureID		= m_psTextures[0];
+		}
+
+		if (m_viewport)
+		{
+			state.clipRect = (m_rasterizerState.scissorEnable ? detail::IntersectRect(*m_viewport, m_scissorRect) : *m_viewport);
+		}
+		else if (m_rasterizerState.scissorEnable)
+		{
+			state.clipRect = m_scissorRect;
+		}
+
+		return state;
+	}
+
+	void CRenderer2D_Software::reserveTexture(const Texture& texture)
+	{
+		m_reservedTextures.try_emplace(texture.id(), texture);
+	}
+}
@@ -0,0 +1,294 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/Renderer2D/IRenderer2D.hpp>
+# include <Siv3D/Renderer2D/Vertex2DBuilder.hpp>
+# include "SoftwareRasterizer.hpp"
+
+namespace s3d
+{
+	class CRenderer_Software;
+	class CTexture_Software;
+
+	class CRenderer2D_Software final : public ISiv3DRenderer2D
+	{
+	private:
+
+		// 描画先ごとの三角形の範囲
+		struct Segment
+		{
+			// none の場合はシーン
+			Optional<RenderTexture> renderTarget;
+
+			size_t triangleBegin = 0;
+		};
+
+		// bufferCreator で確保された、描画ステートに未登録の頂点とインデックス
+		struct PendingBuffer
+		{
+			uint32 baseVertex = 0;
+
+			uint32 indexStart = 0;
+
+			uint32 indexCount = 0;
+		};
+
+		CRenderer_Software* pRenderer = nullptr;
+		CTexture_Software* pTexture = nullptr;
+
+		// Vertex2DBuilder に渡すバッファ作成関数 (インライン展開のため std::function を使わない)
+		struct BufferCreator
+		{
+			CRenderer2D_Software* pRenderer2D = nullptr;
+
+			Vertex2DBufferPointer operator ()(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) const
+			{
+				const uint32 baseVertex = static_cast<uint32>(pRenderer2D->m_vertices.size());
+				const uint32 indexStart = static_cast<uint32>(pRenderer2D->m_indices.size());
+
+				pRenderer2D->m_vertices.resize(baseVertex + vertexSize);
+				pRenderer2D->m_indices.resize(indexStart + indexSize);
+				pRenderer2D->m_pendingBuffers.push_back({ baseVertex, indexStart, indexSize });
+
+				// 頂点ごとに確保するため、インデックスのオフセットは常に 0
+				return Vertex2DBufferPointer{ (pRenderer2D->m_vertices.data() + baseVertex), (pRenderer2D->m_indices.data() + indexStart), 0 };
+			}
+		};
+
+		BufferCreator m_bufferCreator;
+
+		// 変換済みの頂点
+		Array<Vertex2D> m_vertices;
+
+		// bufferCreator で確保されたインデックス (三角形に変換後に破棄)
+		Array<Vertex2D::IndexType> m_indices;
+
+		Array<PendingBuffer> m_pendingBuffers;
+
+		Array<SoftwareTriangle> m_triangles;
+
+		Array<SoftwareDrawState> m_states;
+
+		Array<Segment> m_segments;
+
+		SoftwareRasterizer m_rasterizer;
+
+		// 描画まで Texture を保持する
+		HashTable<Texture::IDType, Texture> m_reservedTextures;
+
+		Float4 m_colorMul{ 1.0f, 1.0f, 1.0f, 1.0f };
+
+		Float4 m_colorAdd{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+		BlendState m_blendState = BlendState::Default2D;
+
+		RasterizerState m_rasterizerState = RasterizerState::Default2D;
+
+		std::array<SamplerState, SamplerState::MaxSamplerCount> m_vsSamplerStates;
+
+		std::array<SamplerState, SamplerState::MaxSamplerCount> m_psSamplerStates;
+
+		std::array<Texture::IDType, SamplerState::MaxSamplerCount> m_vsTextures;
+
+		std::array<Texture::IDType, SamplerState::MaxSamplerCount> m_psTextures;
+
+		Rect m_scissorRect{ 0 };
+
+		Optional<Rect> m_viewport;
+
+		std::array<Float4, 3> m_sdfParams;
+
+		Float4 m_internalPSConstants{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+		Optional<VertexShader> m_currentCustomVS;
+
+		Optional<PixelShader> m_currentCustomPS;
+
+		Mat3x2 m_localTransform = Mat3x2::Identity();
+
+		Mat3x2 m_cameraTransform = Mat3x2::Identity();
+
+		Mat3x2 m_combinedTransform = Mat3x2::Identity();
+
+		float m_maxScaling = 1.0f;
+
+		Optional<RenderTexture> m_currentRT;
+
+		std::unique_ptr<Texture> m_boxShadowTexture;
+
+		// VertexBuilder でのメモリアロケーションを避けるためのバッファ
+		Array<Float2> m_buffer;
+
+		Renderer2DStat m_stat;
+
+		// 確保された頂点を変換し、三角形として現在の描画ステートに登録する
+		void commit(SoftwarePixelShader pixelShader);
+
+		[[nodiscard]]
+		SoftwareDrawState makeCurrentState(SoftwarePixelShader pixelShader) const;
+
+		void reserveTexture(const Texture& texture);
+
+	public:
+
+		CRenderer2D_Software();
+
+		~CRenderer2D_Software() override;
+
+		void init() override;
+
+		void update() override;
+
+		const Renderer2DStat& getStat() const override;
+
+		void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) override;
+
+		void addTriangle(const Float2(&points)[3], const Float4& color) override;
+
+		void addTriangle(const Float2(&points)[3], const Float4(&colors)[3]) override;
+
+		void addRect(const FloatRect& rect, const Float4& color) override;
+
+		void addRect(const FloatRect& rect, const Float4(&colors)[4]) override;
+
+		void addRects(const RectF* rects, const ColorF* colors, size_t count, bool singleColor) override;
+
+		void addRectFrame(const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addCircle(const Float2& center, float r, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addCircles(const Circle* circles, const ColorF* colors, size_t count, bool singleColor) override;
+
+		void addCircleFrame(const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addCirclePie(const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addCircleArc(const LineStyle& style, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addEllipse(const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addEllipseFrame(const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor) override;
+
+		void addQuad(const FloatQuad& quad, const Float4& color) override;
+
+		void addQuad(const FloatQuad& quad, const Float4(&colors)[4]) override;
+
+		void addRoundRect(const FloatRect& rect, float w, float h, float r, const Float4& color) override;
+
+		void addRoundRectFrame(const RoundRect& outer, const RoundRect& inner, const Float4& color) override;
+
+		void addLineString(const LineStyle& style, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, CloseRing closeRing) override;
+
+		void addLineString(const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, float thickness, bool inner, CloseRing closeRing) override;
+
+		void addPolygon(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Optional<Float2>& offset, const Float4& color) override;
+
+		void addPolygon(const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles) override;
+	
+		void addPolygonTransformed(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, float s, float c, const Float2& offset, const Float4& color) override;
+
+		void addPolygonFrame(const Float2* points, size_t size, float thickness, const Float4& color) override;
+
+		void addNullVertices(uint32 count) override;
+
+		void addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4& color) override;
+
+		void addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]) override;
+
+		void addTexturedCircle(const Texture& texture, const Circle& circle, const FloatRect& uv, const Float4& color) override;
+
+		void addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color) override;
+
+		void addTexturedRoundRect(const Texture& texture, const FloatRect& rect, float w, float h, float r, const FloatRect& uvRect, const Float4& color) override;
+
+		void addTexturedVertices(const Texture& texture, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles) override;
+
+		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
+			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
+
+
+		Float4 getColorMul() const override;
+
+		Float4 getColorAdd() const override;
+
+		void setColorMul(const Float4& color) override;
+
+		void setColorAdd(const Float4& color) override;
+
+
+		BlendState getBlendState() const override;
+
+		RasterizerState getRasterizerState() const override;
+
+		SamplerState getSamplerState(ShaderStage shaderStage, uint32 slot) const override;
+
+		void setBlendState(const BlendState& state) override;
+
+		void setRasterizerState(const RasterizerState& state) override;
+
+		void setSamplerState(ShaderStage shaderStage, uint32 slot, const SamplerState& state) override;
+
+
+		void setScissorRect(const Rect& rect) override;
+
+		Rect getScissorRect() const override;
+
+		void setViewport(const Optional<Rect>& viewport) override;
+
+		Optional<Rect> getViewport() const override;
+
+		void setSDFParameters(const std::array<Float4, 3>& params) override;
+
+		void setInternalPSConstants(const Float4& value) override;
+
+
+		Optional<VertexShader> getCustomVS() const override;
+
+		Optional<PixelShader> getCustomPS() const override;
+
+		void setCustomVS(const Optional<VertexShader>& vs) override;
+
+		void setCustomPS(const Optional<PixelShader>& ps) override;
+
+
+		const Mat3x2& getLocalTransform() const override;
+
+		const Mat3x2& getCameraTransform() const override;
+
+		void setLocalTransform(const Mat3x2& matrix) override;
+
+		void setCameraTransform(const Mat3x2& matrix) override;
+
+		float getMaxScaling() const noexcept override;
+
+	
+		void setVSTexture(uint32 slot, const Optional<Texture>& texture) override;
+
+		void setPSTexture(uint32 slot, const Optional<Texture>& texture) override;
+
+
+		void setRenderTarget(const Optional<RenderTexture>& rt) override;
+
+		Optional<RenderTexture> getRenderTarget() const override;
+
+
+		void setConstantBuffer(ShaderStage stage, uint32 slot, const ConstantBufferBase& buffer, const float* data, uint32 num_vectors) override;
+	
+		const Texture& getBoxShadowTexture() const noexcept override;
+
+
+		void flush() override;
+	};
+}
@@ -0,0 +1,51 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Vertex2D.hpp>
+# include <Siv3D/TriangleIndex.hpp>
+# include <Siv3D/BlendState.hpp>
+# include <Siv3D/SamplerState.hpp>
+
+namespace s3d
+{
+	namespace Internal
+	{
+		/// @brief ソフトウェアレンダラーで三角形を描画するときの描画ステート
+		struct SoftwareRasterizationState
+		{
+			/// @brief ブレンドステート
+			BlendState blendState = BlendState::Default2D;
+
+			/// @brief サンプラーステート
+			SamplerState samplerState = SamplerState::Default2D;
+
+			/// @brief シザー矩形。none の場合は描画先全体
+			Optional<Rect> clipRect;
+
+			/// @brief テクスチャ。nullptr の場合は頂点色で描画
+			const Image* pTexture = nullptr;
+		};
+
+		/// @brief ソフトウェアレンダラーのラスタライザで三角形を画像に描画します。
+		/// @param target 描画先の画像
+		/// @param vertices スクリーン座標の頂点配列
+		/// @param indices 三角形のインデックス
+		/// @param state 描画ステート
+		/// @remark エンジンのテスト用です。公開ヘッダには含まれません。
+		void RasterizeSoftware(Image& target, const Array<Vertex2D>& vertices, const Array<TriangleIndex>& indices, const SoftwareRasterizationState& state);
+	}
+}
@@ -0,0 +1,835 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cmath>
+# include <cstring>
+# include "SoftwareRasterizer.hpp"
+# include "SoftwareRasterization.hpp"
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/Threading.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 頂点座標の精度 (1/256 ピクセル)
+		constexpr int64 SubPixelScale = 256;
+
+		// 固定小数点に変換できる頂点座標の範囲 (±2^18 ピクセル)
+		constexpr float GuardBand = static_cast<float>(1 << 18);
+
+		// テクスチャ座標の範囲
+		constexpr float TexelLimit = static_cast<float>(1 << 30);
+
+		// 描画ステートごとの、ピクセル処理に必要な情報
+		struct ShadingContext;
+
+		using SpanFunc = void(*)(Color*, int32, Float4, Float2, const SoftwareRasterizer::TriangleSetup&, const ShadingContext&);
+
+		struct TextureSampler
+		{
+			const Color* pData = nullptr;
+
+			int32 width = 0;
+
+			int32 height = 0;
+
+			TextureAddressMode addressU = TextureAddressMode::Clamp;
+
+			TextureAddressMode addressV = TextureAddressMode::Clamp;
+
+			// [0]: 拡大時, [1]: 縮小時
+			bool linear[2] = { true, true };
+
+			Float4 borderColor{ 0.0f, 0.0f, 0.0f, 0.0f };
+		};
+
+		struct ShadingContext
+		{
+			SpanFunc span = nullptr;
+
+			TextureSampler sampler;
+
+			Float4 colorAdd{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+			Blend src = Blend::SrcAlpha;
+
+			Blend dst = Blend::InvSrcAlpha;
+
+			Blend srcAlpha = Blend::Zero;
+
+			Blend dstAlpha = Blend::One;
+
+			BlendOp op = BlendOp::Add;
+
+			BlendOp opAlpha = BlendOp::Add;
+
+			// 書き込む成分のビットマスク
+			uint32 writeMask = 0xFFFFFFFF;
+		};
+
+		enum class BlendPath : uint8
+		{
+			// ブレンドなし
+			Opaque,
+
+			// BlendState::NonPremultiplied
+			NonPremultiplied,
+
+			// 任意のブレンドステート
+			Generic,
+		};
+
+		[[nodiscard]]
+		inline int64 FloorDiv(const int64 a, const int64 b) noexcept
+		{
+			// b > 0
+			const int64 q = (a / b);
+			return (((a % b) != 0) && (a < 0)) ? (q - 1) : q;
+		}
+
+		[[nodiscard]]
+		inline int64 ToFixed(const float v) noexcept
+		{
+			return static_cast<int64>(std::lround(Clamp(v, -GuardBand, GuardBand) * static_cast<float>(SubPixelScale)));
+		}
+
+		[[nodiscard]]
+		inline __m128 LoadColor(const Color color) noexcept
+		{
+			int32 value;
+			std::memcpy(&value, &color, sizeof(value));
+			const __m128i v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(value));
+			return _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.0f / 255.0f));
+		}
+
+		[[nodiscard]]
+		inline uint32 ToColorValue(const __m128 color) noexcept
+		{
+			const __m128 clamped = _mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+			__m128i v = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)));
+			v = _mm_packs_epi32(v, v);
+			v = _mm_packus_epi16(v, v);
+			return static_cast<uint32>(_mm_cvtsi128_si32(v));
+		}
+
+		[[nodiscard]]
+		inline __m128 LoadFloat4(const Float4& value) noexcept
+		{
+			return _mm_loadu_ps(&value.x);
+		}
+
+		[[nodiscard]]
+		inline __m128 SplatAlpha(const __m128 v) noexcept
+		{
+			return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+
+		[[nodiscard]]
+		inline float Mod(const float x, const float y) noexcept
+		{
+			// GLSL の mod()
+			return (x - y * std::floor(x / y));
+		}
+
+		[[nodiscard]]
+		inline int32 ApplyAddressMode(int32 i, const int32 size, const TextureAddressMode mode) noexcept
+		{
+			switch (mode)
+			{
+			case TextureAddressMode::Repeat:
+				i %= size;
+				return ((i < 0) ? (i + size) : i);
+			case TextureAddressMode::Mirror:
+				{
+					const int32 period = (size * 2);
+					i %= period;
+					i = ((i < 0) ? (i + period) : i);
+					return ((i < size) ? i : (period - 1 - i));
+				}
+			case TextureAddressMode::Border:
+				return (((0 <= i) && (i < size)) ? i : -1);
+			case TextureAddressMode::Clamp:
+			default:
+				return Clamp(i, 0, (size - 1));
+			}
+		}
+
+		[[nodiscard]]
+		inline __m128 FetchTexel(const TextureSampler& sampler, const int32 x, const int32 y) noexcept
+		{
+			if ((x < 0) || (y < 0))
+			{
+				return LoadFloat4(sampler.borderColor);
+			}
+
+			return LoadColor(sampler.pData[static_cast<size_t>(y) * sampler.width + x]);
+		}
+
+		[[nodiscard]]
+		inline __m128 SampleTexture(const TextureSampler& sampler, const bool linear, const Float2 uv) noexcept
+		{
+			const float u = Clamp(uv.x * sampler.width, -TexelLimit, TexelLimit);
+			const float v = Clamp(uv.y * sampler.height, -TexelLimit, TexelLimit);
+
+			if (not linear)
+			{
+				const int32 x = ApplyAddressMode(static_cast<int32>(std::floor(u)), sampler.width, sampler.addressU);
+				const int32 y = ApplyAddressMode(static_cast<int32>(std::floor(v)), sampler.height, sampler.addressV);
+				return FetchTexel(sampler, x, y);
+			}
+
+			const float fu = (u - 0.5f);
+			const float fv = (v - 0.5f);
+			const float bu = std::floor(fu);
+			const float bv = std::floor(fv);
+			const __m128 tx = _mm_set1_ps(fu - bu);
+			const __m128 ty = _mm_set1_ps(fv - bv);
+
+			const int32 x0 = ApplyAddressMode(static_cast<int32>(bu), sampler.width, sampler.addressU);
+			const int32 x1 = ApplyAddressMode((static_cast<int32>(bu) + 1), sampler.width, sampler.addressU);
+			const int32 y0 = ApplyAddressMode(static_cast<int32>(bv), sampler.height, sampler.addressV);
+			const int32 y1 = ApplyAddressMode((static_cast<int32>(bv) + 1), sampler.height, sampler.addressV);
+
+			const __m128 c00 = FetchTexel(sampler, x0, y0);
+			const __m128 c10 = FetchTexel(sampler, x1, y0);
+			const __m128 c01 = FetchTexel(sampler, x0, y1);
+			const __m128 c11 = FetchTexel(sampler, x1, y1);
+
+			const __m128 top = _mm_add_ps(c00, _mm_mul_ps(_mm_sub_ps(c10, c00), tx));
+			const __m128 bottom = _mm_add_ps(c01, _mm_mul_ps(_mm_sub_ps(c11, c01), tx));
+			return _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), ty));
+		}
+
+		[[nodiscard]]
+		inline __m128 MultiplyAlpha(const __m128 color, const float alpha) noexcept
+		{
+			return _mm_mul_ps(color, _mm_setr_ps(1.0f, 1.0f, 1.0f, alpha));
+		}
+
+		template <SoftwarePixelShader PixelShader>
+		[[nodiscard]]
+		inline __m128 Shade(const __m128 color, const Float2 uv, const SoftwareRasterizer::TriangleSetup& setup, const ShadingContext& context) noexcept
+		{
+			__m128 result;
+
+			if constexpr (PixelShader == SoftwarePixelShader::Shape)
+			{
+				result = color;
+			}
+			else if constexpr (PixelShader == SoftwarePixelShader::Texture)
+			{
+				result = _mm_mul_ps(SampleTexture(context.sampler, context.sampler.linear[setup.minification], uv), color);
+			}
+			else if constexpr (PixelShader == SoftwarePixelShader::SquareDot)
+			{
+				const float tr = uv.y;
+				const float d = std::abs(Mod(uv.x, 3.0f) - 1.0f);
+				const float range = (1.0f - tr);
+				result = MultiplyAlpha(color, ((d < range) ? 1.0f : (d < 1.0f) ? ((1.0f - d) / tr) : 0.0f));
+			}
+			else // RoundDot
+			{
+				const float t = Mod(uv.x, 2.0f);
+				const float tx = (std::abs(1.0f - t) * 2.0f);
+				const float ty = uv.y;
+				const float dist = ((tx * tx + ty * ty) * 0.5f);
+
+				// fwidth(dist) を三角形内で一定の UV の増分から見積もる
+				const float delta = (std::abs(tx) * 2.0f * (std::abs(setup.uvDX.x) + std::abs(setup.uvDY.x)))
+					+ (std::abs(ty) * (std::abs(setup.uvDX.y) + std::abs(setup.uvDY.y)));
+
+				float alpha;
+
+				if (delta <= 0.0f)
+				{
+					alpha = ((dist < 0.5f) ? 0.0f : 1.0f);
+				}
+				else
+				{
+					const float s = Clamp(((dist - (0.5f - delta)) / delta), 0.0f, 1.0f);
+					alpha = (s * s * (3.0f - 2.0f * s));
+				}
+
+				result = MultiplyAlpha(color, (1.0f - alpha));
+			}
+
+			return _mm_add_ps(result, LoadFloat4(context.colorAdd));
+		}
+
+		[[nodiscard]]
+		inline __m128 BlendFactor(const Blend blend, const __m128 src, const __m128 dst) noexcept
+		{
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			switch (blend)
+			{
+			case Blend::Zero:
+				return _mm_setzero_ps();
+			case Blend::One:
+				return one;
+			case Blend::SrcColor:
+			case Blend::Src1Color:
+				return src;
+			case Blend::InvSrcColor:
+			case Blend::InvSrc1Color:
+				return _mm_sub_ps(one, src);
+			case Blend::SrcAlpha:
+			case Blend::Src1Alpha:
+				return SplatAlpha(src);
+			case Blend::InvSrcAlpha:
+			case Blend::InvSrc1Alpha:
+				return _mm_sub_ps(one, SplatAlpha(src));
+			case Blend::DestAlpha:
+				return SplatAlpha(dst);
+			case Blend::InvDestAlpha:
+				return _mm_sub_ps(one, SplatAlpha(dst));
+			case Blend::DestColor:
+				return dst;
+			case Blend::InvDestColor:
+				return _mm_sub_ps(one, dst);
+			case Blend::SrcAlphaSat:
+				{
+					const __m128 f = _mm_min_ps(SplatAlpha(src), _mm_sub_ps(one, SplatAlpha(dst)));
+					return _mm_blend_ps(f, one, 0b1000);
+				}
+			case Blend::BlendFactor: // ブレンドファクターは常に (0, 0, 0, 0)
+				return _mm_setzero_ps();
+			case Blend::InvBlendFactor:
+			default:
+				return one;
+			}
+		}
+
+		[[nodiscard]]
+		inline __m128 BlendOperation(const BlendOp op, const __m128 src, const __m128 srcFactor, const __m128 dst, const __m128 dstFactor) noexcept
+		{
+			switch (op)
+			{
+			case BlendOp::Subtract:
+				return _mm_sub_ps(_mm_mul_ps(src, srcFactor), _mm_mul_ps(dst, dstFactor));
+			case BlendOp::RevSubtract:
+				return _mm_sub_ps(_mm_mul_ps(dst, dstFactor), _mm_mul_ps(src, srcFactor));
+			case BlendOp::Min:
+				return _mm_min_ps(src, dst);
+			case BlendOp::Max:
+				return _mm_max_ps(src, dst);
+			case BlendOp::Add:
+			default:
+				return _mm_add_ps(_mm_mul_ps(src, srcFactor), _mm_mul_ps(dst, dstFactor));
+			}
+		}
+
+		template <BlendPath Path>
+		inline void BlendPixel(Color& pixel, __m128 src, const ShadingContext& context) noexcept
+		{
+			// UNORM の描画先には [0, 1] に飽和した値が書き込まれる
+			src = _mm_min_ps(_mm_max_ps(src, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+			uint32 result;
+
+			if constexpr (Path == BlendPath::Opaque)
+			{
+				result = ToColorValue(src);
+			}
+			else if constexpr (Path == BlendPath::NonPremultiplied)
+			{
+				// rgb = src * srcA + dst * (1 - srcA), a = dst.a
+				const __m128 dst = LoadColor(pixel);
+				const __m128 srcAlpha = _mm_blend_ps(SplatAlpha(src), _mm_setzero_ps(), 0b1000);
+				result = ToColorValue(_mm_add_ps(dst, _mm_mul_ps(_mm_sub_ps(src, dst), srcAlpha)));
+			}
+			else
+			{
+				const __m128 dst = LoadColor(pixel);
+				const __m128 srcFactor = _mm_blend_ps(BlendFactor(context.src, src, dst), BlendFactor(context.srcAlpha, src, dst), 0b1000);
+				const __m128 dstFactor = _mm_blend_ps(BlendFactor(context.dst, src, dst), BlendFactor(context.dstAlpha, src, dst), 0b1000);
+				const __m128 color = BlendOperation(context.op, src, srcFactor, dst, dstFactor);
+				const __m128 alpha = BlendOperation(context.opAlpha, src, srcFactor, dst, dstFactor);
+				result = ToColorValue(_mm_blend_ps(color, alpha, 0b1000));
+
+				if (context.writeMask != 0xFFFFFFFF)
+				{
+					uint32 old;
+					std::memcpy(&old, &pixel, sizeof(old));
+					result = ((result & context.writeMask) | (old & ~context.writeMask));
+				}
+			}
+
+			std::memcpy(&pixel, &result, sizeof(result));
+		}
+
+		template <SoftwarePixelShader PixelShader, BlendPath Path>
+		void ShadeSpan(Color* pDst, const int32 count, const Float4 color, Float2 uv, const SoftwareRasterizer::TriangleSetup& setup, const ShadingContext& context)
+		{
+			__m128 c = LoadFloat4(color);
+			const __m128 cDX = LoadFloat4(setup.colorDX);
+
+			for (int32 i = 0; i < count; ++i)
+			{
+				BlendPixel<Path>(pDst[i], Shade<PixelShader>(c, uv, setup, context), context);
+				c = _mm_add_ps(c, cDX);
+				uv += setup.uvDX;
+			}
+		}
+
+		template <SoftwarePixelShader PixelShader>
+		[[nodiscard]]
+		SpanFunc SelectSpanFunc(const BlendPath path) noexcept
+		{
+			switch (path)
+			{
+			case BlendPath::Opaque:
+				return &ShadeSpan<PixelShader, BlendPath::Opaque>;
+			case BlendPath::NonPremultiplied:
+				return &ShadeSpan<PixelShader, BlendPath::NonPremultiplied>;
+			case BlendPath::Generic:
+			default:
+				return &ShadeSpan<PixelShader, BlendPath::Generic>;
+			}
+		}
+
+		[[nodiscard]]
+		static ShadingContext MakeShadingContext(const SoftwareDrawState& state)
+		{
+			ShadingContext context;
+			const BlendState& blendState = state.blendState;
+			const bool writeAll = (blendState.writeR && blendState.writeG && blendState.writeB && blendState.writeA);
+
+			BlendPath path = BlendPath::Generic;
+
+			if (writeAll && (not blendState.enable))
+			{
+				path = BlendPath::Opaque;
+			}
+			else if (writeAll && (blendState == BlendState{ BlendState::NonPremultiplied }))
+			{
+				path = BlendPath::NonPremultiplied;
+			}
+
+			context.src			= (blendState.enable ? blendState.src : Blend::One);
+			context.dst			= (blendState.enable ? blendState.dst : Blend::Zero);
+			context.srcAlpha	= (blendState.enable ? blendState.srcAlpha : Blend::One);
+			context.dstAlpha	= (blendState.enable ? blendState.dstAlpha : Blend::Zero);
+			context.op			= (blendState.enable ? blendState.op : BlendOp::Add);
+			context.opAlpha		= (blendState.enable ? blendState.opAlpha : BlendOp::Add);
+			context.writeMask	= ((blendState.writeR ? 0x000000FFu : 0u)
+								| (blendState.writeG ? 0x0000FF00u : 0u)
+								| (blendState.writeB ? 0x00FF0000u : 0u)
+								| (blendState.writeA ? 0xFF000000u : 0u));
+			context.colorAdd	= state.colorAdd;
+
+			const SoftwarePixelShader pixelShader = state.pixelShader;
+
+			if (pixelShader == SoftwarePixelShader::Texture)
+			{
+				if (state.pTexture && (*state.pTexture))
+				{
+					context.sampler.pData		= state.pTexture->data();
+					context.sampler.width		= state.pTexture->width();
+					context.sampler.height		= state.pTexture->height();
+					context.sampler.addressU	= state.samplerState.addressU;
+					context.sampler.addressV	= state.samplerState.addressV;
+					context.sampler.linear[0]	= (state.samplerState.mag == TextureFilter::Linear);
+					context.sampler.linear[1]	= (state.samplerState.min == TextureFilter::Linear);
+					context.sampler.borderColor	= state.samplerState.borderColor;
+				}
+				else
+				{
+					// テクスチャが無い場合は (0, 0, 0, 0) をサンプリングする
+					static const Color Transparent{ 0, 0, 0, 0 };
+					context.sampler.pData	= &Transparent;
+					context.sampler.width	= 1;
+					context.sampler.height	= 1;
+				}
+			}
+
+			switch (pixelShader)
+			{
+			case SoftwarePixelShader::SquareDot:
+				context.span = SelectSpanFunc<SoftwarePixelShader::SquareDot>(path);
+				break;
+			case SoftwarePixelShader::RoundDot:
+				context.span = SelectSpanFunc<SoftwarePixelShader::RoundDot>(path);
+				break;
+			case SoftwarePixelShader::Texture:
+				context.span = SelectSpanFunc<SoftwarePixelShader::Texture>(path);
+				break;
+			case SoftwarePixelShader::Shape:
+			default:
+				context.span = SelectSpanFunc<SoftwarePixelShader::Shape>(path);
+				break;
+			}
+
+			return context;
+		}
+
+		[[nodiscard]]
+		static Rect GetClipRect(const Size& targetSize, const Optional<Rect>& clipRect) noexcept
+		{
+			if (not clipRect)
+			{
+				return Rect{ targetSize };
+			}
+
+			const int32 x0 = Max(clipRect->x, 0);
+			const int32 y0 = Max(clipRect->y, 0);
+			const int32 x1 = Min((clipRect->x + clipRect->w), targetSize.x);
+			const int32 y1 = Min((clipRect->y + clipRect->h), targetSize.y);
+			return Rect{ x0, y0, Max((x1 - x0), 0), Max((y1 - y0), 0) };
+		}
+
+		static void SetupTriangle(SoftwareRasterizer::TriangleSetup& setup, const Size& targetSize, const Array<Vertex2D>& vertices, const SoftwareTriangle& triangle, const SoftwareDrawState& state)
+		{
+			setup.stateIndex = triangle.stateIndex;
+			setup.minX = setup.maxX = 0;
+			setup.minY = setup.maxY = 0;
+
+			const Vertex2D* v[3] = { &vertices[triangle.indices[0]], &vertices[triangle.indices[1]], &vertices[triangle.indices[2]] };
+
+			for (const Vertex2D* p : v)
+			{
+				if (std::isnan(p->pos.x) || std::isnan(p->pos.y))
+				{
+					return;
+				}
+			}
+
+			int64 X[3] = { ToFixed(v[0]->pos.x), ToFixed(v[1]->pos.x), ToFixed(v[2]->pos.x) };
+			int64 Y[3] = { ToFixed(v[0]->pos.y), ToFixed(v[1]->pos.y), ToFixed(v[2]->pos.y) };
+			int64 area = ((X[1] - X[0]) * (Y[2] - Y[0]) - (Y[1] - Y[0]) * (X[2] - X[0]));
+
+			if (area == 0)
+			{
+				return;
+			}
+
+			// スクリーン座標 (y 軸下向き) で area > 0 のとき時計回り (表面)
+			if (((state.cullMode == CullMode::Back) && (area < 0))
+				|| ((state.cullMode == CullMode::Front) && (0 < area)))
+			{
+				return;
+			}
+
+			// 辺関数が内側で正になるよう、時計回りにそろえる
+			if (area < 0)
+			{
+				std::swap(v[1], v[2]);
+				std::swap(X[1], X[2]);
+				std::swap(Y[1], Y[2]);
+				area = -area;
+			}
+
+			// 描画範囲
+			{
+				const Rect clip = GetClipRect(targetSize, state.clipRect);
+				const int64 minX = FloorDiv(Min({ X[0], X[1], X[2] }), SubPixelScale);
+				const int64 minY = FloorDiv(Min({ Y[0], Y[1], Y[2] }), SubPixelScale);
+				const int64 maxX = (FloorDiv(Max({ X[0], X[1], X[2] }), SubPixelScale) + 1);
+				const int64 maxY = (FloorDiv(Max({ Y[0], Y[1], Y[2] }), SubPixelScale) + 1);
+
+				setup.minX = static_cast<int32>(Max<int64>(minX, clip.x));
+				setup.minY = static_cast<int32>(Max<int64>(minY, clip.y));
+				setup.maxX = static_cast<int32>(Min<int64>(maxX, (clip.x + clip.w)));
+				setup.maxY = static_cast<int32>(Min<int64>(maxY, (clip.y + clip.h)));
+
+				if ((setup.maxX <= setup.minX) || (setup.maxY <= setup.minY))
+				{
+					setup.minX = setup.maxX = 0;
+					setup.minY = setup.maxY = 0;
+					return;
+				}
+			}
+
+			// 辺関数
+			for (int32 i = 0; i < 3; ++i)
+			{
+				const int32 k = ((i + 1) % 3);
+				const int64 dx = (X[k] - X[i]);
+				const int64 dy = (Y[k] - Y[i]);
+				const int64 a = (-dy * SubPixelScale);
+				const int64 b = (dx * SubPixelScale);
+				constexpr int64 HalfPixel = (SubPixelScale / 2);
+
+				setup.edgeA[i] = a;
+				setup.edgeB[i] = b;
+				setup.edgeC[i] = (dx * (HalfPixel - Y[i]) - dy * (HalfPixel - X[i]));
+				setup.edgeBias[i] = (((0 < a) || ((a == 0) && (0 < b))) ? 0 : 1);
+			}
+
+			// 属性の平面方程式
+			{
+				const double x0 = (static_cast<double>(X[0]) / SubPixelScale);
+				const double y0 = (static_cast<double>(Y[0]) / SubPixelScale);
+				const double dx1 = (static_cast<double>(X[1] - X[0]) / SubPixelScale);
+				const double dy1 = (static_cast<double>(Y[1] - Y[0]) / SubPixelScale);
+				const double dx2 = (static_cast<double>(X[2] - X[0]) / SubPixelScale);
+				const double dy2 = (static_cast<double>(Y[2] - Y[0]) / SubPixelScale);
+				const double invDet = (1.0 / (dx1 * dy2 - dx2 * dy1));
+				const double ox = ((setup.minX + 0.5) - x0);
+				const double oy = ((setup.minY + 0.5) - y0);
+
+				const float a0[6] = { v[0]->color.x, v[0]->color.y, v[0]->color.z, v[0]->color.w, v[0]->tex.x, v[0]->tex.y };
+				const float a1[6] = { v[1]->color.x, v[1]->color.y, v[1]->color.z, v[1]->color.w, v[1]->tex.x, v[1]->tex.y };
+				const float a2[6] = { v[2]->color.x, v[2]->color.y, v[2]->color.z, v[2]->color.w, v[2]->tex.x, v[2]->tex.y };
+				float base[6], ddx[6], ddy[6];
+
+				for (int32 i = 0; i < 6; ++i)
+				{
+					const double da1 = (static_cast<double>(a1[i]) - a0[i]);
+					const double da2 = (static_cast<double>(a2[i]) - a0[i]);
+					const double dadx = ((da1 * dy2 - da2 * dy1) * invDet);
+					const double dady = ((da2 * dx1 - da1 * dx2) * invDet);
+					base[i] = static_cast<float>(a0[i] + dadx * ox + dady * oy);
+					ddx[i] = static_cast<float>(dadx);
+					ddy[i] = static_cast<float>(dady);
+				}
+
+				setup.color.set(base[0], base[1], base[2], base[3]);
+				setup.colorDX.set(ddx[0], ddx[1], ddx[2], ddx[3]);
+				setup.colorDY.set(ddy[0], ddy[1], ddy[2], ddy[3]);
+				setup.uv.set(base[4], base[5]);
+				setup.uvDX.set(ddx[4], ddx[5]);
+				setup.uvDY.set(ddy[4], ddy[5]);
+			}
+
+			// テクスチャの拡大・縮小
+			if (state.pTexture)
+			{
+				const double w = state.pTexture->width();
+				const double h = state.pTexture->height();
+				const double ux = (setup.uvDX.x * w), vx = (setup.uvDX.y * h);
+				const double uy = (setup.uvDY.x * w), vy = (setup.uvDY.y * h);
+				const double sx = ((ux * ux) + (vx * vx));
+				const double sy = ((uy * uy) + (vy * vy));
+				setup.minification = (1.0 < Max(sx, sy));
+			}
+		}
+
+		// 三角形の描画範囲とタイルの共通部分に、三角形に含まれるピクセルがありうるか
+		[[nodiscard]]
+		inline bool TileOverlapsTriangle(const SoftwareRasterizer::TriangleSetup& setup, const int32 tileX, const int32 tileY) noexcept
+		{
+			const int64 x0 = Max(setup.minX, tileX);
+			const int64 y0 = Max(setup.minY, tileY);
+			const int64 x1 = (Min(setup.maxX, (tileX + SoftwareRasterizer::TileSize)) - 1);
+			const int64 y1 = (Min(setup.maxY, (tileY + SoftwareRasterizer::TileSize)) - 1);
+
+			// 辺関数は x, y について線形なので、矩形内での最大値は角のいずれかでとる。
+			// 1 つの辺でも最大値が bias 未満なら、矩形内のすべてのピクセルが三角形の外側にある
+			for (int32 i = 0; i < 3; ++i)
+			{
+				const int64 a = setup.edgeA[i];
+				const int64 b = setup.edgeB[i];
+				const int64 e = (a * ((0 < a) ? x1 : x0) + b * ((0 < b) ? y1 : y0) + setup.edgeC[i]);
+
+				if (e < setup.edgeBias[i])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		static void RasterizeTile(Image& target, const Rect& tile, const Array<uint32>& bin,
+			const Array<SoftwareRasterizer::TriangleSetup>& setups, const Array<ShadingContext>& contexts)
+		{
+			const size_t width = target.width();
+			Color* const pImage = target.data();
+
+			for (const uint32 index : bin)
+			{
+				const SoftwareRasterizer::TriangleSetup& setup = setups[index];
+				const ShadingContext& context = contexts[setup.stateIndex];
+				const int32 xBegin = Max(setup.minX, tile.x);
+				const int32 xEnd = Min(setup.maxX, (tile.x + tile.w));
+				const int32 yBegin = Max(setup.minY, tile.y);
+				const int32 yEnd = Min(setup.maxY, (tile.y + tile.h));
+
+				for (int32 y = yBegin; y < yEnd; ++y)
+				{
+					int64 lo = xBegin;
+					int64 hi = xEnd;
+
+					// 3 辺の辺関数がすべて bias 以上になる x の範囲を求める
+					for (int32 i = 0; (i < 3) && (lo < hi); ++i)
+					{
+						const int64 a = setup.edgeA[i];
+						const int64 bias = setup.edgeBias[i];
+						const int64 e = (a * xBegin + setup.edgeB[i] * y + setup.edgeC[i]);
+
+						if (0 < a)
+						{
+							if (e < bias)
+							{
+								lo = Max(lo, (xBegin + (bias - e + a - 1) / a));
+							}
+						}
+						else if (a < 0)
+						{
+							if (e < bias)
+							{
+								hi = lo;
+							}
+							else
+							{
+								hi = Min(hi, (xBegin + (e - bias) / (-a) + 1));
+							}
+						}
+						else if (e < bias)
+						{
+							hi = lo;
+						}
+					}
+
+					if (hi <= lo)
+					{
+						continue;
+					}
+
+					const float fx = static_cast<float>(lo - setup.minX);
+					const float fy = static_cast<float>(y - setup.minY);
+					const Float4 color = (setup.color + setup.colorDX * fx + setup.colorDY * fy);
+					const Float2 uv = (setup.uv + setup.uvDX * fx + setup.uvDY * fy);
+
+					context.span((pImage + (y * width) + lo), static_cast<int32>(hi - lo), color, uv, setup, context);
+				}
+			}
+		}
+	}
+
+	void SoftwareRasterizer::draw(Image& target, const Array<Vertex2D>& vertices, const SoftwareTriangle* triangles, const size_t triangleCount, const Array<SoftwareDrawState>& states)
+	{
+		if ((not target) || (triangleCount == 0))
+		{
+			return;
+		}
+
+		const Size targetSize = target.size();
+
+		// 三角形のセットアップ
+		{
+			m_setups.resize(triangleCount);
+
+			Threading::ParallelFor(triangleCount, [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					detail::SetupTriangle(m_setups[i], targetSize, vertices, triangles[i], states[triangles[i].stateIndex]);
+				}
+			}, 256);
+		}
+
+		// 三角形をタイルに振り分ける (描画順を保つ)
+		// 辺関数は 64 ビット整数のため、タイルの判定はスカラーで行う
+		const int32 tilesX = ((targetSize.x + TileSize - 1) / TileSize);
+		const int32 tilesY = ((targetSize.y + TileSize - 1) / TileSize);
+		const size_t numTiles = (static_cast<size_t>(tilesX) * tilesY);
+		{
+			if (m_bins.size() < numTiles)
+			{
+				m_bins.resize(numTiles);
+			}
+
+			for (size_t i = 0; i < numTiles; ++i)
+			{
+				m_bins[i].clear();
+			}
+
+			for (uint32 i = 0; i < triangleCount; ++i)
+			{
+				const TriangleSetup& setup = m_setups[i];
+
+				if (setup.maxX <= setup.minX)
+				{
+					continue;
+				}
+
+				const int32 tx0 = (setup.minX / TileSize);
+				const int32 ty0 = (setup.minY / TileSize);
+				const int32 tx1 = ((setup.maxX - 1) / TileSize);
+				const int32 ty1 = ((setup.maxY - 1) / TileSize);
+
+				if ((tx0 == tx1) && (ty0 == ty1))
+				{
+					m_bins[static_cast<size_t>(ty0) * tilesX + tx0].push_back(i);
+					continue;
+				}
+
+				for (int32 ty = ty0; ty <= ty1; ++ty)
+				{
+					for (int32 tx = tx0; tx <= tx1; ++tx)
+					{
+						if (detail::TileOverlapsTriangle(setup, (tx * TileSize), (ty * TileSize)))
+						{
+							m_bins[static_cast<size_t>(ty) * tilesX + tx].push_back(i);
+						}
+					}
+				}
+			}
+		}
+
+		// 描画ステートごとのピクセル処理
+		Array<detail::ShadingContext> contexts(Arg::reserve = states.size());
+		{
+			for (const auto& state : states)
+			{
+				contexts.push_back(detail::MakeShadingContext(state));
+			}
+		}
+
+		// タイルごとに並列にラスタライズする
+		Threading::ParallelFor(numTiles, [&](const size_t first, const size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				if (not m_bins[i])
+				{
+					continue;
+				}
+
+				const int32 tx = static_cast<int32>(i % tilesX);
+				const int32 ty = static_cast<int32>(i / tilesX);
+				const Rect tile{ (tx * TileSize), (ty * TileSize), TileSize, TileSize };
+
+				detail::RasterizeTile(target, tile, m_bins[i], m_setups, contexts);
+			}
+		});
+	}
+
+	namespace Internal
+	{
+		void RasterizeSoftware(Image& target, const Array<Vertex2D>& vertices, const Array<TriangleIndex>& indices, const SoftwareRasterizationState& state)
+		{
+			SoftwareDrawState drawState;
+			drawState.blendState	= state.blendState;
+			drawState.samplerState	= state.samplerState;
+			drawState.clipRect		= state.clipRect;
+
+			if (state.pTexture)
+			{
+				drawState.pixelShader	= SoftwarePixelShader::Texture;
+				drawState.pTexture		= state.pTexture;
+			}
+
+			Array<SoftwareTriangle> triangles(Arg::reserve = indices.size());
+
+			for (const auto& index : indices)
+			{
+				triangles.push_back({ { index.i0, index.i1, index.i2 }, 0 });
+			}
+
+			SoftwareRasterizer rasterizer;
+			rasterizer.draw(target, vertices, triangles.data(), triangles.size(), { drawState });
+		}
+	}
+}
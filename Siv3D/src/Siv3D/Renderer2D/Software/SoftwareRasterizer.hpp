@@ -0,0 +1,146 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Vertex2D.hpp>
+# include <Siv3D/BlendState.hpp>
+# include <Siv3D/RasterizerState.hpp>
+# include <Siv3D/SamplerState.hpp>
+# include <Siv3D/Texture.hpp>
+
+namespace s3d
+{
+	/// @brief ソフトウェアレンダラーが実行する標準ピクセルシェーダ
+	enum class SoftwarePixelShader : uint8
+	{
+		/// @brief 頂点色 (shape)
+		Shape,
+
+		/// @brief 角ドット線 (square_dot)
+		SquareDot,
+
+		/// @brief 丸ドット線 (round_dot)
+		RoundDot,
+
+		/// @brief テクスチャ (texture)
+		Texture,
+	};
+
+	/// @brief ソフトウェアレンダラーの描画ステート
+	struct SoftwareDrawState
+	{
+		BlendState blendState = BlendState::Default2D;
+
+		SamplerState samplerState = SamplerState::Default2D;
+
+		CullMode cullMode = CullMode::Off;
+
+		SoftwarePixelShader pixelShader = SoftwarePixelShader::Shape;
+
+		/// @brief ピクセルシェーダのスロット 0 のテクスチャ
+		Texture::IDType textureID = Texture::IDType::InvalidValue();
+
+		Float4 colorAdd{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+		/// @brief 描画範囲 (ビューポートとシザー矩形の共通部分)。none の場合は描画先全体
+		Optional<Rect> clipRect;
+
+		/// @brief textureID のテクスチャの画像 (描画時に設定)
+		const Image* pTexture = nullptr;
+
+		[[nodiscard]]
+		bool operator ==(const SoftwareDrawState& other) const noexcept
+		{
+			return (blendState == other.blendState)
+				&& (samplerState == other.samplerState)
+				&& (cullMode == other.cullMode)
+				&& (pixelShader == other.pixelShader)
+				&& (textureID == other.textureID)
+				&& (colorAdd == other.colorAdd)
+				&& (clipRect == other.clipRect);
+		}
+
+		[[nodiscard]]
+		bool operator !=(const SoftwareDrawState& other) const noexcept
+		{
+			return (not (*this == other));
+		}
+	};
+
+	/// @brief ソフトウェアレンダラーの三角形
+	struct SoftwareTriangle
+	{
+		/// @brief 頂点配列のインデックス
+		uint32 indices[3];
+
+		/// @brief 描画ステートのインデックス
+		uint32 stateIndex;
+	};
+
+	/// @brief 三角形をタイルに振り分け、タイルごとに並列にラスタライズする
+	class SoftwareRasterizer
+	{
+	public:
+
+		/// @brief タイルの一辺のピクセル数
+		static constexpr int32 TileSize = 64;
+
+		/// @brief 三角形を描画先の画像にラスタライズします。
+		/// @param target 描画先の画像
+		/// @param vertices スクリーン座標に変換済みの頂点配列
+		/// @param triangles 三角形の配列の先頭ポインタ
+		/// @param triangleCount 三角形の個数
+		/// @param states 描画ステートの配列 (pTexture 設定済み)
+		/// @remark 同じピクセルに重なる三角形は、配列の順番どおりに描画されます。
+		void draw(Image& target, const Array<Vertex2D>& vertices, const SoftwareTriangle* triangles, size_t triangleCount, const Array<SoftwareDrawState>& states);
+
+		struct TriangleSetup
+		{
+			// 描画範囲 [minX, maxX) x [minY, maxY)。空の場合 minX == maxX
+			int32 minX = 0;
+			int32 minY = 0;
+			int32 maxX = 0;
+			int32 maxY = 0;
+
+			// 辺関数 E(x, y) = a * x + b * y + c (ピクセル (x, y) の中心での値, 1/256 ピクセル単位)
+			int64 edgeA[3];
+			int64 edgeB[3];
+			int64 edgeC[3];
+
+			// 辺上のピクセルを含む場合 0, 含まない場合 1 (top-left rule)
+			int64 edgeBias[3];
+
+			// (minX, minY) のピクセル中心での属性値と、x, y 方向の増分
+			Float4 color;
+			Float4 colorDX;
+			Float4 colorDY;
+			Float2 uv;
+			Float2 uvDX;
+			Float2 uvDY;
+
+			uint32 stateIndex = 0;
+
+			// テクスチャが縮小されて描画されるか
+			bool minification = false;
+		};
+
+	private:
+
+		Array<TriangleSetup> m_setups;
+
+		Array<Array<uint32>> m_bins;
+	};
+}
@@ -13,17 +13,19 @@
 # include <Siv3D/FastMath.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/OffsetCircular.hpp>
+# include <Siv3D/Circle.hpp>
+# include <Siv3D/RectF.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/ArenaAllocator.hpp>
+# include <Siv3D/Threading/SerialExecution.hpp>
+# include "LineStringVertices.hpp"
 
 namespace s3d
 {
 	namespace detail
 	{
-		static constexpr Vertex2D::IndexType RectIndexTable[6] = { 0, 1, 2, 2, 1, 3 };
-
 		static constexpr Vertex2D::IndexType RectFrameIndexTable[24] = { 0, 1, 2, 3, 2, 1, 0, 4, 1, 5, 1, 4, 5, 4, 7, 6, 7, 4, 3, 7, 2, 6, 2, 7 };
 
-		static constexpr Vertex2D::IndexType MaxSinCosTableQuality = 40;
-
 		static constexpr Vertex2D::IndexType SinCosTableSize = ((MaxSinCosTableQuality - 5) * (6 + (MaxSinCosTableQuality))) / 2;
 
 		static const std::array<Float2, SinCosTableSize> CircleSinCosTable = []()
@@ -45,23 +47,221 @@ namespace s3d
 			return results;
 		}();
 
-		[[nodiscard]]
-		inline const Float2* GetSinCosTableStartPtr(const uint16 quality) noexcept
+		const Float2* GetSinCosTableStartPtr(const uint16 quality) noexcept
 		{
 			return &CircleSinCosTable[((quality - 6) * (6 + (quality - 1))) / 2];
 		}
 
+		// 一括描画で 1 回のバッファ要求に含める頂点の最大数
+		static constexpr uint32 MaxBulkVertexSize = 32768;
+
+		// 一括描画で 1 回のバッファ要求に含めるインデックスの最大数 (描画コマンドが Vertex2D::IndexType で数えるため)
+		static constexpr uint32 MaxBulkIndexSize = 65535;
+
+		// 一括描画で、並列に頂点を作成する単位となる図形の個数
+		static constexpr size_t BulkBlockSize = 256;
+
+		// 一括描画で 1 回のバッファ要求に含まれる円のブロックの最大数
+		static constexpr size_t MaxBulkCircleBlocks = (((MaxBulkVertexSize / (CalculateCircleQuality(0.0f) + 1)) / BulkBlockSize) + 1);
+
+		// 線の頂点作成で、並列に処理する単位となる要素数
+		static constexpr size_t LineStringBlockSize = 2048;
+
+		// 1 回のバッファ要求で作成できる線の頂点のペアの最大数 (インデックスの個数が Vertex2D::IndexType に収まる範囲)
+		static constexpr size_t MaxLineStringVertexPairs = 10922;
+
+		// [first, last) の各要素 i について f(i, dst) を呼び、dst に要素を追加する。
+		// 要素数が多い場合はブロックごとに並列に処理し、結果をブロックの順番どおりに連結するため、逐次処理と同じ結果になる
+		// (ブロックはワーカースレッドで確保されるため、フレームアリーナではなく通常のヒープを使う)
+		template <class Type, class Allocator, class Fty>
+		void AppendInOrder(Array<Type, Allocator>& dst, const size_t first, const size_t last, Fty f)
+		{
+			if ((last <= first)
+				|| ((last - first) < (LineStringBlockSize * 2))
+				|| Threading::IsSerialExecution())
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					f(i, dst);
+				}
+
+				return;
+			}
+
+			const size_t numBlocks = (((last - first) + LineStringBlockSize - 1) / LineStringBlockSize);
+			Array<Array<Type>> blocks(numBlocks);
+
+			Threading::ParallelFor(numBlocks, [&](const size_t firstBlock, const size_t lastBlock)
+			{
+				for (size_t block = firstBlock; block < lastBlock; ++block)
+				{
+					const size_t blockFirst = (first + block * LineStringBlockSize);
+					const size_t blockLast = Min((blockFirst + LineStringBlockSize), last);
+					Array<Type>& blockDst = blocks[block];
+					blockDst.reserve((blockLast - blockFirst) * 2);
+
+					for (size_t i = blockFirst; i < blockLast; ++i)
+					{
+						f(i, blockDst);
+					}
+				}
+			});
+
+			Array<size_t> offsets(numBlocks);
+			size_t totalSize = dst.size();
+
+			for (size_t block = 0; block < numBlocks; ++block)
+			{
+				offsets[block] = totalSize;
+				totalSize += blocks[block].size();
+			}
+
+			dst.resize(totalSize);
+
+			Threading::ParallelFor(numBlocks, [&](const size_t firstBlock, const size_t lastBlock)
+			{
+				for (size_t block = firstBlock; block < lastBlock; ++block)
+				{
+					std::copy(blocks[block].begin(), blocks[block].end(), (dst.begin() + offsets[block]));
+				}
+			});
+		}
+
+		// 線の角 current が鋭角の場合、角を丸めるために current の後に追加する点を joint に格納して true を返す
 		[[nodiscard]]
-		inline constexpr Vertex2D::IndexType CalculateCircleQuality(const float size) noexcept
+		inline bool GetJointPoint(const Float2 back, const Float2 current, const Float2 next, const float th2, Float2& joint)
 		{
-			if (size <= 5.0f)
+			const float threshold = 0.55f;
+
+			const Float2 v1 = (back - current).normalized();
+			const Float2 v2 = (next - current).normalized();
+
+			if (v1.dot(v2) <= threshold)
+			{
+				return false;
+			}
+
+			const Float2 line = (current - back);
+			const Float2 tangent = ((next - current).normalized() + (current - back).normalized()).normalized();
+			const Float2 line2 = (next - current);
+
+			if (tangent.dot(line2) >= (-tangent).dot(line2))
+			{
+				joint = (current + tangent.normalized() * th2);
+			}
+			else if (tangent.dot(line2) <= (-tangent).dot(line2))
 			{
-				return static_cast<Vertex2D::IndexType>(size + 3) * 2;
+				joint = (current + (-tangent).normalized() * th2);
 			}
 			else
 			{
-				return static_cast<Vertex2D::IndexType>(Min(18 + (size - 5.0f) / 2.2f, 255.0f));
+				const Float2 normal = Float2{ -line.y, line.x }.normalized();
+				joint = (current + normal * 0.001f);
+			}
+
+			return true;
+		}
+
+		// 線の端点以外の点 p1 について、前後の点 p0, p2 との角を結ぶ頂点のペアを書き込む
+		inline void WriteMiterPair(Vertex2D* pDst, const Float2 p0, const Float2 p1, const Float2 p2, const float thicknessHalf, const Float4& color)
+		{
+			const Float2 line = p1 - p0;
+			const Float2 normal = Float2{ -line.y, line.x }.normalized();
+			const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
+			const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
+			const Float2 miter = Float2{ -tangent.y, tangent.x };
+			const float length = thicknessHalf / miter.dot(normal);
+			const Float2 result0 = p1 + miter * length;
+			const Float2 result1 = p1 - miter * length;
+
+			pDst[0].set(result0, color);
+			pDst[1].set(result1, color);
+		}
+
+		// 線の始点 p0 の頂点のペアを書き込む (p1 は次の点)。線の外側に capLength だけ延ばす
+		inline void WriteBeginPair(Vertex2D* pDst, const Float2 p0, const Float2 p1, const float thicknessHalf, const float capLength, const Float4& color)
+		{
+			const Float2 line = (p1 - p0).normalize();
+			const Float2 vNormalBegin{ -line.y * thicknessHalf, line.x * thicknessHalf };
+			const Float2 lineHalf(line * capLength);
+
+			pDst[0].set(p0 + vNormalBegin - lineHalf, color);
+			pDst[1].set(p0 - vNormalBegin - lineHalf, color);
+		}
+
+		// 線の終点 p1 の頂点のペアを書き込む (p0 は前の点)。線の外側に capLength だけ延ばす
+		inline void WriteEndPair(Vertex2D* pDst, const Float2 p0, const Float2 p1, const float thicknessHalf, const float capLength, const Float4& color)
+		{
+			const Float2 line = (p1 - p0).normalize();
+			const Float2 vNormalEnd{ -line.y * thicknessHalf, line.x * thicknessHalf };
+			const Float2 lineHalf(line * capLength);
+
+			pDst[0].set(p1 + vNormalEnd + lineHalf, color);
+			pDst[1].set(p1 - vNormalEnd + lineHalf, color);
+		}
+
+		// 頂点のペア [0, pairCount) と、隣り合うペアを結ぶ四角形のインデックスを作成する (closed の場合は最後のペアと最初のペアも結ぶ)。
+		// writePair(i, pDst) は i 番目のペアの 2 頂点を pDst に書き込む。
+		// 1 回のバッファ要求に収まらない場合は、隣り合う範囲が境目のペアを共有するように分け、バッファ要求ごとに onBuilt を呼ぶ
+		template <class WritePair>
+		bool BuildLineStrip(const BufferCreatorFunc& bufferCreator, const size_t pairCount, const bool closed, const Optional<Float2>& offset, const OnBuiltFunc& onBuilt, WritePair writePair)
+		{
+			const size_t quadCount = (closed ? pairCount : (pairCount - 1));
+
+			// 1 回のバッファ要求に収まる閉じた線は、最後のペアから最初のペアへのインデックスで閉じる
+			const bool wrap = (closed && (pairCount <= MaxLineStringVertexPairs));
+
+			bool built = false;
+
+			for (size_t firstQuad = 0; firstQuad < quadCount;)
+			{
+				const size_t chunkQuads = (wrap ? quadCount : Min((quadCount - firstQuad), (MaxLineStringVertexPairs - 1)));
+				const size_t chunkPairs = (wrap ? pairCount : (chunkQuads + 1));
+				const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(chunkPairs * 2);
+				const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(chunkQuads * 6);
+				auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+				if (not pVertex)
+				{
+					break;
+				}
+
+				Threading::ParallelFor(chunkPairs, [&, pVertex = pVertex](const size_t first, const size_t last)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						Vertex2D* pDst = (pVertex + i * 2);
+
+						writePair(((firstQuad + i) % pairCount), pDst);
+
+						if (offset)
+						{
+							pDst[0].pos.moveBy(*offset);
+							pDst[1].pos.moveBy(*offset);
+						}
+					}
+				}, LineStringBlockSize);
+
+				Threading::ParallelFor(chunkQuads, [&, pIndex = pIndex, indexOffset = indexOffset](const size_t first, const size_t last)
+				{
+					Vertex2D::IndexType* pDst = (pIndex + first * 6);
+
+					for (size_t k = first; k < last; ++k)
+					{
+						for (Vertex2D::IndexType i = 0; i < 6; ++i)
+						{
+							*pDst++ = static_cast<Vertex2D::IndexType>(indexOffset + (RectIndexTable[i] + k * 2) % vertexSize);
+						}
+					}
+				}, LineStringBlockSize);
+
+				onBuilt(indexSize);
+
+				built = true;
+				firstQuad += chunkQuads;
 			}
+
+			return built;
 		}
 
 		[[nodiscard]]
@@ -328,91 +528,55 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(points[0], color);
-			pVertex[1].set(points[1], color);
-			pVertex[2].set(points[2], color);
-
-			pIndex[0] = indexOffset;
-			pIndex[1] = (indexOffset + 1);
-			pIndex[2] = (indexOffset + 2);
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3])
+		Vertex2D::IndexType BuildRectBatch(const BufferCreatorFunc& bufferCreator, const RectF* rects, const ColorF* colors, const size_t count, const bool singleColor, size_t& numBuilt)
 		{
-			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+			numBuilt = 0;
 
-			if (not pVertex)
+			if ((not rects)
+				|| (not colors)
+				|| (count == 0))
 			{
 				return 0;
 			}
 
-			pVertex[0].set(points[0], colors[0]);
-			pVertex[1].set(points[1], colors[1]);
-			pVertex[2].set(points[2], colors[2]);
-
-			pIndex[0] = indexOffset;
-			pIndex[1] = (indexOffset + 1);
-			pIndex[2] = (indexOffset + 2);
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+			const size_t rectCount = Min({ count, static_cast<size_t>(detail::MaxBulkVertexSize / 4), static_cast<size_t>(detail::MaxBulkIndexSize / 6) });
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(rectCount * 4), indexSize = static_cast<Vertex2D::IndexType>(rectCount * 6);
+			const Vertex2DBufferPointer buffer = bufferCreator(vertexSize, indexSize);
 
-			if (not pVertex)
+			if (not buffer.pVertex)
 			{
 				return 0;
 			}
 
-			pVertex[0].set(rect.left, rect.top, color);
-			pVertex[1].set(rect.right, rect.top, color);
-			pVertex[2].set(rect.left, rect.bottom, color);
-			pVertex[3].set(rect.right, rect.bottom, color);
+			const Float4 color0 = colors[0].toFloat4();
 
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			Threading::ParallelFor(rectCount, [&](const size_t first, const size_t last)
 			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
+				Vertex2D* pVertex = (buffer.pVertex + first * 4);
+				Vertex2D::IndexType* pIndex = (buffer.pIndex + first * 6);
 
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+				for (size_t i = first; i < last; ++i)
+				{
+					const RectF& rect = rects[i];
+					const FloatRect r{ rect.x, rect.y, (rect.x + rect.w), (rect.y + rect.h) };
+					const Float4 color = (singleColor ? color0 : colors[i].toFloat4());
 
-			if (not pVertex)
-			{
-				return 0;
-			}
+					pVertex[0].set(r.left, r.top, color);
+					pVertex[1].set(r.right, r.top, color);
+					pVertex[2].set(r.left, r.bottom, color);
+					pVertex[3].set(r.right, r.bottom, color);
+					pVertex += 4;
 
-			pVertex[0].set(rect.left, rect.top, colors[0]);
-			pVertex[1].set(rect.right, rect.top, colors[1]);
-			pVertex[2].set(rect.left, rect.bottom, colors[3]);
-			pVertex[3].set(rect.right, rect.bottom, colors[2]);
+					const Vertex2D::IndexType indexOffset = static_cast<Vertex2D::IndexType>(buffer.indexOffset + i * 4);
 
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
+					for (Vertex2D::IndexType k = 0; k < 6; ++k)
+					{
+						*pIndex++ = (indexOffset + detail::RectIndexTable[k]);
+					}
+				}
+			}, detail::BulkBlockSize);
 
+			numBuilt = rectCount;
 			return indexSize;
 		}
 
@@ -449,71 +613,76 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildCircle(const BufferCreatorFunc& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, const float scale)
+		Vertex2D::IndexType BuildCircleBatch(const BufferCreatorFunc& bufferCreator, const Circle* circles, const ColorF* colors, const size_t count, const bool singleColor, const float scale, size_t& numBuilt)
 		{
-			const float absR = Abs(r);
-			const Vertex2D::IndexType quality = detail::CalculateCircleQuality(absR * scale);
-			const Vertex2D::IndexType vertexSize = (quality + 1), indexSize = (quality * 3);
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+			numBuilt = 0;
 
-			if (not pVertex)
+			if ((not circles)
+				|| (not colors)
+				|| (count == 0))
 			{
 				return 0;
 			}
 
-			// 中心
-			const float centerX = center.x;
-			const float centerY = center.y;
-			pVertex[0].pos.set(centerX, centerY);
+			// 1 回のバッファ要求に収まる円の個数と、ブロックごとの書き込み開始位置を求める
+			std::array<std::pair<uint32, uint32>, detail::MaxBulkCircleBlocks> blockOffsets;
+			uint32 vertexSize = 0, indexSize = 0;
+			size_t circleCount = 0;
 
-			// 周
-			if (quality <= detail::MaxSinCosTableQuality)
+			for (; circleCount < count; ++circleCount)
 			{
-				const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
-				Vertex2D* pDst = &pVertex[1];
+				const Vertex2D::IndexType quality = detail::CalculateCircleQuality(Abs(static_cast<float>(circles[circleCount].r)) * scale);
 
-				for (Vertex2D::IndexType i = 0; i < quality; ++i)
+				if ((detail::MaxBulkVertexSize < (vertexSize + quality + 1))
+					|| (detail::MaxBulkIndexSize < (indexSize + quality * 3)))
 				{
-					(pDst++)->pos.set(r * pCS->x + centerX, r * pCS->y + centerY);
-					++pCS;
+					break;
 				}
-			}
-			else
-			{
-				const float radDelta = Math::TwoPiF / quality;
-				Vertex2D* pDst = &pVertex[1];
 
-				for (Vertex2D::IndexType i = 0; i < quality; ++i)
+				if ((circleCount % detail::BulkBlockSize) == 0)
 				{
-					const float rad = (radDelta * i);
-					const auto [s, c] = FastMath::SinCos(rad);
-					(pDst++)->pos.set(centerX + r * c, centerY - r * s);
+					blockOffsets[circleCount / detail::BulkBlockSize] = { vertexSize, indexSize };
 				}
+
+				vertexSize += (quality + 1);
+				indexSize += (quality * 3);
 			}
 
-			{
-				(pVertex++)->color = innerColor;
+			const Vertex2DBufferPointer buffer = bufferCreator(static_cast<Vertex2D::IndexType>(vertexSize), static_cast<Vertex2D::IndexType>(indexSize));
 
-				for (size_t i = 1; i < vertexSize; ++i)
-				{
-					(pVertex++)->color = outerColor;
-				}
+			if (not buffer.pVertex)
+			{
+				return 0;
 			}
 
+			const Float4 color0 = colors[0].toFloat4();
+			const size_t numBlocks = ((circleCount + detail::BulkBlockSize - 1) / detail::BulkBlockSize);
+
+			Threading::ParallelFor(numBlocks, [&](const size_t firstBlock, const size_t lastBlock)
 			{
-				for (Vertex2D::IndexType i = 0; i < (quality - 1); ++i)
+				for (size_t block = firstBlock; block < lastBlock; ++block)
 				{
-					*pIndex++ = indexOffset + (i + 1);
-					*pIndex++ = indexOffset;
-					*pIndex++ = indexOffset + (i + 2);
-				}
+					auto [vertexPos, indexPos] = blockOffsets[block];
+					const size_t last = Min(((block + 1) * detail::BulkBlockSize), circleCount);
 
-				*pIndex++ = (indexOffset + quality);
-				*pIndex++ = indexOffset;
-				*pIndex++ = (indexOffset + 1);
-			}
+					for (size_t i = (block * detail::BulkBlockSize); i < last; ++i)
+					{
+						const Circle& circle = circles[i];
+						const float r = static_cast<float>(circle.r);
+						const Vertex2D::IndexType quality = detail::CalculateCircleQuality(Abs(r) * scale);
+						const Float4 color = (singleColor ? color0 : colors[i].toFloat4());
 
-			return indexSize;
+						detail::WriteCircle((buffer.pVertex + vertexPos), (buffer.pIndex + indexPos),
+							static_cast<Vertex2D::IndexType>(buffer.indexOffset + vertexPos), circle.center, r, quality, color, color);
+
+						vertexPos += (quality + 1);
+						indexPos += (quality * 3);
+					}
+				}
+			});
+
+			numBuilt = circleCount;
+			return static_cast<Vertex2D::IndexType>(indexSize);
 		}
 
 		Vertex2D::IndexType BuildCircleFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
@@ -831,52 +1000,6 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4 color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(quad.p[0], color);
-			pVertex[1].set(quad.p[1], color);
-			pVertex[2].set(quad.p[3], color);
-			pVertex[3].set(quad.p[2], color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(quad.p[0], colors[0]);
-			pVertex[1].set(quad.p[1], colors[1]);
-			pVertex[2].set(quad.p[3], colors[3]);
-			pVertex[3].set(quad.p[2], colors[2]);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
 		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale)
 		{
 			const float rr = Min({ w * 0.5f, h * 0.5f, Max(0.0f, r) });
@@ -1093,42 +1216,50 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing, const float scale)
+		bool BuildLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing, const float scale, const OnBuiltFunc& onBuilt)
 		{
 			if ((size < 2)
-				|| (32760 <= size)
 				|| (thickness <= 0.0f)
 				|| (not points))
 			{
-				return 0;
+				return false;
 			}
 
 			if (closeRing)
 			{
-				return BuildClosedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale);
+				return BuildClosedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale, onBuilt);
 			}
 
 			if (style.hasSquareCap())
 			{
-				return BuildCappedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale);
+				return BuildCappedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale, onBuilt);
 			}
 			else if (style.hasNoCap())
 			{
-				return BuildUncappedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale, nullptr, nullptr);
+				return BuildUncappedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale, nullptr, nullptr, onBuilt);
 			}
 			else if (style.hasRoundCap())
 			{
 				float startAngle0 = 0.0f, startAngle1 = 0.0f;
-				Vertex2D::IndexType indexCount = BuildUncappedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale, &startAngle0, &startAngle1);
 
-				if (indexCount)
+				if (not BuildUncappedLineString(bufferCreator, buffer, points, size, offset, thickness, inner, color, scale, &startAngle0, &startAngle1, onBuilt))
 				{
-					const float thicknessHalf = (thickness * 0.5f);
-					indexCount += BuildCirclePie(bufferCreator, points[0], thicknessHalf, startAngle0, Math::PiF, color, color, scale);
-					indexCount += BuildCirclePie(bufferCreator, points[size - 1], thicknessHalf, startAngle1 + Math::PiF, Math::PiF, color, color, scale);
+					return false;
 				}
 
-				return indexCount;
+				const float thicknessHalf = (thickness * 0.5f);
+
+				if (const Vertex2D::IndexType indexCount = BuildCirclePie(bufferCreator, points[0], thicknessHalf, startAngle0, Math::PiF, color, color, scale))
+				{
+					onBuilt(indexCount);
+				}
+
+				if (const Vertex2D::IndexType indexCount = BuildCirclePie(bufferCreator, points[size - 1], thicknessHalf, startAngle1 + Math::PiF, Math::PiF, color, color, scale))
+				{
+					onBuilt(indexCount);
+				}
+
+				return true;
 			}
 			else
 			{
@@ -1136,7 +1267,7 @@ namespace s3d
 			}
 		}
 
-		Vertex2D::IndexType BuildClosedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale)
+		bool BuildClosedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, const OnBuiltFunc& onBuilt)
 		{
 			const float th2 = (0.01f / scale);
 			const double th2D = th2;
@@ -1145,18 +1276,18 @@ namespace s3d
 			{
 				buffer.push_back(points[0]);
 
-				for (size_t i = 1; i < (size - 1); ++i)
+				detail::AppendInOrder(buffer, 1, (size - 1), [&](const size_t i, auto& dst)
 				{
 					const Vec2 back = points[i - 1];
 					const Vec2 current = points[i];
 
 					if (back.distanceFromSq(current) < th2D)
 					{
-						continue;
+						return;
 					}
 
-					buffer.push_back(current);
-				}
+					dst.push_back(current);
+				});
 
 				const Vec2 back = points[size - 2];
 				const Vec2 current = points[size - 1];
@@ -1174,51 +1305,30 @@ namespace s3d
 
 				if (buffer.size() < 2)
 				{
-					return 0;
+					return false;
 				}
 			}
 
 			const float threshold = 0.55f;
 
-			Array<Float2> buf2(Arg::reserve = buffer.size());
+			Array<Float2, ArenaAllocator<Float2>> buf2(Arg::reserve = buffer.size());
 			{
 				buf2.push_back(buffer.front());
 
 				const size_t count = buffer.size();
 
-				for (size_t i = 1; i < count; ++i)
+				detail::AppendInOrder(buf2, 1, count, [&](const size_t i, auto& dst)
 				{
-					const Float2 back = buffer[i - 1];
 					const Float2 current = buffer[i];
-					const Float2 next = buffer[(i + 1) % buffer.size()];
-
-					const Float2 v1 = (back - current).normalized();
-					const Float2 v2 = (next - current).normalized();
 
-					buf2.push_back(current);
+					dst.push_back(current);
 
-					if ((not inner)
-						&& (v1.dot(v2) > threshold))
+					if (Float2 joint; (not inner)
+						&& detail::GetJointPoint(buffer[i - 1], current, buffer[(i + 1) % buffer.size()], th2, joint))
 					{
-						const Float2 line = (current - back);
-						const Float2 tangent = ((next - current).normalized() + (current - back).normalized()).normalized();
-						const Float2 line2 = (next - current);
-
-						if (tangent.dot(line2) >= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + tangent.normalized() * th2);
-						}
-						else if (tangent.dot(line2) <= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + (-tangent).normalized() * th2);
-						}
-						else
-						{
-							const Float2 normal = Float2{ -line.y, line.x }.normalized();
-							buf2.push_back(current + normal * 0.001f);
-						}
+						dst.push_back(joint);
 					}
-				}
+				});
 
 				
 				{
@@ -1253,122 +1363,36 @@ namespace s3d
 				}
 			}
 
-			const Vertex2D::IndexType newSize = static_cast<Vertex2D::IndexType>(buf2.size());
-			const Vertex2D::IndexType vertexSize = (newSize * 2), indexSize = (6 * (newSize - 1) + 6);
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
 			const float thicknessHalf = (thickness * 0.5f);
+			const size_t pairCount = buf2.size();
 
+			return detail::BuildLineStrip(bufferCreator, pairCount, true, offset, onBuilt, [&](const size_t i, Vertex2D* pDst)
 			{
-				const Float2 p0 = buf2.back();
-				const Float2 p1 = buf2[0];
-				const Float2 p2 = buf2[1];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
+				detail::WriteMiterPair(pDst, buf2[(i + pairCount - 1) % pairCount], buf2[i], buf2[(i + 1) % pairCount], thicknessHalf, color);
+			});
+		}
 
-				pVertex[0].pos.set(result0);
-				pVertex[1].pos.set(result1);
-			}
+		bool BuildCappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, const OnBuiltFunc& onBuilt)
+		{
+			const float th2 = (0.01f / scale);
+			const double th2D = th2;
 
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
-
-			
-			{
-				const Float2 p0 = buf2[newSize - 2];
-				const Float2 p1 = buf2[newSize - 1];
-				const Float2 p2 = buf2[0];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[newSize * 2 - 2].pos.set(result0);
-				pVertex[newSize * 2 - 1].pos.set(result1);
-			}
-
-			if (offset)
-			{
-				const Float2 v = *offset;
-				Vertex2D* pDst = pVertex;
-
-				for (Vertex2D::IndexType i = 0; i < vertexSize; ++i)
-				{
-					(pDst++)->pos.moveBy(v);
-				}
-			}
-
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
-
-			{
-				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize);
-
-				for (Vertex2D::IndexType k = 0; k < count; ++k)
-				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
-					{
-						*pIndex++ = (indexOffset + (detail::RectIndexTable[i] + k * 2) % vertexSize);
-					}
-				}
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildCappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale)
-		{
-			const float th2 = (0.01f / scale);
-			const double th2D = th2;
-
-			buffer.clear();
+			buffer.clear();
 			{
 				buffer.push_back(points[0]);
 
-				for (size_t i = 1; i < (size - 1); ++i)
+				detail::AppendInOrder(buffer, 1, (size - 1), [&](const size_t i, auto& dst)
 				{
 					const Vec2 back = points[i - 1];
 					const Vec2 current = points[i];
 
 					if (back.distanceFromSq(current) < th2D)
 					{
-						continue;
+						return;
 					}
 
-					buffer.push_back(current);
-				}
+					dst.push_back(current);
+				});
 
 				const Vec2 back = points[size - 2];
 				const Vec2 current = points[size - 1];
@@ -1380,140 +1404,55 @@ namespace s3d
 
 				if (buffer.size() < 2)
 				{
-					return 0;
+					return false;
 				}
 			}
 
-			const float threshold = 0.55f;
-
-			Array<Float2> buf2(Arg::reserve = buffer.size());
+			Array<Float2, ArenaAllocator<Float2>> buf2(Arg::reserve = buffer.size());
 			{
 				buf2.push_back(buffer.front());
 
 				const size_t count = (buffer.size() - 1);
 
-				for (size_t i = 1; i < count; ++i)
+				detail::AppendInOrder(buf2, 1, count, [&](const size_t i, auto& dst)
 				{
-					const Float2 back = buffer[i - 1];
 					const Float2 current = buffer[i];
-					const Float2 next = buffer[(i + 1) % buffer.size()];
 
-					const Float2 v1 = (back - current).normalized();
-					const Float2 v2 = (next - current).normalized();
-
-					buf2.push_back(current);
+					dst.push_back(current);
 
-					if ((not inner)
-						&& (v1.dot(v2) > threshold))
+					if (Float2 joint; (not inner)
+						&& detail::GetJointPoint(buffer[i - 1], current, buffer[(i + 1) % buffer.size()], th2, joint))
 					{
-						const Float2 line = (current - back);
-						const Float2 tangent = ((next - current).normalized() + (current - back).normalized()).normalized();
-						const Float2 line2 = (next - current);
-
-						if (tangent.dot(line2) >= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + tangent.normalized() * th2);
-						}
-						else if (tangent.dot(line2) <= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + (-tangent).normalized() * th2);
-						}
-						else
-						{
-							const Float2 normal = Float2{ -line.y, line.x }.normalized();
-							buf2.push_back(current + normal * 0.001f);
-						}
+						dst.push_back(joint);
 					}
-				}
+				});
 
 				{
 					buf2.push_back(buffer.back());
 				}
 			}
 
-			const Vertex2D::IndexType newSize = static_cast<Vertex2D::IndexType>(buf2.size());
-			const Vertex2D::IndexType vertexSize = (newSize * 2), indexSize = (6 * (newSize - 1));
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
 			const float thicknessHalf = (thickness * 0.5f);
+			const size_t pairCount = buf2.size();
 
+			return detail::BuildLineStrip(bufferCreator, pairCount, false, offset, onBuilt, [&](const size_t i, Vertex2D* pDst)
 			{
-				const Float2 p0 = buf2[0];
-				const Float2 p1 = buf2[1];
-				const Float2 line = (p1 - p0).normalize();
-				const Float2 vNormalBegin{ -line.y * thicknessHalf, line.x * thicknessHalf };
-				const Float2 lineHalf(line * thicknessHalf);
-
-				pVertex[0].pos.set(p0 + vNormalBegin - lineHalf);
-				pVertex[1].pos.set(p0 - vNormalBegin - lineHalf);
-			}
-
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
-
-			{
-				const Float2 p0 = buf2[newSize - 2];
-				const Float2 p1 = buf2[newSize - 1];
-				const Float2 line = (p1 - p0).normalize();
-				const Float2 vNormalEnd{ -line.y * thicknessHalf, line.x * thicknessHalf };
-				const Float2 lineHalf(line * thicknessHalf);
-
-				pVertex[newSize * 2 - 2].pos.set(p1 + vNormalEnd + lineHalf);
-				pVertex[newSize * 2 - 1].pos.set(p1 - vNormalEnd + lineHalf);
-			}
-
-			if (offset)
-			{
-				const Float2 v = *offset;
-				Vertex2D* pDst = pVertex;
-
-				for (Vertex2D::IndexType i = 0; i < vertexSize; ++i)
+				if (i == 0)
 				{
-					(pDst++)->pos.moveBy(v);
+					detail::WriteBeginPair(pDst, buf2[0], buf2[1], thicknessHalf, thicknessHalf, color);
 				}
-			}
-
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
-
-			{
-				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize - 1);
-
-				for (Vertex2D::IndexType k = 0; k < count; ++k)
+				else if (i == (pairCount - 1))
 				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
-					{
-						*pIndex++ = (indexOffset + (detail::RectIndexTable[i] + k * 2) % vertexSize);
-					}
+					detail::WriteEndPair(pDst, buf2[i - 1], buf2[i], thicknessHalf, thicknessHalf, color);
 				}
-			}
-
-			return indexSize;
+				else
+				{
+					detail::WriteMiterPair(pDst, buf2[i - 1], buf2[i], buf2[i + 1], thicknessHalf, color);
+				}
+			});
 		}
 
-		Vertex2D::IndexType BuildUncappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float* startAngle0, float* startAngle1)
+		bool BuildUncappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float* startAngle0, float* startAngle1, const OnBuiltFunc& onBuilt)
 		{
 			const float th2 = (0.01f / scale);
 			const double th2D = th2;
@@ -1522,18 +1461,18 @@ namespace s3d
 			{
 				buffer.push_back(points[0]);
 
-				for (size_t i = 1; i < (size - 1); ++i)
+				detail::AppendInOrder(buffer, 1, (size - 1), [&](const size_t i, auto& dst)
 				{
 					const Vec2 back = points[i - 1];
 					const Vec2 current = points[i];
 
 					if (back.distanceFromSq(current) < th2D)
 					{
-						continue;
+						return;
 					}
 
-					buffer.push_back(current);
-				}
+					dst.push_back(current);
+				});
 
 				const Vec2 back = points[size - 2];
 				const Vec2 current = points[size - 1];
@@ -1545,176 +1484,99 @@ namespace s3d
 
 				if (buffer.size() < 2)
 				{
-					return 0;
+					return false;
 				}
 			}
 
-			const float threshold = 0.55f;
-
-			Array<Float2> buf2(Arg::reserve = buffer.size());
+			Array<Float2, ArenaAllocator<Float2>> buf2(Arg::reserve = buffer.size());
 			{
 				buf2.push_back(buffer.front());
 
 				const size_t count = (buffer.size() - 1);
 
-				for (size_t i = 1; i < count; ++i)
+				detail::AppendInOrder(buf2, 1, count, [&](const size_t i, auto& dst)
 				{
-					const Float2 back = buffer[i - 1];
 					const Float2 current = buffer[i];
-					const Float2 next = buffer[(i + 1) % buffer.size()];
-
-					const Float2 v1 = (back - current).normalized();
-					const Float2 v2 = (next - current).normalized();
 
-					buf2.push_back(current);
+					dst.push_back(current);
 
-					if ((not inner)
-						&& (v1.dot(v2) > threshold))
+					if (Float2 joint; (not inner)
+						&& detail::GetJointPoint(buffer[i - 1], current, buffer[(i + 1) % buffer.size()], th2, joint))
 					{
-						const Float2 line = (current - back);
-						const Float2 tangent = ((next - current).normalized() + (current - back).normalized()).normalized();
-						const Float2 line2 = (next - current);
-
-						if (tangent.dot(line2) >= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + tangent.normalized() * th2);
-						}
-						else if (tangent.dot(line2) <= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + (-tangent).normalized() * th2);
-						}
-						else
-						{
-							const Float2 normal = Float2{ -line.y, line.x }.normalized();
-							buf2.push_back(current + normal * 0.001f);
-						}
+						dst.push_back(joint);
 					}
-				}
+				});
 
 				{
 					buf2.push_back(buffer.back());
 				}
 			}
 
-			const Vertex2D::IndexType newSize = static_cast<Vertex2D::IndexType>(buf2.size());
-			const Vertex2D::IndexType vertexSize = (newSize * 2), indexSize = (6 * (newSize - 1));
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
 			const float thicknessHalf = (thickness * 0.5f);
+			const size_t pairCount = buf2.size();
 
+			const auto getStartAngle = [thicknessHalf](const Float2 p0, const Float2 p1)
 			{
-				const Float2 p0 = buf2[0];
-				const Float2 p1 = buf2[1];
 				const Float2 line = (p1 - p0).normalize();
-				const Float2 vNormalBegin{ -line.y * thicknessHalf, line.x * thicknessHalf };
+				const Float2 vNormal{ -line.y * thicknessHalf, line.x * thicknessHalf };
+				return std::atan2(vNormal.x, -vNormal.y);
+			};
 
-				if (startAngle0)
-				{
-					*startAngle0 = std::atan2(vNormalBegin.x, -vNormalBegin.y);
-				}
-
-				pVertex[0].pos.set(p0 + vNormalBegin);
-				pVertex[1].pos.set(p0 - vNormalBegin);
+			if (startAngle0)
+			{
+				*startAngle0 = getStartAngle(buf2[0], buf2[1]);
 			}
 
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
+			if (startAngle1)
 			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
+				*startAngle1 = getStartAngle(buf2[pairCount - 2], buf2[pairCount - 1]);
 			}
 
+			return detail::BuildLineStrip(bufferCreator, pairCount, false, offset, onBuilt, [&](const size_t i, Vertex2D* pDst)
 			{
-				const Float2 p0 = buf2[newSize - 2];
-				const Float2 p1 = buf2[newSize - 1];
-				const Float2 line = (p1 - p0).normalize();
-				const Float2 vNormalEnd{ -line.y * thicknessHalf, line.x * thicknessHalf };
-
-				if (startAngle1)
+				if (i == 0)
 				{
-					*startAngle1 = std::atan2(vNormalEnd.x, -vNormalEnd.y);
+					detail::WriteBeginPair(pDst, buf2[0], buf2[1], thicknessHalf, 0.0f, color);
 				}
-
-				pVertex[newSize * 2 - 2].pos.set(p1 + vNormalEnd);
-				pVertex[newSize * 2 - 1].pos.set(p1 - vNormalEnd);
-			}
-
-			if (offset)
-			{
-				const Float2 v = *offset;
-				Vertex2D* pDst = pVertex;
-
-				for (Vertex2D::IndexType i = 0; i < vertexSize; ++i)
+				else if (i == (pairCount - 1))
 				{
-					(pDst++)->pos.moveBy(v);
+					detail::WriteEndPair(pDst, buf2[i - 1], buf2[i], thicknessHalf, 0.0f, color);
 				}
-			}
-
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
-
-			{
-				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize - 1);
-
-				for (Vertex2D::IndexType k = 0; k < count; ++k)
+				else
 				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
-					{
-						*pIndex++ = (indexOffset + (detail::RectIndexTable[i] + k * 2) % vertexSize);
-					}
+					detail::WriteMiterPair(pDst, buf2[i - 1], buf2[i], buf2[i + 1], thicknessHalf, color);
 				}
-			}
-
-			return indexSize;
+			});
 		}
 
-		Vertex2D::IndexType BuildDefaultLineString(const BufferCreatorFunc& bufferCreator, const Vec2* points, const ColorF* colors, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing, const float scale)
+		bool BuildDefaultLineString(const BufferCreatorFunc& bufferCreator, const Vec2* points, const ColorF* colors, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing, const float scale, const OnBuiltFunc& onBuilt)
 		{
 			if ((size < 2)
-				|| (32760 <= size)
 				|| (thickness <= 0.0f)
 				|| (not points))
 			{
-				return 0;
+				return false;
 			}
 
 			const float th2 = (0.01f / scale);
 			const double th2D = th2;
 
-			Array<std::pair<Float2, Float4>> buf(Arg::reserve = size);
+			Array<std::pair<Float2, Float4>, ArenaAllocator<std::pair<Float2, Float4>>> buf(Arg::reserve = size);
 			{
 				buf.emplace_back(points[0], colors[0].toFloat4());
 
-				for (size_t i = 1; i < (size - 1); ++i)
+				detail::AppendInOrder(buf, 1, (size - 1), [&](const size_t i, auto& dst)
 				{
 					const Vec2 back = points[i - 1];
 					const Vec2 current = points[i];
 
 					if (back.distanceFromSq(current) < th2D)
 					{
-						continue;
+						return;
 					}
 
-					buf.emplace_back(current, colors[i].toFloat4());
-				}
+					dst.emplace_back(current, colors[i].toFloat4());
+				});
 
 				const Vec2 back = points[size - 2];
 				const Vec2 current = points[size - 1];
@@ -1733,52 +1595,31 @@ namespace s3d
 
 				if (buf.size() < 2)
 				{
-					return 0;
+					return false;
 				}
 			}
 
 			const float threshold = 0.55f;
 
-			Array<std::pair<Float2, Float4>> buf2(Arg::reserve = buf.size());
+			Array<std::pair<Float2, Float4>, ArenaAllocator<std::pair<Float2, Float4>>> buf2(Arg::reserve = buf.size());
 			{
 				buf2.push_back(buf.front());
 
 				const size_t count = (buf.size() - 1 + static_cast<bool>(closeRing));
 
-				for (size_t i = 1; i < count; ++i)
+				detail::AppendInOrder(buf2, 1, count, [&](const size_t i, auto& dst)
 				{
-					const Float2 back = buf[i - 1].first;
 					const Float2 current = buf[i].first;
-					const Float2 next = buf[(i + 1) % buf.size()].first;
 					const Float4 currentColor = buf[i].second;
 
-					const Float2 v1 = (back - current).normalized();
-					const Float2 v2 = (next - current).normalized();
-
-					buf2.emplace_back(current, currentColor);
+					dst.emplace_back(current, currentColor);
 
-					if ((not inner)
-						&& (v1.dot(v2) > threshold))
+					if (Float2 joint; (not inner)
+						&& detail::GetJointPoint(buf[i - 1].first, current, buf[(i + 1) % buf.size()].first, th2, joint))
 					{
-						const Float2 line = (current - back);
-						const Float2 tangent = ((next - current).normalized() + (current - back).normalized()).normalized();
-						const Float2 line2 = (next - current);
-
-						if (tangent.dot(line2) >= (-tangent).dot(line2))
-						{
-							buf2.emplace_back(current + tangent.normalized() * th2, currentColor);
-						}
-						else if (tangent.dot(line2) <= (-tangent).dot(line2))
-						{
-							buf2.emplace_back(current + (-tangent).normalized() * th2, currentColor);
-						}
-						else
-						{
-							const Float2 normal = Float2{ -line.y, line.x }.normalized();
-							buf2.emplace_back(current + normal * 0.001f, currentColor);
-						}
+						dst.emplace_back(joint, currentColor);
 					}
-				}
+				});
 
 				if (closeRing)
 				{
@@ -1818,123 +1659,32 @@ namespace s3d
 				}
 			}
 
-			const Vertex2D::IndexType newSize = static_cast<Vertex2D::IndexType>(buf2.size());
-			const Vertex2D::IndexType vertexSize = (newSize * 2), indexSize = (6 * (newSize - 1) + (static_cast<bool>(closeRing) * 6));
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
 			const float thicknessHalf = (thickness * 0.5f);
-			const bool hasCap = (not closeRing);
+			const size_t pairCount = buf2.size();
 
 			if (closeRing)
 			{
-				const Float2 p0 = buf2.back().first;
-				const Float2 p1 = buf2[0].first;
-				const Float2 p2 = buf2[1].first;
-				const Float4 c = buf2[0].second;
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[0].set(result0, c);
-				pVertex[1].set(result1, c);
-			}
-			else
-			{
-				const Float2 p0 = buf2[0].first;
-				const Float2 p1 = buf2[1].first;
-				const Float4 c = buf2[0].second;
-				const Float2 line = (p1 - p0).normalize();
-				const Float2 vNormalBegin{ -line.y * thicknessHalf, line.x * thicknessHalf };
-				const Float2 lineHalf(line * thicknessHalf);
-
-				pVertex[0].set(p0 + vNormalBegin - lineHalf * hasCap, c);
-				pVertex[1].set(p0 - vNormalBegin - lineHalf * hasCap, c);
-			}
-
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i].first;
-				const Float2 p1 = buf2[i + 1].first;
-				const Float2 p2 = buf2[i + 2].first;
-				const Float4 c = buf2[i + 1].second;
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].set(result0, c);
-				pVertex[i * 2 + 3].set(result1, c);
-			}
-
-			if (closeRing)
-			{
-				const Float2 p0 = buf2[newSize - 2].first;
-				const Float2 p1 = buf2[newSize - 1].first;
-				const Float2 p2 = buf2[0].first;
-				const Float4 c = buf2[newSize - 1].second;
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[newSize * 2 - 2].set(result0, c);
-				pVertex[newSize * 2 - 1].set(result1, c);
-			}
-			else
-			{
-				const Float2 p0 = buf2[newSize - 2].first;
-				const Float2 p1 = buf2[newSize - 1].first;
-				const Float4 c = buf2[newSize - 1].second;
-				const Float2 line = (p1 - p0).normalize();
-				const Float2 vNormalEnd{ -line.y * thicknessHalf, line.x * thicknessHalf };
-				const Float2 lineHalf(line * thicknessHalf);
-
-				pVertex[newSize * 2 - 2].set(p1 + vNormalEnd + lineHalf * hasCap, c);
-				pVertex[newSize * 2 - 1].set(p1 - vNormalEnd + lineHalf * hasCap, c);
+				return detail::BuildLineStrip(bufferCreator, pairCount, true, offset, onBuilt, [&](const size_t i, Vertex2D* pDst)
+				{
+					detail::WriteMiterPair(pDst, buf2[(i + pairCount - 1) % pairCount].first, buf2[i].first, buf2[(i + 1) % pairCount].first, thicknessHalf, buf2[i].second);
+				});
 			}
 
-			if (offset)
+			return detail::BuildLineStrip(bufferCreator, pairCount, false, offset, onBuilt, [&](const size_t i, Vertex2D* pDst)
 			{
-				const Float2 v = *offset;
-				Vertex2D* pDst = pVertex;
-
-				for (Vertex2D::IndexType i = 0; i < vertexSize; ++i)
+				if (i == 0)
 				{
-					(pDst++)->pos.moveBy(v);
+					detail::WriteBeginPair(pDst, buf2[0].first, buf2[1].first, thicknessHalf, thicknessHalf, buf2[0].second);
 				}
-			}
-
-			{
-				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize - 1 + static_cast<bool>(closeRing));
-
-				for (Vertex2D::IndexType k = 0; k < count; ++k)
+				else if (i == (pairCount - 1))
 				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
-					{
-						*pIndex++ = (indexOffset + (detail::RectIndexTable[i] + k * 2) % vertexSize);
-					}
+					detail::WriteEndPair(pDst, buf2[i - 1].first, buf2[i].first, thicknessHalf, thicknessHalf, buf2[i].second);
 				}
-			}
-
-			return indexSize;
+				else
+				{
+					detail::WriteMiterPair(pDst, buf2[i - 1].first, buf2[i].first, buf2[i + 1].first, thicknessHalf, buf2[i].second);
+				}
+			});
 		}
 
 		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const Optional<Float2>& offset, const Float4& color)
@@ -2072,14 +1822,13 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, const size_t size, const float thickness, const Float4& color, const float scale)
+		bool BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, const size_t size, const float thickness, const Float4& color, const float scale, const OnBuiltFunc& onBuilt)
 		{
 			if ((size < 3)
-				|| (32760 <= size)
 				|| (thickness <= 0.0f)
 				|| (not points))
 			{
-				return 0;
+				return false;
 			}
 
 			const float th2 = (0.01f / scale);
@@ -2089,18 +1838,18 @@ namespace s3d
 			{
 				buffer.push_back(points[0]);
 
-				for (size_t i = 1; i < (size - 1); ++i)
+				detail::AppendInOrder(buffer, 1, (size - 1), [&](const size_t i, auto& dst)
 				{
 					const Vec2 back = points[i - 1];
 					const Vec2 current = points[i];
 
 					if (back.distanceFromSq(current) < th2D)
 					{
-						continue;
+						return;
 					}
 
-					buffer.push_back(current);
-				}
+					dst.push_back(current);
+				});
 
 				const Vec2 back = points[size - 2];
 				const Vec2 current = points[size - 1];
@@ -2118,50 +1867,29 @@ namespace s3d
 
 				if (buffer.size() < 2)
 				{
-					return 0;
+					return false;
 				}
 			}
 
 			const float threshold = 0.55f;
 
-			Array<Float2> buf2(Arg::reserve = buffer.size());
+			Array<Float2, ArenaAllocator<Float2>> buf2(Arg::reserve = buffer.size());
 			{
 				buf2.push_back(buffer.front());
 
 				const size_t count = buffer.size();
 
-				for (size_t i = 1; i < count; ++i)
+				detail::AppendInOrder(buf2, 1, count, [&](const size_t i, auto& dst)
 				{
-					const Float2 back = buffer[i - 1];
 					const Float2 current = buffer[i];
-					const Float2 next = buffer[(i + 1) % count];
 
-					const Float2 v1 = (back - current).normalized();
-					const Float2 v2 = (next - current).normalized();
-
-					buf2.push_back(current);
+					dst.push_back(current);
 
-					if (v1.dot(v2) > threshold)
+					if (Float2 joint; detail::GetJointPoint(buffer[i - 1], current, buffer[(i + 1) % count], th2, joint))
 					{
-						const Float2 line = (current - back);
-						const Float2 tangent = ((next - current).normalized() + (current - back).normalized()).normalized();
-						const Float2 line2 = (next - current);
-
-						if (tangent.dot(line2) >= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + tangent.normalized() * th2);
-						}
-						else if (tangent.dot(line2) <= (-tangent).dot(line2))
-						{
-							buf2.push_back(current + (-tangent).normalized() * th2);
-						}
-						else
-						{
-							const Float2 normal = Float2{ -line.y, line.x }.normalized();
-							buf2.push_back(current + normal * 0.001f);
-						}
+						dst.push_back(joint);
 					}
-				}
+				});
 
 				{
 					const Float2 back = buffer[buffer.size() - 1];
@@ -2194,133 +1922,13 @@ namespace s3d
 				}
 			}
 
-			const Vertex2D::IndexType newSize = static_cast<Vertex2D::IndexType>(buf2.size());
-			const Vertex2D::IndexType vertexSize = (newSize * 2), indexSize = (6 * (newSize - 1) + 6);
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
 			const float thicknessHalf = (thickness * 0.5f);
+			const size_t pairCount = buf2.size();
 
+			return detail::BuildLineStrip(bufferCreator, pairCount, true, none, onBuilt, [&](const size_t i, Vertex2D* pDst)
 			{
-				const Float2 p0 = buf2.back();
-				const Float2 p1 = buf2[0];
-				const Float2 p2 = buf2[1];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[0].pos.set(result0);
-				pVertex[1].pos.set(result1);
-			}
-
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
-
-			{
-				const Float2 p0 = buf2[newSize - 2];
-				const Float2 p1 = buf2[newSize - 1];
-				const Float2 p2 = buf2[0];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[newSize * 2 - 2].pos.set(result0);
-				pVertex[newSize * 2 - 1].pos.set(result1);
-			}
-
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
-
-			{
-				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize);
-
-				for (Vertex2D::IndexType k = 0; k < count; ++k)
-				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
-					{
-						*pIndex++ = (indexOffset + (detail::RectIndexTable[i] + k * 2) % vertexSize);
-					}
-				}
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, color);
-			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, color);
-			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, color);
-			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, colors[0]);
-			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, colors[1]);
-			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, colors[3]);
-			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, colors[2]);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
+				detail::WriteMiterPair(pDst, buf2[(i + pairCount - 1) % pairCount], buf2[i], buf2[(i + 1) % pairCount], thicknessHalf, color);
+			});
 		}
 
 		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
@@ -2381,29 +1989,6 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(quad.p[0], uv.left, uv.top, color);
-			pVertex[1].set(quad.p[1], uv.right, uv.top, color);
-			pVertex[2].set(quad.p[3], uv.left, uv.bottom, color);
-			pVertex[3].set(quad.p[2], uv.right, uv.bottom, color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
 		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, const float w, const float h, const float r, const FloatRect& uvRect, const Float4& color, const float scale)
 		{
 			const float rr = Min({ w * 0.5f, h * 0.5f, Max(0.0f, r) });
@@ -2590,4 +2175,28 @@ namespace s3d
 			return indexSize;
 		}
 	}
+
+	namespace Internal
+	{
+		Array<Vertex2DBatch> BuildLineStringVertices(const LineStyle& style, const Array<Vec2>& points, const Optional<Float2>& offset, const double thickness, const bool inner, const ColorF& color, const CloseRing closeRing)
+		{
+			Array<Vertex2DBatch> batches;
+			Array<Float2> buffer;
+
+			const auto bufferCreator = [&](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+			{
+				Vertex2DBatch& batch = batches.emplace_back();
+				batch.vertices.resize(vertexSize);
+				batch.indices.resize(indexSize);
+				return Vertex2DBufferPointer{ batch.vertices.data(), batch.indices.data(), 0 };
+			};
+
+			Vertex2DBuilder::BuildLineString(bufferCreator, buffer, style, points.data(), points.size(), offset, static_cast<float>(thickness), inner, color.toFloat4(), closeRing, 1.0f, [&](const Vertex2D::IndexType indexCount)
+			{
+				batches.back().drawnIndexCount += indexCount;
+			});
+
+			return batches;
+		}
+	}
 }
@@ -26,7 +26,44 @@
 
 namespace s3d
 {
-	using BufferCreatorFunc = std::function<Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType)>;
+	/// @brief 関数オブジェクトへの参照
+	/// @remark 関数オブジェクトを所有せず、メモリアロケーションを行いません。参照先の関数オブジェクトは呼び出しの間、有効である必要があります。
+	template <class Signature>
+	class Vertex2DFunctionRef;
+
+	template <class Result, class... Args>
+	class Vertex2DFunctionRef<Result(Args...)>
+	{
+	public:
+
+		template <class Fty, std::enable_if_t<not std::is_same_v<std::decay_t<Fty>, Vertex2DFunctionRef>>* = nullptr>
+		Vertex2DFunctionRef(Fty&& f) noexcept
+			: m_object{ const_cast<void*>(static_cast<const void*>(std::addressof(f))) }
+			, m_function{ &Invoke<std::remove_reference_t<Fty>> } {}
+
+		Result operator ()(Args... args) const
+		{
+			return m_function(m_object, args...);
+		}
+
+	private:
+
+		void* m_object = nullptr;
+
+		Result(*m_function)(void*, Args...) = nullptr;
+
+		template <class Fty>
+		static Result Invoke(void* object, Args... args)
+		{
+			return (*static_cast<Fty*>(object))(args...);
+		}
+	};
+
+	/// @brief 頂点バッファとインデックスバッファを確保する関数への参照
+	using BufferCreatorFunc = Vertex2DFunctionRef<Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType)>;
+
+	/// @brief 作成したインデックスの個数を受け取り、描画コマンドを追加する関数への参照
+	using OnBuiltFunc = Vertex2DFunctionRef<void(Vertex2D::IndexType)>;
 
 	namespace Vertex2DBuilder
 	{
@@ -48,23 +85,54 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRoundDotLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4& color);
+		Vertex2D::IndexType BuildTriangle(BufferCreator&& bufferCreator, const Float2(&points)[3], const Float4& color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3]);
+		Vertex2D::IndexType BuildTriangle(BufferCreator&& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3]);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4& color);
+		Vertex2D::IndexType BuildRect(BufferCreator&& bufferCreator, const FloatRect& rect, const Float4& color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildRect(BufferCreator&& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
+
+		/// @brief 1 回のバッファ要求に収まる数の長方形の頂点をまとめて作成します。
+		/// @param colors 色の配列。singleColor が true の場合は colors[0] をすべての長方形に使います。
+		/// @param numBuilt 作成した長方形の個数の格納先
+		/// @return 作成したインデックスの個数
+		[[nodiscard]]
+		Vertex2D::IndexType BuildRectBatch(const BufferCreatorFunc& bufferCreator, const RectF* rects, const ColorF* colors, size_t count, bool singleColor, size_t& numBuilt);
+
+		/// @brief 複数の長方形の頂点を、1 回のバッファ要求に収まる数ずつまとめて作成します。
+		/// @param colors 色の配列。singleColor が true の場合は colors[0] をすべての長方形に使います。
+		/// @param onBuilt バッファ要求ごとに、作成したインデックスの個数を渡して呼ばれる関数。描画コマンドを追加します。
+		template <class OnBuilt>
+		void BuildRects(const BufferCreatorFunc& bufferCreator, const RectF* rects, const ColorF* colors, size_t count, bool singleColor, OnBuilt&& onBuilt);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRectFrame(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor);
 
+		template <class BufferCreator>
+		[[nodiscard]]
+		Vertex2D::IndexType BuildCircle(BufferCreator&& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, float scale);
+
+		/// @brief 1 回のバッファ要求に収まる数の円の頂点をまとめて作成します。
+		/// @param colors 色の配列。singleColor が true の場合は colors[0] をすべての円に使います。
+		/// @param numBuilt 作成した円の個数の格納先
+		/// @return 作成したインデックスの個数
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCircle(const BufferCreatorFunc& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildCircleBatch(const BufferCreatorFunc& bufferCreator, const Circle* circles, const ColorF* colors, size_t count, bool singleColor, float scale, size_t& numBuilt);
+
+		/// @brief 複数の円の頂点を、1 回のバッファ要求に収まる数ずつまとめて作成します。
+		/// @param colors 色の配列。singleColor が true の場合は colors[0] をすべての円に使います。
+		/// @param onBuilt バッファ要求ごとに、作成したインデックスの個数を渡して呼ばれる関数。描画コマンドを追加します。
+		template <class OnBuilt>
+		void BuildCircles(const BufferCreatorFunc& bufferCreator, const Circle* circles, const ColorF* colors, size_t count, bool singleColor, float scale, OnBuilt&& onBuilt);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildCircleFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
@@ -84,11 +152,13 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildEllipseFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4 color);
+		Vertex2D::IndexType BuildQuad(BufferCreator&& bufferCreator, const FloatQuad& quad, const Float4 color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildQuad(BufferCreator&& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
@@ -96,20 +166,19 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRoundRectFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const RoundRect& inner, const RoundRect& outer, const Float4& color, float scale);
 
-		[[nodiscard]]
-		Vertex2D::IndexType BuildLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, CloseRing closeRing, float scale);
+		/// @brief 線の頂点を作成します。
+		/// @param onBuilt バッファ要求ごとに、作成したインデックスの個数を渡して呼ばれる関数。描画コマンドを追加します。
+		/// @return 頂点を作成した場合 true, それ以外の場合は false
+		/// @remark 1 回のバッファ要求に収まらない長さの線は、複数回のバッファ要求に分けて作成します。
+		bool BuildLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, CloseRing closeRing, float scale, const OnBuiltFunc& onBuilt);
 
-		[[nodiscard]]
-		Vertex2D::IndexType BuildClosedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale);
+		bool BuildClosedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, const OnBuiltFunc& onBuilt);
 
-		[[nodiscard]]
-		Vertex2D::IndexType BuildCappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale);
+		bool BuildCappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, const OnBuiltFunc& onBuilt);
 
-		[[nodiscard]]
-		Vertex2D::IndexType BuildUncappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float* startAngle0, float* startAngle1);
+		bool BuildUncappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float* startAngle0, float* startAngle1, const OnBuiltFunc& onBuilt);
 
-		[[nodiscard]]
-		Vertex2D::IndexType BuildDefaultLineString(const BufferCreatorFunc& bufferCreator, const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, float thickness, bool inner, CloseRing closeRing, float scale);
+		bool BuildDefaultLineString(const BufferCreatorFunc& bufferCreator, const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, float thickness, bool inner, CloseRing closeRing, float scale, const OnBuiltFunc& onBuilt);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const Optional<Float2>& offset, const Float4& color);
@@ -120,20 +189,22 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildPolygonTransformed(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, float s, float c, const Float2& offset, const Float4& color);
 
-		[[nodiscard]]
-		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, size_t size, float thickness, const Float4& color, float scale);
+		bool BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, size_t size, float thickness, const Float4& color, float scale, const OnBuiltFunc& onBuilt);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
+		Vertex2D::IndexType BuildTextureRegion(BufferCreator&& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildTextureRegion(BufferCreator&& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
+		Vertex2D::IndexType BuildTexturedQuad(BufferCreator&& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const FloatRect& uvRect, const Float4& color, float scale);
@@ -146,3 +217,5 @@ namespace s3d
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
 	}
 }
+
+# include "Vertex2DBuilder.ipp"
@@ -0,0 +1,352 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/FastMath.hpp>
+# include <Siv3D/MathConstants.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline constexpr Vertex2D::IndexType RectIndexTable[6] = { 0, 1, 2, 2, 1, 3 };
+
+		inline constexpr Vertex2D::IndexType MaxSinCosTableQuality = 40;
+
+		[[nodiscard]]
+		const Float2* GetSinCosTableStartPtr(uint16 quality) noexcept;
+
+		[[nodiscard]]
+		inline constexpr Vertex2D::IndexType CalculateCircleQuality(const float size) noexcept
+		{
+			if (size <= 5.0f)
+			{
+				return static_cast<Vertex2D::IndexType>(size + 3) * 2;
+			}
+			else
+			{
+				return static_cast<Vertex2D::IndexType>(Min(18 + (size - 5.0f) / 2.2f, 255.0f));
+			}
+		}
+
+		/// @brief 円の頂点とインデックスを、確保済みのバッファに書き込みます。
+		inline void WriteCircle(Vertex2D* pVertex, Vertex2D::IndexType* pIndex, const Vertex2D::IndexType indexOffset, const Float2& center, const float r, const Vertex2D::IndexType quality, const Float4& innerColor, const Float4& outerColor) noexcept
+		{
+			const float centerX = center.x;
+			const float centerY = center.y;
+			pVertex[0].set(centerX, centerY, innerColor);
+
+			if (quality <= MaxSinCosTableQuality)
+			{
+				const Float2* pCS = GetSinCosTableStartPtr(quality);
+
+				for (Vertex2D::IndexType i = 1; i <= quality; ++i)
+				{
+					pVertex[i].set(r * pCS->x + centerX, r * pCS->y + centerY, outerColor);
+					++pCS;
+				}
+			}
+			else
+			{
+				const float radDelta = Math::TwoPiF / quality;
+
+				for (Vertex2D::IndexType i = 0; i < quality; ++i)
+				{
+					const float rad = (radDelta * i);
+					const auto [s, c] = FastMath::SinCos(rad);
+					pVertex[i + 1].set(centerX + r * c, centerY - r * s, outerColor);
+				}
+			}
+
+			for (Vertex2D::IndexType i = 0; i < (quality - 1); ++i)
+			{
+				*pIndex++ = indexOffset + (i + 1);
+				*pIndex++ = indexOffset;
+				*pIndex++ = indexOffset + (i + 2);
+			}
+
+			*pIndex++ = (indexOffset + quality);
+			*pIndex++ = indexOffset;
+			*pIndex++ = (indexOffset + 1);
+		}
+	}
+
+	namespace Vertex2DBuilder
+	{
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildTriangle(BufferCreator&& bufferCreator, const Float2(&points)[3], const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(points[0], color);
+			pVertex[1].set(points[1], color);
+			pVertex[2].set(points[2], color);
+
+			pIndex[0] = indexOffset;
+			pIndex[1] = (indexOffset + 1);
+			pIndex[2] = (indexOffset + 2);
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildTriangle(BufferCreator&& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(points[0], colors[0]);
+			pVertex[1].set(points[1], colors[1]);
+			pVertex[2].set(points[2], colors[2]);
+
+			pIndex[0] = indexOffset;
+			pIndex[1] = (indexOffset + 1);
+			pIndex[2] = (indexOffset + 2);
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildRect(BufferCreator&& bufferCreator, const FloatRect& rect, const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, color);
+			pVertex[1].set(rect.right, rect.top, color);
+			pVertex[2].set(rect.left, rect.bottom, color);
+			pVertex[3].set(rect.right, rect.bottom, color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildRect(BufferCreator&& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, colors[0]);
+			pVertex[1].set(rect.right, rect.top, colors[1]);
+			pVertex[2].set(rect.left, rect.bottom, colors[3]);
+			pVertex[3].set(rect.right, rect.bottom, colors[2]);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildCircle(BufferCreator&& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, const float scale)
+		{
+			const float absR = Abs(r);
+			const Vertex2D::IndexType quality = detail::CalculateCircleQuality(absR * scale);
+			const Vertex2D::IndexType vertexSize = (quality + 1), indexSize = (quality * 3);
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			detail::WriteCircle(pVertex, pIndex, indexOffset, center, r, quality, innerColor, outerColor);
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildQuad(BufferCreator&& bufferCreator, const FloatQuad& quad, const Float4 color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(quad.p[0], color);
+			pVertex[1].set(quad.p[1], color);
+			pVertex[2].set(quad.p[3], color);
+			pVertex[3].set(quad.p[2], color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildQuad(BufferCreator&& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(quad.p[0], colors[0]);
+			pVertex[1].set(quad.p[1], colors[1]);
+			pVertex[2].set(quad.p[3], colors[3]);
+			pVertex[3].set(quad.p[2], colors[2]);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildTextureRegion(BufferCreator&& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, color);
+			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, color);
+			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, color);
+			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildTextureRegion(BufferCreator&& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, colors[0]);
+			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, colors[1]);
+			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, colors[3]);
+			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, colors[2]);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		inline Vertex2D::IndexType BuildTexturedQuad(BufferCreator&& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(quad.p[0], uv.left, uv.top, color);
+			pVertex[1].set(quad.p[1], uv.right, uv.top, color);
+			pVertex[2].set(quad.p[3], uv.left, uv.bottom, color);
+			pVertex[3].set(quad.p[2], uv.right, uv.bottom, color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class OnBuilt>
+		inline void BuildRects(const BufferCreatorFunc& bufferCreator, const RectF* rects, const ColorF* colors, const size_t count, const bool singleColor, OnBuilt&& onBuilt)
+		{
+			for (size_t i = 0; i < count;)
+			{
+				size_t numBuilt = 0;
+				const Vertex2D::IndexType indexCount = BuildRectBatch(bufferCreator, (rects + i), (singleColor ? colors : (colors + i)), (count - i), singleColor, numBuilt);
+
+				if (not indexCount)
+				{
+					break;
+				}
+
+				onBuilt(indexCount);
+
+				i += numBuilt;
+			}
+		}
+
+		template <class OnBuilt>
+		inline void BuildCircles(const BufferCreatorFunc& bufferCreator, const Circle* circles, const ColorF* colors, const size_t count, const bool singleColor, const float scale, OnBuilt&& onBuilt)
+		{
+			for (size_t i = 0; i < count;)
+			{
+				size_t numBuilt = 0;
+				const Vertex2D::IndexType indexCount = BuildCircleBatch(bufferCreator, (circles + i), (singleColor ? colors : (colors + i)), (count - i), singleColor, scale, numBuilt);
+
+				if (not indexCount)
+				{
+					break;
+				}
+
+				onBuilt(indexCount);
+
+				i += numBuilt;
+			}
+		}
+	}
+}
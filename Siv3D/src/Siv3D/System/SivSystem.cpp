@@ -10,9 +10,11 @@
 //-----------------------------------------------
 
 # include <Siv3D/System.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 # include <Siv3D/System/ISystem.hpp>
 # include <Siv3D/Renderer/IRenderer.hpp>
 # include <Siv3D/UserAction/IUserAction.hpp>
+# include <Siv3D/ArenaAllocator/FrameArena.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
@@ -21,7 +23,14 @@ namespace s3d
 	{
 		bool Update()
 		{
-			return SIV3D_ENGINE(System)->update();
+			SIV3D_TRACE_ZONE(U"System::Update");
+
+			const bool result = SIV3D_ENGINE(System)->update();
+
+			// プロファイラがこのフレームの使用量を記録した後に、アリーナを次のフレームのために空にする
+			detail::ResetFrameArena();
+
+			return result;
 		}
 
 		void Exit() noexcept
@@ -32,7 +32,7 @@ namespace s3d
 
 			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
 
-			m_io_service_thread = Async([this] { m_io_service->run(); });
+			m_io_service_thread = std::async(std::launch::async, [this] { m_io_service->run(); });
 		}
 
 		if (m_isConnected)
@@ -182,6 +182,16 @@ namespace s3d
 		return m_session->available();
 	}
 
+	TCPReceiveView TCPClient::TCPClientDetail::peek()
+	{
+		if (!m_session)
+		{
+			return{};
+		}
+
+		return m_session->peek();
+	}
+
 	bool TCPClient::TCPClientDetail::skip(const size_t size)
 	{
 		if (!m_session)
@@ -221,4 +231,24 @@ namespace s3d
 
 		return m_session->send(data, size);
 	}
+
+	size_t TCPClient::TCPClientDetail::receiveMessages(Array<Blob>& messages)
+	{
+		if (!m_session)
+		{
+			return 0;
+		}
+
+		return m_session->receiveMessages(messages);
+	}
+
+	bool TCPClient::TCPClientDetail::sendMessages(const Blob* messages, const size_t count)
+	{
+		if (!m_session)
+		{
+			return false;
+		}
+
+		return m_session->sendMessages(messages, count);
+	}
 }
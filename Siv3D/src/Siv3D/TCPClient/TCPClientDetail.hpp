@@ -15,6 +15,7 @@
 # include <Siv3D/Byte.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Network/TCPSessionBuffer.hpp>
 
 # define _WINSOCK_DEPRECATED_NO_WARNINGS
 # ifndef _WIN32_WINNT
@@ -45,24 +46,21 @@ namespace s3d
 			// 受信	
 			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
 
-			std::mutex m_mutexReceivedBuffer;
+			TCPReceiveBuffer m_receivedBuffer{ maxBufferSize };
 
-			Array<Byte> m_receivedBuffer;
+			// 受信バッファの読み込み側は 1 つのスレッドからしか使えないため、ユーザのスレッドどうしを排他する
+			std::mutex m_readMutex;
 
 
 			// 送信
-			std::mutex m_mutexSendingBuffer;
-
-			Array<Array<Byte>> m_sendingBuffer;
-
-			bool m_isSending = false;
+			TCPSendBuffer m_sendingBuffer;
 
 
 			void send_internal()
 			{
-				m_isSending = true;
+				const Array<Byte>& sending = m_sendingBuffer.sending();
 
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
+				asio::async_write(m_socket, asio::buffer(sending.data(), sending.size()),
 					std::bind(&ClientSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
@@ -100,24 +98,15 @@ namespace s3d
 
 				m_socket.close();
 
-				if (!m_isSending)
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
-				}
+				m_sendingBuffer.clear();
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
-					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
-				}
+				m_streamBuffer.consume(m_streamBuffer.size());
 
 				if (m_isActive)
 				{
 					LOG_TRACE(U"Session closed");
 				}
 
-				m_isSending = false;
 				m_isActive = false;
 			}
 
@@ -133,7 +122,10 @@ namespace s3d
 
 			size_t available()
 			{
-				std::lock_guard lock{ m_mutexReceivedBuffer };
+				if (!m_isActive)
+				{
+					return 0;
+				}
 
 				return m_receivedBuffer.size();
 			}
@@ -171,23 +163,17 @@ namespace s3d
 				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
 				const size_t size = m_streamBuffer.size();
 
+				if (not m_receivedBuffer.write(data, size))
 				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+					LOG_FAIL(U"TCPClient: onReceive exceeded the maximum buffer size");
 
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPClient: onReceive exceeded the maximum buffer size");
+					m_error = TCPError::NoBufferSpaceAvailable;
 
-						m_error = TCPError::NoBufferSpaceAvailable;
-
-						m_streamBuffer.consume(m_streamBuffer.size());
-
-						close();
+					m_streamBuffer.consume(m_streamBuffer.size());
 
-						return;
-					}
+					close();
 
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
+					return;
 				}
 
 				m_streamBuffer.consume(m_streamBuffer.size());
@@ -197,12 +183,9 @@ namespace s3d
 
 			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ClientSession>&)
 			{
-				m_isSending = false;
-
 				if (!m_isActive)
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
+					m_sendingBuffer.cancel();
 					return;
 				}
 
@@ -212,24 +195,29 @@ namespace s3d
 
 					m_error = TCPError::Error;
 
+					m_sendingBuffer.cancel();
+
 					close();
 
 					return;
 				}
 
+				if (m_sendingBuffer.onSent())
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
+					send_internal();
+				}
+			}
 
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
+			TCPReceiveView peek()
+			{
+				if (!m_isActive)
+				{
+					return{};
 				}
+
+				std::lock_guard lock{ m_readMutex };
+
+				return m_receivedBuffer.peek();
 			}
 
 			bool skip(const size_t size)
@@ -244,18 +232,9 @@ namespace s3d
 					return true;
 				}
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+				std::lock_guard lock{ m_readMutex };
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
-
-					m_receivedBuffer.pop_front_N(size);
-				}
-
-				return true;
+				return m_receivedBuffer.skip(size);
 			}
 
 			bool lookahead(void* dst, const size_t size)
@@ -270,21 +249,29 @@ namespace s3d
 					return true;
 				}
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+				std::lock_guard lock{ m_readMutex };
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				return m_receivedBuffer.lookahead(dst, size);
+			}
+
+			bool read(void* dst, const size_t size)
+			{
+				if (!m_isActive)
+				{
+					return false;
+				}
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+				if (size == 0)
+				{
+					return true;
 				}
 
-				return true;
+				std::lock_guard lock{ m_readMutex };
+
+				return m_receivedBuffer.read(dst, size);
 			}
 
-			bool read(void* dst, const size_t size)
+			bool send(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
@@ -296,43 +283,60 @@ namespace s3d
 					return true;
 				}
 
+				if (m_sendingBuffer.push(data, size))
 				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+					send_internal();
+				}
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				return true;
+			}
+
+			size_t receiveMessages(Array<Blob>& messages)
+			{
+				if (!m_isActive)
+				{
+					return 0;
+				}
+
+				const size_t oldSize = messages.size();
+
+				std::lock_guard lock{ m_readMutex };
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+				if (not m_receivedBuffer.readMessages(messages))
+				{
+					LOG_FAIL(U"TCPClient: received a message header that exceeds the maximum message size");
+
+					m_error = TCPError::Error;
 
-					m_receivedBuffer.pop_front_N(size);
+					close();
 				}
 
-				return true;
+				return (messages.size() - oldSize);
 			}
 
-			bool send(const void* data, const size_t size)
+			bool sendMessages(const Blob* messages, const size_t count)
 			{
 				if (!m_isActive)
 				{
 					return false;
 				}
 
-				if (size == 0)
+				for (size_t i = 0; i < count; ++i)
 				{
-					return true;
+					if ((maxBufferSize - TCPMessageHeaderSize) < messages[i].size())
+					{
+						return false;
+					}
 				}
 
+				if (count == 0)
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
+					return true;
+				}
 
-					if (!m_isSending)
-					{
-						send_internal();
-					}
+				if (m_sendingBuffer.pushMessages(messages, count))
+				{
+					send_internal();
 				}
 
 				return true;
@@ -384,6 +388,8 @@ namespace s3d
 
 		size_t available();
 
+		TCPReceiveView peek();
+
 		bool skip(size_t size);
 
 		bool lookahead(void* dst, size_t size) const;
@@ -391,5 +397,9 @@ namespace s3d
 		bool read(void* dst, size_t size);
 
 		bool send(const void* data, size_t size);
+
+		size_t receiveMessages(Array<Blob>& messages);
+
+		bool sendMessages(const Blob* messages, size_t count);
 	};
 }
@@ -24,9 +24,9 @@ namespace s3d
 		pImpl->startAccept(port);
 	}
 
-	void TCPServer::startAcceptMulti(const uint16 port)
+	void TCPServer::startAcceptMulti(const uint16 port, const size_t numThreads)
 	{
-		pImpl->startAcceptMulti(port);
+		pImpl->startAcceptMulti(port, numThreads);
 	}
 
 	void TCPServer::cancelAccept()
@@ -74,6 +74,16 @@ namespace s3d
 		return pImpl->available(id);
 	}
 
+	TCPReceiveView TCPServer::peek(const Optional<TCPSessionID>& id)
+	{
+		return pImpl->peek(id);
+	}
+
+	bool TCPServer::consume(const size_t size, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->skip(size, id);
+	}
+
 	bool TCPServer::skip(const size_t size, const Optional<TCPSessionID>& id)
 	{
 		return pImpl->skip(size, id);
@@ -93,4 +103,29 @@ namespace s3d
 	{
 		return pImpl->send(data, size, id);
 	}
+
+	bool TCPServer::sendMessage(const Blob& message, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->sendMessages(&message, 1, id);
+	}
+
+	bool TCPServer::sendBatch(const Array<Blob>& messages, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->sendMessages(messages.data(), messages.size(), id);
+	}
+
+	size_t TCPServer::receiveMessages(Array<Blob>& messages, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->receiveMessages(messages, id);
+	}
+
+	TCPSessionStats TCPServer::getSessionStats(const Optional<TCPSessionID>& id) const
+	{
+		return pImpl->getSessionStats(id);
+	}
+
+	TCPSessionStats TCPServer::getStats() const
+	{
+		return pImpl->getStats();
+	}
 }
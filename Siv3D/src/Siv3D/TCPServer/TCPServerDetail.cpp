@@ -37,12 +37,7 @@ namespace s3d
 
 		m_port = port;
 
-		if (!m_work)
-		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
-
-			m_io_service_thread = Async([this] { m_io_service->run(); });
-		}
+		startThreads(1);
 
 		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
 
@@ -52,7 +47,7 @@ namespace s3d
 			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
 	}
 
-	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port)
+	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port, const size_t numThreads)
 	{
 		if (m_accepting)
 		{
@@ -65,12 +60,7 @@ namespace s3d
 
 		m_port = port;
 
-		if (!m_work)
-		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
-
-			m_io_service_thread = Async([this] { m_io_service->run(); });
-		}
+		startThreads(Max<size_t>(numThreads, 1));
 
 		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
 
@@ -97,31 +87,48 @@ namespace s3d
 
 	void TCPServer::TCPServerDetail::disconnect()
 	{
-		cancelAccept();
-
-		for (auto& session : m_sessions)
-		{
-			session.second->close();
-		}
-
-		m_sessions.clear();
+		m_accepting = false;
 
+		// 通信スレッドを止めてから、アクセプタとセッションを閉じる
 		if (m_work)
 		{
 			m_work.reset();
 
 			m_io_service->stop();
 
-			m_io_service_thread.wait();
+			for (auto& thread : m_io_service_threads)
+			{
+				thread.wait();
+			}
+
+			m_io_service_threads.clear();
 
 			m_io_service->restart();
 		}
+
+		if (m_acceptor)
+		{
+			m_acceptor->close();
+		}
+
+		std::lock_guard lock{ m_sessionsMutex };
+
+		for (auto& session : m_sessions)
+		{
+			session.second->close();
+
+			addRemovedSessionStats(*session.second);
+		}
+
+		m_sessions.clear();
 	}
 
 	bool TCPServer::TCPServerDetail::hasSession()
 	{
 		updateSession();
 
+		std::lock_guard lock{ m_sessionsMutex };
+
 		return m_sessions.any([](const auto& session) { return session.second->isActive(); });
 	}
 
@@ -129,6 +136,8 @@ namespace s3d
 	{
 		updateSession();
 
+		std::lock_guard lock{ m_sessionsMutex };
+
 		return m_sessions.includes_if([=](const auto& session) { return session.first == id; });
 	}
 
@@ -136,6 +145,8 @@ namespace s3d
 	{
 		updateSession();
 
+		std::lock_guard lock{ m_sessionsMutex };
+
 		return m_sessions.count_if([](const auto& session) { return session.second->isActive(); });
 	}
 
@@ -143,6 +154,8 @@ namespace s3d
 	{
 		updateSession();
 
+		std::lock_guard lock{ m_sessionsMutex };
+
 		return m_sessions.map([](const auto& session) { return session.first; });
 	}
 
@@ -153,109 +166,127 @@ namespace s3d
 
 	size_t TCPServer::TCPServerDetail::available(const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return 0;
+			return session->available();
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return 0;
+	}
 
-		for (auto& session : m_sessions)
+	TCPReceiveView TCPServer::TCPServerDetail::peek(const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->available();
-			}
+			return session->peek();
 		}
 
-		return 0;
+		return{};
 	}
 
 	bool TCPServer::TCPServerDetail::skip(const size_t size, const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->skip(size);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<TCPSessionID>& id) const
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->skip(size);
-			}
+			return session->lookahead(dst, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<TCPSessionID>& id) const
+	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->read(dst, size);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->lookahead(dst, size);
-			}
+			return session->send(data, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<TCPSessionID>& id)
+	size_t TCPServer::TCPServerDetail::receiveMessages(Array<Blob>& messages, const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->receiveMessages(messages);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return 0;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::sendMessages(const Blob* messages, const size_t count, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->read(dst, size);
-			}
+			return session->sendMessages(messages, count);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<TCPSessionID>& id)
+	TCPSessionStats TCPServer::TCPServerDetail::getSessionStats(const Optional<TCPSessionID>& id) const
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->getStats();
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return{};
+	}
 
-		for (auto& session : m_sessions)
+	TCPSessionStats TCPServer::TCPServerDetail::getStats() const
+	{
+		std::lock_guard lock{ m_sessionsMutex };
+
+		TCPSessionStats stats = m_removedSessionStats;
+
+		for (const auto& session : m_sessions)
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->send(data, size);
-			}
+			stats += session.second->getStats();
 		}
 
-		return false;
+		return stats;
+	}
+
+	void TCPServer::TCPServerDetail::startThreads(const size_t numThreads)
+	{
+		if (!m_work)
+		{
+			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
+		}
+
+		while (m_io_service_threads.size() < numThreads)
+		{
+			m_io_service_threads.push_back(std::async(std::launch::async, [this] { m_io_service->run(); }));
+		}
 	}
 
 	void TCPServer::TCPServerDetail::onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session)
 	{
 		updateSession();
 
-		if (!m_accepting)
+		// disconnect() や cancelAccept() で閉じたアクセプタの通知
+		if ((!m_accepting) || (error == asio::error::operation_aborted))
 		{
 			return;
 		}
@@ -283,11 +314,15 @@ namespace s3d
 				socket.local_endpoint().port()));
 		}
 
-		m_sessions.push_back({ id, session });
+		{
+			std::lock_guard lock{ m_sessionsMutex };
+
+			m_sessions.push_back({ id, session });
+		}
 
 		LOG_TRACE(U"TCPServer session [{}] created"_fmt(id));
 
-		m_sessions.back().second->startReceive();
+		session->startReceive();
 
 		if (m_allowMulti)
 		{
@@ -304,6 +339,51 @@ namespace s3d
 
 	void TCPServer::TCPServerDetail::updateSession()
 	{
-		m_sessions.remove_if([](const auto& session) { return !session.second->isActive(); });
+		std::lock_guard lock{ m_sessionsMutex };
+
+		m_sessions.remove_if([this](const auto& session)
+		{
+			if (session.second->isActive())
+			{
+				return false;
+			}
+
+			addRemovedSessionStats(*session.second);
+
+			return true;
+		});
+	}
+
+	void TCPServer::TCPServerDetail::addRemovedSessionStats(const detail::ServerSession& session)
+	{
+		TCPSessionStats stats = session.getStats();
+
+		// 送受信バッファのサイズは、現在のセッションのものだけを合計する
+		stats.receiveQueueSize = 0;
+		stats.sendQueueSize = 0;
+
+		m_removedSessionStats += stats;
+	}
+
+	std::shared_ptr<detail::ServerSession> TCPServer::TCPServerDetail::findSession(const Optional<TCPSessionID>& id) const
+	{
+		std::lock_guard lock{ m_sessionsMutex };
+
+		if (m_sessions.isEmpty())
+		{
+			return nullptr;
+		}
+
+		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+
+		for (const auto& session : m_sessions)
+		{
+			if (session.first == sessionID)
+			{
+				return session.second;
+			}
+		}
+
+		return nullptr;
 	}
 }
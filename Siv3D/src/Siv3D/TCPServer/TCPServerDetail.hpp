@@ -10,11 +10,13 @@
 //-----------------------------------------------
 
 # pragma once
+# include <mutex>
 # include <Siv3D/TCPServer.hpp>
 # include <Siv3D/AsyncTask.hpp>
 # include <Siv3D/Byte.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Network/TCPSessionBuffer.hpp>
 
 # define _WINSOCK_DEPRECATED_NO_WARNINGS
 # ifndef _WIN32_WINNT
@@ -36,9 +38,12 @@ namespace s3d
 
 			asio::ip::tcp::socket m_socket;
 
+			// 複数のスレッドで通信を処理する場合も、セッションのハンドラは順番に実行する
+			asio::io_service::strand m_strand;
+
 			TCPSessionID m_id = 0;
 
-			bool m_isActive = false;
+			std::atomic<bool> m_isActive = false;
 
 			bool m_eof = false;
 
@@ -47,31 +52,45 @@ namespace s3d
 			// 受信	
 			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
 
-			std::mutex m_mutexReceivedBuffer;
+			TCPReceiveBuffer m_receivedBuffer{ maxBufferSize };
 
-			Array<Byte> m_receivedBuffer;
+			// 受信バッファの読み込み側は 1 つのスレッドからしか使えないため、ユーザのスレッドどうしを排他する
+			std::mutex m_readMutex;
 
 
 			// 送信
-			std::mutex m_mutexSendingBuffer;
+			TCPSendBuffer m_sendingBuffer;
+
+
+			// 統計
+			std::atomic<uint64> m_bytesReceived = 0;
+
+			std::atomic<uint64> m_bytesSent = 0;
 
-			Array<Array<Byte>> m_sendingBuffer;
+			std::atomic<uint64> m_messagesReceived = 0;
 
-			bool m_isSending = false;
+			std::atomic<uint64> m_messagesSent = 0;
 
 
 			void send_internal()
 			{
-				m_isSending = true;
+				const Array<Byte>& sending = m_sendingBuffer.sending();
 
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
-					std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
+				asio::async_write(m_socket, asio::buffer(sending.data(), sending.size()),
+					asio::bind_executor(m_strand, std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this())));
+			}
+
+			// メインスレッドから送信を開始する
+			void startSend()
+			{
+				asio::post(m_strand, std::bind(&ServerSession::send_internal, shared_from_this()));
 			}
 
 		public:
 
 			ServerSession(asio::io_service& io_service)
 				: m_socket(io_service)
+				, m_strand(io_service)
 			{
 
 			}
@@ -95,19 +114,10 @@ namespace s3d
 
 				m_socket.close();
 
-				if (!m_isSending)
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
-				}
+				m_sendingBuffer.clear();
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
-					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
-				}
+				m_streamBuffer.consume(m_streamBuffer.size());
 
-				m_isSending = false;
 				m_isActive = false;
 				m_eof = false;
 
@@ -119,6 +129,14 @@ namespace s3d
 				m_id = 0;
 			}
 
+			// メインスレッドから切断する
+			void requestClose()
+			{
+				m_isActive = false;
+
+				asio::post(m_strand, std::bind(&ServerSession::close, shared_from_this()));
+			}
+
 			void init(const TCPSessionID id)
 			{
 				m_id = id;
@@ -140,7 +158,10 @@ namespace s3d
 
 			size_t available()
 			{
-				std::lock_guard lock{ m_mutexReceivedBuffer };
+				if (!m_isActive)
+				{
+					return 0;
+				}
 
 				return m_receivedBuffer.size();
 			}
@@ -148,7 +169,7 @@ namespace s3d
 			void startReceive()
 			{
 				asio::async_read(m_socket, m_streamBuffer, asio::transfer_at_least(1),
-					std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
+					asio::bind_executor(m_strand, std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this())));
 			}
 
 			void onReceive(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
@@ -176,36 +197,31 @@ namespace s3d
 				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
 				const size_t size = m_streamBuffer.size();
 
+				if (not m_receivedBuffer.write(data, size))
 				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+					LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
 
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
-
-						m_streamBuffer.consume(m_streamBuffer.size());
-
-						close();
+					m_streamBuffer.consume(m_streamBuffer.size());
 
-						return;
-					}
+					close();
 
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
+					return;
 				}
 
 				m_streamBuffer.consume(m_streamBuffer.size());
 
+				m_bytesReceived += size;
+
 				startReceive();
 			}
 
-			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
+			void onSend(const asio::error_code& error, const size_t bytes_transferred, const std::shared_ptr<ServerSession>&)
 			{
-				m_isSending = false;
+				m_bytesSent += bytes_transferred;
 
 				if (!m_isActive)
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
+					m_sendingBuffer.cancel();
 					return;
 				}
 
@@ -213,24 +229,29 @@ namespace s3d
 				{
 					LOG_FAIL(U"TCPServer: send failed: {}"_fmt(Unicode::Widen(error.message())));
 
+					m_sendingBuffer.cancel();
+
 					close();
 
 					return;
 				}
 
+				if (m_sendingBuffer.onSent())
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
+					send_internal();
+				}
+			}
 
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
+			TCPReceiveView peek()
+			{
+				if (!m_isActive)
+				{
+					return{};
 				}
+
+				std::lock_guard lock{ m_readMutex };
+
+				return m_receivedBuffer.peek();
 			}
 
 			bool skip(const size_t size)
@@ -245,18 +266,9 @@ namespace s3d
 					return true;
 				}
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+				std::lock_guard lock{ m_readMutex };
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
-
-					m_receivedBuffer.pop_front_N(size);
-				}
-
-				return true;
+				return m_receivedBuffer.skip(size);
 			}
 
 			bool lookahead(void* dst, const size_t size)
@@ -271,18 +283,9 @@ namespace s3d
 					return true;
 				}
 
-				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
-
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
-
-					std::memcpy(dst, m_receivedBuffer.data(), size);
-				}
+				std::lock_guard lock{ m_readMutex };
 
-				return true;
+				return m_receivedBuffer.lookahead(dst, size);
 			}
 
 			bool read(void* dst, const size_t size)
@@ -297,42 +300,92 @@ namespace s3d
 					return true;
 				}
 
-				{
-					std::lock_guard<std::mutex> lock{ m_mutexReceivedBuffer };
+				std::lock_guard lock{ m_readMutex };
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				return m_receivedBuffer.read(dst, size);
+			}
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+			bool send(const void* data, const size_t size)
+			{
+				if (!m_isActive)
+				{
+					return false;
+				}
 
-					m_receivedBuffer.pop_front_N(size);
+				if (m_sendingBuffer.push(data, size))
+				{
+					startSend();
 				}
 
 				return true;
 			}
 
-			bool send(const void* data, const size_t size)
+			size_t receiveMessages(Array<Blob>& messages)
 			{
 				if (!m_isActive)
 				{
-					return false;
+					return 0;
 				}
 
+				const size_t oldSize = messages.size();
+
+				std::lock_guard lock{ m_readMutex };
+
+				if (not m_receivedBuffer.readMessages(messages))
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
+					LOG_FAIL(U"TCPServer: received a message header that exceeds the maximum message size");
 
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
+					requestClose();
+				}
+
+				const size_t count = (messages.size() - oldSize);
+
+				m_messagesReceived += count;
+
+				return count;
+			}
+
+			bool sendMessages(const Blob* messages, const size_t count)
+			{
+				if (!m_isActive)
+				{
+					return false;
+				}
 
-					if (!m_isSending)
+				for (size_t i = 0; i < count; ++i)
+				{
+					if ((maxBufferSize - TCPMessageHeaderSize) < messages[i].size())
 					{
-						send_internal();
+						return false;
 					}
 				}
 
+				if (count == 0)
+				{
+					return true;
+				}
+
+				m_messagesSent += count;
+
+				if (m_sendingBuffer.pushMessages(messages, count))
+				{
+					startSend();
+				}
+
 				return true;
 			}
+
+			TCPSessionStats getStats() const
+			{
+				TCPSessionStats stats;
+				stats.bytesReceived		= m_bytesReceived;
+				stats.bytesSent			= m_bytesSent;
+				stats.messagesReceived	= m_messagesReceived;
+				stats.messagesSent		= m_messagesSent;
+				stats.receiveQueueSize	= m_receivedBuffer.size();
+				stats.sendQueueSize		= m_sendingBuffer.size();
+				return stats;
+			}
 		};
 	}
 
@@ -346,22 +399,36 @@ namespace s3d
 
 		std::unique_ptr<asio::ip::tcp::acceptor> m_acceptor;
 
-		AsyncTask<void> m_io_service_thread;
+		Array<AsyncTask<void>> m_io_service_threads;
+
+		// m_sessions は onAccept() を実行する通信スレッドからも変更される
+		mutable std::mutex m_sessionsMutex;
 
 		Array<std::pair<TCPSessionID, std::shared_ptr<detail::ServerSession>>> m_sessions;
 
+		// m_sessions から取り除いたセッションの統計情報の合計（m_sessionsMutex で保護する）
+		TCPSessionStats m_removedSessionStats;
+
 		std::atomic<TCPSessionID> m_currentTCPSessionID = 0;
 
 		uint16 m_port = 0;
 
-		bool m_accepting = false;
+		std::atomic<bool> m_accepting = false;
 
 		bool m_allowMulti = false;
 
+		void startThreads(size_t numThreads);
+
 		void onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session);
 
 		void updateSession();
 
+		// m_sessionsMutex をロックした状態で呼ぶ
+		void addRemovedSessionStats(const detail::ServerSession& session);
+
+		[[nodiscard]]
+		std::shared_ptr<detail::ServerSession> findSession(const Optional<TCPSessionID>& id) const;
+
 	public:
 
 		TCPServerDetail();
@@ -370,7 +437,7 @@ namespace s3d
 
 		void startAccept(uint16 port);
 
-		void startAcceptMulti(uint16 port);
+		void startAcceptMulti(uint16 port, size_t numThreads);
 
 		void cancelAccept();
 
@@ -390,6 +457,8 @@ namespace s3d
 
 		size_t available(const Optional<TCPSessionID>& id);
 
+		TCPReceiveView peek(const Optional<TCPSessionID>& id);
+
 		bool skip(size_t size, const Optional<TCPSessionID>& id);
 
 		bool lookahead(void* dst, size_t size, const Optional<TCPSessionID>& id) const;
@@ -397,5 +466,13 @@ namespace s3d
 		bool read(void* dst, size_t size, const Optional<TCPSessionID>& id);
 
 		bool send(const void* data, size_t size, const Optional<TCPSessionID>& id);
+
+		size_t receiveMessages(Array<Blob>& messages, const Optional<TCPSessionID>& id);
+
+		bool sendMessages(const Blob* messages, size_t count, const Optional<TCPSessionID>& id);
+
+		TCPSessionStats getSessionStats(const Optional<TCPSessionID>& id) const;
+
+		TCPSessionStats getStats() const;
 	};
 }
@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/TaskGroup.hpp>
+# include "TaskGroupDetail.hpp"
+
+namespace s3d
+{
+	TaskGroup::TaskGroup()
+		: pImpl{ std::make_shared<TaskGroupDetail>() } {}
+
+	TaskGroup::~TaskGroup()
+	{
+		try
+		{
+			pImpl->wait();
+		}
+		catch (...) {}
+	}
+
+	bool TaskGroup::isDone() const
+	{
+		return (pImpl->num_pending() == 0);
+	}
+
+	size_t TaskGroup::num_pending() const
+	{
+		return pImpl->num_pending();
+	}
+
+	void TaskGroup::wait()
+	{
+		pImpl->wait();
+	}
+
+	void TaskGroup::then(std::function<void()> continuation)
+	{
+		pImpl->then(std::move(continuation));
+	}
+
+	void TaskGroup::submitTask(std::function<void()> task)
+	{
+		pImpl->submit(std::move(task));
+	}
+}
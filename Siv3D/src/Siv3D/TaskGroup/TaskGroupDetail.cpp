@@ -0,0 +1,114 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "TaskGroupDetail.hpp"
+
+namespace s3d
+{
+	TaskGroup::TaskGroupDetail::TaskGroupDetail() {}
+
+	TaskGroup::TaskGroupDetail::~TaskGroupDetail() {}
+
+	void TaskGroup::TaskGroupDetail::submit(std::function<void()> task)
+	{
+		++m_pendingCount;
+
+		// タスクが参照している間はグループの状態を保持する
+		Threading::Submit([self = shared_from_this(), task = std::move(task)]()
+		{
+			try
+			{
+				task();
+			}
+			catch (...)
+			{
+				std::lock_guard lock{ self->m_mutex };
+
+				if (not self->m_exception)
+				{
+					self->m_exception = std::current_exception();
+				}
+			}
+
+			self->onTaskFinished();
+		});
+	}
+
+	size_t TaskGroup::TaskGroupDetail::num_pending() const noexcept
+	{
+		return m_pendingCount;
+	}
+
+	void TaskGroup::TaskGroupDetail::wait()
+	{
+		while (m_pendingCount)
+		{
+			// ワーカースレッドから待つ場合は、デッドロックを避けるため実行待ちのタスクを処理する
+			if (Threading::IsWorkerThread()
+				&& Threading::RunPendingTask())
+			{
+				continue;
+			}
+
+			std::unique_lock lock{ m_mutex };
+
+			m_condition.wait(lock, [this]() { return (m_pendingCount == 0); });
+		}
+
+		std::exception_ptr exception;
+		{
+			std::lock_guard lock{ m_mutex };
+			std::swap(exception, m_exception);
+		}
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	void TaskGroup::TaskGroupDetail::then(std::function<void()> continuation)
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if (m_pendingCount)
+			{
+				m_continuations.push_back(std::move(continuation));
+				return;
+			}
+		}
+
+		Threading::Submit(std::move(continuation));
+	}
+
+	void TaskGroup::TaskGroupDetail::onTaskFinished()
+	{
+		Array<std::function<void()>> continuations;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if ((--m_pendingCount) != 0)
+			{
+				return;
+			}
+
+			continuations.swap(m_continuations);
+		}
+
+		m_condition.notify_all();
+
+		for (auto& continuation : continuations)
+		{
+			Threading::Submit(std::move(continuation));
+		}
+	}
+}
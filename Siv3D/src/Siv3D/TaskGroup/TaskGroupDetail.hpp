@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <mutex>
+# include <exception>
+# include <condition_variable>
+# include <Siv3D/TaskGroup.hpp>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	class TaskGroup::TaskGroupDetail : public std::enable_shared_from_this<TaskGroupDetail>
+	{
+	public:
+
+		TaskGroupDetail();
+
+		~TaskGroupDetail();
+
+		void submit(std::function<void()> task);
+
+		[[nodiscard]]
+		size_t num_pending() const noexcept;
+
+		void wait();
+
+		void then(std::function<void()> continuation);
+
+	private:
+
+		std::atomic<size_t> m_pendingCount = 0;
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+
+		std::exception_ptr m_exception;
+
+		Array<std::function<void()>> m_continuations;
+
+		void onTaskFinished();
+	};
+}
@@ -9,15 +9,244 @@
 //
 //-----------------------------------------------
 
+# include <bit>
 # include "TextReaderDetail.hpp"
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Endian.hpp>
 # include <Siv3D/Unicode.hpp>
-# include <Siv3D/UnicodeConverter.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <ThirdParty/miniutf/miniutf.hpp>
+# include <Siv3D/MappedReader/MappedReaderUtility.hpp>
 
 namespace s3d
 {
+	namespace
+	{
+		// UTF-8 のバイト列 [first, last) をデコードして pDst に書き込み、デコードした文字数を返す。
+		// 末尾で途切れた符号単位は読み進めずに残し、読み進めたバイト数を consumed に格納する。
+		// isLast が true の場合、途切れた符号単位は破棄する
+		[[nodiscard]]
+		size_t DecodeUTF8(const uint8* first, const uint8* const last, char32* const pDst, const bool isLast, size_t& consumed) noexcept
+		{
+			const uint8* const begin = first;
+			char32* dst = pDst;
+
+			while (first != last)
+			{
+			# if SIV3D_INTRINSIC(SSE)
+
+				// ASCII が 16 バイト続く区間は、まとめて UTF-32 に拡張する
+				while ((last - first) >= 16)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+					if (_mm_movemask_epi8(v) != 0)
+					{
+						break;
+					}
+
+					const __m128i zero = _mm_setzero_si128();
+					const __m128i lo = _mm_unpacklo_epi8(v, zero);
+					const __m128i hi = _mm_unpackhi_epi8(v, zero);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 0), _mm_unpacklo_epi16(lo, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_unpackhi_epi16(lo, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpacklo_epi16(hi, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), _mm_unpackhi_epi16(hi, zero));
+
+					first += 16;
+					dst += 16;
+				}
+
+				if (first == last)
+				{
+					break;
+				}
+
+			# endif
+
+				if (*first < 0x80)
+				{
+					*dst++ = *first++;
+					continue;
+				}
+
+				const size_t remaining = static_cast<size_t>(last - first);
+				const detail::offset_pt result = detail::utf8_decode_check(reinterpret_cast<const char8*>(first), remaining);
+
+				if (result.offset != -1)
+				{
+					*dst++ = result.codePoint;
+					first += result.offset;
+					continue;
+				}
+
+				// 先頭バイトが示す長さに足りない場合は、続きのバイトを次のチャンクから読み込む
+				const size_t length = ((*first < 0xC0) ? 1 : (*first < 0xE0) ? 2 : (*first < 0xF0) ? 3 : (*first < 0xF8) ? 4 : 1);
+
+				if ((remaining < length)
+					&& std::all_of((first + 1), last, [](const uint8 c) { return ((c & 0xC0) == 0x80); }))
+				{
+					if (isLast)
+					{
+						first = last;
+					}
+
+					break;
+				}
+
+				// 不正なバイトは U+FFFD に置き換える
+				*dst++ = 0xFFFD;
+				++first;
+			}
+
+			consumed = static_cast<size_t>(first - begin);
+
+			return static_cast<size_t>(dst - pDst);
+		}
+
+		template <bool BigEndian>
+		[[nodiscard]]
+		inline char16 LoadUTF16(const uint8* p) noexcept
+		{
+			if constexpr (BigEndian)
+			{
+				return static_cast<char16>((p[0] << 8) | p[1]);
+			}
+			else
+			{
+				return static_cast<char16>(p[0] | (p[1] << 8));
+			}
+		}
+
+		// UTF-16 のバイト列 [first, last) をデコードして pDst に書き込み、デコードした文字数を返す。
+		// 末尾で途切れた符号単位は読み進めずに残し、読み進めたバイト数を consumed に格納する。
+		// isLast が true の場合、途切れた符号単位は破棄する
+		template <bool BigEndian>
+		[[nodiscard]]
+		size_t DecodeUTF16(const uint8* first, const uint8* const last, char32* const pDst, const bool isLast, size_t& consumed) noexcept
+		{
+			const uint8* const begin = first;
+			char32* dst = pDst;
+
+			while ((last - first) >= 2)
+			{
+			# if SIV3D_INTRINSIC(SSE)
+
+				// サロゲートを含まない 8 文字の区間は、まとめて UTF-32 に拡張する
+				while ((last - first) >= 16)
+				{
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+					if constexpr (BigEndian)
+					{
+						v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+					}
+
+					const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xF800))), _mm_set1_epi16(static_cast<short>(0xD800)));
+
+					if (_mm_movemask_epi8(surrogates) != 0)
+					{
+						break;
+					}
+
+					const __m128i zero = _mm_setzero_si128();
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 0), _mm_unpacklo_epi16(v, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_unpackhi_epi16(v, zero));
+
+					first += 16;
+					dst += 8;
+				}
+
+				if ((last - first) < 2)
+				{
+					break;
+				}
+
+			# endif
+
+				const char16 c0 = LoadUTF16<BigEndian>(first);
+
+				if (not Unicode::IsHighSurrogate(c0))
+				{
+					// 対になっていない下位サロゲートは U+FFFD に置き換える
+					*dst++ = (Unicode::IsLowSurrogate(c0) ? 0xFFFD : c0);
+					first += 2;
+					continue;
+				}
+
+				if ((last - first) < 4)
+				{
+					// 下位サロゲートを次のチャンクから読み込む
+					if (isLast)
+					{
+						first = last;
+					}
+
+					break;
+				}
+
+				const char16 c1 = LoadUTF16<BigEndian>(first + 2);
+
+				if (Unicode::IsLowSurrogate(c1))
+				{
+					*dst++ = ((((c0 - 0xD800) << 10) | (c1 - 0xDC00)) + 0x10000);
+					first += 4;
+				}
+				else
+				{
+					*dst++ = 0xFFFD;
+					first += 2;
+				}
+			}
+
+			if (isLast)
+			{
+				first = last;
+			}
+
+			consumed = static_cast<size_t>(first - begin);
+
+			return static_cast<size_t>(dst - pDst);
+		}
+
+		// [first, last) から最初の U'\n', U'\r', U'\0' を探す
+		[[nodiscard]]
+		const char32* FindBreak(const char32* first, const char32* const last) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			const __m128i lf = _mm_set1_epi32(U'\n');
+			const __m128i cr = _mm_set1_epi32(U'\r');
+			const __m128i zero = _mm_setzero_si128();
+
+			while ((last - first) >= 4)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(v, lf), _mm_cmpeq_epi32(v, cr)), _mm_cmpeq_epi32(v, zero));
+
+				if (const int32 mask = _mm_movemask_epi8(m))
+				{
+					return (first + (std::countr_zero(static_cast<uint32>(mask)) / 4));
+				}
+
+				first += 4;
+			}
+
+		# endif
+
+			for (; first != last; ++first)
+			{
+				if ((*first == U'\n') || (*first == U'\r') || (*first == U'\0'))
+				{
+					break;
+				}
+			}
+
+			return first;
+		}
+	}
+
 	TextReader::TextReaderDetail::TextReaderDetail()
 	{
 		// do nothing
@@ -44,6 +273,8 @@ namespace s3d
 
 		m_reader = std::move(tmpReader);
 
+		resetBuffer();
+
 		m_info =
 		{
 			.fullPath	= FileSystem::FullPath(path),
@@ -78,6 +309,8 @@ namespace s3d
 
 		m_reader = std::move(reader);
 
+		resetBuffer();
+
 		m_info =
 		{
 			.fullPath	= {},
@@ -102,6 +335,8 @@ namespace s3d
 
 		m_reader.reset();
 
+		resetBuffer();
+
 		m_info = {};
 	}
 
@@ -146,94 +381,30 @@ namespace s3d
 
 		String line;
 
-		for (;;)
+		if (not readLine(line))
 		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					return line;
-				}
-
-				return none;
-			}
-
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				return line;
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
+			return none;
 		}
+
+		return line;
 	}
 
 	Array<String> TextReader::TextReaderDetail::readLines()
 	{
-		if (not m_info.isOpen) SIV3D_UNLIKELY
-		{
-			return{};
-		}
-
 		Array<String> lines;
-		String line;
-
-		for (;;)
-		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					lines.push_back(std::move(line));
-				}
 
-				return lines;
-			}
+		readLines(lines);
 
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				lines.push_back(line);
-				line.clear();
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
-		}
+		return lines;
 	}
 
 	String TextReader::TextReaderDetail::readAll()
 	{
-		if (not m_info.isOpen) SIV3D_UNLIKELY
-		{
-			return{};
-		}
-
 		String s;
 
-		for (;;)
-		{
-			char32 codePoint;
+		readAll(s);
 
-			if (not readCodePoint(codePoint))
-			{
-				return s;
-			}
-
-			if (codePoint == U'\0')
-			{
-				return s;
-			}
-			else if (codePoint != U'\r')
-			{
-				s.push_back(codePoint);
-			}
-		}
+		return s;
 	}
 
 	bool TextReader::TextReaderDetail::readChar(char32& ch)
@@ -277,26 +448,19 @@ namespace s3d
 
 		for (;;)
 		{
-			char32 codePoint;
+			char32 found;
 
-			if (not readCodePoint(codePoint))
+			if (not appendUntilBreak(line, found))
 			{
-				if (line)
-				{
-					return true;
-				}
-
-				return false;
+				return (not line.isEmpty());
 			}
 
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
+			if ((found == U'\n') || (found == U'\0'))
 			{
 				return true;
 			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
+
+			// U'\r' は読み飛ばす
 		}
 	}
 
@@ -313,32 +477,23 @@ namespace s3d
 
 		for (;;)
 		{
-			char32 codePoint;
+			char32 found;
 
-			if (not readCodePoint(codePoint))
+			if (not appendUntilBreak(line, found))
 			{
 				if (line)
 				{
 					lines.push_back(std::move(line));
 				}
 
-				if (not lines)
-				{
-					return false;
-				}
-
-				return true;
+				return (not lines.isEmpty());
 			}
 
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
+			if ((found == U'\n') || (found == U'\0'))
 			{
 				lines.push_back(line);
 				line.clear();
 			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
 		}
 	}
 
@@ -353,25 +508,20 @@ namespace s3d
 
 		for (;;)
 		{
-			char32 codePoint;
+			char32 found;
 
-			if (not readCodePoint(codePoint))
+			if (not appendUntilBreak(s, found))
 			{
-				if (not s)
-				{
-					return false;
-				}
-
-				return true;
+				return (not s.isEmpty());
 			}
 
-			if (codePoint == U'\0')
+			if (found == U'\0')
 			{
 				return true;
 			}
-			else if (codePoint != U'\r')
+			else if (found == U'\n')
 			{
-				s.push_back(codePoint);
+				s.push_back(U'\n');
 			}
 		}
 	}
@@ -386,138 +536,126 @@ namespace s3d
 		return m_info.fullPath;
 	}
 
-	bool TextReader::TextReaderDetail::readByte(uint8& c)
-	{
-		return m_reader->read(c);
-	}
-
-	bool TextReader::TextReaderDetail::readTwoBytes(uint16& c)
-	{
-		return m_reader->read(c);
-	}
-
-	bool TextReader::TextReaderDetail::readUTF8(char32& c)
+	bool TextReader::TextReaderDetail::fillBuffer()
 	{
-		uint8 cx;
+		m_buffer.clear();
+		m_bufferPos = 0;
 
-		if (not readByte(cx))
+		while (m_buffer.isEmpty())
 		{
-			return false;
-		}
-
-		UTF8toUTF32_Converter converter;
+			if (m_readerEOF)
+			{
+				return false;
+			}
 
-		if (converter.put(cx)) // 1
-		{
-			c = converter.get();
-			return true;
-		}
+			// MappedReader の場合は、チャンクをコピーせずにマップされたデータから直接デコードする
+			const std::span<const Byte> mapped = detail::GetMappedSpan(*m_reader);
+			const bool decodeMapped = (not mapped.empty());
+			const uint8* first = nullptr;
+			const uint8* last = nullptr;
 
-		if (not readByte(cx))
-		{
-			return false;
-		}
+			if (decodeMapped)
+			{
+				const size_t chunkSize = Min(mapped.size(), ChunkSize);
+				first = reinterpret_cast<const uint8*>(mapped.data());
+				last = (first + chunkSize);
+				m_readerEOF = (chunkSize == mapped.size());
+			}
+			else
+			{
+				const size_t oldSize = m_bytes.size();
+				m_bytes.resize(oldSize + ChunkSize);
 
-		if (converter.put(cx)) // 2
-		{
-			c = converter.get();
-			return true;
-		}
+				const int64 readSize = m_reader->read((m_bytes.data() + oldSize), static_cast<int64>(ChunkSize));
+				m_bytes.resize(oldSize + static_cast<size_t>(Max<int64>(readSize, 0)));
 
-		if (not readByte(cx))
-		{
-			return false;
-		}
+				if (readSize <= 0)
+				{
+					m_readerEOF = true;
+				}
 
-		if (converter.put(cx)) // 3
-		{
-			c = converter.get();
-			return true;
-		}
+				first = m_bytes.data();
+				last = (first + m_bytes.size());
+			}
 
-		if (not readByte(cx))
-		{
-			return false;
-		}
+			// 1 バイトあたり最大 1 文字になる
+			m_buffer.resize(last - first);
 
-		if (converter.put(cx)) // 4
-		{
-			c = converter.get();
-			return true;
-		}
+			size_t consumed = 0;
+			size_t length = 0;
 
-		return false;
-	}
+			if (m_info.encoding == TextEncoding::UTF16LE)
+			{
+				length = DecodeUTF16<false>(first, last, m_buffer.data(), m_readerEOF, consumed);
+			}
+			else if (m_info.encoding == TextEncoding::UTF16BE)
+			{
+				length = DecodeUTF16<true>(first, last, m_buffer.data(), m_readerEOF, consumed);
+			}
+			else
+			{
+				length = DecodeUTF8(first, last, m_buffer.data(), m_readerEOF, consumed);
+			}
 
-	bool TextReader::TextReaderDetail::readUTF16LE(char32& c)
-	{
-		uint16 c0 = 0, c1 = 0;
-		
-		if (not readTwoBytes(c0))
-		{
-			return false;
-		}
+			m_buffer.resize(length);
 
-		if (Unicode::IsHighSurrogate(c0))
-		{
-			if (not readTwoBytes(c1))
+			if (decodeMapped)
 			{
-				return false;
+				m_reader->skip(static_cast<int64>(consumed));
+			}
+			else
+			{
+				m_bytes.erase(m_bytes.begin(), (m_bytes.begin() + consumed));
 			}
-
-			c = ((((c0 - 0xD800) << 10) | (c1 - 0xDC00)) + 0x10000);
-		}
-		else
-		{
-			c = c0;
 		}
 
 		return true;
 	}
 
-	bool TextReader::TextReaderDetail::readUTF16BE(char32& c)
+	bool TextReader::TextReaderDetail::readCodePoint(char32& codePoint)
 	{
-		uint16 c0 = 0, c1 = 0;
-
-		if (not readTwoBytes(c0))
+		if ((m_bufferPos == m_buffer.size())
+			&& (not fillBuffer()))
 		{
 			return false;
 		}
 
-		c0 = SwapEndian(c0);
+		codePoint = m_buffer[m_bufferPos++];
 
-		if (Unicode::IsHighSurrogate(c0))
+		return true;
+	}
+
+	bool TextReader::TextReaderDetail::appendUntilBreak(String& dst, char32& found)
+	{
+		for (;;)
 		{
-			if (not readTwoBytes(c1))
+			if ((m_bufferPos == m_buffer.size())
+				&& (not fillBuffer()))
 			{
 				return false;
 			}
 
-			c1 = SwapEndian(c1);
+			const char32* const first = (m_buffer.data() + m_bufferPos);
+			const char32* const last = (m_buffer.data() + m_buffer.size());
+			const char32* const it = FindBreak(first, last);
 
-			c = ((((c0 - 0xD800) << 10) | (c1 - 0xDC00)) + 0x10000);
-		}
-		else
-		{
-			c = c0;
-		}
+			dst.append(first, (it - first));
+			m_bufferPos += (it - first);
 
-		return true;
+			if (it != last)
+			{
+				found = *it;
+				++m_bufferPos;
+				return true;
+			}
+		}
 	}
 
-	bool TextReader::TextReaderDetail::readCodePoint(char32& codePoint)
+	void TextReader::TextReaderDetail::resetBuffer() noexcept
 	{
-		if (m_info.encoding == TextEncoding::UTF16LE)
-		{
-			return readUTF16LE(codePoint);
-		}
-		else if (m_info.encoding == TextEncoding::UTF16BE)
-		{
-			return readUTF16BE(codePoint);
-		}
-		else
-		{
-			return readUTF8(codePoint);
-		}
+		m_bytes.clear();
+		m_buffer.clear();
+		m_bufferPos = 0;
+		m_readerEOF = false;
 	}
 }
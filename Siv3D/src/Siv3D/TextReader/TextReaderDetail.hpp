@@ -27,24 +27,33 @@ namespace s3d
 			bool isOpen = false;
 		} m_info;
 
-		[[nodiscard]]
-		bool readByte(uint8& c);
+		// 一度に読み込むバイト数
+		static constexpr size_t ChunkSize = (64 * 1024);
 
-		[[nodiscard]]
-		bool readTwoBytes(uint16& c);
+		// まだデコードしていないバイト列（チャンクの末尾で途切れた符号単位を含む）
+		Array<uint8> m_bytes;
 
-		[[nodiscard]]
-		bool readUTF8(char32& c);
+		// デコード済みの文字列
+		String m_buffer;
 
-		[[nodiscard]]
-		bool readUTF16LE(char32& c);
+		// m_buffer の読み込み位置
+		size_t m_bufferPos = 0;
 
+		bool m_readerEOF = false;
+
+		// m_buffer を読み終えたときに、次のチャンクを読み込んでデコードする。新しい文字が得られなかった場合は false を返す
 		[[nodiscard]]
-		bool readUTF16BE(char32& c);
+		bool fillBuffer();
 
 		[[nodiscard]]
 		bool readCodePoint(char32& codePoint);
 
+		// U'\n', U'\r', U'\0' の直前までの文字を dst に追加し、見つかった文字を読み進めて found に格納する。終端に達した場合は false を返す
+		[[nodiscard]]
+		bool appendUntilBreak(String& dst, char32& found);
+
+		void resetBuffer() noexcept;
+
 	public:
 
 		TextReaderDetail();
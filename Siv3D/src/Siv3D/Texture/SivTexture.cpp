@@ -23,6 +23,7 @@
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/Renderer2D/IRenderer2D.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
+# include <Siv3D/Profiler/IProfiler.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
@@ -60,12 +61,22 @@ namespace s3d
 				SIV3D_ENGINE(Texture)->createUnmipped(image, desc)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
+		SIV3D_ENGINE(Profiler)->addTextureUploadSize(image.size_bytes());
 	}
 
 	Texture::Texture(const Image& image, const Array<Image>& mipmaps, const TextureDesc desc)
 		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Texture)->createMipped(image, mipmaps, desc)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
+
+		size_t uploadSize = image.size_bytes();
+
+		for (const auto& mipmap : mipmaps)
+		{
+			uploadSize += mipmap.size_bytes();
+		}
+
+		SIV3D_ENGINE(Profiler)->addTextureUploadSize(uploadSize);
 	}
 
 	Texture::Texture(const FilePathView path, const TextureDesc desc)
@@ -631,12 +642,18 @@ namespace s3d
 		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Texture)->createDynamic(size, pData, stride, format, desc)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
+
+		if (pData)
+		{
+			SIV3D_ENGINE(Profiler)->addTextureUploadSize(static_cast<size_t>(stride) * size.y);
+		}
 	}
 
 	Texture::Texture(Dynamic, const Size& size, const ColorF& color, const TextureFormat& format, const TextureDesc desc)
 		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Texture)->createDynamic(size, color, format, desc)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
+		SIV3D_ENGINE(Profiler)->addTextureUploadSize(static_cast<size_t>(size.x) * size.y * format.pixelSize());
 	}
 
 	Texture::Texture(Render, const Size& size, const TextureFormat& format, const HasDepth hasDepth)
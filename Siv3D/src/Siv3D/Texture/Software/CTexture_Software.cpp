@@ -0,0 +1,272 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "CTexture_Software.hpp"
+# include <Siv3D/Error.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Texture/TextureCommon.hpp>
+
+namespace s3d
+{
+	CTexture_Software::CTexture_Software()
+	{
+		// do nothing
+	}
+
+	CTexture_Software::~CTexture_Software()
+	{
+		LOG_SCOPED_TRACE(U"CTexture_Software::~CTexture_Software()");
+
+		m_textures.destroy();
+	}
+
+	void CTexture_Software::init()
+	{
+		// null Texture を管理に登録
+		{
+			// null Texture を作成
+			auto nullTexture = std::make_unique<SoftwareTexture>(Image{ 16, Palette::Yellow }, TextureDesc::Unmipped);
+
+			if (not nullTexture->isInitialized()) // もし作成に失敗していたら
+			{
+				throw EngineError(U"Null Texture initialization failed");
+			}
+
+			// 管理に登録
+			m_textures.setNullData(std::move(nullTexture));
+		}
+	}
+
+	void CTexture_Software::updateAsyncTextureLoad(const size_t)
+	{
+		// CPU 上のテクスチャは任意のスレッドから直接作成できるため、何もしない
+	}
+
+	size_t CTexture_Software::getTextureCount() const
+	{
+		return m_textures.size();
+	}
+
+	Texture::IDType CTexture_Software::createUnmipped(const Image& image, const TextureDesc desc)
+	{
+		if (not image)
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		auto texture = std::make_unique<SoftwareTexture>(image, desc);
+
+		if (not texture->isInitialized())
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const String info = U"(type: Default, size:{0}x{1}, format: {2})"_fmt(image.width(), image.height(), texture->getFormat().name());
+		return m_textures.add(std::move(texture), info);
+	}
+
+	Texture::IDType CTexture_Software::createMipped(const Image& image, const Array<Image>&, const TextureDesc desc)
+	{
+		// ソフトウェアレンダラーはミップマップを使わずに基本レベルのみをサンプリングする
+		return createUnmipped(image, desc);
+	}
+
+	Texture::IDType CTexture_Software::createDynamic(const Size& size, const void* pData, const uint32 stride, const TextureFormat& format, const TextureDesc desc)
+	{
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		auto texture = std::make_unique<SoftwareTexture>(SoftwareTexture::Dynamic{}, size, pData, stride, format, desc);
+
+		if (not texture->isInitialized())
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const String info = U"(type: Dynamic, size: {0}x{1}, format: {2})"_fmt(size.x, size.y, texture->getFormat().name());
+		return m_textures.add(std::move(texture), info);
+	}
+
+	Texture::IDType CTexture_Software::createDynamic(const Size& size, const ColorF& color, const TextureFormat& format, const TextureDesc desc)
+	{
+		const Array<Byte> initialData = GenerateInitialColorBuffer(size, color, format);
+
+		if (not initialData)
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		return createDynamic(size, initialData.data(), static_cast<uint32>(initialData.size() / size.y), format, desc);
+	}
+
+	Texture::IDType CTexture_Software::createRT(const Size& size, const TextureFormat& format, const HasDepth hasDepth)
+	{
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const TextureDesc desc = (format.isSRGB() ? TextureDesc::UnmippedSRGB : TextureDesc::Unmipped);
+		auto texture = std::make_unique<SoftwareTexture>(SoftwareTexture::Render{}, size, format, desc, hasDepth);
+
+		if (not texture->isInitialized())
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const String info = U"(type: Render, size:{0}x{1}, format: {2})"_fmt(size.x, size.y, texture->getFormat().name());
+		return m_textures.add(std::move(texture), info);
+	}
+
+	Texture::IDType CTexture_Software::createRT(const Image& image, const HasDepth hasDepth)
+	{
+		if (not image)
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const TextureDesc desc = TextureDesc::Unmipped;
+		const TextureFormat format = TextureFormat::R8G8B8A8_Unorm;
+		auto texture = std::make_unique<SoftwareTexture>(SoftwareTexture::Render{}, image, format, desc, hasDepth);
+
+		if (not texture->isInitialized())
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const String info = U"(type: Render, size:{0}x{1}, format: {2})"_fmt(image.width(), image.height(), texture->getFormat().name());
+		return m_textures.add(std::move(texture), info);
+	}
+
+	Texture::IDType CTexture_Software::createRT(const Grid<float>&, const HasDepth)
+	{
+		LOG_FAIL(U"CTexture_Software::createRT(): Grid<float> is not supported in the software renderer");
+		return Texture::IDType::NullAsset();
+	}
+
+	Texture::IDType CTexture_Software::createRT(const Grid<Float2>&, const HasDepth)
+	{
+		LOG_FAIL(U"CTexture_Software::createRT(): Grid<Float2> is not supported in the software renderer");
+		return Texture::IDType::NullAsset();
+	}
+
+	Texture::IDType CTexture_Software::createRT(const Grid<Float4>&, const HasDepth)
+	{
+		LOG_FAIL(U"CTexture_Software::createRT(): Grid<Float4> is not supported in the software renderer");
+		return Texture::IDType::NullAsset();
+	}
+
+	Texture::IDType CTexture_Software::createMSRT(const Size& size, const TextureFormat& format, const HasDepth hasDepth)
+	{
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const TextureDesc desc = (format.isSRGB() ? TextureDesc::UnmippedSRGB : TextureDesc::Unmipped);
+		auto texture = std::make_unique<SoftwareTexture>(SoftwareTexture::MSRender{}, size, format, desc, hasDepth);
+
+		if (not texture->isInitialized())
+		{
+			return Texture::IDType::NullAsset();
+		}
+
+		const String info = U"(type: MSRender, size:{0}x{1}, format: {2})"_fmt(size.x, size.y, texture->getFormat().name());
+		return m_textures.add(std::move(texture), info);
+	}
+
+	void CTexture_Software::release(const Texture::IDType handleID)
+	{
+		m_textures.erase(handleID);
+	}
+
+	Size CTexture_Software::getSize(const Texture::IDType handleID)
+	{
+		return m_textures[handleID]->getSize();
+	}
+
+	TextureDesc CTexture_Software::getDesc(const Texture::IDType handleID)
+	{
+		return m_textures[handleID]->getDesc();
+	}
+
+	TextureFormat CTexture_Software::getFormat(const Texture::IDType handleID)
+	{
+		return m_textures[handleID]->getFormat();
+	}
+
+	bool CTexture_Software::hasDepth(const Texture::IDType handleID)
+	{
+		return m_textures[handleID]->hasDepth();
+	}
+
+	bool CTexture_Software::fill(const Texture::IDType handleID, const ColorF& color, const bool wait)
+	{
+		return m_textures[handleID]->fill(color, wait);
+	}
+
+	bool CTexture_Software::fillRegion(const Texture::IDType handleID, const ColorF& color, const Rect& rect)
+	{
+		return m_textures[handleID]->fillRegion(color, rect);
+	}
+
+	bool CTexture_Software::fill(const Texture::IDType handleID, const void* src, const uint32 stride, const bool wait)
+	{
+		return m_textures[handleID]->fill(src, stride, wait);
+	}
+
+	bool CTexture_Software::fillRegion(const Texture::IDType handleID, const void* src, const uint32 stride, const Rect& rect, const bool wait)
+	{
+		return m_textures[handleID]->fillRegion(src, stride, rect, wait);
+	}
+
+	void CTexture_Software::clearRT(const Texture::IDType handleID, const ColorF& color)
+	{
+		m_textures[handleID]->clearRT(color);
+	}
+
+	void CTexture_Software::readRT(const Texture::IDType handleID, Image& image)
+	{
+		m_textures[handleID]->readRT(image);
+	}
+
+	void CTexture_Software::readRT(Texture::IDType, Grid<float>&)
+	{
+		LOG_FAIL(U"CTexture_Software::readRT(): Grid<float> is not supported in the software renderer");
+	}
+
+	void CTexture_Software::readRT(Texture::IDType, Grid<Float2>&)
+	{
+		LOG_FAIL(U"CTexture_Software::readRT(): Grid<Float2> is not supported in the software renderer");
+	}
+
+	void CTexture_Software::readRT(Texture::IDType, Grid<Float4>&)
+	{
+		LOG_FAIL(U"CTexture_Software::readRT(): Grid<Float4> is not supported in the software renderer");
+	}
+
+	void CTexture_Software::resolveMSRT(Texture::IDType)
+	{
+		// マルチサンプルを行わないため、何もしない
+	}
+
+	const Image& CTexture_Software::getImage(const Texture::IDType handleID)
+	{
+		return m_textures[handleID]->getImage();
+	}
+
+	Image* CTexture_Software::getRenderTargetImage(const Texture::IDType handleID)
+	{
+		return m_textures[handleID]->getRenderTargetImage();
+	}
+}
@@ -0,0 +1,205 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "SoftwareTexture.hpp"
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/Texture/TextureCommon.hpp>
+
+namespace s3d
+{
+	SoftwareTexture::SoftwareTexture(const Image& image, const TextureDesc desc)
+		: m_image{ image }
+		, m_format{ detail::IsSRGB(desc) ? TextureFormat::R8G8B8A8_Unorm_SRGB : TextureFormat::R8G8B8A8_Unorm }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Default }
+		, m_initialized{ true } {}
+
+	SoftwareTexture::SoftwareTexture(Dynamic, const Size& size, const void* pData, const uint32 stride, const TextureFormat& format, const TextureDesc desc)
+		: m_format{ format }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Dynamic }
+	{
+		if (not IsSupportedFormat(format))
+		{
+			LOG_FAIL(U"TextureFormat `{}` is not supported in the software renderer"_fmt(format.name()));
+			return;
+		}
+
+		m_image.resize(size);
+
+		if (pData)
+		{
+			FillByImage(m_image.data(), size, m_image.stride(), pData, stride, format);
+		}
+
+		m_initialized = true;
+	}
+
+	SoftwareTexture::SoftwareTexture(Render, const Size& size, const TextureFormat& format, const TextureDesc desc, const HasDepth hasDepth)
+		: m_format{ format }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Render }
+		, m_hasDepth{ hasDepth.getBool() }
+	{
+		if (not IsSupportedFormat(format))
+		{
+			LOG_FAIL(U"TextureFormat `{}` is not supported in the software renderer"_fmt(format.name()));
+			return;
+		}
+
+		m_image.resize(size, Color{ 0, 0 });
+		m_initialized = true;
+	}
+
+	SoftwareTexture::SoftwareTexture(Render, const Image& image, const TextureFormat& format, const TextureDesc desc, const HasDepth hasDepth)
+		: m_image{ image }
+		, m_format{ format }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Render }
+		, m_hasDepth{ hasDepth.getBool() }
+		, m_initialized{ true } {}
+
+	SoftwareTexture::SoftwareTexture(MSRender, const Size& size, const TextureFormat& format, const TextureDesc desc, const HasDepth hasDepth)
+		: SoftwareTexture{ Render{}, size, format, desc, hasDepth }
+	{
+		m_type = TextureType::MSRender;
+	}
+
+	bool SoftwareTexture::isInitialized() const noexcept
+	{
+		return m_initialized;
+	}
+
+	Size SoftwareTexture::getSize() const noexcept
+	{
+		return m_image.size();
+	}
+
+	TextureDesc SoftwareTexture::getDesc() const noexcept
+	{
+		return m_textureDesc;
+	}
+
+	TextureFormat SoftwareTexture::getFormat() const noexcept
+	{
+		return m_format;
+	}
+
+	bool SoftwareTexture::hasDepth() const noexcept
+	{
+		return m_hasDepth;
+	}
+
+	const Image& SoftwareTexture::getImage() const noexcept
+	{
+		return m_image;
+	}
+
+	Image* SoftwareTexture::getRenderTargetImage() noexcept
+	{
+		if ((m_type != TextureType::Render)
+			&& (m_type != TextureType::MSRender))
+		{
+			return nullptr;
+		}
+
+		return &m_image;
+	}
+
+	bool SoftwareTexture::fill(const ColorF& color, bool)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		FillByColor(m_image.data(), m_image.size(), m_image.stride(), color, m_format);
+
+		return true;
+	}
+
+	bool SoftwareTexture::fillRegion(const ColorF& color, const Rect& rect)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		if ((m_image.width() < (rect.x + rect.w))
+			|| (m_image.height() < (rect.y + rect.h)))
+		{
+			return false;
+		}
+
+		FillRegionByColor(m_image.data(), m_image.size(), m_image.stride(), rect, color, m_format);
+
+		return true;
+	}
+
+	bool SoftwareTexture::fill(const void* src, const uint32 stride, bool)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		FillByImage(m_image.data(), m_image.size(), m_image.stride(), src, stride, m_format);
+
+		return true;
+	}
+
+	bool SoftwareTexture::fillRegion(const void* src, const uint32 stride, const Rect& rect, bool)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		if ((m_image.width() < (rect.x + rect.w))
+			|| (m_image.height() < (rect.y + rect.h)))
+		{
+			return false;
+		}
+
+		FillRegionByImage(m_image.data(), m_image.size(), m_image.stride(), src, stride, rect, m_format);
+
+		return true;
+	}
+
+	void SoftwareTexture::clearRT(const ColorF& color)
+	{
+		if ((m_type != TextureType::Render)
+			&& (m_type != TextureType::MSRender))
+		{
+			return;
+		}
+
+		m_image.fill(color.toColor());
+	}
+
+	void SoftwareTexture::readRT(Image& image)
+	{
+		if ((m_type != TextureType::Render)
+			&& (m_type != TextureType::MSRender))
+		{
+			return;
+		}
+
+		image = m_image;
+	}
+
+	bool SoftwareTexture::IsSupportedFormat(const TextureFormat& format) noexcept
+	{
+		return ((format == TextureFormat::R8G8B8A8_Unorm)
+			|| (format == TextureFormat::R8G8B8A8_Unorm_SRGB));
+	}
+}
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/TextureAssetData.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 
 namespace s3d
 {
@@ -45,6 +46,8 @@ namespace s3d
 
 	bool TextureAssetData::load(const String& hint)
 	{
+		SIV3D_TRACE_ZONE(U"TextureAsset::load");
+
 		if (isUninitialized())
 		{
 			if (onLoad(*this, hint))
@@ -75,6 +78,8 @@ namespace s3d
 
 			m_task = Async([this, hint = hint]()
 				{
+					SIV3D_TRACE_ZONE(U"TextureAsset::loadAsync");
+
 					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
 				});
 		}
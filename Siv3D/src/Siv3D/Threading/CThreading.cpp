@@ -0,0 +1,219 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cassert>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "CThreading.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline constexpr size_t NotWorker = static_cast<size_t>(-1);
+
+		static thread_local const CThreading* tl_owner = nullptr;
+
+		static thread_local size_t tl_workerIndex = NotWorker;
+
+		static void Execute(ISiv3DThreading::Task& task) noexcept
+		{
+			try
+			{
+				task();
+			}
+			catch (...)
+			{
+				LOG_FAIL(U"❌ Threading: An uncaught exception was thrown in a task");
+			}
+		}
+	}
+
+	CThreading::CThreading() {}
+
+	CThreading::~CThreading()
+	{
+		LOG_SCOPED_TRACE(U"CThreading::~CThreading()");
+
+		{
+			std::lock_guard lock{ m_sleepMutex };
+			m_abort = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	void CThreading::init()
+	{
+		LOG_SCOPED_TRACE(U"CThreading::init()");
+
+	# if SIV3D_PLATFORM(WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+		LOG_INFO(U"ℹ️ Threading: Task scheduler is disabled because threads are not supported");
+
+	# else
+
+		// 呼び出し元のスレッドも ParallelFor に参加するため、1 つ少なく作成する
+		const size_t numWorkers = Max<size_t>(1, (Threading::GetConcurrency() - 1));
+
+		for (size_t i = 0; i < numWorkers; ++i)
+		{
+			m_workQueues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		for (size_t i = 0; i < numWorkers; ++i)
+		{
+			m_workers.emplace_back(&CThreading::run, this, i);
+		}
+
+		LOG_INFO(U"ℹ️ Threading: Task scheduler started with {} worker threads"_fmt(numWorkers));
+
+	# endif
+	}
+
+	size_t CThreading::getWorkerCount() const noexcept
+	{
+		return m_workers.size();
+	}
+
+	bool CThreading::isWorkerThread() const noexcept
+	{
+		return (detail::tl_owner == this);
+	}
+
+	void CThreading::submit(Task task)
+	{
+		assert(not m_workers.isEmpty());
+
+		++m_pendingCount;
+
+		// ワーカースレッドからの投入は自身のキューへ、それ以外はグローバルキューへ
+		WorkQueue& queue = isWorkerThread() ? *m_workQueues[detail::tl_workerIndex] : m_globalQueue;
+		{
+			std::lock_guard lock{ queue.mutex };
+			queue.tasks.push_back(std::move(task));
+		}
+
+		if (m_sleepingCount)
+		{
+			{
+				std::lock_guard lock{ m_sleepMutex };
+			}
+
+			m_sleepCondition.notify_one();
+		}
+	}
+
+	bool CThreading::runPendingTask()
+	{
+		Task task;
+
+		if (not popTask((isWorkerThread() ? detail::tl_workerIndex : detail::NotWorker), task))
+		{
+			return false;
+		}
+
+		detail::Execute(task);
+
+		return true;
+	}
+
+	void CThreading::run(const size_t workerIndex)
+	{
+		detail::tl_owner = this;
+		detail::tl_workerIndex = workerIndex;
+
+		for (;;)
+		{
+			Task task;
+
+			if (popTask(workerIndex, task))
+			{
+				detail::Execute(task);
+				continue;
+			}
+
+			std::unique_lock lock{ m_sleepMutex };
+
+			++m_sleepingCount;
+
+			m_sleepCondition.wait(lock, [this]() { return ((0 < m_pendingCount) || m_abort); });
+
+			--m_sleepingCount;
+
+			// 終了時は、投入済みのタスクをすべて処理してから抜ける
+			if (m_abort && (m_pendingCount == 0))
+			{
+				return;
+			}
+		}
+	}
+
+	bool CThreading::popTask(const size_t workerIndex, Task& task)
+	{
+		const auto tryPopBack = [&](WorkQueue& queue)
+		{
+			std::lock_guard lock{ queue.mutex };
+
+			if (queue.tasks.empty())
+			{
+				return false;
+			}
+
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			return true;
+		};
+
+		const auto tryPopFront = [&](WorkQueue& queue)
+		{
+			std::lock_guard lock{ queue.mutex };
+
+			if (queue.tasks.empty())
+			{
+				return false;
+			}
+
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			return true;
+		};
+
+		const size_t numQueues = m_workQueues.size();
+
+		bool found = ((workerIndex != detail::NotWorker) && tryPopBack(*m_workQueues[workerIndex]))
+			|| tryPopFront(m_globalQueue);
+
+		// 他のワーカースレッドのキューから盗む
+		for (size_t i = 1; ((not found) && (i <= numQueues)); ++i)
+		{
+			const size_t victim = (((workerIndex == detail::NotWorker) ? 0 : workerIndex) + i) % numQueues;
+
+			if (victim != workerIndex)
+			{
+				found = tryPopFront(*m_workQueues[victim]);
+			}
+		}
+
+		if (found)
+		{
+			--m_pendingCount;
+		}
+
+		return found;
+	}
+}
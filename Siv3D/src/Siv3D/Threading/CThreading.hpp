@@ -0,0 +1,73 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <deque>
+# include <mutex>
+# include <thread>
+# include <condition_variable>
+# include <Siv3D/Array.hpp>
+# include "IThreading.hpp"
+
+namespace s3d
+{
+	class CThreading final : public ISiv3DThreading
+	{
+	public:
+
+		CThreading();
+
+		~CThreading() override;
+
+		void init() override;
+
+		size_t getWorkerCount() const noexcept override;
+
+		bool isWorkerThread() const noexcept override;
+
+		void submit(Task task) override;
+
+		bool runPendingTask() override;
+
+	private:
+
+		// ワーカースレッドごとのタスクキュー
+		// 所有するワーカーは末尾から取り出し (LIFO)、他のワーカーは先頭から盗む (FIFO)
+		struct WorkQueue
+		{
+			std::mutex mutex;
+
+			std::deque<Task> tasks;
+		};
+
+		Array<std::unique_ptr<WorkQueue>> m_workQueues;
+
+		// ワーカースレッド以外から投入されたタスクのキュー
+		WorkQueue m_globalQueue;
+
+		Array<std::thread> m_workers;
+
+		std::mutex m_sleepMutex;
+
+		std::condition_variable m_sleepCondition;
+
+		std::atomic<size_t> m_pendingCount = 0;
+
+		std::atomic<size_t> m_sleepingCount = 0;
+
+		std::atomic<bool> m_abort = false;
+
+		void run(size_t workerIndex);
+
+		bool popTask(size_t workerIndex, Task& task);
+	};
+}
@@ -0,0 +1,40 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <functional>
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	class SIV3D_NOVTABLE ISiv3DThreading
+	{
+	public:
+
+		using Task = std::function<void()>;
+
+		static ISiv3DThreading* Create();
+
+		virtual ~ISiv3DThreading() = default;
+
+		virtual void init() = 0;
+
+		[[nodiscard]]
+		virtual size_t getWorkerCount() const noexcept = 0;
+
+		[[nodiscard]]
+		virtual bool isWorkerThread() const noexcept = 0;
+
+		virtual void submit(Task task) = 0;
+
+		virtual bool runPendingTask() = 0;
+	};
+}
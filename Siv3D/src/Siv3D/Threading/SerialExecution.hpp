@@ -0,0 +1,39 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	namespace Threading
+	{
+		/// @brief 現在のスレッドで ParallelFor() が逐次処理に切り替えられているかを返します。
+		/// @return 逐次処理に切り替えられている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsSerialExecution() noexcept;
+
+		/// @brief オブジェクトが存在する間、現在のスレッドから呼ばれた ParallelFor() を現在のスレッドだけで逐次処理します。
+		/// @remark 並列処理と逐次処理の結果を比較するテスト用です。公開ヘッダには含まれません。
+		class ScopedSerialExecution
+		{
+		public:
+
+			ScopedSerialExecution() noexcept;
+
+			~ScopedSerialExecution();
+
+			ScopedSerialExecution(const ScopedSerialExecution&) = delete;
+
+			ScopedSerialExecution& operator =(const ScopedSerialExecution&) = delete;
+		};
+	}
+}
@@ -9,12 +9,93 @@
 //
 //-----------------------------------------------
 
+# include <atomic>
+# include <mutex>
 # include <thread>
+# include <exception>
+# include <condition_variable>
 # include <Siv3D/Threading.hpp>
 # include <Siv3D/Utility.hpp>
+# include <Siv3D/Threading/IThreading.hpp>
+# include <Siv3D/Threading/SerialExecution.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		[[nodiscard]]
+		static ISiv3DThreading* GetScheduler() noexcept
+		{
+			if (not Siv3DEngine::isActive())
+			{
+				return nullptr;
+			}
+
+			return SIV3D_ENGINE(Threading);
+		}
+
+		// ScopedSerialExecution のネストの深さ
+		static thread_local size_t SerialExecutionDepth = 0;
+
+		struct ParallelForState
+		{
+			const std::function<void(size_t, size_t)>* pFunction = nullptr;
+
+			size_t count = 0;
+
+			size_t numChunks = 0;
+
+			std::atomic<size_t> nextChunk = 0;
+
+			std::atomic<size_t> finishedChunks = 0;
+
+			std::mutex mutex;
+
+			std::condition_variable condition;
+
+			std::exception_ptr exception;
+
+			// 残っているチャンクがなくなるまで処理する
+			void process()
+			{
+				for (;;)
+				{
+					const size_t chunkIndex = nextChunk++;
+
+					// ParallelFor() から戻った後に実行されたタスクは、pFunction に触れずにここで抜ける
+					if (numChunks <= chunkIndex)
+					{
+						return;
+					}
+
+					try
+					{
+						(*pFunction)((count * chunkIndex / numChunks), (count * (chunkIndex + 1) / numChunks));
+					}
+					catch (...)
+					{
+						std::lock_guard lock{ mutex };
+
+						if (not exception)
+						{
+							exception = std::current_exception();
+						}
+					}
+
+					if ((++finishedChunks) == numChunks)
+					{
+						{
+							std::lock_guard lock{ mutex };
+						}
+
+						condition.notify_all();
+					}
+				}
+			}
+		};
+	}
+
 	namespace Threading
 	{
 		size_t GetConcurrency() noexcept
@@ -22,5 +103,114 @@ namespace s3d
 			static const size_t n = Max<size_t>(1, std::thread::hardware_concurrency());
 			return n;
 		}
+
+		size_t GetWorkerCount() noexcept
+		{
+			if (const auto pScheduler = detail::GetScheduler())
+			{
+				return pScheduler->getWorkerCount();
+			}
+
+			return 0;
+		}
+
+		bool IsWorkerThread() noexcept
+		{
+			if (const auto pScheduler = detail::GetScheduler())
+			{
+				return pScheduler->isWorkerThread();
+			}
+
+			return false;
+		}
+
+		void Submit(std::function<void()> task)
+		{
+			if (const auto pScheduler = detail::GetScheduler();
+				pScheduler && pScheduler->getWorkerCount())
+			{
+				pScheduler->submit(std::move(task));
+				return;
+			}
+
+		# if SIV3D_PLATFORM(WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+			task();
+
+		# else
+
+			std::thread{ std::move(task) }.detach();
+
+		# endif
+		}
+
+		bool RunPendingTask()
+		{
+			if (const auto pScheduler = detail::GetScheduler())
+			{
+				return pScheduler->runPendingTask();
+			}
+
+			return false;
+		}
+
+		void ParallelFor(const size_t count, const std::function<void(size_t, size_t)>& f, const size_t minChunkSize)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			const size_t numWorkers = GetWorkerCount();
+
+			// 負荷の偏りを work stealing で吸収できるよう、スレッド数より多めに分割する
+			const size_t numChunks = Clamp<size_t>((count / Max<size_t>(1, minChunkSize)), 1, ((numWorkers + 1) * 4));
+
+			if ((numWorkers == 0) || (numChunks == 1) || IsSerialExecution())
+			{
+				f(0, count);
+				return;
+			}
+
+			auto state = std::make_shared<detail::ParallelForState>();
+			state->pFunction = &f;
+			state->count = count;
+			state->numChunks = numChunks;
+
+			const size_t numTasks = Min((numChunks - 1), numWorkers);
+
+			for (size_t i = 0; i < numTasks; ++i)
+			{
+				Submit([state]() { state->process(); });
+			}
+
+			state->process();
+
+			{
+				std::unique_lock lock{ state->mutex };
+
+				state->condition.wait(lock, [&]() { return (state->finishedChunks == numChunks); });
+			}
+
+			if (state->exception)
+			{
+				std::rethrow_exception(state->exception);
+			}
+		}
+
+		bool IsSerialExecution() noexcept
+		{
+			return (detail::SerialExecutionDepth != 0);
+		}
+
+		ScopedSerialExecution::ScopedSerialExecution() noexcept
+		{
+			++detail::SerialExecutionDepth;
+		}
+
+		ScopedSerialExecution::~ScopedSerialExecution()
+		{
+			--detail::SerialExecutionDepth;
+		}
 	}
 }
@@ -0,0 +1,20 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "CThreading.hpp"
+
+namespace s3d
+{
+	ISiv3DThreading* ISiv3DThreading::Create()
+	{
+		return new CThreading;
+	}
+}
@@ -0,0 +1,516 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <mutex>
+# include <Siv3D/TraceRecorder.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/EngineLog.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		enum class TraceEventType : uint8
+		{
+			Zone,
+
+			AsyncBegin,
+
+			AsyncEnd,
+		};
+
+		struct TraceEvent
+		{
+			StringView name;
+
+			// Zone の場合は開始時刻、非同期イベントの場合はイベントの時刻
+			uint64 time;
+
+			// Zone の場合は終了時刻、非同期イベントの場合は ID
+			uint64 value;
+
+			TraceEventType type;
+		};
+
+		// 1 つのスレッドが書き込み、保存時に他のスレッドから読み出されるバッファ
+		class TraceBuffer
+		{
+		public:
+
+			static constexpr size_t ChunkSize = 4096;
+
+			static constexpr size_t MaxChunks = 256;
+
+			explicit TraceBuffer(const uint32 threadIndex)
+				: m_threadIndex{ threadIndex } {}
+
+			~TraceBuffer()
+			{
+				for (auto& chunk : m_chunks)
+				{
+					delete[] chunk.load(std::memory_order_relaxed);
+				}
+			}
+
+			// 所有スレッドからのみ呼ばれる
+			void push(const TraceEvent& event, const uint32 generation)
+			{
+				// 記録が開始し直された後の最初の書き込みで、以前のイベントを破棄する
+				if (m_generation.load(std::memory_order_relaxed) != generation)
+				{
+					m_size.store(0, std::memory_order_relaxed);
+					m_generation.store(generation, std::memory_order_release);
+				}
+
+				const size_t index = m_size.load(std::memory_order_relaxed);
+				const size_t chunkIndex = (index / ChunkSize);
+
+				if (MaxChunks <= chunkIndex)
+				{
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				TraceEvent* chunk = m_chunks[chunkIndex].load(std::memory_order_relaxed);
+
+				if (not chunk)
+				{
+					chunk = new TraceEvent[ChunkSize];
+					m_chunks[chunkIndex].store(chunk, std::memory_order_release);
+				}
+
+				chunk[index % ChunkSize] = event;
+
+				m_size.store((index + 1), std::memory_order_release);
+			}
+
+			[[nodiscard]]
+			size_t size(const uint32 generation) const noexcept
+			{
+				if (m_generation.load(std::memory_order_acquire) != generation)
+				{
+					return 0;
+				}
+
+				return m_size.load(std::memory_order_acquire);
+			}
+
+			[[nodiscard]]
+			const TraceEvent& operator [](const size_t index) const noexcept
+			{
+				return m_chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+			}
+
+			[[nodiscard]]
+			size_t takeDropped() noexcept
+			{
+				return m_dropped.exchange(0, std::memory_order_relaxed);
+			}
+
+			[[nodiscard]]
+			uint32 threadIndex() const noexcept
+			{
+				return m_threadIndex;
+			}
+
+			// 所有スレッドの終了時に呼ばれる
+			void release() noexcept
+			{
+				m_released.store(true, std::memory_order_release);
+			}
+
+			[[nodiscard]]
+			bool isReleased() const noexcept
+			{
+				return m_released.load(std::memory_order_acquire);
+			}
+
+			// m_threadName は TraceRecorderState::mutex で保護する
+			String m_threadName;
+
+		private:
+
+			std::array<std::atomic<TraceEvent*>, MaxChunks> m_chunks{};
+
+			std::atomic<size_t> m_size = 0;
+
+			std::atomic<uint32> m_generation = 0;
+
+			std::atomic<size_t> m_dropped = 0;
+
+			std::atomic<bool> m_released = false;
+
+			uint32 m_threadIndex = 0;
+		};
+
+		struct TraceRecorderState
+		{
+			std::atomic<bool> recording = false;
+
+			// 記録を開始するたびに増える
+			std::atomic<uint32> generation = 0;
+
+			// 記録を開始した時刻
+			std::atomic<uint64> startTick = 0;
+
+			uint64 startNanosec = 0;
+
+			// 記録を終了した時刻（記録中は 0）
+			uint64 stopTick = 0;
+
+			uint64 stopNanosec = 0;
+
+			// バッファの登録と保存、スレッド名の変更を保護する
+			std::mutex mutex;
+
+			// 終了したスレッドのバッファは、保存されていないイベントが無くなるまで保持する
+			Array<std::unique_ptr<TraceBuffer>> buffers;
+
+			uint32 nextThreadIndex = 1;
+		};
+
+		// 終了したスレッドのバッファのうち、現在の記録のイベントを持たないものを解放する（mutex をロックして呼ぶ）
+		static void FreeReleasedTraceBuffers(TraceRecorderState& state)
+		{
+			const uint32 generation = state.generation.load(std::memory_order_acquire);
+
+			state.buffers.remove_if([=](const std::unique_ptr<TraceBuffer>& buffer)
+				{
+					return (buffer->isReleased() && (buffer->size(generation) == 0));
+				});
+		}
+
+		// スレッドの終了時にバッファを解放可能にする
+		class TraceBufferOwner
+		{
+		public:
+
+			TraceBufferOwner() = default;
+
+			TraceBufferOwner(const TraceBufferOwner&) = delete;
+
+			TraceBufferOwner& operator =(const TraceBufferOwner&) = delete;
+
+			~TraceBufferOwner()
+			{
+				if (buffer)
+				{
+					buffer->release();
+				}
+			}
+
+			TraceBuffer* buffer = nullptr;
+		};
+
+		[[nodiscard]]
+		static TraceRecorderState& GetTraceRecorderState()
+		{
+			static TraceRecorderState state;
+			return state;
+		}
+
+		[[nodiscard]]
+		static TraceBuffer& GetThreadTraceBuffer()
+		{
+			thread_local TraceBufferOwner owner;
+
+			if (not owner.buffer)
+			{
+				auto& state = GetTraceRecorderState();
+
+				std::lock_guard lock{ state.mutex };
+
+				state.buffers.push_back(std::make_unique<TraceBuffer>(state.nextThreadIndex++));
+
+				owner.buffer = state.buffers.back().get();
+			}
+
+			return *owner.buffer;
+		}
+
+		static void PushTraceEvent(const TraceEvent& event)
+		{
+			const auto& state = GetTraceRecorderState();
+
+			// 記録を開始する前に始まったゾーンは記録しない
+			if (event.time < state.startTick.load(std::memory_order_acquire))
+			{
+				return;
+			}
+
+			GetThreadTraceBuffer().push(event, state.generation.load(std::memory_order_acquire));
+		}
+
+		static void AppendEscaped(std::string& out, const StringView s)
+		{
+			for (const char ch : Unicode::ToUTF8(s))
+			{
+				if ((ch == '"') || (ch == '\\'))
+				{
+					out.push_back('\\');
+					out.push_back(ch);
+				}
+				else if (static_cast<uint8>(ch) < 0x20)
+				{
+					constexpr char Hex[] = "0123456789abcdef";
+					out.append("\\u00");
+					out.push_back(Hex[static_cast<uint8>(ch) >> 4]);
+					out.push_back(Hex[static_cast<uint8>(ch) & 0xF]);
+				}
+				else
+				{
+					out.push_back(ch);
+				}
+			}
+		}
+
+		// ナノ秒を、小数点以下 3 桁のマイクロ秒として書き出す
+		static void AppendMicrosec(std::string& out, const uint64 ns)
+		{
+			out.append(std::to_string(ns / 1000));
+			out.push_back('.');
+
+			const uint32 fraction = static_cast<uint32>(ns % 1000);
+			out.push_back(static_cast<char>('0' + (fraction / 100)));
+			out.push_back(static_cast<char>('0' + (fraction / 10 % 10)));
+			out.push_back(static_cast<char>('0' + (fraction % 10)));
+		}
+
+		bool IsTraceRecording() noexcept
+		{
+			return GetTraceRecorderState().recording.load(std::memory_order_relaxed);
+		}
+
+		void RecordTraceZone(const StringView name, const uint64 begin, const uint64 end)
+		{
+			PushTraceEvent({ name, begin, end, TraceEventType::Zone });
+		}
+	}
+
+	namespace TraceRecorder
+	{
+		void Start()
+		{
+			auto& state = detail::GetTraceRecorderState();
+
+			std::lock_guard lock{ state.mutex };
+
+			state.recording.store(false, std::memory_order_relaxed);
+
+			state.startNanosec = Time::GetNanosec();
+			state.startTick.store(Platform::Rdtsc(), std::memory_order_release);
+			state.stopTick = state.stopNanosec = 0;
+
+			state.generation.fetch_add(1, std::memory_order_release);
+
+			// 以前の記録のイベントは破棄されるため、終了したスレッドのバッファはすべて解放できる
+			detail::FreeReleasedTraceBuffers(state);
+
+			for (auto& buffer : state.buffers)
+			{
+				(void)buffer->takeDropped();
+			}
+
+			state.recording.store(true, std::memory_order_release);
+		}
+
+		void Stop()
+		{
+			auto& state = detail::GetTraceRecorderState();
+
+			std::lock_guard lock{ state.mutex };
+
+			if (not state.recording.exchange(false, std::memory_order_acq_rel))
+			{
+				return;
+			}
+
+			state.stopTick = Platform::Rdtsc();
+			state.stopNanosec = Time::GetNanosec();
+		}
+
+		bool IsRecording() noexcept
+		{
+			return detail::IsTraceRecording();
+		}
+
+		void SetThreadName(const StringView name)
+		{
+			auto& buffer = detail::GetThreadTraceBuffer();
+
+			std::lock_guard lock{ detail::GetTraceRecorderState().mutex };
+
+			buffer.m_threadName = name;
+		}
+
+		void BeginAsync(const StringView name, const uint64 id)
+		{
+			if (detail::IsTraceRecording())
+			{
+				detail::PushTraceEvent({ name, Platform::Rdtsc(), id, detail::TraceEventType::AsyncBegin });
+			}
+		}
+
+		void EndAsync(const StringView name, const uint64 id)
+		{
+			if (detail::IsTraceRecording())
+			{
+				detail::PushTraceEvent({ name, Platform::Rdtsc(), id, detail::TraceEventType::AsyncEnd });
+			}
+		}
+
+		size_t GetEventCount()
+		{
+			auto& state = detail::GetTraceRecorderState();
+
+			std::lock_guard lock{ state.mutex };
+
+			const uint32 generation = state.generation.load(std::memory_order_acquire);
+
+			size_t count = 0;
+
+			for (const auto& buffer : state.buffers)
+			{
+				count += buffer->size(generation);
+			}
+
+			return count;
+		}
+
+		bool Save(const FilePathView path)
+		{
+			auto& state = detail::GetTraceRecorderState();
+
+			std::lock_guard lock{ state.mutex };
+
+			detail::FreeReleasedTraceBuffers(state);
+
+			const uint64 startTick = state.startTick.load(std::memory_order_acquire);
+			uint64 stopTick = state.stopTick;
+			uint64 stopNanosec = state.stopNanosec;
+
+			if (stopTick == 0)
+			{
+				stopTick = Platform::Rdtsc();
+				stopNanosec = Time::GetNanosec();
+			}
+
+			// RDTSC のカウントを、記録中の経過時間（ナノ秒）と比べて換算する
+			const double nanosecPerTick = ((startTick < stopTick) ? (static_cast<double>(stopNanosec - state.startNanosec) / (stopTick - startTick)) : 1.0);
+
+			const auto toNanosec = [=](const uint64 tick)
+			{
+				return static_cast<uint64>((tick - startTick) * nanosecPerTick);
+			};
+
+			const uint32 generation = state.generation.load(std::memory_order_acquire);
+
+			std::string json = R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+			bool first = true;
+
+			const auto beginEvent = [&](const StringView name, const char* phase, const uint32 tid)
+			{
+				if (not first)
+				{
+					json.push_back(',');
+				}
+
+				first = false;
+
+				json.append(R"({"name":")");
+				detail::AppendEscaped(json, name);
+				json.append(R"(","ph":")");
+				json.append(phase);
+				json.append(R"(","pid":1,"tid":)");
+				json.append(std::to_string(tid));
+			};
+
+			size_t dropped = 0;
+
+			for (const auto& buffer : state.buffers)
+			{
+				const uint32 tid = buffer->threadIndex();
+				const size_t size = buffer->size(generation);
+
+				if (size == 0)
+				{
+					continue;
+				}
+
+				dropped += buffer->takeDropped();
+
+				if (buffer->m_threadName)
+				{
+					beginEvent(U"thread_name", "M", tid);
+					json.append(R"(,"args":{"name":")");
+					detail::AppendEscaped(json, buffer->m_threadName);
+					json.append(R"("}})");
+				}
+
+				for (size_t i = 0; i < size; ++i)
+				{
+					const detail::TraceEvent& event = (*buffer)[i];
+
+					switch (event.type)
+					{
+					case detail::TraceEventType::Zone:
+						beginEvent(event.name, "X", tid);
+						json.append(R"(,"ts":)");
+						detail::AppendMicrosec(json, toNanosec(event.time));
+						json.append(R"(,"dur":)");
+						detail::AppendMicrosec(json, static_cast<uint64>((event.value - event.time) * nanosecPerTick));
+						json.push_back('}');
+						break;
+					case detail::TraceEventType::AsyncBegin:
+					case detail::TraceEventType::AsyncEnd:
+						beginEvent(event.name, ((event.type == detail::TraceEventType::AsyncBegin) ? "b" : "e"), tid);
+						json.append(R"(,"cat":"async","id":)");
+						json.append(std::to_string(event.value));
+						json.append(R"(,"ts":)");
+						detail::AppendMicrosec(json, toNanosec(event.time));
+						json.push_back('}');
+						break;
+					}
+				}
+			}
+
+			json.append("]}\n");
+
+			if (dropped)
+			{
+				LOG_WARNING(U"TraceRecorder::Save(): {} events were dropped because the trace buffer was full"_fmt(dropped));
+			}
+
+			BinaryWriter writer{ path };
+
+			if (not writer)
+			{
+				LOG_FAIL(U"TraceRecorder::Save(): Failed to open `{}`"_fmt(path));
+				return false;
+			}
+
+			const int64 jsonSize = static_cast<int64>(json.size());
+
+			if (writer.write(json.data(), jsonSize) != jsonSize)
+			{
+				LOG_FAIL(U"TraceRecorder::Save(): Failed to write `{}`"_fmt(path));
+				return false;
+			}
+
+			return true;
+		}
+	}
+}
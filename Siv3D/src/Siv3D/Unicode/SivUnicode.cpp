@@ -13,6 +13,7 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Unicode.hpp>
 # include "UnicodeUtility.hpp"
+# include "UnicodeSIMD.hpp"
 
 namespace s3d
 {
@@ -25,6 +26,15 @@ namespace s3d
 
 		String FromUTF8(const std::string_view s)
 		{
+			if (size_t utf32Length = 0, utf16Length = 0;
+				detail::ValidateUTF8(s.data(), s.size(), utf32Length, utf16Length))
+			{
+				String result(utf32Length, '0');
+				detail::UTF8_DecodeValid(&result[0], s);
+				return result;
+			}
+
+			// 不正なバイト列を含む場合は、1 文字ずつ U+FFFD に置き換えながら変換する
 			String result(detail::UTF32_Length(s), '0');
 
 			const char8* pSrc = s.data();
@@ -45,16 +55,7 @@ namespace s3d
 		{
 			String result(detail::UTF32_Length(s), '0');
 
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
-			}
+			detail::UTF16_Decode(&result[0], s);
 
 			return result;
 		}
@@ -84,14 +85,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF8_Encode(&result[0], s);
 
 			return result;
 		}
@@ -100,14 +94,7 @@ namespace s3d
 		{
 			std::u16string result(detail::UTF16_Length(s), u'0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char16* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF16_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF16_Encode(&result[0], s);
 
 			return result;
 		}
@@ -119,6 +106,14 @@ namespace s3d
 
 		std::u16string UTF8ToUTF16(const std::string_view s)
 		{
+			if (size_t utf32Length = 0, utf16Length = 0;
+				detail::ValidateUTF8(s.data(), s.size(), utf32Length, utf16Length))
+			{
+				std::u16string result(utf16Length, u'0');
+				detail::UTF8_DecodeValid(&result[0], s);
+				return result;
+			}
+
 			std::u16string result(detail::UTF16_Length(s), '0');
 
 			const char8* pSrc = s.data();
@@ -139,6 +134,14 @@ namespace s3d
 
 		std::u32string UTF8ToUTF32(const std::string_view s)
 		{
+			if (size_t utf32Length = 0, utf16Length = 0;
+				detail::ValidateUTF8(s.data(), s.size(), utf32Length, utf16Length))
+			{
+				std::u32string result(utf32Length, U'0');
+				detail::UTF8_DecodeValid(&result[0], s);
+				return result;
+			}
+
 			std::u32string result(detail::UTF32_Length(s), '0');
 
 			const char8* pSrc = s.data();
@@ -161,18 +164,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				detail::UTF8_Encode(&pDst, detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset));
-
-				pSrc += offset;
-			}
+			detail::UTF8_Encode(&result[0], s);
 
 			return result;
 		}
@@ -181,18 +173,7 @@ namespace s3d
 		{
 			std::u32string result(detail::UTF32_Length(s), '0');
 
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-			}
+			detail::UTF16_Decode(&result[0], s);
 
 			return result;
 		}
@@ -201,14 +182,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF8_Encode(&result[0], s);
 
 			return result;
 		}
@@ -217,14 +191,7 @@ namespace s3d
 		{
 			std::u16string result(detail::UTF16_Length(s), u'0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char16* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF16_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF16_Encode(&result[0], s);
 
 			return result;
 		}
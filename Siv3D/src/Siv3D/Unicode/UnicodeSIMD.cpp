@@ -0,0 +1,771 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <cstring>
+# include <Siv3D/CPUInfo.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <ThirdParty/miniutf/miniutf.hpp>
+# include "UnicodeSIMD.hpp"
+
+# if SIV3D_INTRINSIC(SSE) && (defined(_M_X64) || defined(__x86_64__)) && !SIV3D_PLATFORM(WEB)
+
+	# include <immintrin.h>
+
+	# define SIV3D_UNICODE_AVX2 1
+
+	# if defined(_MSC_VER) && !defined(__clang__)
+		# define SIV3D_TARGET_AVX2
+	# else
+		# define SIV3D_TARGET_AVX2 __attribute__((target("avx2")))
+	# endif
+
+# else
+
+	# define SIV3D_UNICODE_AVX2 0
+
+# endif
+
+namespace s3d
+{
+	namespace detail
+	{
+		////////////////////////////////////////////////////////////////
+		//
+		//	Reference
+		//
+		////////////////////////////////////////////////////////////////
+
+		[[nodiscard]]
+		static bool ValidateUTF8_Reference(const char8* s, const size_t size, size_t& utf32Length, size_t& utf16Length) noexcept
+		{
+			const char8* pSrc = s;
+			const char8* const pSrcEnd = (s + size);
+			size_t length32 = 0;
+			size_t length16 = 0;
+
+			while (pSrc != pSrcEnd)
+			{
+				if (static_cast<uint8>(*pSrc) < 0x80)
+				{
+					++pSrc;
+					++length32;
+					++length16;
+					continue;
+				}
+
+				const offset_pt result = utf8_decode_check(pSrc, (pSrcEnd - pSrc));
+
+				if ((result.offset < 0)
+					|| ((0xD800 <= result.codePoint) && (result.codePoint < 0xE000)))
+				{
+					return false;
+				}
+
+				pSrc += result.offset;
+				++length32;
+				length16 += ((result.codePoint < 0x10000) ? 1 : 2);
+			}
+
+			utf32Length = length32;
+			utf16Length = length16;
+			return true;
+		}
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	SSE4.1
+		//
+		////////////////////////////////////////////////////////////////
+
+		namespace utf8
+		{
+			// 連続する 2 バイトの組み合わせから不正なパターンを検出するためのフラグ
+			// (John Keiser, Daniel Lemire: "Validating UTF-8 In Less Than One Instruction Per Byte")
+			inline constexpr uint8 TooShort		= (1 << 0);	// 11______ 0_______ / 11______ 11______
+			inline constexpr uint8 TooLong		= (1 << 1);	// 0_______ 10______
+			inline constexpr uint8 Overlong3	= (1 << 2);	// 11100000 100_____
+			inline constexpr uint8 TooLarge		= (1 << 3);	// 11110100 1001____ / 11110100 101_____ / 11110101+ ________
+			inline constexpr uint8 Surrogate	= (1 << 4);	// 11101101 101_____
+			inline constexpr uint8 Overlong2	= (1 << 5);	// 1100000_ 10______
+			inline constexpr uint8 TooLarge1000	= (1 << 6);	// 11110101+ 1000____
+			inline constexpr uint8 Overlong4	= (1 << 6);	// 11110000 1000____
+			inline constexpr uint8 TwoConts		= (1 << 7);	// 10______ 10______
+			inline constexpr uint8 Carry		= (TooShort | TooLong | TwoConts);
+
+			// 1 バイト目の上位 4 ビット
+			inline constexpr uint8 Byte1High[16] =
+			{
+				TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+				TwoConts, TwoConts, TwoConts, TwoConts,
+				(TooShort | Overlong2),
+				TooShort,
+				(TooShort | Overlong3 | Surrogate),
+				(TooShort | TooLarge | TooLarge1000 | Overlong4),
+			};
+
+			// 1 バイト目の下位 4 ビット
+			inline constexpr uint8 Byte1Low[16] =
+			{
+				(Carry | Overlong3 | Overlong2 | Overlong4),
+				(Carry | Overlong2),
+				Carry,
+				Carry,
+				(Carry | TooLarge),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000 | Surrogate),
+				(Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000),
+			};
+
+			// 2 バイト目の上位 4 ビット
+			inline constexpr uint8 Byte2High[16] =
+			{
+				TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+				(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4),
+				(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge),
+				(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+				(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+				TooShort, TooShort, TooShort, TooShort,
+			};
+
+			// ブロックの末尾 3 バイトが、次のブロックに続く符号単位の途中であるかを調べるための値
+			inline constexpr uint8 MaxValue[32] =
+			{
+				0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+				0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, (0xF0 - 1), (0xE0 - 1), (0xC0 - 1),
+			};
+		}
+
+		[[nodiscard]]
+		inline __m128i CheckUTF8Block_SSE4_1(const __m128i input, const __m128i prevInput) noexcept
+		{
+			const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+			const __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+			const __m128i byte1High = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::Byte1High)), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibbleMask));
+			const __m128i byte1Low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::Byte1Low)), _mm_and_si128(prev1, nibbleMask));
+			const __m128i byte2High = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::Byte2High)), _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask));
+			const __m128i specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+			// 3 バイト目と 4 バイト目は、継続バイトが 2 つ続く (TwoConts) 必要がある
+			const __m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+			const __m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+			const __m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			const __m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			const __m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(static_cast<char>(0x80)));
+
+			return _mm_xor_si128(must23, specialCases);
+		}
+
+		[[nodiscard]]
+		static bool ValidateUTF8_SSE4_1(const char8* s, const size_t size, size_t& utf32Length, size_t& utf16Length) noexcept
+		{
+			const __m128i maxValue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::MaxValue + 16));
+			const __m128i notContinuation = _mm_set1_epi8(-65); // 0xBF より大きい、または ASCII
+			const __m128i fourByteLead = _mm_set1_epi8(-17); // 0xEF より大きい
+
+			__m128i error = _mm_setzero_si128();
+			__m128i prevInput = _mm_setzero_si128();
+			__m128i prevIncomplete = _mm_setzero_si128();
+			size_t length32 = 0;
+			size_t length16 = 0;
+
+			auto process = [&](const __m128i input)
+			{
+				const uint32 highBits = static_cast<uint32>(_mm_movemask_epi8(input));
+				const uint32 chars = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(input, notContinuation)));
+				const uint32 fourByteLeads = (highBits & static_cast<uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(input, fourByteLead))));
+				length32 += std::popcount(chars);
+				length16 += (std::popcount(chars) + std::popcount(fourByteLeads));
+
+				if (highBits == 0)
+				{
+					error = _mm_or_si128(error, prevIncomplete);
+				}
+				else
+				{
+					error = _mm_or_si128(error, CheckUTF8Block_SSE4_1(input, prevInput));
+					prevIncomplete = _mm_subs_epu8(input, maxValue);
+				}
+
+				prevInput = input;
+			};
+
+			size_t i = 0;
+
+			for (; (i + 16) <= size; i += 16)
+			{
+				process(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+			}
+
+			if (i < size)
+			{
+				// 末尾の端数は 0 で埋めて処理し、埋めた分の文字数を差し引く
+				alignas(16) char8 tail[16] = {};
+				std::memcpy(tail, (s + i), (size - i));
+				process(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+				length32 -= (16 - (size - i));
+				length16 -= (16 - (size - i));
+			}
+
+			error = _mm_or_si128(error, prevIncomplete);
+
+			if (not _mm_testz_si128(error, error))
+			{
+				return false;
+			}
+
+			utf32Length = length32;
+			utf16Length = length16;
+			return true;
+		}
+
+		[[nodiscard]]
+		static size_t CountLeadingASCII_SSE4_1(const char16* s, const size_t size) noexcept
+		{
+			const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+			size_t i = 0;
+
+			for (; (i + 8) <= size; i += 8)
+			{
+				if (not _mm_testz_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), mask))
+				{
+					break;
+				}
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t CountLeadingASCII_SSE4_1(const char32* s, const size_t size) noexcept
+		{
+			const __m128i mask = _mm_set1_epi32(static_cast<int32>(0xFFFFFF80));
+			size_t i = 0;
+
+			for (; (i + 4) <= size; i += 4)
+			{
+				if (not _mm_testz_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), mask))
+				{
+					break;
+				}
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		inline bool HasSurrogate_SSE4_1(const __m128i v) noexcept
+		{
+			const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xF800))), _mm_set1_epi16(static_cast<short>(0xD800)));
+			return (_mm_movemask_epi8(surrogates) != 0);
+		}
+
+		[[nodiscard]]
+		static size_t CountLeadingNonSurrogates_SSE4_1(const char16* s, const size_t size) noexcept
+		{
+			size_t i = 0;
+
+			for (; (i + 8) <= size; i += 8)
+			{
+				if (HasSurrogate_SSE4_1(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i))))
+				{
+					break;
+				}
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t CountLeadingBMP_SSE4_1(const char32* s, const size_t size) noexcept
+		{
+			const __m128i mask = _mm_set1_epi32(static_cast<int32>(0xFFFF0000));
+			size_t i = 0;
+
+			for (; (i + 4) <= size; i += 4)
+			{
+				if (not _mm_testz_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), mask))
+				{
+					break;
+				}
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t WidenLeadingASCII_SSE4_1(const char8* s, const size_t size, char32* dst) noexcept
+		{
+			size_t i = 0;
+
+			for (; (i + 16) <= size; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+
+				if (_mm_movemask_epi8(v) != 0)
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 0), _mm_cvtepu8_epi32(v));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12), _mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t WidenLeadingASCII_SSE4_1(const char8* s, const size_t size, char16* dst) noexcept
+		{
+			size_t i = 0;
+
+			for (; (i + 16) <= size; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+
+				if (_mm_movemask_epi8(v) != 0)
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 0), _mm_cvtepu8_epi16(v));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_cvtepu8_epi16(_mm_srli_si128(v, 8)));
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t WidenLeadingNonSurrogates_SSE4_1(const char16* s, const size_t size, char32* dst) noexcept
+		{
+			size_t i = 0;
+
+			for (; (i + 8) <= size; i += 8)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+
+				if (HasSurrogate_SSE4_1(v))
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 0), _mm_cvtepu16_epi32(v));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_cvtepu16_epi32(_mm_srli_si128(v, 8)));
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t NarrowLeadingASCII_SSE4_1(const char16* s, const size_t size, char8* dst) noexcept
+		{
+			const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+			size_t i = 0;
+
+			for (; (i + 16) <= size; i += 16)
+			{
+				const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8));
+
+				if (not _mm_testz_si128(_mm_or_si128(v0, v1), mask))
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v0, v1));
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t NarrowLeadingASCII_SSE4_1(const char32* s, const size_t size, char8* dst) noexcept
+		{
+			const __m128i mask = _mm_set1_epi32(static_cast<int32>(0xFFFFFF80));
+			size_t i = 0;
+
+			for (; (i + 16) <= size; i += 16)
+			{
+				const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 4));
+				const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8));
+				const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 12));
+
+				if (not _mm_testz_si128(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)), mask))
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(_mm_packus_epi32(v0, v1), _mm_packus_epi32(v2, v3)));
+			}
+
+			return i;
+		}
+
+		[[nodiscard]]
+		static size_t NarrowLeadingBMP_SSE4_1(const char32* s, const size_t size, char16* dst) noexcept
+		{
+			const __m128i mask = _mm_set1_epi32(static_cast<int32>(0xFFFF0000));
+			size_t i = 0;
+
+			for (; (i + 8) <= size; i += 8)
+			{
+				const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 4));
+
+				if (not _mm_testz_si128(_mm_or_si128(v0, v1), mask))
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi32(v0, v1));
+			}
+
+			return i;
+		}
+
+	# endif
+
+	# if SIV3D_UNICODE_AVX2
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	AVX2
+		//
+		////////////////////////////////////////////////////////////////
+
+		[[nodiscard]]
+		SIV3D_TARGET_AVX2
+		inline __m256i LoadTable_AVX2(const uint8(&table)[16]) noexcept
+		{
+			return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+		}
+
+		// 前のブロックの末尾から N バイトずらした値
+		template <int N>
+		[[nodiscard]]
+		SIV3D_TARGET_AVX2
+		inline __m256i Prev_AVX2(const __m256i input, const __m256i prevInput) noexcept
+		{
+			return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prevInput, input, 0x21), (16 - N));
+		}
+
+		[[nodiscard]]
+		SIV3D_TARGET_AVX2
+		inline __m256i CheckUTF8Block_AVX2(const __m256i input, const __m256i prevInput) noexcept
+		{
+			const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+			const __m256i prev1 = Prev_AVX2<1>(input, prevInput);
+			const __m256i byte1High = _mm256_shuffle_epi8(LoadTable_AVX2(utf8::Byte1High), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibbleMask));
+			const __m256i byte1Low = _mm256_shuffle_epi8(LoadTable_AVX2(utf8::Byte1Low), _mm256_and_si256(prev1, nibbleMask));
+			const __m256i byte2High = _mm256_shuffle_epi8(LoadTable_AVX2(utf8::Byte2High), _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+			const __m256i specialCases = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+			const __m256i prev2 = Prev_AVX2<2>(input, prevInput);
+			const __m256i prev3 = Prev_AVX2<3>(input, prevInput);
+			const __m256i isThirdByte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			const __m256i isFourthByte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			const __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThirdByte, isFourthByte), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+			return _mm256_xor_si256(must23, specialCases);
+		}
+
+		struct UTF8Validator_AVX2
+		{
+			__m256i error;
+
+			__m256i prevInput;
+
+			__m256i prevIncomplete;
+
+			size_t length32 = 0;
+
+			size_t length16 = 0;
+
+			SIV3D_TARGET_AVX2
+			void process(const __m256i input) noexcept
+			{
+				const __m256i notContinuation = _mm256_set1_epi8(-65);
+				const __m256i fourByteLead = _mm256_set1_epi8(-17);
+
+				const uint32 highBits = static_cast<uint32>(_mm256_movemask_epi8(input));
+				const uint32 chars = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, notContinuation)));
+				const uint32 fourByteLeads = (highBits & static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, fourByteLead))));
+				length32 += std::popcount(chars);
+				length16 += (std::popcount(chars) + std::popcount(fourByteLeads));
+
+				if (highBits == 0)
+				{
+					error = _mm256_or_si256(error, prevIncomplete);
+				}
+				else
+				{
+					error = _mm256_or_si256(error, CheckUTF8Block_AVX2(input, prevInput));
+					prevIncomplete = _mm256_subs_epu8(input, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(utf8::MaxValue)));
+				}
+
+				prevInput = input;
+			}
+		};
+
+		[[nodiscard]]
+		SIV3D_TARGET_AVX2
+		static bool ValidateUTF8_AVX2(const char8* s, const size_t size, size_t& utf32Length, size_t& utf16Length) noexcept
+		{
+			UTF8Validator_AVX2 validator{ _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+			size_t i = 0;
+
+			for (; (i + 32) <= size; i += 32)
+			{
+				validator.process(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)));
+			}
+
+			if (i < size)
+			{
+				// 末尾の端数は 0 で埋めて処理し、埋めた分の文字数を差し引く
+				alignas(32) char8 tail[32] = {};
+				std::memcpy(tail, (s + i), (size - i));
+				validator.process(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+				validator.length32 -= (32 - (size - i));
+				validator.length16 -= (32 - (size - i));
+			}
+
+			const __m256i error = _mm256_or_si256(validator.error, validator.prevIncomplete);
+
+			if (not _mm256_testz_si256(error, error))
+			{
+				return false;
+			}
+
+			utf32Length = validator.length32;
+			utf16Length = validator.length16;
+			return true;
+		}
+
+		[[nodiscard]]
+		SIV3D_TARGET_AVX2
+		static size_t WidenLeadingASCII_AVX2(const char8* s, const size_t size, char32* dst) noexcept
+		{
+			size_t i = 0;
+
+			for (; (i + 32) <= size; i += 32)
+			{
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+
+				if (_mm256_movemask_epi8(v) != 0)
+				{
+					break;
+				}
+
+				const __m128i lo = _mm256_castsi256_si128(v);
+				const __m128i hi = _mm256_extracti128_si256(v, 1);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 0), _mm256_cvtepu8_epi32(lo));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), _mm256_cvtepu8_epi32(hi));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+			}
+
+			return i;
+		}
+
+	# endif
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	Dispatch
+		//
+		////////////////////////////////////////////////////////////////
+
+		bool ValidateUTF8(const char8* s, const size_t size, size_t& utf32Length, size_t& utf16Length) noexcept
+		{
+		# if SIV3D_UNICODE_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return ValidateUTF8_AVX2(s, size, utf32Length, utf16Length);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return ValidateUTF8_SSE4_1(s, size, utf32Length, utf16Length);
+			}
+
+		# endif
+
+			return ValidateUTF8_Reference(s, size, utf32Length, utf16Length);
+		}
+
+		size_t CountLeadingASCII([[maybe_unused]] const char16* s, [[maybe_unused]] const size_t size) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return CountLeadingASCII_SSE4_1(s, size);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t CountLeadingASCII([[maybe_unused]] const char32* s, [[maybe_unused]] const size_t size) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return CountLeadingASCII_SSE4_1(s, size);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t CountLeadingNonSurrogates([[maybe_unused]] const char16* s, [[maybe_unused]] const size_t size) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return CountLeadingNonSurrogates_SSE4_1(s, size);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t CountLeadingBMP([[maybe_unused]] const char32* s, [[maybe_unused]] const size_t size) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return CountLeadingBMP_SSE4_1(s, size);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t WidenLeadingASCII([[maybe_unused]] const char8* s, [[maybe_unused]] const size_t size, [[maybe_unused]] char32* dst) noexcept
+		{
+		# if SIV3D_UNICODE_AVX2
+
+			if (GetCPUInfo().features.avx2)
+			{
+				return WidenLeadingASCII_AVX2(s, size, dst);
+			}
+
+		# endif
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return WidenLeadingASCII_SSE4_1(s, size, dst);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t WidenLeadingASCII([[maybe_unused]] const char8* s, [[maybe_unused]] const size_t size, [[maybe_unused]] char16* dst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return WidenLeadingASCII_SSE4_1(s, size, dst);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t WidenLeadingNonSurrogates([[maybe_unused]] const char16* s, [[maybe_unused]] const size_t size, [[maybe_unused]] char32* dst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return WidenLeadingNonSurrogates_SSE4_1(s, size, dst);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t NarrowLeadingASCII([[maybe_unused]] const char16* s, [[maybe_unused]] const size_t size, [[maybe_unused]] char8* dst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return NarrowLeadingASCII_SSE4_1(s, size, dst);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t NarrowLeadingASCII([[maybe_unused]] const char32* s, [[maybe_unused]] const size_t size, [[maybe_unused]] char8* dst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return NarrowLeadingASCII_SSE4_1(s, size, dst);
+			}
+
+		# endif
+
+			return 0;
+		}
+
+		size_t NarrowLeadingBMP([[maybe_unused]] const char32* s, [[maybe_unused]] const size_t size, [[maybe_unused]] char16* dst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return NarrowLeadingBMP_SSE4_1(s, size, dst);
+			}
+
+		# endif
+
+			return 0;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		//
+		//	UTF-8 の検証
+		//
+
+		/// @brief UTF-8 のバイト列が正しいかを調べ、正しい場合は UTF-32 と UTF-16 に変換したときの長さを格納します。
+		/// @remark 冗長な表現、サロゲートのコードポイント、U+10FFFF を超えるコードポイント、途切れた符号単位を含む場合は false を返します。
+		[[nodiscard]]
+		bool ValidateUTF8(const char8* s, size_t size, size_t& utf32Length, size_t& utf16Length) noexcept;
+
+		//
+		//	先頭から続く区間の長さ
+		//	（以下の関数は SIMD 命令で処理できるブロック単位で調べるため、区間の末尾の端数は数えません）
+		//
+
+		/// @brief 先頭から続く ASCII の文字数を返します。
+		[[nodiscard]]
+		size_t CountLeadingASCII(const char16* s, size_t size) noexcept;
+
+		/// @brief 先頭から続く ASCII の文字数を返します。
+		[[nodiscard]]
+		size_t CountLeadingASCII(const char32* s, size_t size) noexcept;
+
+		/// @brief 先頭から続く、サロゲートでない符号単位の個数を返します。
+		[[nodiscard]]
+		size_t CountLeadingNonSurrogates(const char16* s, size_t size) noexcept;
+
+		/// @brief 先頭から続く、U+FFFF 以下の文字数を返します。
+		[[nodiscard]]
+		size_t CountLeadingBMP(const char32* s, size_t size) noexcept;
+
+		//
+		//	先頭から続く区間の変換
+		//	（変換した文字数を返します。区間の末尾の端数は変換しません）
+		//
+
+		/// @brief 先頭から続く ASCII の文字を UTF-32 に変換します。
+		[[nodiscard]]
+		size_t WidenLeadingASCII(const char8* s, size_t size, char32* dst) noexcept;
+
+		/// @brief 先頭から続く ASCII の文字を UTF-16 に変換します。
+		[[nodiscard]]
+		size_t WidenLeadingASCII(const char8* s, size_t size, char16* dst) noexcept;
+
+		/// @brief 先頭から続く、サロゲートでない符号単位を UTF-32 に変換します。
+		[[nodiscard]]
+		size_t WidenLeadingNonSurrogates(const char16* s, size_t size, char32* dst) noexcept;
+
+		/// @brief 先頭から続く ASCII の文字を UTF-8 に変換します。
+		[[nodiscard]]
+		size_t NarrowLeadingASCII(const char16* s, size_t size, char8* dst) noexcept;
+
+		/// @brief 先頭から続く ASCII の文字を UTF-8 に変換します。
+		[[nodiscard]]
+		size_t NarrowLeadingASCII(const char32* s, size_t size, char8* dst) noexcept;
+
+		/// @brief 先頭から続く、U+FFFF 以下の文字を UTF-16 に変換します。
+		[[nodiscard]]
+		size_t NarrowLeadingBMP(const char32* s, size_t size, char16* dst) noexcept;
+	}
+}
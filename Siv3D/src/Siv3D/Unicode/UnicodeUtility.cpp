@@ -9,13 +9,58 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/Utility.hpp>
 # include "UnicodeUtility.hpp"
 # include <ThirdParty/miniutf/miniutf.hpp>
+# include "UnicodeSIMD.hpp"
 
 namespace s3d
 {
 	namespace detail
 	{
+		namespace
+		{
+			// SIMD で処理できなかった区間を、1 文字ずつ処理する最小の長さ
+			// （この長さを処理した後も、SIMD で処理できない文字が続く間は 1 文字ずつ処理する）
+			constexpr size_t ScalarBlockSize = 16;
+
+			[[nodiscard]]
+			inline constexpr bool IsSurrogate(const char16 ch) noexcept
+			{
+				return ((0xD800 <= ch) && (ch < 0xE000));
+			}
+
+			[[nodiscard]]
+			inline char32 DecodeValidUTF8(const char8*& s) noexcept
+			{
+				const uint32 b0 = static_cast<uint8>(s[0]);
+
+				if (b0 < 0x80)
+				{
+					++s;
+					return b0;
+				}
+				else if (b0 < 0xE0)
+				{
+					const char32 codePoint = (((b0 & 0x1F) << 6) | (static_cast<uint8>(s[1]) & 0x3F));
+					s += 2;
+					return codePoint;
+				}
+				else if (b0 < 0xF0)
+				{
+					const char32 codePoint = (((b0 & 0x0F) << 12) | ((static_cast<uint8>(s[1]) & 0x3F) << 6) | (static_cast<uint8>(s[2]) & 0x3F));
+					s += 3;
+					return codePoint;
+				}
+				else
+				{
+					const char32 codePoint = (((b0 & 0x07) << 18) | ((static_cast<uint8>(s[1]) & 0x3F) << 12) | ((static_cast<uint8>(s[2]) & 0x3F) << 6) | (static_cast<uint8>(s[3]) & 0x3F));
+					s += 4;
+					return codePoint;
+				}
+			}
+		}
+
 		//
 		// UTF-8
 		//
@@ -29,11 +74,20 @@ namespace s3d
 
 			while (pSrc != pSrcEnd)
 			{
-				int32 offset;
+				const size_t asciiLength = CountLeadingASCII(pSrc, (pSrcEnd - pSrc));
+				length += asciiLength;
+				pSrc += asciiLength;
 
-				length += UTF8_Length(utf16_decode(pSrc, pSrcEnd - pSrc, offset));
+				const char16* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
 
-				pSrc += offset;
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x80 <= *pSrc)))
+				{
+					int32 offset;
+
+					length += UTF8_Length(utf16_decode(pSrc, pSrcEnd - pSrc, offset));
+
+					pSrc += offset;
+				}
 			}
 
 			return length;
@@ -75,7 +129,16 @@ namespace s3d
 
 			while (pSrc != pSrcEnd)
 			{
-				result += UTF8_Length(*pSrc++);
+				const size_t asciiLength = CountLeadingASCII(pSrc, (pSrcEnd - pSrc));
+				result += asciiLength;
+				pSrc += asciiLength;
+
+				const char32* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x80 <= *pSrc)))
+				{
+					result += UTF8_Length(*pSrc++);
+				}
 			}
 
 			return result;
@@ -117,6 +180,98 @@ namespace s3d
 			}
 		}
 
+		char8* UTF8_Encode(char8* dst, const std::u16string_view s) noexcept
+		{
+			const char16* pSrc = s.data();
+			const char16* const pSrcEnd = pSrc + s.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const size_t asciiLength = NarrowLeadingASCII(pSrc, (pSrcEnd - pSrc), dst);
+				pSrc += asciiLength;
+				dst += asciiLength;
+
+				const char16* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x80 <= *pSrc)))
+				{
+					int32 offset;
+
+					UTF8_Encode(&dst, utf16_decode(pSrc, pSrcEnd - pSrc, offset));
+
+					pSrc += offset;
+				}
+			}
+
+			return dst;
+		}
+
+		char8* UTF8_Encode(char8* dst, const StringView s) noexcept
+		{
+			const char32* pSrc = s.data();
+			const char32* const pSrcEnd = pSrc + s.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const size_t asciiLength = NarrowLeadingASCII(pSrc, (pSrcEnd - pSrc), dst);
+				pSrc += asciiLength;
+				dst += asciiLength;
+
+				const char32* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x80 <= *pSrc)))
+				{
+					UTF8_Encode(&dst, *pSrc++);
+				}
+			}
+
+			return dst;
+		}
+
+		char32* UTF8_DecodeValid(char32* dst, const std::string_view s) noexcept
+		{
+			const char8* pSrc = s.data();
+			const char8* const pSrcEnd = pSrc + s.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const size_t asciiLength = WidenLeadingASCII(pSrc, (pSrcEnd - pSrc), dst);
+				pSrc += asciiLength;
+				dst += asciiLength;
+
+				const char8* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x80 <= static_cast<uint8>(*pSrc))))
+				{
+					*dst++ = DecodeValidUTF8(pSrc);
+				}
+			}
+
+			return dst;
+		}
+
+		char16* UTF8_DecodeValid(char16* dst, const std::string_view s) noexcept
+		{
+			const char8* pSrc = s.data();
+			const char8* const pSrcEnd = pSrc + s.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const size_t asciiLength = WidenLeadingASCII(pSrc, (pSrcEnd - pSrc), dst);
+				pSrc += asciiLength;
+				dst += asciiLength;
+
+				const char8* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x80 <= static_cast<uint8>(*pSrc))))
+				{
+					UTF16_Encode(&dst, DecodeValidUTF8(pSrc));
+				}
+			}
+
+			return dst;
+		}
+
 		//
 		// UTF-16
 		//
@@ -166,12 +321,69 @@ namespace s3d
 
 			while (pSrc != pSrcEnd)
 			{
-				result += UTF16_Length(*pSrc++);
+				const size_t bmpLength = CountLeadingBMP(pSrc, (pSrcEnd - pSrc));
+				result += bmpLength;
+				pSrc += bmpLength;
+
+				const char32* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x10000 <= *pSrc)))
+				{
+					result += UTF16_Length(*pSrc++);
+				}
 			}
 
 			return result;
 		}
 
+		char16* UTF16_Encode(char16* dst, const StringView s) noexcept
+		{
+			const char32* pSrc = s.data();
+			const char32* const pSrcEnd = pSrc + s.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const size_t bmpLength = NarrowLeadingBMP(pSrc, (pSrcEnd - pSrc), dst);
+				pSrc += bmpLength;
+				dst += bmpLength;
+
+				const char32* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && (0x10000 <= *pSrc)))
+				{
+					UTF16_Encode(&dst, *pSrc++);
+				}
+			}
+
+			return dst;
+		}
+
+		char32* UTF16_Decode(char32* dst, const std::u16string_view s) noexcept
+		{
+			const char16* pSrc = s.data();
+			const char16* const pSrcEnd = pSrc + s.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const size_t length = WidenLeadingNonSurrogates(pSrc, (pSrcEnd - pSrc), dst);
+				pSrc += length;
+				dst += length;
+
+				const char16* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
+
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && IsSurrogate(*pSrc)))
+				{
+					int32 offset;
+
+					*dst++ = utf16_decode(pSrc, pSrcEnd - pSrc, offset);
+
+					pSrc += offset;
+				}
+			}
+
+			return dst;
+		}
+
 		size_t UTF32_Length(const std::string_view s) noexcept
 		{
 			size_t length = 0;
@@ -202,13 +414,22 @@ namespace s3d
 
 			while (pSrc != pSrcEnd)
 			{
-				int32 offset;
+				const size_t bmpLength = CountLeadingNonSurrogates(pSrc, (pSrcEnd - pSrc));
+				length += bmpLength;
+				pSrc += bmpLength;
 
-				utf16_decode(pSrc, pSrcEnd - pSrc, offset);
+				const char16* const pBlockEnd = (pSrc + Min<size_t>(ScalarBlockSize, (pSrcEnd - pSrc)));
 
-				pSrc += offset;
+				while ((pSrc < pBlockEnd) || ((pSrc != pSrcEnd) && IsSurrogate(*pSrc)))
+				{
+					int32 offset;
 
-				++length;
+					utf16_decode(pSrc, pSrcEnd - pSrc, offset);
+
+					pSrc += offset;
+
+					++length;
+				}
 			}
 
 			return length;
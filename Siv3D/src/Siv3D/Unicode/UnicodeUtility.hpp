@@ -31,6 +31,22 @@ namespace s3d
 
 		void UTF8_Encode(char8** s, char32 codePoint) noexcept;
 
+		/// @brief UTF-16 文字列を UTF-8 に変換して書き込みます。
+		/// @return 書き込んだ範囲の終端
+		char8* UTF8_Encode(char8* dst, std::u16string_view s) noexcept;
+
+		/// @brief UTF-32 文字列を UTF-8 に変換して書き込みます。
+		/// @return 書き込んだ範囲の終端
+		char8* UTF8_Encode(char8* dst, StringView s) noexcept;
+
+		/// @brief ValidateUTF8() で検証済みの UTF-8 文字列を UTF-32 に変換して書き込みます。
+		/// @return 書き込んだ範囲の終端
+		char32* UTF8_DecodeValid(char32* dst, std::string_view s) noexcept;
+
+		/// @brief ValidateUTF8() で検証済みの UTF-8 文字列を UTF-16 に変換して書き込みます。
+		/// @return 書き込んだ範囲の終端
+		char16* UTF8_DecodeValid(char16* dst, std::string_view s) noexcept;
+
 
 		//
 		// UTF-16
@@ -64,6 +80,14 @@ namespace s3d
 			}
 		}
 
+		/// @brief UTF-32 文字列を UTF-16 に変換して書き込みます。
+		/// @return 書き込んだ範囲の終端
+		char16* UTF16_Encode(char16* dst, StringView s) noexcept;
+
+		/// @brief UTF-16 文字列を UTF-32 に変換して書き込みます。
+		/// @return 書き込んだ範囲の終端
+		char32* UTF16_Decode(char32* dst, std::u16string_view s) noexcept;
+
 		//
 		// UTF-32
 		//
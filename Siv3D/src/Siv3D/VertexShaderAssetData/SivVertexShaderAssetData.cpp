@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/VertexShaderAssetData.hpp>
+# include <Siv3D/TraceRecorder.hpp>
 # include <Siv3D/System.hpp>
 
 namespace s3d
@@ -55,6 +56,8 @@ namespace s3d
 
 	bool VertexShaderAssetData::load(const String& hint)
 	{
+		SIV3D_TRACE_ZONE(U"VertexShaderAsset::load");
+
 		if (isUninitialized())
 		{
 			if (onLoad(*this, hint))
@@ -85,6 +88,8 @@ namespace s3d
 
 			m_task = Async([this, hint = hint]()
 				{
+					SIV3D_TRACE_ZONE(U"VertexShaderAsset::loadAsync");
+
 					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
 				});
 		}
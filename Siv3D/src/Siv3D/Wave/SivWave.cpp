@@ -14,6 +14,7 @@
 # include <Siv3D/AudioEncoder.hpp>
 # include <Siv3D/Dialog.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AllocationTracker.hpp>
 # include <Siv3D/SoundFont/ISoundFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/AudioFormat/WAVEEncoder.hpp>
@@ -73,6 +74,8 @@ namespace s3d
 
 	Wave::Wave(const GMInstrument instrument, const uint8 key, const Duration& noteOn, const Duration& noteOff, const double velocity, const Arg::sampleRate_<uint32> sampleRate)
 	{
+		const ScopedAllocationTag allocationTag{ AllocationTag::Wave };
+
 		*this = SIV3D_ENGINE(SoundFont)->render(instrument, key, noteOn, noteOff, velocity, sampleRate);
 	}
 
@@ -109,14 +109,12 @@ namespace s3d
 			}
 			else
 			{
-				const std::string archivePathC = Unicode::Narrow(path);
-				err = ::mz_zip_reader_open_file(m_reader, archivePathC.c_str());
+				err = openFile(path);
 			}
 
 		# else
 
-			const std::string archivePathC = Unicode::Narrow(path);
-			err = ::mz_zip_reader_open_file(m_reader, archivePathC.c_str());
+			err = openFile(path);
 
 		# endif
 
@@ -178,6 +176,8 @@ namespace s3d
 		m_archiveFileFullPath.clear();
 
 		::mz_zip_reader_delete(&m_reader); // 内部で m_reader = nullptr;
+
+		m_mapped.close();
 	}
 
 	bool ZIPReader::ZIPReaderDetail::isOpen() const noexcept
@@ -290,4 +290,21 @@ namespace s3d
 
 		return Blob{ std::move(data) };
 	}
+
+	int32 ZIPReader::ZIPReaderDetail::openFile(const FilePathView path)
+	{
+		// メモリマップできた場合は、ファイル全体をコピーせずにマップされたデータからアーカイブを読み込む
+		if (m_mapped.open(path)
+			&& InRange<int64>(m_mapped.size(), 1, std::numeric_limits<int32>::max()))
+		{
+			return ::mz_zip_reader_open_buffer(m_reader,
+				const_cast<uint8*>(reinterpret_cast<const uint8*>(m_mapped.span().data())),
+				static_cast<int32>(m_mapped.size()), 0);
+		}
+
+		m_mapped.close();
+
+		const std::string archivePathC = Unicode::Narrow(path);
+		return ::mz_zip_reader_open_file(m_reader, archivePathC.c_str());
+	}
 }
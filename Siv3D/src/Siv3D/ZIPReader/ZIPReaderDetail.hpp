@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/ZIPReader.hpp>
 # include <Siv3D/Unicode.hpp>
+# include <Siv3D/MappedReader.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS)
 
@@ -99,8 +100,14 @@ namespace s3d
 
 	private:
 
+		[[nodiscard]]
+		int32 openFile(FilePathView path);
+
 		void* m_reader = nullptr;
 
+		// アーカイブファイルをメモリマップできた場合、マップされたデータから直接読み込む
+		MappedReader m_mapped;
+
 		FilePath m_archiveFileFullPath;
 
 		Array<FilePath> m_paths;
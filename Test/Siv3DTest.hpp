@@ -17,4 +17,33 @@
 using namespace s3d;
 using namespace std::literals;
 
+namespace TestUtil
+{
+	/// @brief バイト列をそのままファイルに書き込みます。
+	/// @param path ファイルパス
+	/// @param bytes 書き込むバイト列
+	inline void WriteBytes(const FilePathView path, const std::string_view bytes)
+	{
+		BinaryWriter writer{ path };
+		writer.write(bytes.data(), bytes.size());
+	}
+
+	/// @brief f() の読み込み速度と、ヒープ確保量のピーク（AllocationTracker が有効な場合のみ）を表示します。
+	/// @param name 表示する名前
+	/// @param megaBytes 読み込むデータのサイズ（MB）
+	/// @param f 読み込みを行い、読み込んだ要素数を返す関数
+	template <class Fty>
+	void ReportReadThroughput(const StringView name, const double megaBytes, Fty f)
+	{
+		AllocationTracker::ResetPeak();
+		const size_t baseBytes = AllocationTracker::GetTotalStat().currentBytes;
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+		const size_t count = f();
+		const double sec = stopwatch.sF();
+		const size_t peakBytes = (AllocationTracker::GetTotalStat().peakBytes - baseBytes);
+
+		Console << U"{} | {} : {:.1f} MB/s, peak heap {:.1f} MB"_fmt(name, count, (megaBytes / sec), (peakBytes / (1024.0 * 1024.0)));
+	}
+}
+
 //# define SIV3D_RUN_BENCHMARK
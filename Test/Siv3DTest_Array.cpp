@@ -82,6 +82,36 @@ TEST_CASE("Array::parallel_map()")
 	}
 }
 
+TEST_CASE("Array::parallel_each()")
+{
+	{
+		Array<uint32> v(64 * 1024);
+		for (size_t i = 0; i < v.size(); ++i)
+		{
+			v[i] = static_cast<uint32>(i);
+		}
+
+		v.parallel_each([](uint32& n) { n *= 3; });
+
+		bool ok = true;
+		for (size_t i = 0; i < v.size(); ++i)
+		{
+			ok &= (v[i] == (i * 3));
+		}
+
+		REQUIRE(ok);
+	}
+
+	{
+		const Array<uint32> v(64 * 1024, 1);
+		std::atomic<size_t> sum = 0;
+
+		v.parallel_each([&](uint32 n) { sum += n; });
+
+		REQUIRE(sum == v.size());
+	}
+}
+
 # if defined(SIV3D_RUN_BENCHMARK)
 
 TEST_CASE("Array::parallel_count_if() : benchmark")
@@ -152,6 +182,26 @@ TEST_CASE("Array::parallel_count_if() : benchmark")
 	}
 }
 
+TEST_CASE("Array::parallel_each() : benchmark")
+{
+	// 1 フレーム内で何度も呼ばれる小さなバッチ
+	{
+		Array<double> v(1024, 1.0);
+
+		BENCHMARK("Array::each() | 1K")
+		{
+			v.each([](double& x) { x = std::sqrt(x + 1.0); });
+			return v[0];
+		};
+
+		BENCHMARK("Array::parallel_each() | 1K")
+		{
+			v.parallel_each([](double& x) { x = std::sqrt(x + 1.0); });
+			return v[0];
+		};
+	}
+}
+
 TEST_CASE("Array::parallel_map() : benchmark")
 {
 	{
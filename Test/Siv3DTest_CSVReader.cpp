@@ -0,0 +1,185 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+SIV3D_DISABLE_MSVC_WARNINGS_PUSH(4566)
+
+namespace
+{
+	[[nodiscard]]
+	Array<Array<String>> ReadAllRows(CSVReader& reader)
+	{
+		Array<Array<String>> rows;
+		Array<std::string_view> cells;
+
+		while (reader.readRow(cells))
+		{
+			rows.push_back(cells.map([](const std::string_view cell) { return Unicode::FromUTF8(cell); }));
+		}
+
+		return rows;
+	}
+}
+
+TEST_CASE("CSVReader")
+{
+	SECTION("Nonexist")
+	{
+		const CSVReader reader{ U"test/csv/nonexist.csv" };
+		REQUIRE(reader.isOpen() == false);
+		REQUIRE(static_cast<bool>(reader) == false);
+		REQUIRE(reader.path() == U"");
+	}
+
+	SECTION("Empty")
+	{
+		const FilePath path = U"test/runtime/csvreader/empty.csv";
+		TestUtil::WriteBytes(path, "");
+
+		CSVReader reader{ path };
+		REQUIRE(reader.isOpen() == true);
+
+		Array<std::string_view> cells;
+		REQUIRE(reader.readRow(cells) == false);
+		REQUIRE(reader.readColumns({ { 0, CSVColumnType::Int64 } }).size() == 1);
+	}
+
+	SECTION("readRow() matches CSV::load()")
+	{
+		const FilePath path = U"test/runtime/csvreader/syntax.csv";
+		TestUtil::WriteBytes(path,
+			"\xEF\xBB\xBF" "name,value,comment\r\n"
+			"apple,100,\"red, sweet\"\r\n"
+			"\n"
+			"banana,,\"say \\\"hi\\\"\"\n"
+			"cherry,3.5,multi\\nline\n"
+			"日本語,-7,\\,escaped\n"
+			"broken,1,C:\\path\\to\n"
+			"trailing,2,");
+
+		CSVReader reader{ path };
+		const Array<Array<String>> rows = ReadAllRows(reader);
+		const CSV csv{ path };
+
+		REQUIRE(rows == csv.getData());
+		REQUIRE(rows.size() == 8);
+		REQUIRE(rows[1] == Array<String>{ U"apple", U"100", U"red, sweet" });
+		REQUIRE(rows[2].isEmpty());
+		REQUIRE(rows[3] == Array<String>{ U"banana", U"", U"say \"hi\"" });
+		REQUIRE(rows[4] == Array<String>{ U"cherry", U"3.5", U"multi\nline" });
+		REQUIRE(rows[5] == Array<String>{ U"日本語", U"-7", U",escaped" });
+		REQUIRE(rows[6] == Array<String>{ U"broken", U"1", U"C:\\path\\to" });
+		REQUIRE(rows[7] == Array<String>{ U"trailing", U"2", U"" });
+
+		// rewind() で先頭から読み直せる
+		reader.rewind();
+		REQUIRE(ReadAllRows(reader) == rows);
+	}
+
+	SECTION("Separators")
+	{
+		const FilePath path = U"test/runtime/csvreader/tsv.csv";
+		TestUtil::WriteBytes(path, "a\tb c\t'x\ty'\n");
+
+		CSVReader reader{ path, U"\t", U"'" };
+		REQUIRE(ReadAllRows(reader) == CSV{ path, U"\t", U"'" }.getData());
+	}
+
+	SECTION("readColumns()")
+	{
+		const FilePath path = U"test/runtime/csvreader/columns.csv";
+		std::string text = "id,value,name\n";
+
+		for (int32 i = 0; i < 100000; ++i)
+		{
+			text += U"{},{},item{}\n"_fmt(i, (i * 0.25), i).narrow();
+		}
+
+		text += "broken\n";
+		TestUtil::WriteBytes(path, text);
+
+		const CSVReader reader{ path };
+		const Array<CSVColumnData> columns = reader.readColumns({ { 2, CSVColumnType::String }, { 0, CSVColumnType::Int64 }, { 1, CSVColumnType::Double } }, 1);
+		REQUIRE(columns.size() == 3);
+
+		const auto& names = std::get<Array<String>>(columns[0]);
+		const auto& ids = std::get<Array<int64>>(columns[1]);
+		const auto& values = std::get<Array<double>>(columns[2]);
+		REQUIRE(names.size() == 100001);
+		REQUIRE(ids.size() == 100001);
+		REQUIRE(values.size() == 100001);
+
+		bool ok = true;
+
+		for (int32 i = 0; i < 100000; ++i)
+		{
+			ok &= (names[i] == U"item{}"_fmt(i));
+			ok &= (ids[i] == i);
+			ok &= (values[i] == (i * 0.25));
+		}
+
+		REQUIRE(ok);
+
+		// 数値として解釈できない要素や、存在しない列
+		REQUIRE(names.back() == U"");
+		REQUIRE(ids.back() == 0);
+		REQUIRE(std::isnan(values.back()));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("CSVReader : benchmark")
+{
+	// 約 64 MB の CSV
+	const FilePath path = U"test/runtime/csvreader/benchmark/large.csv";
+	{
+		TextWriter writer{ path, TextEncoding::UTF8_NO_BOM };
+		writer.writeln(U"id,x,y,label");
+
+		for (int64 i = 0; i < 1'600'000; ++i)
+		{
+			writer.writeln(U"{},{:.3f},{:.3f},label-{}"_fmt(i, (i * 0.001), (i * 0.002), (i % 1000)));
+		}
+	}
+
+	const double megaBytes = (FileSystem::FileSize(path) / (1024.0 * 1024.0));
+
+	TestUtil::ReportReadThroughput(U"CSV::load()", megaBytes, [&]()
+	{
+		return CSV{ path }.rows();
+	});
+
+	TestUtil::ReportReadThroughput(U"CSVReader::readRow()", megaBytes, [&]()
+	{
+		CSVReader reader{ path };
+		Array<std::string_view> cells;
+		size_t rows = 0;
+
+		while (reader.readRow(cells))
+		{
+			++rows;
+		}
+
+		return rows;
+	});
+
+	TestUtil::ReportReadThroughput(U"CSVReader::readColumns()", megaBytes, [&]()
+	{
+		const Array<CSVColumnData> columns = CSVReader{ path }.readColumns({ { 0, CSVColumnType::Int64 }, { 1, CSVColumnType::Double }, { 3, CSVColumnType::String } }, 1);
+		return std::get<Array<int64>>(columns[0]).size();
+	});
+}
+
+# endif
+
+SIV3D_DISABLE_MSVC_WARNINGS_POP()
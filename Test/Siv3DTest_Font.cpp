@@ -0,0 +1,377 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// CJK 統合漢字を先頭から count 文字並べた文字列を返す
+	String MakeCJKText(const size_t count)
+	{
+		String text;
+
+		for (char32 ch = 0x4E00; text.size() < count; ++ch)
+		{
+			text << ch;
+		}
+
+		return text;
+	}
+
+	// テクスチャの内容をそのまま書き込んだ画像を返す
+	Image ReadTexture(const Texture& texture)
+	{
+		const RenderTexture renderTexture{ texture.size(), ColorF{ 0.0, 0.0 } };
+		{
+			const ScopedRenderTarget2D target{ renderTexture.clear(ColorF{ 0.0, 0.0 }) };
+			const ScopedRenderStates2D blend{ BlendState::Opaque };
+			texture.draw();
+		}
+		Graphics2D::Flush();
+
+		Image image;
+		renderTexture.readAsImage(image);
+		return image;
+	}
+}
+
+TEST_CASE("Font::preload() : SDF / MSDF")
+{
+	const String text = (MakeCJKText(300) + U"ABCabc123ABC");
+
+	for (const FontMethod method : { FontMethod::SDF, FontMethod::MSDF })
+	{
+		// まとめて生成した場合 (並列に処理される) と、1 文字ずつ生成した場合でアトラスが一致する
+		const Font batch{ method, 32, Typeface::CJK_Regular_JP };
+		const Font single{ method, 32, Typeface::CJK_Regular_JP };
+
+		REQUIRE(batch.preload(text));
+
+		for (const char32 ch : text)
+		{
+			REQUIRE(single.preload(StringView{ &ch, 1 }));
+		}
+
+		const Image batchImage = ReadTexture(batch.getTexture());
+		const Image singleImage = ReadTexture(single.getTexture());
+		REQUIRE(batchImage.size() == singleImage.size());
+		REQUIRE(std::equal(batchImage.begin(), batchImage.end(), singleImage.begin()));
+	}
+}
+
+TEST_CASE("Font::getTexture() : partial update")
+{
+	const String text = MakeCJKText(300);
+
+	for (const FontMethod method : { FontMethod::Bitmap, FontMethod::SDF, FontMethod::MSDF })
+	{
+		// 1 文字追加するごとにテクスチャを更新した場合 (変更された範囲のみ転送される) と、最後にまとめて更新した場合でテクスチャが一致する
+		const Font partial{ method, 32, Typeface::CJK_Regular_JP };
+		const Font whole{ method, 32, Typeface::CJK_Regular_JP };
+
+		for (const char32 ch : text)
+		{
+			REQUIRE(partial.preload(StringView{ &ch, 1 }));
+			REQUIRE(partial.getTexture());
+		}
+
+		REQUIRE(whole.preload(text));
+
+		const Image partialImage = ReadTexture(partial.getTexture());
+		const Image wholeImage = ReadTexture(whole.getTexture());
+		REQUIRE(partialImage.size() == wholeImage.size());
+		REQUIRE(std::equal(partialImage.begin(), partialImage.end(), wholeImage.begin()));
+	}
+}
+
+TEST_CASE("Font::getTexture() : upload size")
+{
+	const String text = MakeCJKText(320);
+
+	for (const FontMethod method : { FontMethod::Bitmap, FontMethod::SDF, FontMethod::MSDF })
+	{
+		const Font font{ method, 32, Typeface::CJK_Regular_JP };
+		REQUIRE(font.preload(text.substr(0, 300)));
+
+		// 新しいグリフを 1 文字追加したときは、アトラスのページ全体よりも少ないデータだけが転送される
+		// （アトラスが拡張されたときはページ全体が転送されるため、拡張されない文字で確かめる）
+		bool checked = false;
+
+		for (const char32 ch : text.substr(300))
+		{
+			const Size pageSize = font.getTexture().size();
+			System::Update();
+
+			REQUIRE(font.preload(StringView{ &ch, 1 }));
+
+			if (font.getTexture().size() != pageSize)
+			{
+				continue;
+			}
+
+			System::Update();
+
+			const size_t uploadSize = Profiler::GetStat().fontTextureUploadSize;
+			REQUIRE(0 < uploadSize);
+			REQUIRE(uploadSize < (pageSize.x * pageSize.y * sizeof(Color)));
+			checked = true;
+			break;
+		}
+
+		REQUIRE(checked);
+	}
+}
+
+TEST_CASE("Font::preload() : multiple pages")
+{
+	const String text = MakeCJKText(3000);
+
+	for (const FontMethod method : { FontMethod::Bitmap, FontMethod::SDF, FontMethod::MSDF })
+	{
+		// 1 ページに収まらない数の文字をキャッシュできる
+		const Font font{ method, 64, Typeface::CJK_Regular_JP };
+		REQUIRE(font.getGlyphCacheMemoryBudget() == (128 * 1024 * 1024));
+		REQUIRE(font.preload(text));
+		REQUIRE(font.getGlyph(text.back()).texture.texture);
+	}
+}
+
+TEST_CASE("Font::setGlyphCacheMemoryBudget()")
+{
+	const String a = MakeCJKText(1000);
+	const String b = MakeCJKText(2000).substr(1000);
+
+	// 1 ページ分のメモリしか使えない場合、前のフレームで使ったページを破棄して再利用する
+	const Font font{ FontMethod::Bitmap, 64, Typeface::CJK_Regular_JP };
+	font.setGlyphCacheMemoryBudget(1536 * 4096 * 4);
+	REQUIRE(font.getGlyphCacheMemoryBudget() == (1536 * 4096 * 4));
+
+	REQUIRE(font.preload(a));
+
+	System::Update();
+
+	REQUIRE(font.preload(b));
+	REQUIRE(font.getGlyph(b.back()).texture.texture);
+
+	System::Update();
+
+	REQUIRE(font.preload(a));
+	REQUIRE(font.getGlyph(a.back()).texture.texture);
+
+	// 同じフレームで使ったページは破棄しない
+	REQUIRE(not font.preload(a + b));
+}
+
+TEST_CASE("Font::setShapingCacheCapacity()")
+{
+	const Array<String> texts = { U"Siv3D", U"ffi fl", U"こんにちは世界", U"🐈🐕", U"", U"Siv3D\nOpenSiv3D" };
+
+	// キャッシュを使う場合と使わない場合でシェーピング結果が一致する
+	const Font cached{ 32, Typeface::Regular };
+	const Font uncached{ 32, Typeface::Regular };
+	const Font emoji{ 32, Typeface::ColorEmoji };
+	cached.addFallback(emoji);
+	uncached.addFallback(emoji);
+
+	REQUIRE(cached.getShapingCacheCapacity() == 4096);
+	uncached.setShapingCacheCapacity(0);
+	REQUIRE(uncached.getShapingCacheCapacity() == 0);
+
+	auto equals = [](const Array<GlyphCluster>& a, const Array<GlyphCluster>& b)
+	{
+		return ((a.size() == b.size())
+			&& std::equal(a.begin(), a.end(), b.begin(), [](const GlyphCluster& x, const GlyphCluster& y)
+				{ return ((x.glyphIndex == y.glyphIndex) && (x.fontIndex == y.fontIndex) && (x.pos == y.pos)); }));
+	};
+
+	for (int32 i = 0; i < 2; ++i)
+	{
+		for (const auto& text : texts)
+		{
+			for (const auto useFallback : { UseFallback::No, UseFallback::Yes })
+			{
+				for (const auto ligature : { Ligature::No, Ligature::Yes })
+				{
+					REQUIRE(equals(cached.getGlyphClusters(text, useFallback, ligature), uncached.getGlyphClusters(text, useFallback, ligature)));
+				}
+			}
+		}
+	}
+
+	// 最大数を超えたエントリは破棄される
+	cached.setShapingCacheCapacity(1);
+
+	for (const auto& text : texts)
+	{
+		REQUIRE(equals(cached.getGlyphClusters(text), uncached.getGlyphClusters(text)));
+	}
+}
+
+TEST_CASE("ProfilerStat : shaping cache")
+{
+	const Font font{ 32, Typeface::Regular };
+
+	System::Update();
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		font(U"Siv3D").draw();
+	}
+
+	System::Update();
+
+	REQUIRE(Profiler::GetStat().fontShapingCacheMisses >= 1);
+	REQUIRE(Profiler::GetStat().fontShapingCacheHits >= 9);
+}
+
+TEST_CASE("Font::saveGlyphCache() / loadGlyphCache()")
+{
+	const String text = (MakeCJKText(300) + U"ABCabc123ABC");
+	const FilePath path = U"test/font_glyph_cache.bin";
+
+	for (const FontMethod method : { FontMethod::Bitmap, FontMethod::SDF, FontMethod::MSDF })
+	{
+		const Font saved{ method, 32, Typeface::CJK_Regular_JP };
+		REQUIRE(saved.preload(text));
+		REQUIRE(saved.saveGlyphCache(path));
+
+		// 読み込んだアトラスは保存したアトラスと一致し、グリフを再生成しない
+		const Font loaded{ method, 32, Typeface::CJK_Regular_JP };
+		REQUIRE(loaded.loadGlyphCache(path));
+
+		const Image savedImage = ReadTexture(saved.getTexture());
+		const Image loadedImage = ReadTexture(loaded.getTexture());
+		REQUIRE(savedImage.size() == loadedImage.size());
+		REQUIRE(std::equal(savedImage.begin(), savedImage.end(), loadedImage.begin()));
+
+		REQUIRE(loaded.preload(text));
+		const Image preloadedImage = ReadTexture(loaded.getTexture());
+		REQUIRE(std::equal(preloadedImage.begin(), preloadedImage.end(), loadedImage.begin(), loadedImage.end()));
+
+		// フォントサイズや余白が異なるフォントには読み込めない
+		REQUIRE(not Font{ method, 40, Typeface::CJK_Regular_JP }.loadGlyphCache(path));
+		REQUIRE(not Font{ method, 32, Typeface::CJK_Regular_KR }.loadGlyphCache(path));
+
+		if (method != FontMethod::Bitmap)
+		{
+			const Font font{ method, 32, Typeface::CJK_Regular_JP };
+			font.setBufferThickness(4);
+			REQUIRE(not font.loadGlyphCache(path));
+		}
+
+		REQUIRE(FileSystem::Remove(path));
+	}
+
+	REQUIRE(not Font{ 32 }.loadGlyphCache(path));
+}
+
+TEST_CASE("Font::loadGlyphCache() : out-of-page values")
+{
+	const FilePath path = U"test/font_glyph_cache.bin";
+	{
+		const Font font{ 32, Typeface::CJK_Regular_JP };
+		REQUIRE(font.preload(MakeCJKText(300)));
+		REQUIRE(font.saveGlyphCache(path));
+	}
+
+	const Blob blob{ path };
+
+	const auto readInt32 = [&](const size_t offset)
+	{
+		int32 value = 0;
+		std::memcpy(&value, (blob.data() + offset), sizeof(value));
+		return value;
+	};
+
+	// ファイルの構成: ヘッダ (48 バイト), ページ数, 現在のページ, 各ページ (幅, 高さ, ペンの位置 x, y, 行の最大の高さ, 画像), グリフ数, 各グリフ
+	const size_t firstPageOffset = 56;
+	const int32 pageWidth = readInt32(firstPageOffset);
+	size_t offset = firstPageOffset;
+
+	for (int32 i = 0; i < readInt32(48); ++i)
+	{
+		offset += (20 + static_cast<size_t>(readInt32(offset)) * readInt32(offset + 4) * sizeof(Color));
+	}
+
+	// 最初のグリフの、グリフインデックス (4 バイト) と GlyphInfo (36 バイト) の後のテクスチャ領域
+	const size_t textureRegionOffset = (offset + 4 + 40);
+
+	const auto loadModified = [&](const size_t offset, const auto value)
+	{
+		Blob modified = blob;
+		std::memcpy((modified.data() + offset), &value, sizeof(value));
+		modified.save(path);
+		return Font{ 32, Typeface::CJK_Regular_JP }.loadGlyphCache(path);
+	};
+
+	REQUIRE(loadModified(firstPageOffset, pageWidth));
+
+	// ペンの位置
+	REQUIRE(not loadModified((firstPageOffset + 8), int32{ -1 }));
+	REQUIRE(not loadModified((firstPageOffset + 8), int32{ pageWidth + 1 }));
+	REQUIRE(not loadModified((firstPageOffset + 12), int32{ 100000 }));
+
+	// グリフのテクスチャ領域
+	REQUIRE(not loadModified(textureRegionOffset, int16{ -1 }));
+	REQUIRE(not loadModified((textureRegionOffset + 2), Largest<int16>));
+	REQUIRE(not loadModified((textureRegionOffset + 4), Largest<int16>));
+
+	REQUIRE(FileSystem::Remove(path));
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Font : benchmark")
+{
+	const String text = MakeCJKText(3000);
+
+	for (const FontMethod method : { FontMethod::SDF, FontMethod::MSDF })
+	{
+		const String name = ((method == FontMethod::SDF) ? U"SDF" : U"MSDF");
+
+		// 1 文字ずつ生成する (並列化される前と同じ処理量)
+		BENCHMARK(U"{} | cold preload() one by one | 3000 glyphs"_fmt(name).narrow())
+		{
+			const Font font{ method, 20, Typeface::CJK_Regular_JP };
+
+			for (const char32 ch : text)
+			{
+				font.preload(StringView{ &ch, 1 });
+			}
+
+			return font.getTexture().height();
+		};
+
+		BENCHMARK(U"{} | cold preload() | 3000 glyphs"_fmt(name).narrow())
+		{
+			const Font font{ method, 20, Typeface::CJK_Regular_JP };
+			font.preload(text);
+			return font.getTexture().height();
+		};
+
+		{
+			const Font font{ method, 20, Typeface::CJK_Regular_JP };
+			font.preload(text);
+			font.saveGlyphCache(U"test/font_glyph_cache.bin");
+		}
+
+		BENCHMARK(U"{} | loadGlyphCache() | 3000 glyphs"_fmt(name).narrow())
+		{
+			const Font font{ method, 20, Typeface::CJK_Regular_JP };
+			font.loadGlyphCache(U"test/font_glyph_cache.bin");
+			return font.getTexture().height();
+		};
+
+		FileSystem::Remove(U"test/font_glyph_cache.bin");
+	}
+}
+
+# endif
@@ -10,6 +10,91 @@
 //-----------------------------------------------
 
 # include "Siv3DTest.hpp"
+# include "../Siv3D/src/Siv3D/Image/ImageFilter.hpp"
+
+namespace
+{
+	struct ImageFilterKernels
+	{
+		void (*negate)(Color*, size_t);
+
+		void (*grayscale)(Color*, size_t);
+
+		void (*sepia)(Color*, size_t);
+
+		void (*brighten)(Color*, size_t, int32);
+
+		void (*threshold)(Color*, size_t, uint8, bool);
+
+		void (*swapRB)(Color*, size_t);
+
+		void (*reverse)(Color*, size_t);
+
+		void (*reverseCopy)(const Color*, Color*, size_t);
+
+		// 実装が無い場合は nullptr
+		void (*rotate90)(const Color*, Color*, size_t, size_t);
+
+		void (*rotate270)(const Color*, Color*, size_t, size_t);
+	};
+
+	// CPU による分岐を通さずに、kernels と _Reference の結果を同じ入力で比べる
+	void CheckImageFilterKernels(const Image& image, const ImageFilterKernels& kernels)
+	{
+		const size_t num_pixels = image.num_pixels();
+
+		// SIMD の端数処理の各場合を通るよう、要素数を変える
+		for (const size_t count : { size_t{ 0 }, size_t{ 1 }, size_t{ 3 }, size_t{ 7 }, size_t{ 9 }, size_t{ 17 }, num_pixels })
+		{
+			const auto Apply = [&](auto f)
+			{
+				Array<Color> pixels(image.begin(), (image.begin() + count));
+				f(pixels.data());
+				return pixels;
+			};
+
+			REQUIRE(Apply([&](Color* p) { kernels.negate(p, count); }) == Apply([&](Color* p) { ImageFilter::Negate_Reference(p, count); }));
+			REQUIRE(Apply([&](Color* p) { kernels.grayscale(p, count); }) == Apply([&](Color* p) { ImageFilter::Grayscale_Reference(p, count); }));
+			REQUIRE(Apply([&](Color* p) { kernels.sepia(p, count); }) == Apply([&](Color* p) { ImageFilter::Sepia_Reference(p, count); }));
+			REQUIRE(Apply([&](Color* p) { kernels.swapRB(p, count); }) == Apply([&](Color* p) { ImageFilter::SwapRB_Reference(p, count); }));
+			REQUIRE(Apply([&](Color* p) { kernels.reverse(p, count); }) == Apply([&](Color* p) { ImageFilter::Reverse_Reference(p, count); }));
+
+			for (const int32 level : { -300, -40, 0, 40, 300 })
+			{
+				REQUIRE(Apply([&](Color* p) { kernels.brighten(p, count, level); }) == Apply([&](Color* p) { ImageFilter::Brighten_Reference(p, count, level); }));
+			}
+
+			for (const uint8 threshold : { 0, 100, 255 })
+			{
+				for (const bool invertColor : { false, true })
+				{
+					REQUIRE(Apply([&](Color* p) { kernels.threshold(p, count, threshold, invertColor); }) == Apply([&](Color* p) { ImageFilter::Threshold_Reference(p, count, threshold, invertColor); }));
+				}
+			}
+
+			{
+				Array<Color> a(count), b(count);
+				kernels.reverseCopy(image.data(), a.data(), count);
+				ImageFilter::ReverseCopy_Reference(image.data(), b.data(), count);
+				REQUIRE(a == b);
+			}
+		}
+
+		if (kernels.rotate90)
+		{
+			const size_t width = image.width(), height = image.height();
+			Array<Color> a(num_pixels), b(num_pixels);
+
+			kernels.rotate90(image.data(), a.data(), width, height);
+			ImageFilter::Rotate90_Reference(image.data(), b.data(), width, height);
+			REQUIRE(a == b);
+
+			kernels.rotate270(image.data(), a.data(), width, height);
+			ImageFilter::Rotate270_Reference(image.data(), b.data(), width, height);
+			REQUIRE(a == b);
+		}
+	}
+}
 
 TEST_CASE("Image")
 {
@@ -201,3 +286,218 @@ TEST_CASE("Image")
 		}
 	}
 }
+
+TEST_CASE("Image : Parallel")
+{
+	Image image{ Size{ 317, 211 } };
+
+	for (auto& pixel : image)
+	{
+		pixel = Color{ RandomUint8(), RandomUint8(), RandomUint8(), RandomUint8() };
+	}
+
+	REQUIRE(image.negated(Parallel::Yes).asArray() == image.negated().asArray());
+	REQUIRE(image.grayscaled(Parallel::Yes).asArray() == image.grayscaled().asArray());
+	REQUIRE(image.sepiaed(Parallel::Yes).asArray() == image.sepiaed().asArray());
+	REQUIRE(image.posterized(4, Parallel::Yes).asArray() == image.posterized(4).asArray());
+	REQUIRE(image.brightened(40, Parallel::Yes).asArray() == image.brightened(40).asArray());
+	REQUIRE(image.brightened(-40, Parallel::Yes).asArray() == image.brightened(-40).asArray());
+	REQUIRE(image.gammaCorrected(0.5, Parallel::Yes).asArray() == image.gammaCorrected(0.5).asArray());
+
+	{
+		Image a = image, b = image;
+		a.negate(Parallel::Yes).grayscale(Parallel::Yes);
+		b.negate().grayscale();
+		REQUIRE(a.asArray() == b.asArray());
+	}
+}
+
+TEST_CASE("Image : Filters")
+{
+	// SIMD の端数処理も通るよう、幅と高さは 4, 8 の倍数にしない
+	Image image{ Size{ 37, 23 } };
+
+	for (auto& pixel : image)
+	{
+		pixel = Color{ RandomUint8(), RandomUint8(), RandomUint8(), RandomUint8() };
+	}
+
+	const auto ForEach = [](Image src, auto f)
+	{
+		for (auto& pixel : src)
+		{
+			f(pixel);
+		}
+
+		return src;
+	};
+
+	REQUIRE(image.negated().asArray() == ForEach(image, [](Color& c) { c = ~c; }).asArray());
+
+	REQUIRE(image.grayscaled().asArray() == ForEach(image, [](Color& c) { c.setRGB(c.grayscale0_255()); }).asArray());
+
+	REQUIRE(image.sepiaed().asArray() == ForEach(image, [](Color& c)
+	{
+		const uint8 r = static_cast<uint8>(Min(((0.393 * c.r) + (0.769 * c.g) + (0.189 * c.b)), 255.0));
+		const uint8 g = static_cast<uint8>(Min(((0.349 * c.r) + (0.686 * c.g) + (0.168 * c.b)), 255.0));
+		const uint8 b = static_cast<uint8>(Min(((0.272 * c.r) + (0.534 * c.g) + (0.131 * c.b)), 255.0));
+		c.setRGB(r, g, b);
+	}).asArray());
+
+	for (const int32 level : { -300, -40, 40, 300 })
+	{
+		REQUIRE(image.brightened(level).asArray() == ForEach(image, [=](Color& c)
+		{
+			c.setRGB(static_cast<uint8>(Clamp((c.r + level), 0, 255)), static_cast<uint8>(Clamp((c.g + level), 0, 255)), static_cast<uint8>(Clamp((c.b + level), 0, 255)));
+		}).asArray());
+	}
+
+	for (const uint8 threshold : { 0, 100, 255 })
+	{
+		REQUIRE(image.thresholded(threshold).asArray() == ForEach(image, [=](Color& c) { c.setRGB(((threshold / 255.0) < c.grayscale()) ? 255 : 0); }).asArray());
+		REQUIRE(image.thresholded(threshold, InvertColor::Yes).asArray() == ForEach(image, [=](Color& c) { c.setRGB(((threshold / 255.0) < c.grayscale()) ? 0 : 255); }).asArray());
+	}
+
+	REQUIRE(Image{ image }.RGBAtoBGRA().asArray() == ForEach(image, [](Color& c) { std::swap(c.r, c.b); }).asArray());
+
+	{
+		const Image mirrored = image.mirrored();
+		const Image rotated90 = image.rotated90();
+		const Image rotated180 = image.rotated180();
+		const Image rotated270 = image.rotated270();
+		REQUIRE(rotated90.size() == Size{ image.height(), image.width() });
+		REQUIRE(rotated270.size() == Size{ image.height(), image.width() });
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				REQUIRE(mirrored[y][image.width() - x - 1] == image[y][x]);
+				REQUIRE(rotated90[x][image.height() - y - 1] == image[y][x]);
+				REQUIRE(rotated180[image.height() - y - 1][image.width() - x - 1] == image[y][x]);
+				REQUIRE(rotated270[image.width() - x - 1][y] == image[y][x]);
+			}
+		}
+
+		REQUIRE(Image{ image }.mirror().asArray() == mirrored.asArray());
+		REQUIRE(Image{ image }.rotate90().asArray() == rotated90.asArray());
+		REQUIRE(Image{ image }.rotate180().asArray() == rotated180.asArray());
+		REQUIRE(Image{ image }.rotate270().asArray() == rotated270.asArray());
+	}
+
+	// 実行環境で選ばれない経路も含め、対応している SIMD 実装をすべて確かめる
+# if SIV3D_INTRINSIC(SSE)
+
+	if (GetCPUInfo().features.sse4_1)
+	{
+		CheckImageFilterKernels(image, { ImageFilter::Negate_SSE4_1, ImageFilter::Grayscale_SSE4_1, ImageFilter::Sepia_SSE4_1,
+			ImageFilter::Brighten_SSE4_1, ImageFilter::Threshold_SSE4_1, ImageFilter::SwapRB_SSE4_1, ImageFilter::Reverse_SSE4_1,
+			ImageFilter::ReverseCopy_SSE4_1, ImageFilter::Rotate90_SSE4_1, ImageFilter::Rotate270_SSE4_1 });
+	}
+
+# endif
+
+# if SIV3D_IMAGE_FILTER_AVX2
+
+	if (GetCPUInfo().features.avx2)
+	{
+		CheckImageFilterKernels(image, { ImageFilter::Negate_AVX2, ImageFilter::Grayscale_AVX2, ImageFilter::Sepia_AVX2,
+			ImageFilter::Brighten_AVX2, ImageFilter::Threshold_AVX2, ImageFilter::SwapRB_AVX2, ImageFilter::Reverse_AVX2,
+			ImageFilter::ReverseCopy_AVX2, nullptr, nullptr });
+	}
+
+# endif
+}
+
+TEST_CASE("Grid : Parallel")
+{
+	Grid<int32> grid(123, 77);
+
+	for (size_t i = 0; i < grid.num_elements(); ++i)
+	{
+		grid.data()[i] = static_cast<int32>(i);
+	}
+
+	{
+		Grid<int32> g = grid;
+		g.parallel_each([](int32& n) { n *= 3; });
+		REQUIRE(g == grid.map([](int32 n) { return (n * 3); }));
+	}
+
+	{
+		int64 sum = 0;
+		std::mutex mutex;
+		grid.parallel_each([&](int32 n) { std::lock_guard lock{ mutex }; sum += n; });
+		REQUIRE(sum == (static_cast<int64>(grid.num_elements()) * (static_cast<int64>(grid.num_elements()) - 1) / 2));
+	}
+
+	REQUIRE(grid.parallel_map([](int32 n) { return (n * 0.5); }) == grid.map([](int32 n) { return (n * 0.5); }));
+
+	{
+		Grid<int32> g = grid;
+		g.parallel_transform([](int32 n) { return (n + 1); });
+		REQUIRE(g == grid.map([](int32 n) { return (n + 1); }));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Image::grayscale() : benchmark")
+{
+	Image image{ Size{ 3840, 2160 }, Palette::Orange };
+
+	BENCHMARK("Image::grayscale() | 4K")
+	{
+		image.grayscale();
+		return image[0][0];
+	};
+
+	BENCHMARK("Image::grayscale(Parallel::Yes) | 4K")
+	{
+		image.grayscale(Parallel::Yes);
+		return image[0][0];
+	};
+
+	BENCHMARK("Image::sepia() | 4K")
+	{
+		image.sepia();
+		return image[0][0];
+	};
+
+	BENCHMARK("Image::rotate90() | 4K")
+	{
+		image.rotate90();
+		return image[0][0];
+	};
+
+	BENCHMARK("Image::gammaCorrect() | 4K")
+	{
+		image.gammaCorrect(0.9);
+		return image[0][0];
+	};
+
+	BENCHMARK("Image::gammaCorrect(Parallel::Yes) | 4K")
+	{
+		image.gammaCorrect(0.9, Parallel::Yes);
+		return image[0][0];
+	};
+}
+
+TEST_CASE("Grid::parallel_transform() : benchmark")
+{
+	Grid<double> grid(1024, 1024, 1.0);
+
+	BENCHMARK("Grid::each() | 1M")
+	{
+		grid.each([](double& x) { x = std::sqrt(x + 1.0); });
+		return grid[0][0];
+	};
+
+	BENCHMARK("Grid::parallel_transform() | 1M")
+	{
+		grid.parallel_transform([](double x) { return std::sqrt(x + 1.0); });
+		return grid[0][0];
+	};
+}
+
+# endif
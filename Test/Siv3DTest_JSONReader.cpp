@@ -0,0 +1,343 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+SIV3D_DISABLE_MSVC_WARNINGS_PUSH(4566)
+
+namespace
+{
+	// 受け取ったイベントを文字列にして記録する
+	struct EventLogger : IJSONHandler
+	{
+		String log;
+
+		size_t errorCount = 0;
+
+		bool onNull() override { log += U"null "; return true; }
+
+		bool onBool(const bool value) override { log += (value ? U"true " : U"false "); return true; }
+
+		bool onInt64(const int64 value) override { log += U"i{} "_fmt(value); return true; }
+
+		bool onUint64(const uint64 value) override { log += U"u{} "_fmt(value); return true; }
+
+		bool onDouble(const double value) override { log += U"d{:.1f} "_fmt(value); return true; }
+
+		bool onString(const StringView value) override { log += U"s[{}] "_fmt(value); return true; }
+
+		bool onKey(const StringView key) override { log += U"k[{}] "_fmt(key); return true; }
+
+		bool onObjectBegin() override { log += U"{ "; return true; }
+
+		bool onObjectEnd() override { log += U"} "; return true; }
+
+		bool onArrayBegin() override { log += U"[ "; return true; }
+
+		bool onArrayEnd() override { log += U"] "; return true; }
+
+		void onError(size_t, StringView) override { ++errorCount; }
+	};
+
+	// JSONValueView と JSON が同じ値を表すかを調べる
+	[[nodiscard]]
+	bool IsSameValue(const JSONValueView& view, const JSON& json)
+	{
+		if (view.getType() != json.getType())
+		{
+			return false;
+		}
+
+		switch (json.getType())
+		{
+		case JSONValueType::Null:
+			return true;
+		case JSONValueType::Bool:
+			return (view.get<bool>() == json.get<bool>());
+		case JSONValueType::Number:
+			return (view.isInteger() ? (view.get<int64>() == json.get<int64>()) : (view.get<double>() == json.get<double>()));
+		case JSONValueType::String:
+			return (view.getString() == json.getString());
+		case JSONValueType::Array:
+			{
+				if (view.size() != json.size())
+				{
+					return false;
+				}
+
+				size_t i = 0;
+
+				for (const auto& element : view)
+				{
+					if (not IsSameValue(element, json[i++]))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		case JSONValueType::Object:
+			{
+				if (view.size() != json.size())
+				{
+					return false;
+				}
+
+				for (const auto& element : view)
+				{
+					if (not IsSameValue(element, json[element.key()]))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		default:
+			return false;
+		}
+	}
+}
+
+TEST_CASE("JSONReader")
+{
+	SECTION("Nonexist")
+	{
+		const JSONReader reader{ U"test/json/nonexist.json" };
+		REQUIRE(reader.isOpen() == false);
+		REQUIRE(static_cast<bool>(reader) == false);
+		REQUIRE(reader.root().isEmpty());
+
+		EventLogger logger;
+		REQUIRE(reader.read(logger) == false);
+	}
+
+	const FilePath path = U"test/runtime/jsonreader/sample.json";
+	TestUtil::WriteBytes(path,
+		"\xEF\xBB\xBF{\n"
+		"\t\"name\": \"Siv3D \\u3042\\n\\\"\xF0\x9F\x98\x80\",\n"
+		"\t\"version\": [0, 6, -1, 18446744073709551615],\n"
+		"\t\"ratio\": 1.5e2,\n"
+		"\t\"enabled\": true,\n"
+		"\t\"empty\": {},\n"
+		"\t\"items\": [{ \"id\": 1, \"tag\": null }, { \"id\": 2, \"tag\": \"b\" }],\n"
+		"\t\"dup\": 1,\n"
+		"\t\"dup\": 2\n"
+		"}\n");
+
+	SECTION("read()")
+	{
+		const JSONReader reader{ path };
+		REQUIRE(reader.isOpen());
+
+		EventLogger logger;
+		REQUIRE(reader.read(logger));
+		REQUIRE(logger.errorCount == 0);
+		REQUIRE(logger.log == U"{ k[name] s[Siv3D あ\n\"😀] k[version] [ u0 u6 i-1 u18446744073709551615 ] k[ratio] d150.0 k[enabled] true "
+			U"k[empty] { } k[items] [ { k[id] u1 k[tag] null } { k[id] u2 k[tag] s[b] } ] k[dup] u1 k[dup] u2 } ");
+	}
+
+	SECTION("read() can be stopped")
+	{
+		struct FirstKey : IJSONHandler
+		{
+			String key;
+
+			bool onKey(const StringView k) override
+			{
+				key = k;
+				return false;
+			}
+		};
+
+		const JSONReader reader{ path };
+		FirstKey handler;
+		REQUIRE(reader.read(handler) == false);
+		REQUIRE(handler.key == U"name");
+	}
+
+	SECTION("root()")
+	{
+		const JSONReader reader{ path };
+		const JSONValueView root = reader.root();
+		REQUIRE(root.isObject());
+		REQUIRE(root.size() == 8);
+
+		REQUIRE(root[U"name"].getString() == U"Siv3D あ\n\"😀");
+		REQUIRE(root[U"name"].raw() == "\"Siv3D \\u3042\\n\\\"\xF0\x9F\x98\x80\"");
+		REQUIRE(root[U"version"].size() == 4);
+		REQUIRE(root[U"version"][1].get<int32>() == 6);
+		REQUIRE(root[U"version"][2].get<int32>() == -1);
+		REQUIRE(root[U"version"][3].get<uint64>() == 18446744073709551615ull);
+		REQUIRE(root[U"version"][3].isUnsigned());
+		REQUIRE(root[U"version"][4].isEmpty());
+		REQUIRE(root[U"ratio"].isFloat());
+		REQUIRE(root[U"ratio"].get<double>() == 150.0);
+		REQUIRE(root[U"enabled"].get<bool>() == true);
+		REQUIRE(root[U"empty"].isObject());
+		REQUIRE(root[U"empty"].size() == 0);
+		REQUIRE(root[U"items"][1][U"tag"].getString() == U"b");
+		REQUIRE(root[U"items"][0][U"tag"].isNull());
+		REQUIRE(root[U"dup"].get<int32>() == 2);
+
+		REQUIRE(root.hasElement(U"items"));
+		REQUIRE(root.hasElement(U"nonexist") == false);
+		REQUIRE(root[U"nonexist"].isEmpty());
+		REQUIRE(root[U"nonexist"].getOr<int32>(-1) == -1);
+		REQUIRE(root[U"name"].getOpt<int32>().has_value() == false);
+		REQUIRE_THROWS_AS(root[U"name"].get<int32>(), Error);
+
+		Array<String> keys;
+
+		for (const auto& element : root)
+		{
+			keys << element.key();
+		}
+
+		REQUIRE(keys == Array<String>{ U"name", U"version", U"ratio", U"enabled", U"empty", U"items", U"dup", U"dup" });
+
+		REQUIRE(root[U"items"][0].toJSON() == JSON::Parse(U"{ \"id\": 1, \"tag\": null }"));
+		REQUIRE(IsSameValue(root[U"items"], JSON::Load(path)[U"items"]));
+	}
+
+	SECTION("Invalid")
+	{
+		for (const auto& text : { "", "{", "[1, 2,]", "{\"a\" 1}", "\"\\x\"", "01", "1e400", "[1] 2", "\"\xFF\"" })
+		{
+			const FilePath invalidPath = U"test/runtime/jsonreader/invalid.json";
+			TestUtil::WriteBytes(invalidPath, text);
+
+			const JSONReader reader{ invalidPath };
+			REQUIRE(reader.isOpen());
+			REQUIRE(reader.root().isEmpty());
+
+			EventLogger logger;
+			REQUIRE(reader.read(logger) == false);
+			REQUIRE(logger.errorCount == 1);
+		}
+	}
+
+	SECTION("Embedded NUL")
+	{
+		// NUL 文字は入力の終わりとして扱われ、read() と root() と JSON::Load() の結果が一致する
+		for (const auto& text : { "-92233720368547758\0 9"sv, "[1, 2]\0garbage"sv, "[1, \0 2]"sv, "\"a\0b\""sv })
+		{
+			const FilePath nulPath = U"test/runtime/jsonreader/nul.json";
+			TestUtil::WriteBytes(nulPath, text);
+
+			const JSONReader reader{ nulPath };
+			REQUIRE(reader.isOpen());
+
+			EventLogger logger;
+			const bool accepted = reader.read(logger);
+			const JSON json = JSON::Load(nulPath);
+
+			REQUIRE(accepted == (not reader.root().isEmpty()));
+			REQUIRE(accepted == (not json.isEmpty()));
+
+			if (accepted)
+			{
+				REQUIRE(IsSameValue(reader.root(), json));
+			}
+		}
+	}
+
+	SECTION("Same as JSON::Load()")
+	{
+		const FilePath largePath = U"test/runtime/jsonreader/large.json";
+		{
+			TextWriter writer{ largePath, TextEncoding::UTF8_NO_BOM };
+			writer.write(U"[");
+
+			for (int32 i = 0; i < 10000; ++i)
+			{
+				writer.write(U"{}{{\"id\":{},\"name\":\"item\\t{}\",\"value\":{},\"tags\":[\"a\",{}]}}"_fmt((i ? U"," : U""), i, i, (i * -0.25), (i % 2 == 0)));
+			}
+
+			writer.write(U"]");
+		}
+
+		const JSONReader reader{ largePath };
+		const JSON json = JSON::Load(largePath);
+		REQUIRE(json.isArray());
+		REQUIRE(IsSameValue(reader.root(), json));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("JSONReader : benchmark")
+{
+	// 約 64 MB の JSON
+	const FilePath path = U"test/runtime/jsonreader/benchmark/large.json";
+	{
+		TextWriter writer{ path, TextEncoding::UTF8_NO_BOM };
+		writer.write(U"[");
+
+		for (int64 i = 0; i < 640'000; ++i)
+		{
+			writer.write(U"{}{{\"id\":{},\"x\":{:.3f},\"y\":{:.3f},\"label\":\"label-{}\",\"tags\":[\"a\",\"b\"],\"ok\":true}}"_fmt((i ? U",\n" : U""), i, (i * 0.001), (i * 0.002), (i % 1000)));
+		}
+
+		writer.write(U"]");
+	}
+
+	const double megaBytes = (FileSystem::FileSize(path) / (1024.0 * 1024.0));
+
+	TestUtil::ReportReadThroughput(U"JSON::Load()", megaBytes, [&]()
+	{
+		const JSON json = JSON::Load(path);
+		double sum = 0.0;
+
+		for (const auto& element : json.arrayView())
+		{
+			sum += element[U"x"].get<double>();
+		}
+
+		return static_cast<size_t>(sum);
+	});
+
+	TestUtil::ReportReadThroughput(U"JSONReader::read()", megaBytes, [&]()
+	{
+		struct Sum : IJSONHandler
+		{
+			double sum = 0.0;
+
+			bool onDouble(const double value) override
+			{
+				sum += value;
+				return true;
+			}
+		};
+
+		Sum handler;
+		JSONReader{ path }.read(handler);
+		return static_cast<size_t>(handler.sum);
+	});
+
+	TestUtil::ReportReadThroughput(U"JSONReader::root()", megaBytes, [&]()
+	{
+		const JSONReader reader{ path };
+		double sum = 0.0;
+
+		for (const auto& element : reader.root())
+		{
+			sum += element[U"x"].get<double>();
+		}
+
+		return static_cast<size_t>(sum);
+	});
+}
+
+# endif
+
+SIV3D_DISABLE_MSVC_WARNINGS_POP()
@@ -0,0 +1,100 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/EngineLog.hpp>
+
+TEST_CASE("Logger::setOutputFile()")
+{
+	SECTION("write")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/logger/log.txt");
+		REQUIRE(Logger.setOutputFile(path));
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			Logger << U"Logger test " << i;
+		}
+
+		Logger.flush();
+		REQUIRE(Logger.setOutputFile(U""));
+
+		// ログは出力した順に書き込まれる
+		TextReader reader{ path };
+		String line;
+		int32 count = 0;
+
+		while (reader.readLine(line))
+		{
+			if (line.includes(U"Logger test "))
+			{
+				REQUIRE(line.ends_with(U"Logger test {}"_fmt(count)));
+				++count;
+			}
+		}
+
+		REQUIRE(count == 100);
+	}
+
+	SECTION("rotation")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/logger/rotation.txt");
+		REQUIRE(Logger.setOutputFile(path, 1024, 2));
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			Logger << U"Logger rotation test " << i;
+		}
+
+		Logger.flush();
+		REQUIRE(Logger.setOutputFile(U""));
+
+		REQUIRE(FileSystem::Exists(path));
+		REQUIRE(FileSystem::Exists(path + U".1"));
+		REQUIRE(FileSystem::Exists(path + U".2"));
+		REQUIRE(not FileSystem::Exists(path + U".3"));
+		REQUIRE(FileSystem::FileSize(path) <= 1024);
+		REQUIRE(FileSystem::FileSize(path + U".1") <= 1024);
+	}
+
+	SECTION("error")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/logger/error.txt");
+		REQUIRE(Logger.setOutputFile(path));
+		Logger.flush();
+		const int64 size = FileSystem::FileSize(path);
+
+		// エラーは flush() を呼ばなくても、戻る前にファイルに書き込まれる
+		Internal::OutputEngineLog(LogType::Error, U"Logger error test");
+		REQUIRE(FileSystem::FileSize(path) > size);
+
+		REQUIRE(Logger.setOutputFile(U""));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Logger : benchmark")
+{
+	BENCHMARK("Logger | 10000 lines")
+	{
+		for (int32 i = 0; i < 10000; ++i)
+		{
+			Logger << U"Logger benchmark " << i;
+		}
+
+		return 0;
+	};
+
+	Logger.flush();
+}
+
+# endif
@@ -0,0 +1,202 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("MappedReader")
+{
+	SECTION("default")
+	{
+		MappedReader reader;
+		REQUIRE(reader.supportsLookahead() == true);
+		REQUIRE(reader.isOpen() == false);
+		REQUIRE(static_cast<bool>(reader) == false);
+		REQUIRE(reader.size() == 0);
+		REQUIRE(reader.getPos() == 0);
+		REQUIRE(reader.span().empty());
+		REQUIRE(reader.path() == U"");
+	}
+
+	SECTION("Nonexist")
+	{
+		MappedReader reader{ U"test/binary/nonexist.bin" };
+		REQUIRE(reader.isOpen() == false);
+		REQUIRE(reader.size() == 0);
+		REQUIRE(reader.span().empty());
+	}
+
+	SECTION("Directory")
+	{
+		MappedReader reader{ U"test/binary/" };
+		REQUIRE(reader.isOpen() == false);
+	}
+
+	SECTION("empty")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/binary/empty.bin");
+		MappedReader reader{ path };
+		REQUIRE(reader.isOpen() == true);
+		REQUIRE(reader.size() == 0);
+		REQUIRE(reader.span().empty());
+		REQUIRE(reader.path() == path);
+
+		uint8 value = 0;
+		REQUIRE(reader.read(value) == false);
+
+		reader.close();
+		REQUIRE(reader.isOpen() == false);
+		REQUIRE(reader.path() == U"");
+	}
+
+	SECTION("large")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/binary/large.bin");
+		MappedReader reader{ path };
+		REQUIRE(reader.isOpen() == true);
+		REQUIRE(reader.size() == 130'064);
+		REQUIRE(reader.span().size() == 130'064);
+		REQUIRE(reader.path() == path);
+
+		const Blob blob{ path };
+		REQUIRE(std::memcmp(reader.span().data(), blob.data(), blob.size()) == 0);
+
+		reader.skip(100);
+		REQUIRE(reader.remaining().size() == (130'064 - 100));
+		REQUIRE(reader.remaining().data() == (reader.span().data() + 100));
+
+		reader.close();
+		REQUIRE(reader.isOpen() == false);
+		REQUIRE(reader.size() == 0);
+		REQUIRE(reader.getPos() == 0);
+		REQUIRE(reader.span().empty());
+	}
+}
+
+TEST_CASE("MappedReader matches BinaryReader")
+{
+	const FilePath path = FileSystem::FullPath(U"test/binary/small.bin");
+	MappedReader mapped{ path };
+	BinaryReader binary{ path };
+	REQUIRE(mapped.size() == binary.size());
+
+	const std::array<int64, 8> positions = { -1, 0, 1, 100, 254, 255, 256, 1000 };
+	const std::array<int64, 6> sizes = { -1, 0, 1, 16, 254, 300 };
+
+	for (const int64 pos : positions)
+	{
+		REQUIRE(mapped.setPos(pos) == binary.setPos(pos));
+		REQUIRE(mapped.getPos() == binary.getPos());
+
+		for (const int64 size : sizes)
+		{
+			std::array<uint8, 300> a{}, b{};
+			REQUIRE(mapped.lookahead(a.data(), pos, size) == binary.lookahead(b.data(), pos, size));
+			REQUIRE(a == b);
+			REQUIRE(mapped.lookahead(a.data(), size) == binary.lookahead(b.data(), size));
+			REQUIRE(a == b);
+			REQUIRE(mapped.read(a.data(), pos, size) == binary.read(b.data(), pos, size));
+			REQUIRE(a == b);
+			REQUIRE(mapped.getPos() == binary.getPos());
+			REQUIRE(mapped.read(a.data(), size) == binary.read(b.data(), size));
+			REQUIRE(a == b);
+			REQUIRE(mapped.getPos() == binary.getPos());
+			REQUIRE(mapped.skip(size) == binary.skip(size));
+		}
+	}
+}
+
+TEST_CASE("MappedReader decoding")
+{
+	SECTION("TextReader")
+	{
+		for (const auto& path : { U"test/text/utf8_no_bom.txt", U"test/text/utf8_with_bom.txt", U"test/text/utf16_le.txt", U"test/text/utf16_be.txt" })
+		{
+			TextReader expected{ path };
+			TextReader actual{ std::make_unique<MappedReader>(path) };
+			REQUIRE(actual.encoding() == expected.encoding());
+			REQUIRE(actual.readAll() == expected.readAll());
+		}
+	}
+
+	SECTION("Image")
+	{
+		for (const auto& path : FileSystem::DirectoryContents(U"test/image/", Recursive::Yes))
+		{
+			if (FileSystem::IsDirectory(path))
+			{
+				continue;
+			}
+
+			BinaryReader binary{ path };
+			MappedReader mapped{ path };
+			const Image expected = ImageDecoder::Decode(binary);
+			const Image actual = ImageDecoder::Decode(mapped);
+			REQUIRE(actual.size() == expected.size());
+			REQUIRE(std::equal(actual.begin(), actual.end(), expected.begin()));
+		}
+	}
+
+	SECTION("JSON")
+	{
+		const FilePath path = U"test/runtime/mappedreader/test.json";
+		{
+			TextWriter writer{ path, TextEncoding::UTF8_NO_BOM };
+			writer.write(U"{\"a\": [1, 2.5, \"\u3042\"],\r\n\"b\": {\"c\": null}}");
+		}
+
+		const JSON expected = JSON::Parse(TextReader{ path }.readAll());
+		const JSON actual = JSON::Load(path);
+		REQUIRE(actual.isObject());
+		REQUIRE(actual.formatMinimum() == expected.formatMinimum());
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("MappedReader : benchmark")
+{
+	// 約 16 MB の JSON
+	const FilePath path = U"test/runtime/mappedreader/benchmark/large.json";
+	{
+		TextWriter writer{ path, TextEncoding::UTF8_NO_BOM };
+		writer.writeln(U"[");
+
+		for (int32 i = 0; i < 250'000; ++i)
+		{
+			writer.writeln(U"{}{{\"id\":{},\"name\":\"item{}\",\"value\":{:.3f}}}"_fmt((i ? U"," : U""), i, i, (i * 0.5)));
+		}
+
+		writer.writeln(U"]");
+	}
+
+	const double megaBytes = (FileSystem::FileSize(path) / (1024.0 * 1024.0));
+
+	auto report = [&](const StringView name, auto f)
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+		const size_t count = f();
+		const double sec = stopwatch.sF();
+
+		Console << U"{} | {} elements : {:.1f} MB/s"_fmt(name, count, (megaBytes / sec));
+	};
+
+	report(U"JSON::Parse(TextReader::readAll())", [&]()
+	{
+		return JSON::Parse(TextReader{ path }.readAll()).size();
+	});
+
+	report(U"JSON::Load()", [&]()
+	{
+		return JSON::Load(path).size();
+	});
+}
+
+# endif
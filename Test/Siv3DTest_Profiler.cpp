@@ -0,0 +1,166 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Profiler::GetFrameMetrics()")
+{
+	const Font font{ 24 };
+
+	System::Update();
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		Rect{ (i * 4), 0, 4 }.draw();
+	}
+
+	font(U"FrameMetrics").draw();
+
+	System::Update();
+
+	const FrameMetrics& metrics = Profiler::GetFrameMetrics();
+	REQUIRE(metrics.drawCalls >= 1);
+	REQUIRE(metrics.triangleCount >= 200);
+	REQUIRE(metrics.vertexBytes >= (sizeof(Vertex2D) * 400));
+	REQUIRE(metrics.indexBytes >= (sizeof(Vertex2D::IndexType) * 600));
+	REQUIRE(metrics.getCommandCount(Renderer2DCommandType::Draw) >= 1);
+	REQUIRE(metrics.getCommandCount(Renderer2DCommandType::UpdateBuffers) >= 1);
+	REQUIRE(metrics.frameTime() >= Duration{ 0 });
+}
+
+TEST_CASE("Profiler::GetFrameMetricsHistory()")
+{
+	const size_t defaultSize = Profiler::GetFrameMetricsHistorySize();
+
+	Profiler::SetFrameMetricsHistorySize(4);
+	REQUIRE(Profiler::GetFrameMetricsHistorySize() == 4);
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		System::Update();
+	}
+
+	const Array<FrameMetrics> history = Profiler::GetFrameMetricsHistory();
+	REQUIRE(history.size() == 4);
+
+	// 古いフレームから順に並ぶ
+	for (size_t i = 1; i < history.size(); ++i)
+	{
+		REQUIRE(history[i - 1].frameCount < history[i].frameCount);
+	}
+
+	REQUIRE(history.back().frameCount == Profiler::GetFrameMetrics().frameCount);
+
+	Profiler::SetFrameMetricsHistorySize(defaultSize);
+}
+
+TEST_CASE("ArenaAllocator")
+{
+	System::Update();
+
+	{
+		Array<int32, ArenaAllocator<int32>> values;
+
+		for (int32 i = 0; i < 10000; ++i)
+		{
+			values << i;
+		}
+
+		REQUIRE(values.size() == 10000);
+		REQUIRE(values.front() == 0);
+		REQUIRE(values.back() == 9999);
+	}
+
+	System::Update();
+
+	const FrameMetrics& metrics = Profiler::GetFrameMetrics();
+	REQUIRE(metrics.arenaBytes >= (sizeof(int32) * 10000));
+}
+
+TEST_CASE("ArenaAllocator : lifetime")
+{
+	System::Update();
+
+	SECTION("Deallocate on another thread")
+	{
+		auto values = std::make_unique<Array<int32, ArenaAllocator<int32>>>(1000, 1);
+		std::thread{ [&]() { values.reset(); } }.join();
+		REQUIRE(values == nullptr);
+	}
+
+	SECTION("Allocation that outlives the frame")
+	{
+		// フレームをまたいで保持されたメモリがあっても、以降のフレームでアリーナを使い続けられる
+		const Array<int32, ArenaAllocator<int32>> held(100, 1);
+		size_t arenaFrames = 0;
+
+		for (int32 i = 0; i < 60; ++i)
+		{
+			{
+				const Array<int32, ArenaAllocator<int32>> values((256 * 1024), i);
+			}
+
+			System::Update();
+
+			if (Profiler::GetFrameMetrics().arenaBytes >= (sizeof(int32) * 256 * 1024))
+			{
+				++arenaFrames;
+			}
+		}
+
+		REQUIRE(arenaFrames == 60);
+		REQUIRE(held.back() == 1);
+	}
+
+	System::Update();
+}
+
+TEST_CASE("AllocationTracker")
+{
+	if (not AllocationTracker::IsAvailable())
+	{
+		REQUIRE(AllocationTracker::GetTotalStat().totalCount == 0);
+		return;
+	}
+
+	SECTION("tag")
+	{
+		const AllocationStat before = AllocationTracker::GetStat(AllocationTag::Image);
+		{
+			const Image image{ U"test/image/bmp/3x3_24.bmp" };
+			const AllocationStat stat = AllocationTracker::GetStat(AllocationTag::Image);
+			REQUIRE((before.currentBytes + image.size_bytes()) <= stat.currentBytes);
+			REQUIRE(stat.currentBytes <= stat.peakBytes);
+		}
+
+		{
+			const ScopedAllocationTag allocationTag{ AllocationTag::Wave };
+			const AllocationStat stat = AllocationTracker::GetStat(AllocationTag::Wave);
+			const Array<int32> values(1000);
+			REQUIRE((stat.currentBytes + values.size_bytes()) <= AllocationTracker::GetStat(AllocationTag::Wave).currentBytes);
+		}
+	}
+
+	SECTION("sites")
+	{
+		AllocationTracker::EnableSiteTracking(true);
+
+		const Array<int32> values(1'000'000);
+		const Array<AllocationSite> sites = AllocationTracker::GetTopSites(1);
+
+		AllocationTracker::EnableSiteTracking(false);
+
+		if (sites)
+		{
+			REQUIRE(values.size_bytes() <= sites.front().currentBytes);
+		}
+	}
+}
@@ -0,0 +1,244 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include "../Siv3D/src/Siv3D/Renderer2D/LineStringVertices.hpp"
+# include "../Siv3D/src/Siv3D/Threading/SerialExecution.hpp"
+
+namespace
+{
+	// 描画関数 f で描画したレンダーテクスチャの内容を返す
+	template <class Fty>
+	Image RenderToImage(Fty f)
+	{
+		const RenderTexture renderTexture{ Size{ 256, 256 }, ColorF{ 0.0, 1.0 } };
+		{
+			const ScopedRenderTarget2D target{ renderTexture.clear(ColorF{ 0.0, 1.0 }) };
+			f();
+		}
+		Graphics2D::Flush();
+
+		Image image;
+		renderTexture.readAsImage(image);
+		return image;
+	}
+}
+
+TEST_CASE("Graphics2D::DrawRects()")
+{
+	Array<RectF> rects;
+	Array<ColorF> colors;
+
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		rects.emplace_back(((i * 37) % 256 - 8.5), ((i * 53) % 256 - 8.25), ((i % 13) + 0.5), ((i % 7) + 1.0));
+		colors.emplace_back(HSV{ (i * 10.0), 0.8, 1.0, 0.5 });
+	}
+
+	SECTION("single color")
+	{
+		const Image reference = RenderToImage([&]() { for (const auto& rect : rects) { rect.draw(ColorF{ 0.2, 0.4, 0.8, 0.5 }); } });
+		const Image bulk = RenderToImage([&]() { Graphics2D::DrawRects(rects, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		REQUIRE(reference.size() == bulk.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), bulk.begin()));
+	}
+
+	SECTION("colors")
+	{
+		const Image reference = RenderToImage([&]() { for (size_t i = 0; i < rects.size(); ++i) { rects[i].draw(colors[i]); } });
+		const Image bulk = RenderToImage([&]() { Graphics2D::DrawRects(rects, colors); });
+		REQUIRE(reference.size() == bulk.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), bulk.begin()));
+	}
+}
+
+TEST_CASE("Graphics2D::DrawCircles()")
+{
+	Array<Circle> circles;
+	Array<ColorF> colors;
+
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		circles.emplace_back(((i * 37) % 256 + 0.5), ((i * 53) % 256 + 0.25), ((i % 31 == 0) ? (i % 200) : (i % 9) * 0.75));
+		colors.emplace_back(HSV{ (i * 10.0), 0.8, 1.0, 0.5 });
+	}
+
+	SECTION("single color")
+	{
+		const Image reference = RenderToImage([&]() { for (const auto& circle : circles) { circle.draw(ColorF{ 0.2, 0.4, 0.8, 0.5 }); } });
+		const Image bulk = RenderToImage([&]() { Graphics2D::DrawCircles(circles, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		REQUIRE(reference.size() == bulk.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), bulk.begin()));
+	}
+
+	SECTION("colors")
+	{
+		const Image reference = RenderToImage([&]() { for (size_t i = 0; i < circles.size(); ++i) { circles[i].draw(colors[i]); } });
+		const Image bulk = RenderToImage([&]() { Graphics2D::DrawCircles(circles, colors); });
+		REQUIRE(reference.size() == bulk.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), bulk.begin()));
+	}
+}
+
+TEST_CASE("LineString::draw() : large")
+{
+	// 各点を複製した線は、重複点の除去 (要素数が多いため並列に処理される) の後に元の線と同じ頂点になる
+	LineString lines;
+	LineString padded;
+	Array<ColorF> colors;
+	Array<ColorF> paddedColors;
+
+	for (int32 i = 0; i < 3000; ++i)
+	{
+		const Vec2 pos{ (8.0 + (i * 7.3) - (std::floor((i * 7.3) / 240.0) * 240.0)), (8.0 + (i % 240) + ((i % 3) * 4.5)) };
+		const ColorF color = HSV{ (i * 10.0), 0.8, 1.0, 0.5 };
+		lines << pos;
+		colors << color;
+
+		for (int32 k = 0; k < 10; ++k)
+		{
+			padded << pos;
+			paddedColors << color;
+		}
+	}
+
+	REQUIRE(padded.size() == 30000);
+
+	SECTION("draw")
+	{
+		const Image reference = RenderToImage([&]() { lines.draw(3.0, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		const Image parallel = RenderToImage([&]() { padded.draw(3.0, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		REQUIRE(reference.size() == parallel.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), parallel.begin()));
+	}
+
+	SECTION("drawClosed")
+	{
+		const Image reference = RenderToImage([&]() { lines.drawClosed(3.0, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		const Image parallel = RenderToImage([&]() { padded.drawClosed(3.0, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		REQUIRE(reference.size() == parallel.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), parallel.begin()));
+	}
+
+	SECTION("Uncapped")
+	{
+		const Image reference = RenderToImage([&]() { lines.draw(LineStyle::Uncapped, 3.0, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		const Image parallel = RenderToImage([&]() { padded.draw(LineStyle::Uncapped, 3.0, ColorF{ 0.2, 0.4, 0.8, 0.5 }); });
+		REQUIRE(reference.size() == parallel.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), parallel.begin()));
+	}
+
+	SECTION("colors")
+	{
+		const Image reference = RenderToImage([&]() { lines.draw(3.0, colors); });
+		const Image parallel = RenderToImage([&]() { padded.draw(3.0, paddedColors); });
+		REQUIRE(reference.size() == parallel.size());
+		REQUIRE(std::equal(reference.begin(), reference.end(), parallel.begin()));
+	}
+}
+
+TEST_CASE("LineString vertices : serial and parallel")
+{
+	const auto equalVertex = [](const Vertex2D& a, const Vertex2D& b)
+	{
+		return ((a.pos == b.pos) && (a.tex == b.tex) && (a.color == b.color));
+	};
+
+	// 30000 点の線は 1 回のバッファ要求に収まらないため、複数のバッファ要求に分けて作成される
+	for (const size_t num_points : { 10000, 30000 })
+	{
+		Array<Vec2> points(num_points);
+
+		for (size_t i = 0; i < num_points; ++i)
+		{
+			const double t = (i * 0.37);
+			points[i].set((100.0 + (i * 0.05) + 40.0 * std::sin(t)), (100.0 + 40.0 * std::cos(t * 1.3) + (((i % 97) == 0) ? 30.0 : 0.0)));
+		}
+
+		for (const auto& [style, closeRing] : { std::pair{ LineStyle::SquareCap, CloseRing::No }, std::pair{ LineStyle::Uncapped, CloseRing::No },
+			std::pair{ LineStyle::RoundCap, CloseRing::No }, std::pair{ LineStyle::SquareCap, CloseRing::Yes } })
+		{
+			const Array<Internal::Vertex2DBatch> parallel = Internal::BuildLineStringVertices(style, points, Float2{ 3.5f, -2.25f }, 3.0, false, ColorF{ 0.2, 0.4, 0.8, 0.5 }, closeRing);
+			Array<Internal::Vertex2DBatch> serial;
+			{
+				const Threading::ScopedSerialExecution serialExecution;
+				serial = Internal::BuildLineStringVertices(style, points, Float2{ 3.5f, -2.25f }, 3.0, false, ColorF{ 0.2, 0.4, 0.8, 0.5 }, closeRing);
+			}
+
+			REQUIRE(serial.size() == parallel.size());
+
+			size_t indexCount = 0;
+
+			for (size_t i = 0; i < serial.size(); ++i)
+			{
+				REQUIRE(serial[i].vertices.size() == parallel[i].vertices.size());
+				REQUIRE(std::equal(serial[i].vertices.begin(), serial[i].vertices.end(), parallel[i].vertices.begin(), equalVertex));
+				REQUIRE(serial[i].indices == parallel[i].indices);
+				REQUIRE(parallel[i].drawnIndexCount == parallel[i].indices.size());
+				indexCount += parallel[i].indices.size();
+			}
+
+			// 線のすべての区間が描画される
+			REQUIRE((6 * (num_points - 1)) <= indexCount);
+
+			if (num_points == 30000)
+			{
+				REQUIRE(3 <= parallel.size());
+			}
+		}
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Renderer2D : benchmark")
+{
+	Array<RectF> rects(1'000'000, Arg::generator = [i = 0]() mutable { ++i; return RectF{ (i % 800), (i % 600), 4 }; });
+	Array<Circle> circles(1'000'000, Arg::generator = [i = 0]() mutable { ++i; return Circle{ (i % 800), (i % 600), 4 }; });
+
+	BENCHMARK("Rect::draw() | 1M")
+	{
+		for (int32 i = 0; i < 1'000'000; ++i)
+		{
+			Rect{ (i % 800), (i % 600), 4 }.draw(ColorF{ 1.0, 0.5 });
+		}
+
+		Graphics2D::Flush();
+		return 0;
+	};
+
+	BENCHMARK("Graphics2D::DrawRects() | 1M")
+	{
+		Graphics2D::DrawRects(rects, ColorF{ 1.0, 0.5 });
+		Graphics2D::Flush();
+		return 0;
+	};
+
+	BENCHMARK("Circle::draw() | 1M")
+	{
+		for (int32 i = 0; i < 1'000'000; ++i)
+		{
+			Circle{ (i % 800), (i % 600), 4 }.draw(ColorF{ 1.0, 0.5 });
+		}
+
+		Graphics2D::Flush();
+		return 0;
+	};
+
+	BENCHMARK("Graphics2D::DrawCircles() | 1M")
+	{
+		Graphics2D::DrawCircles(circles, ColorF{ 1.0, 0.5 });
+		Graphics2D::Flush();
+		return 0;
+	};
+}
+
+# endif
@@ -0,0 +1,209 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include "../Siv3D/src/Siv3D/Renderer2D/Software/SoftwareRasterization.hpp"
+
+namespace
+{
+	constexpr Color Background{ 0, 0, 255 };
+
+	// 図形の三角形を、ソフトウェアレンダラーで描画する
+	void RasterizePolygon(Image& image, const Polygon& polygon, const ColorF& color, const Internal::SoftwareRasterizationState& state = {})
+	{
+		Array<Vertex2D> vertices;
+
+		for (const auto& pos : polygon.vertices())
+		{
+			vertices << Vertex2D{ .pos = pos, .tex = Float2{ 0, 0 }, .color = color.toFloat4() };
+		}
+
+		Internal::RasterizeSoftware(image, vertices, polygon.indices(), state);
+	}
+
+	// ピクセル (x, y) の中心が図形の境界から十分離れている場合、内側にあるかを返す
+	Optional<bool> IsInside(const Polygon& polygon, const int32 x, const int32 y)
+	{
+		const Vec2 center{ (x + 0.5), (y + 0.5) };
+		const Array<Vec2>& outer = polygon.outer();
+
+		for (size_t i = 0; i < outer.size(); ++i)
+		{
+			const Line edge{ outer[i], outer[(i + 1) % outer.size()] };
+
+			// 頂点座標は 1/256 ピクセル単位に丸められる
+			if (Geometry2D::Distance(center, edge) < (1.0 / 64))
+			{
+				return none;
+			}
+		}
+
+		return polygon.contains(center);
+	}
+
+	// 図形の内側のピクセルが color, 外側のピクセルが Background であるかを調べ、内側のピクセルの個数を返す
+	size_t CheckCoverage(const Image& image, const Polygon& polygon, const Color& color)
+	{
+		size_t insideCount = 0;
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				const auto inside = IsInside(polygon, x, y);
+
+				if (not inside)
+				{
+					continue;
+				}
+
+				if (*inside)
+				{
+					++insideCount;
+				}
+
+				const Color expected = (*inside ? color : Background);
+
+				if (image[y][x] != expected)
+				{
+					FAIL("(" << x << ", " << y << ") : " << image[y][x] << " != " << expected);
+				}
+			}
+		}
+
+		return insideCount;
+	}
+}
+
+TEST_CASE("Software renderer : shapes")
+{
+	SECTION("Rect")
+	{
+		Image image{ Size{ 200, 150 }, Background };
+		const Polygon polygon = RectF{ 10.25, 20.75, 100.0, 50.0 }.asPolygon();
+		RasterizePolygon(image, polygon, ColorF{ 1.0, 0.0, 0.0 });
+		REQUIRE(CheckCoverage(image, polygon, Color{ 255, 0, 0 }) == (100 * 50));
+	}
+
+	SECTION("Triangle")
+	{
+		Image image{ Size{ 200, 150 }, Background };
+		const Polygon polygon = Triangle{ Vec2{ 5.3, 3.1 }, Vec2{ 190.7, 60.2 }, Vec2{ 40.1, 140.9 } }.asPolygon();
+		RasterizePolygon(image, polygon, ColorF{ 0.0, 1.0, 0.0 });
+		REQUIRE(CheckCoverage(image, polygon, Color{ 0, 255, 0 }) != 0);
+	}
+
+	SECTION("Circle")
+	{
+		Image image{ Size{ 200, 150 }, Background };
+		const Polygon polygon = Circle{ 100.2, 75.4, 60.3 }.asPolygon(64);
+		RasterizePolygon(image, polygon, ColorF{ 1.0, 1.0, 1.0 });
+		REQUIRE(CheckCoverage(image, polygon, Color{ 255, 255, 255 }) != 0);
+	}
+
+	SECTION("Thin triangle across tiles")
+	{
+		// 外接矩形はすべてのタイルに重なるが、三角形が通るタイルは一部のみ
+		Image image{ Size{ 320, 256 }, Background };
+		const Polygon polygon = Triangle{ Vec2{ 1.1, 1.3 }, Vec2{ 310.2, 250.7 }, Vec2{ 311.0, 249.2 } }.asPolygon();
+		RasterizePolygon(image, polygon, ColorF{ 1.0, 1.0, 0.0 });
+		REQUIRE(CheckCoverage(image, polygon, Color{ 255, 255, 0 }) != 0);
+	}
+
+	SECTION("Multiple triangles share edges")
+	{
+		// 共有する辺上のピクセルは一度だけ描画される
+		Image image{ Size{ 200, 150 }, Background };
+		const Polygon polygon = Circle{ 99.5, 74.5, 70.0 }.asPolygon(48);
+		Internal::SoftwareRasterizationState state;
+		state.blendState = BlendState::Additive;
+		RasterizePolygon(image, polygon, ColorF{ 0.0, 0.5, 0.0 }, state);
+		REQUIRE(CheckCoverage(image, polygon, Color{ 0, 128, 255 }) != 0);
+	}
+}
+
+TEST_CASE("Software renderer : states")
+{
+	SECTION("Alpha blending")
+	{
+		Image image{ Size{ 64, 64 }, Background };
+		RasterizePolygon(image, RectF{ 8, 8, 48, 48 }.asPolygon(), ColorF{ 1.0, 0.0, 0.0, 0.5 });
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				const bool inside = (InRange(x, 8, 55) && InRange(y, 8, 55));
+				const Color expected = (inside ? Color{ 128, 0, 128, 255 } : Background);
+				const Color pixel = image[y][x];
+				REQUIRE(AbsDiff(pixel.r, expected.r) <= 1);
+				REQUIRE(pixel.g == expected.g);
+				REQUIRE(AbsDiff(pixel.b, expected.b) <= 1);
+				REQUIRE(pixel.a == 255);
+			}
+		}
+	}
+
+	SECTION("Scissor rect")
+	{
+		Image image{ Size{ 200, 150 }, Background };
+		Internal::SoftwareRasterizationState state;
+		state.clipRect = Rect{ 50, 40, 90, 70 };
+		RasterizePolygon(image, RectF{ 0, 0, 200, 150 }.asPolygon(), ColorF{ 1.0, 0.0, 0.0 }, state);
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				const Color expected = (state.clipRect->contains(Point{ x, y }) ? Color{ 255, 0, 0 } : Background);
+				REQUIRE(image[y][x] == expected);
+			}
+		}
+	}
+
+	SECTION("Texture")
+	{
+		Image texture{ Size{ 4, 4 } };
+
+		for (int32 y = 0; y < 4; ++y)
+		{
+			for (int32 x = 0; x < 4; ++x)
+			{
+				texture[y][x] = Color{ static_cast<uint8>(x * 60), static_cast<uint8>(y * 60), 200, 255 };
+			}
+		}
+
+		const Array<Vertex2D> vertices =
+		{
+			Vertex2D{ .pos = Float2{ 16, 16 }, .tex = Float2{ 0, 0 }, .color = Float4{ 1, 1, 1, 1 } },
+			Vertex2D{ .pos = Float2{ 48, 16 }, .tex = Float2{ 1, 0 }, .color = Float4{ 1, 1, 1, 1 } },
+			Vertex2D{ .pos = Float2{ 48, 48 }, .tex = Float2{ 1, 1 }, .color = Float4{ 1, 1, 1, 1 } },
+			Vertex2D{ .pos = Float2{ 16, 48 }, .tex = Float2{ 0, 1 }, .color = Float4{ 1, 1, 1, 1 } },
+		};
+		const Array<TriangleIndex> indices = { TriangleIndex{ 0, 1, 2 }, TriangleIndex{ 0, 2, 3 } };
+
+		Image image{ Size{ 64, 64 }, Background };
+		Internal::SoftwareRasterizationState state;
+		state.samplerState = SamplerState::ClampNearest;
+		state.pTexture = &texture;
+		Internal::RasterizeSoftware(image, vertices, indices, state);
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				const bool inside = (InRange(x, 16, 47) && InRange(y, 16, 47));
+				const Color expected = (inside ? texture[(y - 16) / 8][(x - 16) / 8] : Background);
+				REQUIRE(image[y][x] == expected);
+			}
+		}
+	}
+}
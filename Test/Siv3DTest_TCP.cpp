@@ -0,0 +1,385 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+# if !SIV3D_PLATFORM(WEB)
+
+namespace
+{
+	constexpr uint16 TestPort = 50080;
+
+	// サーバとクライアントの接続を待つ
+	bool WaitForConnection(TCPServer& server, TCPClient& client)
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (stopwatch < 5s)
+		{
+			if (client.isConnected() && server.hasSession())
+			{
+				return true;
+			}
+
+			System::Sleep(1ms);
+		}
+
+		return false;
+	}
+}
+
+TEST_CASE("TCPServer::peek()")
+{
+	TCPServer server;
+	server.startAccept(TestPort);
+
+	TCPClient client;
+	client.connect(IPv4Address::Localhost(), TestPort);
+
+	REQUIRE(WaitForConnection(server, client));
+
+	// 受信バッファの複数のブロックにまたがるサイズ
+	constexpr size_t DataSize = (1024 * 1024 + 123);
+	Array<uint8> data(DataSize);
+
+	for (size_t i = 0; i < DataSize; ++i)
+	{
+		data[i] = static_cast<uint8>(i * 7);
+	}
+
+	REQUIRE(client.send(data.data(), data.size()));
+
+	Array<uint8> received;
+	const Stopwatch stopwatch{ StartImmediately::Yes };
+
+	while ((received.size() < DataSize) && (stopwatch < 10s))
+	{
+		const TCPReceiveView view = server.peek();
+
+		if (not view)
+		{
+			System::Sleep(1ms);
+			continue;
+		}
+
+		REQUIRE(view.size <= server.available());
+		received.insert(received.end(), reinterpret_cast<const uint8*>(view.data), (reinterpret_cast<const uint8*>(view.data) + view.size));
+		REQUIRE(server.consume(view.size));
+	}
+
+	REQUIRE(received == data);
+	REQUIRE(server.available() == 0);
+	REQUIRE(server.peek().isEmpty());
+	REQUIRE(not server.consume(1));
+}
+
+TEST_CASE("TCPClient::read()")
+{
+	TCPServer server;
+	server.startAccept(TestPort);
+
+	TCPClient client;
+	client.connect(IPv4Address::Localhost(), TestPort);
+
+	REQUIRE(WaitForConnection(server, client));
+
+	for (uint32 i = 0; i < 10000; ++i)
+	{
+		REQUIRE(server.send(i));
+	}
+
+	uint32 count = 0;
+	bool ordered = true;
+	const Stopwatch stopwatch{ StartImmediately::Yes };
+
+	while ((count < 10000) && (stopwatch < 10s))
+	{
+		uint32 value = 0;
+
+		if ((count % 2) && client.lookahead(value))
+		{
+			uint32 value2 = 0;
+			ordered &= client.read(value2);
+			ordered &= (value == value2);
+		}
+		else if (not client.read(value))
+		{
+			System::Sleep(1ms);
+			continue;
+		}
+
+		ordered &= (value == count);
+		++count;
+	}
+
+	REQUIRE(count == 10000);
+	REQUIRE(ordered);
+}
+
+TEST_CASE("TCPServer::receiveMessages()")
+{
+	TCPServer server;
+	server.startAccept(TestPort);
+
+	TCPClient client;
+	client.connect(IPv4Address::Localhost(), TestPort);
+
+	REQUIRE(WaitForConnection(server, client));
+
+	Array<Blob> messages;
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		// 空のメッセージや、受信バッファの複数のブロックにまたがるメッセージを含む
+		const size_t size = ((i % 100 == 0) ? (100'000 + i) : (i % 37));
+		Blob message(size);
+
+		for (size_t k = 0; k < size; ++k)
+		{
+			message.data()[k] = static_cast<Byte>(i + k);
+		}
+
+		messages << message;
+	}
+
+	REQUIRE(client.sendMessage(messages.front()));
+	REQUIRE(client.sendBatch(Array<Blob>(messages.begin() + 1, messages.end())));
+
+	Array<Blob> received;
+	const Stopwatch stopwatch{ StartImmediately::Yes };
+
+	while ((received.size() < messages.size()) && (stopwatch < 10s))
+	{
+		if (server.receiveMessages(received) == 0)
+		{
+			System::Sleep(1ms);
+		}
+	}
+
+	REQUIRE(received.size() == messages.size());
+	REQUIRE(std::equal(received.begin(), received.end(), messages.begin()));
+	REQUIRE(server.available() == 0);
+
+	// サーバからクライアントへ
+	REQUIRE(server.sendBatch(messages));
+
+	received.clear();
+
+	while ((received.size() < messages.size()) && (stopwatch < 20s))
+	{
+		if (client.receiveMessages(received) == 0)
+		{
+			System::Sleep(1ms);
+		}
+	}
+
+	REQUIRE(received.size() == messages.size());
+	REQUIRE(std::equal(received.begin(), received.end(), messages.begin()));
+}
+
+TEST_CASE("TCPServer::startAcceptMulti()")
+{
+	constexpr size_t NumClients = 16;
+	constexpr size_t NumMessages = 100;
+
+	TCPServer server;
+	server.startAcceptMulti(TestPort, 4);
+
+	Array<TCPClient> clients(NumClients);
+
+	for (auto& client : clients)
+	{
+		client.connect(IPv4Address::Localhost(), TestPort);
+	}
+
+	{
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (((server.num_sessions() < NumClients)
+			|| (not clients.all([](const TCPClient& client) { return client.isConnected(); })))
+			&& (stopwatch < 5s))
+		{
+			System::Sleep(1ms);
+		}
+	}
+
+	REQUIRE(server.num_sessions() == NumClients);
+
+	Array<Array<Blob>> messages(NumClients);
+	size_t totalBytes = 0;
+
+	for (size_t i = 0; i < NumClients; ++i)
+	{
+		for (size_t k = 0; k < NumMessages; ++k)
+		{
+			Blob message(k % 50);
+			std::fill(message.begin(), message.end(), static_cast<Byte>(i));
+			totalBytes += (sizeof(uint32) + message.size());
+			messages[i] << message;
+		}
+
+		REQUIRE(clients[i].sendBatch(messages[i]));
+	}
+
+	// サーバは受け取ったメッセージをそのまま送り返す
+	Array<Array<Blob>> received(NumClients);
+	const Stopwatch stopwatch{ StartImmediately::Yes };
+
+	while ((not received.all([](const Array<Blob>& r) { return (r.size() == NumMessages); })) && (stopwatch < 10s))
+	{
+		for (const auto id : server.getSessionIDs())
+		{
+			Array<Blob> echo;
+
+			if (server.receiveMessages(echo, id))
+			{
+				server.sendBatch(echo, id);
+			}
+		}
+
+		for (size_t i = 0; i < NumClients; ++i)
+		{
+			clients[i].receiveMessages(received[i]);
+		}
+
+		System::Sleep(1ms);
+	}
+
+	for (size_t i = 0; i < NumClients; ++i)
+	{
+		REQUIRE(received[i].size() == NumMessages);
+		REQUIRE(std::equal(received[i].begin(), received[i].end(), messages[i].begin()));
+	}
+
+	const TCPSessionStats stats = server.getStats();
+	REQUIRE(stats.bytesReceived == totalBytes);
+	REQUIRE(stats.messagesReceived == (NumClients * NumMessages));
+	REQUIRE(stats.messagesSent == (NumClients * NumMessages));
+	REQUIRE(stats.receiveQueueSize == 0);
+
+	for (const auto id : server.getSessionIDs())
+	{
+		REQUIRE(server.getSessionStats(id).messagesReceived == NumMessages);
+	}
+
+	REQUIRE(server.getSessionStats(0).messagesReceived == 0);
+}
+
+TEST_CASE("TCPServer::getStats() after disconnection")
+{
+	TCPServer server;
+	server.startAcceptMulti(TestPort);
+
+	{
+		TCPClient client;
+		client.connect(IPv4Address::Localhost(), TestPort);
+
+		REQUIRE(WaitForConnection(server, client));
+		REQUIRE(client.sendMessage(Blob(1000)));
+
+		Array<Blob> received;
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		while (received.isEmpty() && (stopwatch < 5s))
+		{
+			if (server.receiveMessages(received) == 0)
+			{
+				System::Sleep(1ms);
+			}
+		}
+
+		REQUIRE(received.size() == 1);
+	}
+
+	// クライアントが切断され、サーバがセッションを取り除くまで待つ
+	const Stopwatch stopwatch{ StartImmediately::Yes };
+
+	while (server.hasSession() && (stopwatch < 5s))
+	{
+		System::Sleep(1ms);
+	}
+
+	REQUIRE(server.num_sessions() == 0);
+
+	// 切断されたセッションの送受信量も合計に含まれる
+	const TCPSessionStats stats = server.getStats();
+	REQUIRE(stats.bytesReceived == (sizeof(uint32) + 1000));
+	REQUIRE(stats.messagesReceived == 1);
+	REQUIRE(stats.receiveQueueSize == 0);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("TCP : benchmark")
+{
+	TCPServer server;
+	server.startAccept(TestPort);
+
+	TCPClient client;
+	client.connect(IPv4Address::Localhost(), TestPort);
+
+	REQUIRE(WaitForConnection(server, client));
+
+	for (const size_t payloadSize : { 16, 256, 4096, 65536 })
+	{
+		// 1 回あたりの転送量を受信バッファの上限 (32 MiB) より十分小さく保つ
+		const size_t MessageCount = Min<size_t>(10'000, ((8 * 1024 * 1024) / (sizeof(uint32) + payloadSize)));
+		const Blob message(payloadSize);
+		const Array<Blob> messages(MessageCount, message);
+		Array<uint8> buffer(payloadSize);
+		Array<Blob> received(Arg::reserve = MessageCount);
+
+		// length-prefix を read() / send() で実装した場合
+		BENCHMARK(U"send() / read() | {} messages x {} bytes"_fmt(MessageCount, payloadSize).narrow())
+		{
+			for (size_t i = 0; i < MessageCount; ++i)
+			{
+				client.send(static_cast<uint32>(payloadSize));
+				client.send(message.data(), message.size());
+			}
+
+			size_t count = 0;
+
+			while (count < MessageCount)
+			{
+				uint32 size = 0;
+
+				if (server.lookahead(size)
+					&& ((sizeof(uint32) + size) <= server.available()))
+				{
+					server.skip(sizeof(uint32));
+					server.read(buffer.data(), size);
+					++count;
+				}
+			}
+
+			return count;
+		};
+
+		BENCHMARK(U"sendBatch() / receiveMessages() | {} messages x {} bytes"_fmt(MessageCount, payloadSize).narrow())
+		{
+			client.sendBatch(messages);
+
+			received.clear();
+
+			while (received.size() < MessageCount)
+			{
+				server.receiveMessages(received);
+			}
+
+			return received.size();
+		};
+	}
+}
+
+# endif
+
+# endif
@@ -0,0 +1,116 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Threading::ParallelFor()")
+{
+	Array<int32> v(100000, 0);
+
+	Threading::ParallelFor(v.size(), [&](size_t first, size_t last)
+	{
+		for (size_t i = first; i < last; ++i)
+		{
+			++v[i];
+		}
+	});
+
+	REQUIRE(v.count(1) == v.size());
+}
+
+TEST_CASE("TaskGroup")
+{
+	SECTION("submit / wait")
+	{
+		std::atomic<int32> count = 0;
+
+		TaskGroup group;
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			group.submit([&](int32 n) { count += n; }, 1);
+		}
+
+		group.wait();
+
+		REQUIRE(group.isDone());
+		REQUIRE(count == 1000);
+	}
+
+	SECTION("nested")
+	{
+		std::atomic<int32> count = 0;
+
+		TaskGroup group;
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			group.submit([&]()
+			{
+				TaskGroup inner;
+				inner.submit([&]() { ++count; });
+				inner.wait();
+				++count;
+			});
+		}
+
+		group.wait();
+
+		REQUIRE(count == 200);
+	}
+
+	SECTION("then")
+	{
+		std::atomic<int32> count = 0;
+		std::promise<int32> promise;
+		std::future<int32> result = promise.get_future();
+
+		TaskGroup group;
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			group.submit([&]() { ++count; });
+		}
+
+		group.then([&]() { promise.set_value(count); });
+
+		REQUIRE(result.get() == 100);
+	}
+
+	SECTION("exception")
+	{
+		TaskGroup group;
+
+		group.submit([]() { throw Error{ U"TaskGroup" }; });
+
+		REQUIRE_THROWS_AS(group.wait(), Error);
+	}
+}
+
+TEST_CASE("AsyncTask")
+{
+	Array<AsyncTask<int32>> tasks;
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		// タスクの中から別のタスクを待つ
+		tasks << Async([](int32 n) { return (Async([n]() { return n; }).get() * 2); }, i);
+	}
+
+	int32 sum = 0;
+
+	for (auto& task : tasks)
+	{
+		sum += task.get();
+	}
+
+	REQUIRE(sum == 9900);
+}
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include "Siv3DTest.hpp"
+# include <fstream>
 
 SIV3D_DISABLE_MSVC_WARNINGS_PUSH(4566)
 
@@ -1416,4 +1417,135 @@ TEST_CASE("TextReader::readAll(String&) | LONG")
 	}
 }
 
+TEST_CASE("TextReader::readLine() | CHUNK")
+{
+	// 内部で読み込むチャンクの境界をまたぐ複数バイトの文字とサロゲートペア
+	Array<String> expected;
+
+	for (int32 i = 0; i < 64; ++i)
+	{
+		expected << (String(i * 997, U'a') + U"あ😀\r\t" + ToString(i));
+	}
+
+	const std::pair<TextEncoding, FilePath> files[] =
+	{
+		{ TextEncoding::UTF8_NO_BOM, U"test/runtime/textreader/chunk/utf8_no_bom.txt" },
+		{ TextEncoding::UTF8_WITH_BOM, U"test/runtime/textreader/chunk/utf8_with_bom.txt" },
+		{ TextEncoding::UTF16LE, U"test/runtime/textreader/chunk/utf16_le.txt" },
+		{ TextEncoding::UTF16BE, U"test/runtime/textreader/chunk/utf16_be.txt" },
+	};
+
+	for (const auto& [encoding, path] : files)
+	{
+		{
+			TextWriter writer{ path, encoding };
+
+			for (const auto& line : expected)
+			{
+				writer.writeln(line);
+			}
+		}
+
+		TextReader reader{ path };
+		REQUIRE(reader.encoding() == encoding);
+
+		String line;
+
+		for (const auto& e : expected)
+		{
+			REQUIRE(reader.readLine(line) == true);
+			REQUIRE(line == String{ e }.remove(U'\r'));
+		}
+
+		REQUIRE(reader.readLine(line) == false);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("TextReader : benchmark")
+{
+	// 約 32 MB のログ形式のテキスト
+	String text;
+
+	for (int32 i = 0; text.size() < (32 * 1024 * 1024); ++i)
+	{
+		text += U"2022-01-01 12:00:00 [info] message number {} こんにちは\n"_fmt(i);
+	}
+
+	const std::pair<TextEncoding, FilePath> files[] =
+	{
+		{ TextEncoding::UTF8_NO_BOM, U"test/runtime/textreader/benchmark/utf8_no_bom.txt" },
+		{ TextEncoding::UTF8_WITH_BOM, U"test/runtime/textreader/benchmark/utf8_with_bom.txt" },
+		{ TextEncoding::UTF16LE, U"test/runtime/textreader/benchmark/utf16_le.txt" },
+		{ TextEncoding::UTF16BE, U"test/runtime/textreader/benchmark/utf16_be.txt" },
+	};
+
+	for (const auto& [encoding, path] : files)
+	{
+		TextWriter{ path, encoding }.write(text);
+	}
+
+	// 1 行ずつ読み込んだときのスループット (MB/s) を表示する
+	for (const auto& [encoding, path] : files)
+	{
+		const double megaBytes = (FileSystem::FileSize(path) / (1024.0 * 1024.0));
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		TextReader reader{ path };
+		String line;
+		size_t length = 0;
+
+		while (reader.readLine(line))
+		{
+			length += (line.size() + 1);
+		}
+
+		REQUIRE(length == text.size());
+		Console << U"TextReader::readLine() | {} : {:.1f} MB/s"_fmt(path, (megaBytes / stopwatch.sF()));
+	}
+
+	{
+		const FilePath& path = files[0].second;
+		const double megaBytes = (FileSystem::FileSize(path) / (1024.0 * 1024.0));
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+
+		std::ifstream ifs{ Unicode::Narrow(path) };
+		std::string line;
+		size_t length = 0;
+
+		while (std::getline(ifs, line))
+		{
+			length += (Unicode::FromUTF8(line).size() + 1);
+		}
+
+		REQUIRE(length == text.size());
+		Console << U"std::getline() + Unicode::FromUTF8() | {} : {:.1f} MB/s"_fmt(path, (megaBytes / stopwatch.sF()));
+	}
+
+	for (const auto& [encoding, path] : files)
+	{
+		BENCHMARK(U"TextReader::readLine() | {}"_fmt(path).narrow())
+		{
+			TextReader reader{ path };
+			String line;
+			size_t count = 0;
+
+			while (reader.readLine(line))
+			{
+				++count;
+			}
+
+			return count;
+		};
+
+		BENCHMARK(U"TextReader::readAll() | {}"_fmt(path).narrow())
+		{
+			return TextReader{ path }.readAll().size();
+		};
+	}
+}
+
+# endif
+
 SIV3D_DISABLE_MSVC_WARNINGS_POP()
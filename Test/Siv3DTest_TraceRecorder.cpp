@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("TraceRecorder")
+{
+	{
+		SIV3D_TRACE_ZONE(U"Not recorded");
+	}
+
+	TraceRecorder::Start();
+	REQUIRE(TraceRecorder::IsRecording());
+	TraceRecorder::SetThreadName(U"Main \"thread\"");
+
+	{
+		SIV3D_TRACE_ZONE(U"Outer");
+
+		for (int32 i = 0; i < 10; ++i)
+		{
+			SIV3D_TRACE_ZONE(U"Inner");
+		}
+	}
+
+	// 別のスレッドで開始して、このスレッドで終了する非同期の処理区間
+	Async([]()
+		{
+			TraceRecorder::SetThreadName(U"Worker");
+			TraceRecorder::BeginAsync(U"Cross-thread", 1);
+			SIV3D_TRACE_ZONE(U"Worker zone");
+		}).wait();
+
+	TraceRecorder::EndAsync(U"Cross-thread", 1);
+	TraceRecorder::Stop();
+	REQUIRE(not TraceRecorder::IsRecording());
+
+	{
+		SIV3D_TRACE_ZONE(U"Not recorded");
+	}
+
+	REQUIRE(TraceRecorder::GetEventCount() == 14);
+
+	const FilePath path = FileSystem::FullPath(U"test/runtime/trace/trace.json");
+	REQUIRE(TraceRecorder::Save(path));
+
+	const JSON json = JSON::Load(path);
+	REQUIRE(json);
+	REQUIRE(json[U"traceEvents"].isArray());
+
+	HashTable<String, int32> counts;
+
+	for (const auto& event : json[U"traceEvents"].arrayView())
+	{
+		++counts[event[U"name"].getString()];
+
+		if (event[U"ph"].getString() == U"X")
+		{
+			REQUIRE(0.0 <= event[U"ts"].get<double>());
+			REQUIRE(0.0 <= event[U"dur"].get<double>());
+		}
+	}
+
+	CHECK(counts[U"Outer"] == 1);
+	CHECK(counts[U"Inner"] == 10);
+	CHECK(counts[U"Worker zone"] == 1);
+	CHECK(counts[U"Cross-thread"] == 2);
+	CHECK(counts[U"thread_name"] == 2);
+	CHECK(not counts.contains(U"Not recorded"));
+
+	// 記録を開始し直すと、以前のイベントは破棄される
+	TraceRecorder::Start();
+	TraceRecorder::Stop();
+	REQUIRE(TraceRecorder::GetEventCount() == 0);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("TraceRecorder : benchmark")
+{
+	BENCHMARK("SIV3D_TRACE_ZONE | not recording | 1M")
+	{
+		for (int32 i = 0; i < 1'000'000; ++i)
+		{
+			SIV3D_TRACE_ZONE(U"Benchmark");
+		}
+
+		return 0;
+	};
+
+	TraceRecorder::Start();
+
+	BENCHMARK("SIV3D_TRACE_ZONE | recording | 100K")
+	{
+		for (int32 i = 0; i < 100'000; ++i)
+		{
+			SIV3D_TRACE_ZONE(U"Benchmark");
+		}
+
+		return 0;
+	};
+
+	TraceRecorder::Stop();
+}
+
+# endif
@@ -0,0 +1,237 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+SIV3D_DISABLE_MSVC_WARNINGS_PUSH(4566)
+
+namespace
+{
+	[[nodiscard]]
+	std::string MakeBytes(const std::initializer_list<uint8> bytes)
+	{
+		return std::string(bytes.begin(), bytes.end());
+	}
+
+	[[nodiscard]]
+	std::string Repeat(const std::string_view s, const size_t count)
+	{
+		std::string result;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			result.append(s);
+		}
+
+		return result;
+	}
+
+	// ASCII, 2 バイト, 3 バイト, 4 バイト, サロゲートペアが必要な文字を含む文字列
+	[[nodiscard]]
+	String MakeMixedText(const size_t length, const uint64 seed)
+	{
+		static constexpr char32 Samples[] = { U'a', U'Z', U'0', U'\n', U'\0', U'é', U'Ω', U'あ', U'漢', U'￿', U'😀', U'𠮷', U'\U0010FFFF' };
+
+		String result;
+		uint64 state = seed;
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			state = (state * 6364136223846793005ull + 1442695040888963407ull);
+			const size_t index = ((state >> 33) % std::size(Samples));
+
+			// ASCII が長く続く区間を作る
+			result.push_back(((state >> 60) < 10) ? static_cast<char32>(U'a' + (i % 26)) : Samples[index]);
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("Unicode : malformed UTF-8")
+{
+	struct Case
+	{
+		std::string input;
+
+		String expected;
+	};
+
+	// 不正なバイトは 1 バイトずつ U+FFFD に置き換えられる
+	const Array<Case> cases =
+	{
+		{ MakeBytes({ 0x80 }), U"�" },
+		{ MakeBytes({ 0xBF, 0x80 }), U"��" },
+		{ MakeBytes({ 0xFF }), U"�" },
+		{ MakeBytes({ 0xFE, 0xFF }), U"��" },
+
+		// 冗長な表現
+		{ MakeBytes({ 0xC0, 0xAF }), U"��" },
+		{ MakeBytes({ 0xC1, 0xBF }), U"��" },
+		{ MakeBytes({ 0xE0, 0x80, 0xAF }), U"���" },
+		{ MakeBytes({ 0xE0, 0x9F, 0xBF }), U"���" },
+		{ MakeBytes({ 0xF0, 0x80, 0x80, 0xAF }), U"����" },
+		{ MakeBytes({ 0xF0, 0x8F, 0xBF, 0xBF }), U"����" },
+
+		// U+10FFFF を超えるコードポイント
+		{ MakeBytes({ 0xF4, 0x90, 0x80, 0x80 }), U"����" },
+		{ MakeBytes({ 0xF5, 0x80, 0x80, 0x80 }), U"����" },
+		{ MakeBytes({ 0xF8, 0x88, 0x80, 0x80, 0x80 }), U"�����" },
+
+		// 途切れた符号単位
+		{ MakeBytes({ 0xC3 }), U"�" },
+		{ MakeBytes({ 0xE3, 0x81 }), U"��" },
+		{ MakeBytes({ 0xF0, 0x9F, 0x98 }), U"���" },
+		{ MakeBytes({ 0xE3, 0x81, 0x41 }), U"��A" },
+		{ MakeBytes({ 0xF0, 0x9F, 0x98, 0xE3, 0x81, 0x82 }), U"���あ" },
+
+		// 余分な継続バイト
+		{ MakeBytes({ 0xE3, 0x81, 0x82, 0x82 }), U"あ�" },
+	};
+
+	SECTION("Short")
+	{
+		for (const auto& [input, expected] : cases)
+		{
+			CHECK(Unicode::FromUTF8(input) == expected);
+			CHECK(Unicode::UTF8ToUTF32(input) == expected.toUTF32());
+			CHECK(Unicode::UTF8ToUTF16(input) == expected.toUTF16());
+		}
+	}
+
+	SECTION("Block boundaries")
+	{
+		// SIMD のブロック境界をまたぐ位置に、不正なバイト列を埋め込む
+		for (const auto& [input, expected] : cases)
+		{
+			for (const std::string_view fill : { "a"sv, "\xC3\xA9"sv, "\xE3\x81\x82"sv, "\xF0\x9F\x98\x80"sv })
+			{
+				for (size_t before = 0; before < 40; ++before)
+				{
+					for (const size_t after : { size_t{ 0 }, size_t{ 1 }, size_t{ 17 }, size_t{ 40 } })
+					{
+						const std::string s = (Repeat(fill, before) + input + Repeat(fill, after));
+						const String e = (Unicode::FromUTF8(Repeat(fill, before)) + expected + Unicode::FromUTF8(Repeat(fill, after)));
+
+						CHECK(Unicode::FromUTF8(s) == e);
+						CHECK(Unicode::UTF8ToUTF32(s) == e.toUTF32());
+						CHECK(Unicode::UTF8ToUTF16(s) == e.toUTF16());
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Encoded surrogates")
+	{
+		// UTF-8 でエンコードされたサロゲートは、従来どおりそのままのコードポイントとして変換される
+		const std::string s = (Repeat("a", 30) + MakeBytes({ 0xED, 0xA0, 0x80 }) + Repeat("a", 30));
+		const String e = (String(30, U'a') + String(1, static_cast<char32>(0xD800)) + String(30, U'a'));
+		CHECK(Unicode::FromUTF8(s) == e);
+		CHECK(Unicode::UTF8ToUTF32(s) == e.toUTF32());
+	}
+}
+
+TEST_CASE("Unicode : malformed UTF-16 / UTF-32")
+{
+	SECTION("Unpaired surrogates")
+	{
+		for (size_t before = 0; before < 20; ++before)
+		{
+			const std::u16string fill(before, u'x');
+			const String fillText(before, U'x');
+
+			CHECK(Unicode::FromUTF16(fill + u'\xD800' + u"abc") == (fillText + U"�abc"));
+			CHECK(Unicode::FromUTF16(fill + u'\xDC00' + u"abc") == (fillText + U"�abc"));
+			CHECK(Unicode::FromUTF16(fill + u'\xD800') == (fillText + U"�"));
+			CHECK(Unicode::UTF16ToUTF32(fill + u'\xDBFF' + u'\xD800') == (fillText + U"��").toUTF32());
+			CHECK(Unicode::UTF16ToUTF8(fill + u'\xDFFF' + u"abc") == Unicode::ToUTF8(fillText + U"�abc"));
+		}
+	}
+
+	SECTION("Out of range")
+	{
+		for (size_t before = 0; before < 20; ++before)
+		{
+			const String fillText(before, U'x');
+			const String s = (fillText + String(1, static_cast<char32>(0x110000)) + U"abc");
+
+			CHECK(Unicode::ToUTF8(s) == Unicode::ToUTF8(fillText + U"�abc"));
+			CHECK(Unicode::ToUTF16(s) == Unicode::ToUTF16(fillText + U"�abc"));
+		}
+	}
+}
+
+TEST_CASE("Unicode : round trip")
+{
+	for (size_t length = 0; length < 200; ++length)
+	{
+		const String s = MakeMixedText(length, length);
+		const std::string s8 = Unicode::ToUTF8(s);
+		const std::u16string s16 = Unicode::ToUTF16(s);
+		const std::u32string s32 = Unicode::ToUTF32(s);
+
+		CHECK(Unicode::FromUTF8(s8) == s);
+		CHECK(Unicode::FromUTF16(s16) == s);
+		CHECK(Unicode::FromUTF32(s32) == s);
+
+		CHECK(Unicode::UTF8ToUTF16(s8) == s16);
+		CHECK(Unicode::UTF8ToUTF32(s8) == s32);
+		CHECK(Unicode::UTF16ToUTF8(s16) == s8);
+		CHECK(Unicode::UTF16ToUTF32(s16) == s32);
+		CHECK(Unicode::UTF32ToUTF8(s32) == s8);
+		CHECK(Unicode::UTF32ToUTF16(s32) == s16);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Unicode : benchmark")
+{
+	// 約 4 MB の ASCII 主体のテキストと、日本語主体のテキスト
+	String ascii, japanese;
+
+	for (int32 i = 0; ascii.size() < (4 * 1024 * 1024); ++i)
+	{
+		ascii += U"2022-01-01 12:00:00 [info] message number {} こんにちは\n"_fmt(i);
+		japanese += U"吾輩は猫である。名前はまだ無い。{}\n"_fmt(i);
+	}
+
+	for (const auto& [name, text] : { std::pair{ U"ascii"sv, ascii }, std::pair{ U"japanese"sv, japanese } })
+	{
+		const std::string s8 = Unicode::ToUTF8(text);
+		const std::u16string s16 = Unicode::ToUTF16(text);
+
+		BENCHMARK(U"Unicode::FromUTF8() | {}"_fmt(name).narrow())
+		{
+			return Unicode::FromUTF8(s8).size();
+		};
+
+		BENCHMARK(U"Unicode::ToUTF8() | {}"_fmt(name).narrow())
+		{
+			return Unicode::ToUTF8(text).size();
+		};
+
+		BENCHMARK(U"Unicode::UTF8ToUTF16() | {}"_fmt(name).narrow())
+		{
+			return Unicode::UTF8ToUTF16(s8).size();
+		};
+
+		BENCHMARK(U"Unicode::UTF16ToUTF32() | {}"_fmt(name).narrow())
+		{
+			return Unicode::UTF16ToUTF32(s16).size();
+		};
+	}
+}
+
+# endif
+
+SIV3D_DISABLE_MSVC_WARNINGS_POP()